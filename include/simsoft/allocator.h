@@ -208,24 +208,103 @@ CPP_NAMESPACE_START(SimSoft)
 
 #   ifdef __cplusplus /* C++ API */
 
+        /**
+         * @class SimSoft::Allocator
+         * @headerfile allocator.h "simsoft/allocator.h"
+         * @brief Base class for C++ memory allocators.
+         * 
+         * @details Containers taking an allocator type parameter take a pointer to an instance
+         *          of it, & use the default allocator when given @c nullptr .
+         */
         class EXPORT Allocator {
         private:
             C_API::Sim_IAllocator _c_allocator;
-        
+
         public:
             virtual void* malloc(size_t size) = 0;
-            virtual void* falloc(size_t size, ubyte fill = 0x00) = 0;
+            virtual void* falloc(size_t size, uint8 fill = 0x00) = 0;
             virtual void* realloc(void* ptr, size_t size) = 0;
             virtual void  free(void* ptr) = 0;
 
-            Allocator();
+            Allocator() : _c_allocator(*C_API::sim_allocator_get_default()) { }
             virtual ~Allocator() = 0;
 
-            C_API::Sim_IAllocator *const get_c_allocator() const {
+            /**
+             * @fn const C_API::Sim_IAllocator* SimSoft::Allocator::get_c_allocator() const
+             * @brief Retrieves an allocator usable by the C API.
+             * 
+             * @return Pointer to the default allocator's functions; C function pointers can't
+             *         call an instance's member functions.
+             */
+            const C_API::Sim_IAllocator* get_c_allocator() const {
                 return &_c_allocator;
             }
+        };
+
+        inline Allocator::~Allocator() { }
+
+        /**
+         * @fn void* allocator_malloc(_Alloc *const, size_t)
+         * @headerfile allocator.h "simsoft/allocator.h"
+         * @brief Allocates memory with an allocator.
+         * 
+         * @tparam _Alloc Allocator type; calls are devirtualized if it's @c final .
+         * 
+         * @param[in] allocator_ptr Pointer to an allocator. Uses the default allocator if
+         *                          @c nullptr .
+         * @param[in] size          How much memory to allocate.
+         * 
+         * @return @c nullptr if out of memory; pointer to allocated space otherwise.
+         */
+        template <class _Alloc>
+        inline void* allocator_malloc(_Alloc *const allocator_ptr, size_t size) {
+            return allocator_ptr ?
+                allocator_ptr->malloc(size) :
+                C_API::sim_allocator_get_default()->malloc(size)
+            ;
         }
-        
+
+        /**
+         * @fn void* allocator_realloc(_Alloc *const, void*, size_t)
+         * @headerfile allocator.h "simsoft/allocator.h"
+         * @brief Reallocates memory allocated by allocator_malloc() with the same allocator.
+         * 
+         * @tparam _Alloc Allocator type; calls are devirtualized if it's @c final .
+         * 
+         * @param[in] allocator_ptr Pointer to an allocator. Uses the default allocator if
+         *                          @c nullptr .
+         * @param[in] ptr           Pointer to memory to reallocate.
+         * @param[in] size          Size request for reallocated memory.
+         * 
+         * @return @c nullptr if out of memory; pointer to reallocated space otherwise.
+         */
+        template <class _Alloc>
+        inline void* allocator_realloc(_Alloc *const allocator_ptr, void* ptr, size_t size) {
+            return allocator_ptr ?
+                allocator_ptr->realloc(ptr, size) :
+                C_API::sim_allocator_get_default()->realloc(ptr, size)
+            ;
+        }
+
+        /**
+         * @fn void allocator_free(_Alloc *const, void*)
+         * @headerfile allocator.h "simsoft/allocator.h"
+         * @brief Frees memory allocated by allocator_malloc() with the same allocator.
+         * 
+         * @tparam _Alloc Allocator type.
+         * 
+         * @param[in] allocator_ptr Pointer to an allocator. Uses the default allocator if
+         *                          @c nullptr .
+         * @param[in] ptr           Pointer to memory to free.
+         */
+        template <class _Alloc>
+        inline void allocator_free(_Alloc *const allocator_ptr, void* ptr) {
+            if (allocator_ptr)
+                allocator_ptr->free(ptr);
+            else
+                C_API::sim_allocator_get_default()->free(ptr);
+        }
+
 #   endif /* end C++ API */
 CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
 
@@ -0,0 +1,435 @@
+/**
+ * @file cache.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Header for bounded caches built on hashmaps
+ * @version 0.1
+ * @date 2020-02-20
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_CACHE_H_
+#define SIMSOFT_CACHE_H_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./hashmap.h"
+
+CPP_NAMESPACE_START(SimSoft)
+    CPP_NAMESPACE_C_API_START /* C API */
+
+        /**
+         * @enum Sim_CachePolicy
+         * @headerfile cache.h "simsoft/cache.h"
+         * @brief How a cache picks which entry to evict when it's full.
+         * 
+         * @var Sim_CachePolicy::SIM_CACHE_LRU
+         *     Evict the least recently used entry. Entries are kept on an intrusive list in the
+         *     order they were last used; each hit moves its entry to the front.
+         * @var Sim_CachePolicy::SIM_CACHE_CLOCK
+         *     Approximate LRU with the CLOCK algorithm. Each hit only sets its entry's reference
+         *     bit; evictions sweep a hand over the entries, clearing set bits & evicting the
+         *     first entry found with its bit already clear.
+         */
+        typedef enum Sim_CachePolicy {
+            SIM_CACHE_LRU   = 0,
+            SIM_CACHE_CLOCK = 1
+        } Sim_CachePolicy;
+
+        /**
+         * @typedef Sim_CacheChargeProc
+         * @headerfile cache.h "simsoft/cache.h"
+         * @brief Function pointer used to weigh an entry against a cache's capacity.
+         * 
+         * @param[in] key_ptr   Pointer to the entry's key.
+         * @param[in] value_ptr Pointer to the entry's value.
+         * 
+         * @return How much of the cache's capacity the entry takes up; usually the amount of
+         *         bytes its value holds on to.
+         */
+        typedef size_t (*Sim_CacheChargeProc)(
+            const void *const key_ptr,
+            const void *const value_ptr
+        );
+
+        /**
+         * @typedef Sim_CacheEvictProc
+         * @headerfile cache.h "simsoft/cache.h"
+         * @brief Function pointer called on each entry evicted from a cache.
+         * 
+         * @param[in] key_ptr   Pointer to the evicted entry's key.
+         * @param[in] value_ptr Pointer to the evicted entry's value.
+         * @param[in] userdata  User-provided callback data.
+         */
+        typedef void (*Sim_CacheEvictProc)(
+            const void *const key_ptr,
+            void *const       value_ptr,
+            Sim_Variant       userdata
+        );
+
+        /**
+         * @struct Sim_CacheStats
+         * @headerfile cache.h "simsoft/cache.h"
+         * @brief Snapshot of how well a cache is performing.
+         * 
+         * @var Sim_CacheStats::count
+         *     The amount of entries in the cache.
+         * @var Sim_CacheStats::charge
+         *     The total charge of every entry in the cache.
+         * @var Sim_CacheStats::capacity
+         *     The largest total charge the cache holds before evicting entries.
+         * @var Sim_CacheStats::hits
+         *     The amount of lookups that found their key.
+         * @var Sim_CacheStats::misses
+         *     The amount of lookups that didn't find their key.
+         * @var Sim_CacheStats::insertions
+         *     The amount of entries put into the cache, not counting overwrites.
+         * @var Sim_CacheStats::evictions
+         *     The amount of entries evicted to make room for others.
+         * @var Sim_CacheStats::hit_rate
+         *     @e hits divided by the total amount of lookups; @c 0 if there were none.
+         */
+        typedef struct Sim_CacheStats {
+            size_t count;    // amount of entries
+            size_t charge;   // total charge of entries
+            size_t capacity; // largest total charge
+
+            size_t hits;       // lookups that found their key
+            size_t misses;     // lookups that didn't find their key
+            size_t insertions; // entries put into the cache
+            size_t evictions;  // entries evicted to make room
+            double hit_rate;   // hits / (hits + misses)
+        } Sim_CacheStats;
+
+        /**
+         * @struct Sim_Cache
+         * @headerfile cache.h "simsoft/cache.h"
+         * @brief Bounded key-value pair container that evicts entries when full.
+         * 
+         * @details Entries live in one array & are found through a hashmap from keys to their
+         *          index in it. The array is only ever grown while the cache warms up, so once
+         *          it's full, puts & gets run in constant time without allocating: a put either
+         *          reuses a removed entry or evicts one.
+         * 
+         * @var Sim_Cache::_index @private
+         *     Hashmap from keys to the index of their entry.
+         * @var Sim_Cache::_allocator_ptr @private
+         *     Pointer to allocator used to allocate the entries.
+         * @var Sim_Cache::count
+         *     The amount of entries in the cache.
+         * @var Sim_Cache::charge
+         *     The total charge of every entry in the cache.
+         * @var Sim_Cache::capacity
+         *     The largest total charge the cache holds before evicting entries.
+         * @var Sim_Cache::data_ptr
+         *     Pointer to the entries.
+         * @var Sim_Cache::_allocated @private
+         *     The amount of allocated entries.
+         * @var Sim_Cache::_used @private
+         *     The amount of entries that have ever held a pair.
+         * @var Sim_Cache::_free @private
+         *     Index of the first removed entry waiting to be reused; @c SIZE_MAX if none.
+         * @var Sim_Cache::_head @private
+         *     Index of the most recently used entry; @c SIZE_MAX if empty. LRU only.
+         * @var Sim_Cache::_tail @private
+         *     Index of the least recently used entry; @c SIZE_MAX if empty. LRU only.
+         * @var Sim_Cache::_hand @private
+         *     Index of the next entry the clock hand looks at. CLOCK only.
+         * @var Sim_Cache::_policy @private
+         *     How the cache picks which entry to evict.
+         * @var Sim_Cache::_charge_proc @private
+         *     Pointer to function weighing entries; @c NULL if each entry has a charge of 1.
+         * @var Sim_Cache::_evict_proc @private
+         *     Pointer to function called on evicted entries; @c NULL if none.
+         * @var Sim_Cache::_evict_userdata @private
+         *     User-provided data for the eviction function.
+         * @var Sim_Cache::_entry_size @private
+         *     The size of each entry in bytes.
+         * @var Sim_Cache::_hits @private
+         *     The amount of lookups that found their key.
+         * @var Sim_Cache::_misses @private
+         *     The amount of lookups that didn't find their key.
+         * @var Sim_Cache::_insertions @private
+         *     The amount of entries put into the cache.
+         * @var Sim_Cache::_evictions @private
+         *     The amount of entries evicted to make room.
+         * @var Sim_Cache::_value_size @private
+         *     The size of values contained in the cache in bytes.
+         */
+        typedef struct Sim_Cache {
+            Sim_HashMap _index; // key -> entry index
+            const Sim_IAllocator *const _allocator_ptr; // entry allocator
+
+            size_t count;          // amount of entries
+            size_t charge;         // total charge of entries
+            const size_t capacity; // largest total charge
+            void* data_ptr;        // pointer to entries
+
+            size_t _allocated; // how many entries have been allocated
+            size_t _used;      // how many entries have ever held a pair
+            size_t _free;      // first removed entry
+            size_t _head;      // most recently used entry
+            size_t _tail;      // least recently used entry
+            size_t _hand;      // next entry looked at by the clock hand
+
+            const Sim_CachePolicy _policy;           // eviction policy
+            const Sim_CacheChargeProc _charge_proc; // entry weighing function
+            const Sim_CacheEvictProc _evict_proc;   // eviction function
+            const Sim_Variant _evict_userdata;      // eviction function userdata
+            const size_t _entry_size;               // size of each entry in bytes
+
+            size_t _hits;       // lookups that found their key
+            size_t _misses;     // lookups that didn't find their key
+            size_t _insertions; // entries put into the cache
+            size_t _evictions;  // entries evicted to make room
+
+            const size_t _value_size; // size of cache values
+        } Sim_Cache;
+
+        /**
+         * @fn void sim_cache_construct(
+         *         Sim_Cache *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const Sim_CachePolicy,
+         *         const size_t,
+         *         Sim_CacheChargeProc,
+         *         Sim_CacheEvictProc,
+         *         Sim_Variant
+         *     )
+         * @relates @capi{Sim_Cache}
+         * @brief Constructs a new cache.
+         * 
+         * @param[in,out] cache_ptr          Pointer to a cache to construct.
+         * @param[in]     key_size           Size of each key in bytes.
+         * @param[in]     key_hash_proc      Pointer to a hash function used on keys. Uses a
+         *                                   default hash function if @c NULL.
+         * @param[in]     key_predicate_proc Pointer to a predicate function used on keys.
+         * @param[in]     value_size         Size of each value in bytes.
+         * @param[in]     allocator_ptr      Pointer to an allocator. Uses the default allocator
+         *                                   if @c NULL.
+         * @param[in]     policy             How the cache picks which entry to evict.
+         * @param[in]     capacity           The largest total charge the cache may hold; an
+         *                                   amount of entries if @e charge_proc is @c NULL.
+         * @param[in]     charge_proc        Pointer to a function weighing each entry, e.g. in
+         *                                   bytes; @c NULL to give each entry a charge of 1.
+         * @param[in]     evict_proc         Pointer to a function called on each evicted entry;
+         *                                   may be @c NULL.
+         * @param[in]     evict_userdata     User-provided data for @e evict_proc.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e cache_ptr or @e key_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e capacity is 0 or @e policy is invalid;
+         *     @b SIM_RC_ERR_OUTOFMEM if the entries or the index couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Caches bounded by an amount of entries allocate every entry up front.
+         *          Caches weighing their entries don't know how many will fit, so they grow their
+         *          entries as they fill up, until they first have to evict.
+         * 
+         * @sa sim_cache_destroy
+         */
+        extern EXPORT void C_CALL sim_cache_construct(
+            Sim_Cache *const      cache_ptr,
+            const size_t          key_size,
+            Sim_HashProc          key_hash_proc,
+            Sim_PredicateProc     key_predicate_proc,
+            const size_t          value_size,
+            const Sim_IAllocator* allocator_ptr,
+            const Sim_CachePolicy policy,
+            const size_t          capacity,
+            Sim_CacheChargeProc   charge_proc,
+            Sim_CacheEvictProc    evict_proc,
+            Sim_Variant           evict_userdata
+        );
+
+        /**
+         * @fn void sim_cache_destroy(Sim_Cache *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Destroys a cache.
+         * 
+         * @param[in,out] cache_ptr Pointer to a cache to destroy.
+         * 
+         * @remarks The eviction function isn't called on the entries left in the cache.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_cache_construct
+         */
+        extern EXPORT void C_CALL sim_cache_destroy(
+            Sim_Cache *const cache_ptr
+        );
+
+        /**
+         * @fn void sim_cache_clear(Sim_Cache *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Clears a cache of all its entries, keeping its memory for reuse.
+         * 
+         * @param[in,out] cache_ptr Pointer to a cache to empty.
+         * 
+         * @remarks The eviction function isn't called on the cleared entries.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_cache_clear(
+            Sim_Cache *const cache_ptr
+        );
+
+        /**
+         * @fn bool sim_cache_contains_key(Sim_Cache *const, const void *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Checks if a key is contained in a cache without counting as a use of it.
+         * 
+         * @param[in] cache_ptr Pointer to a cache to search.
+         * @param[in] key_ptr   Pointer to key to search for.
+         * 
+         * @return @c true if the key is contained in the cache; @c false otherwise or on error
+         *         (see remarks).
+         * 
+         * @remarks Neither the entry's recency nor the hit & miss counters are updated.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if @e key_ptr isn't contained in the cache;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_cache_contains_key(
+            Sim_Cache *const  cache_ptr,
+            const void *const key_ptr
+        );
+
+        /**
+         * @fn void* sim_cache_get_ptr(Sim_Cache *const, const void *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Get pointer to value in a cache via a particular key, marking it as used.
+         * 
+         * @param[in,out] cache_ptr Pointer to a cache to retrieve a value from.
+         * @param[in]     key_ptr   Pointer to lookup key.
+         * 
+         * @return @c NULL on error (see remarks); pointer to value associated with the key
+         *         otherwise.
+         * 
+         * @remarks The pointer is invalidated by the next put, which may evict the entry or
+         *          grow the entries.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if the key isn't contained in the cache;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void* C_CALL sim_cache_get_ptr(
+            Sim_Cache *const  cache_ptr,
+            const void *const key_ptr
+        );
+
+        /**
+         * @fn void sim_cache_get(Sim_Cache *const, const void*, void*)
+         * @relates @capi{Sim_Cache}
+         * @brief Get a value from a cache via a particular key, marking it as used.
+         * 
+         * @param[in,out] cache_ptr     Pointer to a cache to retrieve a value from.
+         * @param[in]     key_ptr       Pointer to lookup key.
+         * @param[out]    out_value_ptr Pointer to be filled with the associated value.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr, @e key_ptr, or @e out_value_ptr are
+         *                           @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if the key isn't contained in the cache;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_cache_get(
+            Sim_Cache *const cache_ptr,
+            const void*      key_ptr,
+            void*            out_value_ptr
+        );
+
+        /**
+         * @fn void sim_cache_put(Sim_Cache *const, const void*, const void*)
+         * @relates @capi{Sim_Cache}
+         * @brief Puts a key-value pair into a cache or overwrites a pre-existing pair's value,
+         *        evicting entries until it fits.
+         * 
+         * @param[in,out] cache_ptr Pointer to a cache to put into.
+         * @param[in]     key_ptr   Pointer to key to put.
+         * @param[in]     value_ptr Pointer to value to put.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e cache_ptr, @e key_ptr, or @e value_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the cache had to grow its entries to hold the pair and
+         *                            was unable to;
+         *     @b SIM_RC_FAILURE      if the pair's charge alone is larger than the cache's
+         *                            capacity; nothing is changed;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Putting a pair counts as a use of it. Overwritten values aren't passed to the
+         *          eviction function.
+         */
+        extern EXPORT void C_CALL sim_cache_put(
+            Sim_Cache *const cache_ptr,
+            const void*      key_ptr,
+            const void*      value_ptr
+        );
+
+        /**
+         * @fn void sim_cache_remove(Sim_Cache *const, const void *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Removes a key-value pair from a cache via a key.
+         * 
+         * @param[in,out] cache_ptr      Pointer to a cache to remove from.
+         * @param[in]     remove_key_ptr Pointer to a key to remove from the cache.
+         * 
+         * @remarks The eviction function isn't called on the removed entry.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr or @e remove_key_ptr are @c NULL ;
+         *     @b SIM_RC_FAILURE     if *remove_key_ptr was not contained in the cache;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_cache_remove(
+            Sim_Cache *const  cache_ptr,
+            const void *const remove_key_ptr
+        );
+
+        /**
+         * @fn void sim_cache_get_stats(Sim_Cache *const, Sim_CacheStats *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Gathers a snapshot of a cache's size & hit, miss, & eviction counters.
+         * 
+         * @param[in]  cache_ptr     Pointer to a cache to inspect.
+         * @param[out] out_stats_ptr Pointer to be filled with the cache's statistics.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr or @e out_stats_ptr are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_cache_reset_stats
+         */
+        extern EXPORT void C_CALL sim_cache_get_stats(
+            Sim_Cache *const      cache_ptr,
+            Sim_CacheStats *const out_stats_ptr
+        );
+
+        /**
+         * @fn void sim_cache_reset_stats(Sim_Cache *const)
+         * @relates @capi{Sim_Cache}
+         * @brief Resets a cache's hit, miss, insertion, & eviction counters to 0.
+         * 
+         * @param[in,out] cache_ptr Pointer to a cache whose counters will be reset.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e cache_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_cache_get_stats
+         */
+        extern EXPORT void C_CALL sim_cache_reset_stats(
+            Sim_Cache *const cache_ptr
+        );
+
+    CPP_NAMESPACE_C_API_END /* end C API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_CACHE_H_ */
@@ -842,6 +842,144 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t attempt
         );
 
+        /**
+         * @enum Sim_HashFlags
+         * @headerfile common.h "simsoft/common.h"
+         * @brief C enumeration of hash table (hashset & hashmap) construction options.
+         * @details Flags may be combined with a bitwise OR.
+         *
+         * @var Sim_HashFlags::SIM_HASH_DEFAULT
+         *     Default behavior; each item is stored in its own separately allocated node.
+         * @var Sim_HashFlags::SIM_HASH_FLAT_STORAGE
+         *     Store items inline in the hash table's slots instead of in separately allocated
+         *     nodes. Pointers into the hash table are invalidated whenever it is resized.
+         * @var Sim_HashFlags::SIM_HASH_GROUP_PROBING
+         *     Probe groups of 16 slots at a time (via SIMD where supported) by matching 7-bit
+         *     hash fingerprints instead of double hashing one slot at a time. Keys are only
+         *     compared on fingerprint matches. The hash table's size is kept at a power of 2.
+         * @var Sim_HashFlags::SIM_HASH_POWER_OF_TWO
+         *     Keep the hash table's size at a power of 2 instead of a prime and probe it
+         *     linearly, indexing with a bitmask instead of a modulo. Hashes are passed through a
+         *     finalizer mixer first. Ignored if @c SIM_HASH_GROUP_PROBING is set.
+         * @var Sim_HashFlags::SIM_HASH_SIPHASH
+         *     Hash keys with sim_siphash instead of sim_fasthash when no hash function is
+         *     provided. Slower, but resistant to hash flooding from untrusted keys.
+         * @var Sim_HashFlags::SIM_HASH_CACHE_HASHES
+         *     Store each item's full hash alongside it. Resizing never calls the hash function
+         *     and cached hashes are compared before calling the predicate function. Probe
+         *     sequences are derived from the cached hash, so the hash function is only ever
+         *     called with an attempt of 0. Worthwhile for keys that are expensive to hash.
+         * @var Sim_HashFlags::SIM_HASH_INCREMENTAL_RESIZE
+         *     Spread growing & shrinking the hash table across later operations instead of
+         *     rehashing every item at once. The old buckets are kept until each insert, lookup &
+         *     removal has migrated a bounded amount of them, capping the latency of any single
+         *     operation at the cost of briefly holding both bucket arrays.
+         * @var Sim_HashFlags::SIM_HASH_ROBIN_HOOD
+         *     Probe linearly with Robin Hood hashing; implies @c SIM_HASH_POWER_OF_TWO. Each slot
+         *     stores how far its item is from its home slot, inserts go in front of items closer
+         *     to home than the new one, & lookups stop at the first such item instead of at an
+         *     empty slot, bounding the length of failed lookups. Removals shift later items back
+         *     instead of leaving tombstones. Costs an extra byte per slot. Ignored if
+         *     @c SIM_HASH_GROUP_PROBING is set.
+         */
+        typedef enum Sim_HashFlags {
+            SIM_HASH_DEFAULT       = 0,
+            SIM_HASH_FLAT_STORAGE  = 0x1,
+            SIM_HASH_GROUP_PROBING = 0x2,
+            SIM_HASH_POWER_OF_TWO  = 0x4,
+            SIM_HASH_SIPHASH       = 0x8,
+            SIM_HASH_CACHE_HASHES  = 0x10,
+            SIM_HASH_INCREMENTAL_RESIZE = 0x20,
+            SIM_HASH_ROBIN_HOOD    = 0x40
+        } Sim_HashFlags;
+
+#       ifndef SIM_HASH_OP_COUNTERS
+#           ifdef DEBUG
+#               define SIM_HASH_OP_COUNTERS 1
+#           else
+#               define SIM_HASH_OP_COUNTERS 0
+#           endif
+#       endif
+
+#       ifndef SIM_HASH_STATS_HISTOGRAM_SIZE
+#           define SIM_HASH_STATS_HISTOGRAM_SIZE 16
+#       endif
+
+        /**
+         * @struct Sim_HashOpCounters
+         * @headerfile common.h "simsoft/common.h"
+         * @brief Per-operation counters kept by hash tables (hashsets & hashmaps).
+         * @details Only counted if the library is built with @c SIM_HASH_OP_COUNTERS non-zero,
+         *          which it is by default in @c DEBUG builds; otherwise the counting compiles
+         *          away & the counters always read as @c 0. Hash tables hold them either way, so
+         *          code using the library needn't be built with the same setting.
+         * 
+         * @var Sim_HashOpCounters::lookups
+         *     The amount of keys searched for (contains, get, & batched lookups).
+         * @var Sim_HashOpCounters::lookup_probes
+         *     The total amount of probes made by those lookups.
+         * @var Sim_HashOpCounters::inserts
+         *     The amount of insertions, including overwrites of pre-existing keys.
+         * @var Sim_HashOpCounters::removes
+         *     The amount of successful removals.
+         */
+        typedef struct Sim_HashOpCounters {
+            size_t lookups;       // amount of lookups
+            size_t lookup_probes; // total probes made by lookups
+            size_t inserts;       // amount of insertions
+            size_t removes;       // amount of removals
+        } Sim_HashOpCounters;
+
+        /**
+         * @struct Sim_HashStats
+         * @headerfile common.h "simsoft/common.h"
+         * @brief Snapshot of how well a hash table (hashset or hashmap) is performing.
+         * @details A probe is one slot examined, or one group of slots when group probing. An
+         *          item's probe length is how many probes a lookup of it takes; its displacement
+         *          is its probe length minus 1. Long probe lengths on a lightly loaded table point
+         *          to a poor hash function.
+         * 
+         * @var Sim_HashStats::count
+         *     The amount of items in the hash table.
+         * @var Sim_HashStats::allocated
+         *     The amount of slots in the hash table, including any still being migrated out of
+         *     by an incremental resize.
+         * @var Sim_HashStats::tombstones
+         *     The amount of slots marked as deleted.
+         * @var Sim_HashStats::load_factor
+         *     @e count divided by @e allocated.
+         * @var Sim_HashStats::probe_histogram
+         *     The amount of items with each probe length; index @c i counts items found in
+         *     @c i+1 probes. The last index also counts every item needing more probes.
+         * @var Sim_HashStats::average_displacement
+         *     The mean displacement of every item.
+         * @var Sim_HashStats::max_displacement
+         *     The largest displacement of any item.
+         * @var Sim_HashStats::resize_count
+         *     The amount of times the hash table has allocated new buckets since construction.
+         * @var Sim_HashStats::allocated_bytes
+         *     The amount of bytes currently allocated through the hash table's allocator, both
+         *     for buckets & nodes. Nodes freed from a bulk construction's block are still counted
+         *     until the whole block is; buckets mapped from a file aren't counted.
+         * @var Sim_HashStats::op_counters
+         *     Per-operation counters; all @c 0 unless @c SIM_HASH_OP_COUNTERS is non-zero.
+         */
+        typedef struct Sim_HashStats {
+            size_t count;      // amount of items
+            size_t allocated;  // amount of slots
+            size_t tombstones; // amount of deleted slots
+            double load_factor; // count / allocated
+
+            size_t probe_histogram[SIM_HASH_STATS_HISTOGRAM_SIZE]; // items per probe length
+            double average_displacement; // mean probe length - 1
+            size_t max_displacement;     // longest probe length - 1
+
+            size_t resize_count;    // amount of bucket reallocations
+            size_t allocated_bytes; // bytes allocated for buckets & nodes
+
+            Sim_HashOpCounters op_counters; // per-operation counters
+        } Sim_HashStats;
+
         /**
          * @typedef Sim_FilterProc
          * @headerfile common.h "simsoft/common.h"
@@ -0,0 +1,275 @@
+/**
+ * @file conhashmap.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Header for concurrent hashmaps
+ * @version 0.1
+ * @date 2020-02-05
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_CONHASHMAP_H_
+#define SIMSOFT_CONHASHMAP_H_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./hashmap.h"
+
+CPP_NAMESPACE_START(SimSoft)
+    CPP_NAMESPACE_C_API_START /* C API */
+
+#       ifndef SIM_CONHASHMAP_DEFAULT_SHARDS
+#           define SIM_CONHASHMAP_DEFAULT_SHARDS 64
+#       endif
+
+        /**
+         * @struct Sim_ConcurrentHashMap
+         * @headerfile conhashmap.h "simsoft/conhashmap.h"
+         * @brief Thread-safe unordered key-value pair container.
+         * 
+         * @details Keys are split across a power of 2 amount of shards by their hash. Each shard
+         *          is a hashmap guarded by its own reader-writer lock, so lookups never block
+         *          each other & writers only block operations on keys in the same shard.
+         * 
+         * @var Sim_ConcurrentHashMap::_allocator_ptr @private
+         *     Pointer to allocator used to allocate shards, buckets, & nodes. Must be
+         *     thread-safe.
+         * @var Sim_ConcurrentHashMap::_shard_count @private
+         *     The amount of shards keys are split across; always a power of 2.
+         * @var Sim_ConcurrentHashMap::_shards_ptr @private
+         *     Pointer to the shards, each holding a lock & a hashmap.
+         */
+        typedef struct Sim_ConcurrentHashMap {
+            const Sim_IAllocator *const _allocator_ptr; // shard allocator
+            const size_t _shard_count; // amount of shards
+            void* _shards_ptr;         // pointer to shards
+        } Sim_ConcurrentHashMap;
+
+        /**
+         * @fn void sim_conhashmap_construct(
+         *         Sim_ConcurrentHashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const size_t,
+         *         const size_t,
+         *         const Sim_HashFlags
+         *     )
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Constructs a new concurrent hashmap.
+         * 
+         * @param[in,out] conhashmap_ptr     Pointer to a concurrent hashmap to initialize.
+         * @param[in]     key_size           Size of each key in bytes.
+         * @param[in]     key_hash_proc      Pointer to a hash function used on keys. Uses a
+         *                                   default hash function if @c NULL.
+         * @param[in]     key_predicate_proc Pointer to a predicate function used on keys.
+         * @param[in]     value_size         Size of each value in bytes.
+         * @param[in]     allocator_ptr      Pointer to a thread-safe allocator. Uses the default
+         *                                   allocator if @c NULL.
+         * @param[in]     initial_size       The starting size of the whole concurrent hashmap.
+         * @param[in]     shard_count        The amount of shards to split keys across; rounded up
+         *                                   to a power of 2. Uses
+         *                                   @c SIM_CONHASHMAP_DEFAULT_SHARDS if @c 0.
+         * @param[in]     flags              Storage & probing options for each shard;
+         *                                   @c SIM_HASH_DEFAULT for default behavior.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e conhashmap_ptr or @e key_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if shards or hash buckets couldn't be allocated;
+         *     @b SIM_RC_FAILURE      if a shard's lock couldn't be initialized;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @sa sim_conhashmap_destroy
+         */
+        extern EXPORT void C_CALL sim_conhashmap_construct(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            const size_t                 key_size,
+            Sim_HashProc                 key_hash_proc,
+            Sim_PredicateProc            key_predicate_proc,
+            const size_t                 value_size,
+            const Sim_IAllocator*        allocator_ptr,
+            const size_t                 initial_size,
+            const size_t                 shard_count,
+            const Sim_HashFlags          flags
+        );
+
+        /**
+         * @fn void sim_conhashmap_destroy(Sim_ConcurrentHashMap *const)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Destroys a concurrent hashmap.
+         * 
+         * @param[in,out] conhashmap_ptr Pointer to a concurrent hashmap to destroy.
+         * 
+         * @remarks Must not be called while other threads are using the concurrent hashmap.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_conhashmap_construct
+         */
+        extern EXPORT void C_CALL sim_conhashmap_destroy(
+            Sim_ConcurrentHashMap *const conhashmap_ptr
+        );
+
+        /**
+         * @fn size_t sim_conhashmap_get_count(Sim_ConcurrentHashMap *const)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Counts the key-value pairs in a concurrent hashmap.
+         * 
+         * @param[in] conhashmap_ptr Pointer to a concurrent hashmap to count.
+         * 
+         * @return The amount of key-value pairs in the concurrent hashmap; @c 0 on error (see
+         *         remarks).
+         * 
+         * @remarks Shards are counted one at a time, so the count may be stale by the time it's
+         *          returned if other threads are inserting or removing.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT size_t C_CALL sim_conhashmap_get_count(
+            Sim_ConcurrentHashMap *const conhashmap_ptr
+        );
+
+        /**
+         * @fn void sim_conhashmap_clear(Sim_ConcurrentHashMap *const)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Clears a concurrent hashmap of all its contents.
+         * 
+         * @param[in,out] conhashmap_ptr Pointer to a concurrent hashmap to empty.
+         * 
+         * @remarks Shards are cleared one at a time; pairs inserted into already cleared shards
+         *          by other threads meanwhile are kept.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_conhashmap_clear(
+            Sim_ConcurrentHashMap *const conhashmap_ptr
+        );
+
+        /**
+         * @fn bool sim_conhashmap_contains_key(Sim_ConcurrentHashMap *const, const void *const)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Checks if a key is contained in a concurrent hashmap.
+         * 
+         * @param[in] conhashmap_ptr Pointer to a concurrent hashmap to search.
+         * @param[in] key_ptr        Pointer to key to compare against.
+         * 
+         * @return @c false on error (see remarks) or if the key isn't contained in the
+         *         concurrent hashmap; @c true otherwise.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if @e key_ptr isn't contained in the concurrent hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_conhashmap_contains_key(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            const void *const            key_ptr
+        );
+
+        /**
+         * @fn void sim_conhashmap_get(Sim_ConcurrentHashMap *const, const void*, void*)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Get a copy of a value from a concurrent hashmap via a particular key.
+         * 
+         * @param[in]  conhashmap_ptr Pointer to a concurrent hashmap to retrieve a value from.
+         * @param[in]  key_ptr        Pointer to lookup key.
+         * @param[out] out_value_ptr  Pointer to be filled with the associated value.
+         * 
+         * @remarks There is no pointer-returning equivalent of sim_hashmap_get_ptr(); values may
+         *          be moved or freed by other threads as soon as their shard is unlocked.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr, @e key_ptr, or @e out_value_ptr are
+         *                           @c NULL;
+         *     @b SIM_RC_NOT_FOUND   if the key isn't contained in the concurrent hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_conhashmap_get(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            const void*                  key_ptr,
+            void*                        out_value_ptr
+        );
+
+        /**
+         * @fn void sim_conhashmap_insert(Sim_ConcurrentHashMap *const, const void*, const void*)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Inserts a key-value pair into a concurrent hashmap or overwrites a pre-existing
+         *        pair if the key is already in the concurrent hashmap.
+         * 
+         * @param[in,out] conhashmap_ptr Pointer to a concurrent hashmap to insert into.
+         * @param[in]     new_key_ptr    Pointer to a new key to add to the concurrent hashmap.
+         * @param[in]     value_ptr      Pointer to a value to associate with the key.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e conhashmap_ptr, @e new_key_ptr, or @e value_ptr are
+         *                            @c NULL;
+         *     @b SIM_RC_ERR_OUTOFMEM if the key's shard had to resize to accomodate the newly
+         *                            inserted pair and was unable to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_conhashmap_insert(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            const void*                  new_key_ptr,
+            const void*                  value_ptr
+        );
+
+        /**
+         * @fn void sim_conhashmap_remove(Sim_ConcurrentHashMap *const, const void *const)
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Removes a key-value pair from a concurrent hashmap via a key.
+         * 
+         * @param[in,out] conhashmap_ptr Pointer to a concurrent hashmap to remove from.
+         * @param[in]     remove_key_ptr Pointer to a key to remove from the concurrent hashmap.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e conhashmap_ptr or @e remove_key_ptr are @c NULL;
+         *     @b SIM_RC_ERR_OUTOFMEM if the key's shard had to resize to save space and was
+         *                            unable to;
+         *     @b SIM_RC_FAILURE      if *remove_key_ptr was not contained in the concurrent
+         *                            hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_conhashmap_remove(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            const void *const            remove_key_ptr
+        );
+
+        /**
+         * @fn bool sim_conhashmap_foreach(
+         *         Sim_ConcurrentHashMap *const,
+         *         Sim_MapForEachProc,
+         *         Sim_Variant
+         *     )
+         * @relates @capi{Sim_ConcurrentHashMap}
+         * @brief Applies a given function to each key-value pair in a concurrent hashmap.
+         * 
+         * @param[in] conhashmap_ptr Pointer to a concurrent hashmap whose key-value pairs will be
+         *                           iterated over.
+         * @param[in] foreach_proc   Pointer to a function that will be applied to each pair in
+         *                           the concurrent hashmap.
+         * @param[in] userdata       User-provided data for @e foreach_proc.
+         * 
+         * @return @c false on error (see remarks) or if the loop wasn't fully completed;
+         *         @c true  otherwise.
+         * 
+         * @remarks Each shard is read-locked while its pairs are iterated over; @e foreach_proc
+         *          must not insert into or remove from the concurrent hashmap.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e conhashmap_ptr or @e foreach_proc are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_conhashmap_foreach(
+            Sim_ConcurrentHashMap *const conhashmap_ptr,
+            Sim_MapForEachProc           foreach_proc,
+            Sim_Variant                  userdata
+        );
+
+    CPP_NAMESPACE_C_API_END /* end C API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_CONHASHMAP_H_ */
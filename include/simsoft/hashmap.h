@@ -14,6 +14,7 @@
 
 #include "./common.h"
 #include "./allocator.h"
+#include "./hashtable.hpp"
 
 CPP_NAMESPACE_START(SimSoft)
     CPP_NAMESPACE_C_API_START /* C API */
@@ -41,6 +42,36 @@ CPP_NAMESPACE_START(SimSoft)
          *     The base size passed into the hashmap's constructor.
          * @var Sim_HashMap::_allocated @private
          *     The amount of allocated buckets in the hash table used by the hashmap.
+         * @var Sim_HashMap::_tombstones @private
+         *     The amount of buckets in the hash table marked as deleted.
+         * @var Sim_HashMap::_flags @private
+         *     The storage & probing options the hashmap was constructed with.
+         * @var Sim_HashMap::_slot_size @private
+         *     The size of each bucket in the hash table used by the hashmap in bytes.
+         * @var Sim_HashMap::_old_data_ptr @private
+         *     Pointer to the hash table being migrated out of by an incremental resize; @c NULL
+         *     when not resizing.
+         * @var Sim_HashMap::_old_allocated @private
+         *     The amount of allocated buckets in the hash table being migrated out of.
+         * @var Sim_HashMap::_migrated @private
+         *     The amount of buckets that have been migrated out of the old hash table.
+         * @var Sim_HashMap::_resize_count @private
+         *     The amount of times new buckets have been allocated since construction.
+         * @var Sim_HashMap::_node_block_ptr @private
+         *     Pointer to the block holding the nodes created by a bulk construction; @c NULL if
+         *     there are none.
+         * @var Sim_HashMap::_node_block_size @private
+         *     The size of the node block in bytes.
+         * @var Sim_HashMap::_mapped_ptr @private
+         *     Pointer to the file mapping holding the buckets of a read-only hashmap; @c NULL
+         *     if the hashmap owns its buckets.
+         * @var Sim_HashMap::_mapped_size @private
+         *     The size of the file mapping in bytes.
+         * @var Sim_HashMap::_thread_count @private
+         *     The most threads that resizes & bulk insertions may split their work between.
+         * @var Sim_HashMap::_op_counters @private
+         *     Per-operation counters; only counted if the library is built with
+         *     @c SIM_HASH_OP_COUNTERS non-zero.
          * @var Sim_HashMap::_value_size @private
          *     The size of values contained in the hashmap in bytes.
          */
@@ -55,10 +86,26 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t _initial_size;
             const size_t _base_size; // base size used for initialization
             size_t _allocated; // how many buckets have been allocated
+            size_t _tombstones; // how many buckets are marked as deleted
 
             size_t count;   // amount of items stored in the hashmap
             void* data_ptr; // pointer to hash buckets
 
+            const Sim_HashFlags _flags; // storage & probing options
+            const size_t _slot_size;    // size of each bucket in bytes
+
+            void* _old_data_ptr;   // buckets being migrated out of by an incremental resize
+            size_t _old_allocated; // how many old buckets were allocated
+            size_t _migrated;      // how many old buckets have been migrated
+
+            size_t _resize_count;    // how many times new buckets have been allocated
+            void* _node_block_ptr;   // nodes created at once by a bulk construction
+            size_t _node_block_size; // size of the node block in bytes
+            void* _mapped_ptr;       // file mapping holding read-only buckets
+            size_t _mapped_size;     // size of the file mapping in bytes
+            size_t _thread_count;    // most threads used by resizes & bulk insertions
+            Sim_HashOpCounters _op_counters; // per-operation counters
+
             size_t _value_size; // size of hashmap values
         } Sim_HashMap;
 
@@ -111,6 +158,7 @@ CPP_NAMESPACE_START(SimSoft)
          *     @b SIM_RC_ERR_OUTOFMEM if hash buckets couldn't be allocated;
          *     @b SIM_RC_SUCCESS      otherwise.
          * 
+         * @sa sim_hashmap_construct_with_flags
          * @sa sim_hashmap_construct_struct
          * @sa sim_hashmap_destroy
          */
@@ -124,6 +172,234 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t          initial_size
         );
 
+        /**
+         * @fn Sim_ReturnCode sim_hashmap_construct_with_flags(
+         *         Sim_HashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const size_t,
+         *         const Sim_HashFlags
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Constructs a new hashmap with given storage & probing options.
+         * 
+         * @param[in,out] hashmap_ptr        Pointer to a hashmap to construct.
+         * @param[in]     key_size           Size of hashmap keys.
+         * @param[in]     key_hash_proc      Key hash function.
+         * @param[in]     key_predicate_proc Key equality predicate function.
+         * @param[in]     value_size         Size of each item.
+         * @param[in]     allocator_ptr      Pointer to allocator to use when resizing hash
+         *                                   buckets.
+         * @param[in]     initial_size       The initial allocated size of the newly created
+         *                                   hashmap.
+         * @param[in]     flags              Storage & probing options; @c SIM_HASH_DEFAULT for
+         *                                   default behavior.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr or @e key_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if hash buckets couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @sa sim_hashmap_construct
+         * @sa sim_hashmap_destroy
+         */
+        extern EXPORT void C_CALL sim_hashmap_construct_with_flags(
+            Sim_HashMap *const    hashmap_ptr,
+            const size_t          key_size,
+            Sim_HashProc          key_hash_proc,
+            Sim_PredicateProc     key_predicate_proc,
+            const size_t          value_size,
+            const Sim_IAllocator* allocator_ptr,
+            const size_t          initial_size,
+            const Sim_HashFlags   flags
+        );
+
+        /**
+         * @fn void sim_hashmap_construct_from(
+         *         Sim_HashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const Sim_HashFlags,
+         *         const void *const,
+         *         const void *const,
+         *         const size_t
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Constructs a new hashmap holding the key-value pairs of parallel arrays.
+         * 
+         * @param[in,out] hashmap_ptr        Pointer to a hashmap to construct.
+         * @param[in]     key_size           Size of hashmap keys.
+         * @param[in]     key_hash_proc      Key hash function.
+         * @param[in]     key_predicate_proc Key equality predicate function.
+         * @param[in]     value_size         Size of each item.
+         * @param[in]     allocator_ptr      Pointer to allocator to use when resizing hash
+         *                                   buckets.
+         * @param[in]     flags              Storage & probing options; @c SIM_HASH_DEFAULT for
+         *                                   default behavior.
+         * @param[in]     keys_ptr           Pointer to an array of keys to insert.
+         * @param[in]     values_ptr         Pointer to an array of values to insert; one per key.
+         * @param[in]     item_count         The amount of key-value pairs to insert.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr, @e key_predicate_proc, @e keys_ptr, or
+         *                            @e values_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if hash buckets or nodes couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details The hash buckets are sized to hold every pair up front, so nothing is resized
+         *          while they're inserted, & every node is carved out of a single block rather
+         *          than allocated one by one. The block is freed once the hashmap is cleared or
+         *          destroyed. Later duplicate keys overwrite the values of earlier ones, as with
+         *          sim_hashmap_insert. @e keys_ptr & @e values_ptr may be @c NULL if
+         *          @e item_count is 0.
+         * @details A new hashmap only uses the calling thread, so the pairs are always inserted
+         *          on it. To build a large hashmap on several threads, construct it empty, call
+         *          sim_hashmap_set_thread_count, then insert the pairs with
+         *          sim_hashmap_insert_many.
+         * 
+         * @sa sim_hashmap_construct_with_flags
+         * @sa sim_hashmap_construct_from_vector
+         * @sa sim_hashmap_set_thread_count
+         */
+        extern EXPORT void C_CALL sim_hashmap_construct_from(
+            Sim_HashMap *const    hashmap_ptr,
+            const size_t          key_size,
+            Sim_HashProc          key_hash_proc,
+            Sim_PredicateProc     key_predicate_proc,
+            const size_t          value_size,
+            const Sim_IAllocator* allocator_ptr,
+            const Sim_HashFlags   flags,
+            const void *const     keys_ptr,
+            const void *const     values_ptr,
+            const size_t          item_count
+        );
+
+        struct Sim_Vector; // see vector.h
+
+        /**
+         * @fn void sim_hashmap_construct_from_vector(
+         *         Sim_HashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const Sim_HashFlags,
+         *         const struct Sim_Vector *const
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Constructs a new hashmap holding the key-value pairs in a vector.
+         * 
+         * @param[in,out] hashmap_ptr        Pointer to a hashmap to construct.
+         * @param[in]     key_size           Size of hashmap keys.
+         * @param[in]     key_hash_proc      Key hash function.
+         * @param[in]     key_predicate_proc Key equality predicate function.
+         * @param[in]     value_size         Size of each item.
+         * @param[in]     allocator_ptr      Pointer to allocator to use when resizing hash
+         *                                   buckets.
+         * @param[in]     flags              Storage & probing options; @c SIM_HASH_DEFAULT for
+         *                                   default behavior.
+         * @param[in]     pairs_vector_ptr   Pointer to a vector of key-value pairs to insert;
+         *                                   each item is a key followed by its value.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr, @e key_predicate_proc, or
+         *                            @e pairs_vector_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if the vector's item size isn't @e key_size + @e value_size ;
+         *     @b SIM_RC_ERR_OUTOFMEM if hash buckets or nodes couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details See sim_hashmap_construct_from.
+         * 
+         * @sa sim_hashmap_construct_from
+         */
+        extern EXPORT void C_CALL sim_hashmap_construct_from_vector(
+            Sim_HashMap *const             hashmap_ptr,
+            const size_t                   key_size,
+            Sim_HashProc                   key_hash_proc,
+            Sim_PredicateProc              key_predicate_proc,
+            const size_t                   value_size,
+            const Sim_IAllocator*          allocator_ptr,
+            const Sim_HashFlags            flags,
+            const struct Sim_Vector *const pairs_vector_ptr
+        );
+
+        /**
+         * @fn void sim_hashmap_construct_mapped(
+         *         Sim_HashMap *const,
+         *         FILE *const,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Constructs a read-only hashmap whose buckets are mapped straight from a file
+         *        written by sim_hashmap_serialize.
+         * 
+         * @param[in,out] hashmap_ptr        Pointer to a hashmap to construct.
+         * @param[in]     file_ptr           File to map the hashmap from.
+         * @param[in]     key_hash_proc      Key hash function; must be the one the serialized
+         *                                   hashmap was constructed with.
+         * @param[in]     key_predicate_proc Key equality predicate function.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr or @e key_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_BADFILE  if @e file_ptr is @c NULL or doesn't hold a serialized
+         *                            hashmap this build can use;
+         *     @b SIM_RC_ERR_INVALARG if @e key_hash_proc doesn't hash keys as the serialized
+         *                            hashmap's hash function did;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Nothing is copied or rehashed, so opening even a large hashmap costs no more
+         *          than mapping the file. Lookups work as usual, but anything that would modify the
+         *          hashmap (inserting, removing, resizing, or clearing) fails with
+         *          @b SIM_RC_ERR_UNSUPRTD, & pointers handed out by lookups or iteration point into
+         *          read-only memory. The file may be closed once the hashmap is constructed; the
+         *          mapping is released when the hashmap is destroyed.
+         * 
+         * @sa sim_hashmap_serialize
+         */
+        extern EXPORT void C_CALL sim_hashmap_construct_mapped(
+            Sim_HashMap *const hashmap_ptr,
+            FILE *const        file_ptr,
+            Sim_HashProc       key_hash_proc,
+            Sim_PredicateProc  key_predicate_proc
+        );
+
+        /**
+         * @fn void sim_hashmap_serialize(Sim_HashMap *const, FILE *const)
+         * @relates @capi{Sim_HashMap}
+         * @brief Writes a hashmap to a file that sim_hashmap_construct_mapped can map back in.
+         * 
+         * @param[in,out] hashmap_ptr Pointer to a hashmap to serialize.
+         * @param[in]     file_ptr    File to write the hashmap to; it's written from the start.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_BADFILE  if @e file_ptr is @c NULL or couldn't be written to;
+         *     @b SIM_RC_ERR_INVALARG if the hashmap wasn't constructed with
+         *                            @c SIM_HASH_FLAT_STORAGE ;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details The buckets are written behind a small header exactly as they're laid out in
+         *          memory, so only flat storage can be serialized & keys must not hold
+         *          pointers. Any incremental resize is finished first. Files can only be mapped by
+         *          builds with the same byte order & word size, & only with a hash function that
+         *          gives the same hashes in every process; the default hash functions use fixed
+         *          seeds, so they qualify.
+         * 
+         * @sa sim_hashmap_construct_mapped
+         */
+        extern EXPORT void C_CALL sim_hashmap_serialize(
+            Sim_HashMap *const hashmap_ptr,
+            FILE *const        file_ptr
+        );
+
         /**
          * @fn void sim_hashmap_destroy(Sim_HashMap *const)
          * @relates @capi{Sim_HashMap}
@@ -194,6 +470,28 @@ CPP_NAMESPACE_START(SimSoft)
             const void *const  key_ptr
         );
 
+        /**
+         * @fn void sim_hashmap_get_stats(Sim_HashMap *const, Sim_HashStats *const)
+         * @relates @capi{Sim_HashMap}
+         * @brief Gathers a snapshot of a hashmap's load, probe lengths, & memory use.
+         * 
+         * @param[in,out] hashmap_ptr   Pointer to a hashmap to inspect.
+         * @param[out]    out_stats_ptr Pointer to be filled with the hashmap's statistics.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashmap_ptr or @e out_stats_ptr are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Every item is looked up again to measure its probe length, so this takes time
+         *          linear in the size of the hashmap; it's meant for tuning & diagnostics rather
+         *          than hot paths. @e out_stats_ptr->op_counters is only filled in when the
+         *          library is built with @c SIM_HASH_OP_COUNTERS enabled.
+         */
+        extern EXPORT void C_CALL sim_hashmap_get_stats(
+            Sim_HashMap *const   hashmap_ptr,
+            Sim_HashStats *const out_stats_ptr
+        );
+
         /**
          * @fn void sim_hashmap_resize(Sim_HashMap *const, size_t)
          * @relates @capi{Sim_HashMap}
@@ -213,6 +511,40 @@ CPP_NAMESPACE_START(SimSoft)
             size_t             new_size
         );
 
+        /**
+         * @fn void sim_hashmap_set_thread_count(Sim_HashMap *const, const size_t)
+         * @relates @capi{Sim_HashMap}
+         * @brief Sets how many threads a hashmap's resizes & bulk insertions may split their work
+         *        between.
+         * 
+         * @param[in,out] hashmap_ptr  Pointer to a hashmap to configure.
+         * @param[in]     thread_count The most threads to use; @c 0 or @c 1 to only use the
+         *                             calling thread, which is the default.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Work is only split up once there are several thousand items per thread.
+         *          Threads claim slots in the new buckets atomically, so every item can be found
+         *          along its probe sequence just as if it had been placed one at a time. Nodes are
+         *          still allocated on the calling thread, but the key hash & predicate functions
+         *          are called from several threads at once; they must be thread-safe & must not
+         *          throw. Robin Hood hashmaps & incremental resizes always use the calling thread
+         *          alone.
+         * @details Bulk constructions happen before a thread count can be set, so they always use
+         *          the calling thread; a hashmap built from many pairs on several threads is
+         *          constructed empty, given a thread count, & then filled by
+         *          sim_hashmap_insert_many.
+         * 
+         * @sa sim_hashmap_insert_many
+         * @sa sim_hashmap_construct_from
+         */
+        extern EXPORT void C_CALL sim_hashmap_set_thread_count(
+            Sim_HashMap *const hashmap_ptr,
+            const size_t       thread_count
+        );
+
         /**
          * @fn void sim_hashmap_get(Sim_HashMap *const, const void*, void*)
          * @relates @capi{Sim_HashMap}
@@ -255,6 +587,44 @@ CPP_NAMESPACE_START(SimSoft)
             const void*        key_ptr
         );
 
+        /**
+         * @fn size_t sim_hashmap_get_many(
+         *         Sim_HashMap *const,
+         *         const void*,
+         *         const size_t,
+         *         void* *const
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Get pointers to the values in the hashmap associated with each of a batch of
+         *        keys.
+         * 
+         * @param[in,out] hashmap_ptr    Pointer to a hashmap to retrieve values from.
+         * @param[in]     keys_ptr       Pointer to an array of lookup keys.
+         * @param[in]     key_count      Number of keys in @e keys_ptr.
+         * @param[out]    out_value_ptrs Pointer to an array of @e key_count pointers to be filled
+         *                               with pointers to each key's value in the hashmap, or
+         *                               @c NULL for keys that aren't contained in it.
+         * 
+         * @return The amount of keys found in the hashmap; @c 0 on error (see remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashmap_ptr, @e keys_ptr, or @e out_value_ptrs are
+         *                           @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if any key isn't contained in the hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Every key in the batch is hashed & has its buckets prefetched before any of
+         *          them are searched for, overlapping the cache misses of each lookup.
+         * 
+         * @sa sim_hashmap_get_ptr
+         */
+        extern EXPORT size_t C_CALL sim_hashmap_get_many(
+            Sim_HashMap *const hashmap_ptr,
+            const void*        keys_ptr,
+            const size_t       key_count,
+            void* *const       out_value_ptrs
+        );
+
         /**
          * @fn void sim_hashmap_insert(Sim_HashMap *const, const void*, const void*)
          * @relates @capi{Sim_HashMap}
@@ -278,6 +648,44 @@ CPP_NAMESPACE_START(SimSoft)
             const void*        value_ptr
         );
 
+        /**
+         * @fn void sim_hashmap_insert_many(
+         *         Sim_HashMap *const,
+         *         const void*,
+         *         const void*,
+         *         const size_t
+         *     )
+         * @relates @capi{Sim_HashMap}
+         * @brief Inserts a batch of key-value pairs into the hashmap, overwriting pre-existing
+         *        pairs with the same keys.
+         * 
+         * @param[in,out] hashmap_ptr Pointer to a hashmap to insert into.
+         * @param[in]     keys_ptr    Pointer to an array of new keys to add to the hashmap.
+         * @param[in]     values_ptr  Pointer to an array of values to associate with each key.
+         * @param[in]     item_count  Number of keys in @e keys_ptr & values in @e values_ptr.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashmap_ptr, @e keys_ptr, or @e values_ptr are
+         *                            @c NULL;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashmap had to resize to accomodate the newly
+         *                            inserted items and was unable to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Keys are hashed & have their buckets prefetched several at a time ahead of
+         *          being inserted. Pairs are inserted in order, so later duplicate keys win.
+         *          Large batches are split between threads if sim_hashmap_set_thread_count
+         *          allowed it; duplicates still keep their first key & their last value.
+         * 
+         * @sa sim_hashmap_insert
+         * @sa sim_hashmap_set_thread_count
+         */
+        extern EXPORT void C_CALL sim_hashmap_insert_many(
+            Sim_HashMap *const hashmap_ptr,
+            const void*        keys_ptr,
+            const void*        values_ptr,
+            const size_t       item_count
+        );
+
         /**
          * @fn void sim_hashmap_remove(Sim_HashMap *const, const void *const)
          * @relates @capi{Sim_HashMap}
@@ -326,18 +734,181 @@ CPP_NAMESPACE_START(SimSoft)
     CPP_NAMESPACE_C_API_END /* end C API */
 
 #   ifdef __cplusplus /* C++ API */
-#       include "./exception.hpp"
-        
+
+        /**
+         * @class SimSoft::HashMap
+         * @headerfile hashmap.h "simsoft/hashmap.h"
+         * @brief Generic unordered key-value pair container / associative array class.
+         * 
+         * @tparam K      The type of keys stored in this hashmap.
+         * @tparam V      The type of values stored in this hashmap.
+         * @tparam _Hash  Hash functor used on keys.
+         * @tparam _Pred  Equality predicate functor used on keys.
+         * @tparam _Alloc Allocator for slots.
+         * 
+         * @details Hashing & comparing keys is inlined into each lookup; see HashTable.
+         */
         template <
             class K,
             class V,
-            class _Hash,
-            class _Pred,
+            class _Hash = Hash<K>,
+            class _Pred = Predicate_Equal<K>,
             class _Alloc = Allocator
         >
-        class HashMap {
+        class HashMap : public HashTable<K, V, _Hash, _Pred, _Alloc> {
+        private:
+            typedef HashTable<K, V, _Hash, _Pred, _Alloc> Table;
+
+        public:
+            /**
+             * @typedef SimSoft::HashMap::value_type
+             * @brief The type of values stored in this hashmap.
+             */
+            typedef V value_type;
+
+            /**
+             * @fn SimSoft::HashMap::HashMap(size_t, _Alloc*)
+             * @brief Constructs a new HashMap object.
+             * 
+             * @param[in] initial_size  @b Optional: The amount of slots allocated by the first
+             *                          insertion. Defaults to @e HashMap::DEFAULT_SIZE.
+             * @param[in] allocator_ptr @b Optional: Pointer to an allocator. Uses the default
+             *                          allocator if @c nullptr .
+             */
+            HashMap(
+                size_t  initial_size = Table::DEFAULT_SIZE,
+                _Alloc* allocator_ptr = nullptr
+            ) noexcept : Table(initial_size, allocator_ptr) { }
+
+            /**
+             * @fn bool SimSoft::HashMap::contains_key(const K&) const
+             * @brief Checks if a key is contained in the hashmap.
+             * 
+             * @param[in] key Key to check.
+             */
+            bool contains_key(const K& key) const {
+                return Table::_find(key) != nullptr;
+            }
+
+            /**
+             * @fn V* SimSoft::HashMap::get_ptr(const K&)
+             * @brief Get pointer to value in the hashmap via a particular key.
+             * 
+             * @param[in] key Lookup key.
+             * 
+             * @return @c nullptr if the key isn't contained in the hashmap; pointer to its value
+             *         otherwise.
+             */
+            V* get_ptr(const K& key) {
+                typename Table::Slot *const slot_ptr = Table::_find(key);
+                return slot_ptr ?
+                    &slot_ptr->value :
+                    nullptr
+                ;
+            }
+            const V* get_ptr(const K& key) const {
+                return const_cast<HashMap*>(this)->get_ptr(key);
+            }
+
+            /**
+             * @fn V& SimSoft::HashMap::get(const K&)
+             * @brief Get a value from the hashmap via a particular key.
+             * 
+             * @param[in] key Lookup key.
+             * 
+             * @throws OutOfBoundsException If the key isn't contained in the hashmap.
+             */
+            V& get(const K& key) {
+                V *const value_ptr = get_ptr(key);
+                if (!value_ptr)
+                    throw OutOfBoundsException();
+                return *value_ptr;
+            }
+            const V& get(const K& key) const {
+                return const_cast<HashMap*>(this)->get(key);
+            }
+
+            /**
+             * @fn V& SimSoft::HashMap::operator[](const K&)
+             * @brief Get a value from the hashmap, inserting a value-initialized one if the key
+             *        isn't contained in it.
+             * 
+             * @param[in] key Lookup key.
+             * 
+             * @throws OutOfMemoryException If the hashmap needed to grow & couldn't.
+             */
+            V& operator[](const K& key) {
+                bool inserted;
+                return Table::_insert(inserted, key, V())->value;
+            }
+            V& operator[](K&& key) {
+                bool inserted;
+                return Table::_insert(inserted, std::move(key), V())->value;
+            }
+
+            /**
+             * @fn bool SimSoft::HashMap::insert(const K&, const V&)
+             * @brief Inserts a key-value pair into the hashmap or overwrites a pre-existing
+             *        key's value.
+             * 
+             * @param[in] key   Key to insert.
+             * @param[in] value Value to associate with @e key.
+             * 
+             * @return @c true if @e key wasn't contained in the hashmap; @c false otherwise.
+             * 
+             * @throws OutOfMemoryException If the hashmap needed to grow & couldn't.
+             */
+            bool insert(const K& key, const V& value) {
+                return _insert_or_assign(key, value);
+            }
+            bool insert(const K& key, V&& value) {
+                return _insert_or_assign(key, std::move(value));
+            }
+            bool insert(K&& key, const V& value) {
+                return _insert_or_assign(std::move(key), value);
+            }
+            bool insert(K&& key, V&& value) {
+                return _insert_or_assign(std::move(key), std::move(value));
+            }
+
+            /**
+             * @fn bool SimSoft::HashMap::foreach(PROC)
+             * @brief Applies a given functor to each key-value pair in the hashmap.
+             * 
+             * @tparam PROC Functor type; called as @c bool(const K&, V&) .
+             * 
+             * @param[in] foreach_proc Functor returning @c false to break out of the loop.
+             * 
+             * @return @c false if the loop wasn't fully completed; @c true otherwise.
+             * 
+             * @remarks Pairs must not be inserted or removed during the loop.
+             */
+            template <class PROC>
+            bool foreach(PROC&& foreach_proc) {
+                for (size_t i = 0; i < Table::_allocated; i++) {
+                    if (Table::_control_ptr[i] == Table::_CTRL_EMPTY)
+                        continue;
+
+                    typename Table::Slot& slot = Table::_slots_ptr[i];
+                    if (!foreach_proc((const K&)slot.key, slot.value))
+                        return false;
+                }
+                return true;
+            }
+
         private:
-            C_API::Sim_HashMap _c_hashmap;
+            template <class KEY, class VALUE>
+            bool _insert_or_assign(KEY&& key, VALUE&& value) {
+                bool inserted;
+                typename Table::Slot *const slot_ptr = Table::_insert(
+                    inserted,
+                    std::forward<KEY>(key),
+                    std::forward<VALUE>(value)
+                );
+                if (!inserted)
+                    slot_ptr->value = std::forward<VALUE>(value);
+                return inserted;
+            }
         };
 
 #   endif /* end C++ API */
@@ -14,6 +14,7 @@
 
 #include "./common.h"
 #include "./allocator.h"
+#include "./hashtable.hpp"
 
 CPP_NAMESPACE_START(SimSoft)
     CPP_NAMESPACE_C_API_START /* C API */
@@ -40,6 +41,36 @@ CPP_NAMESPACE_START(SimSoft)
          *     The base size passed into the hashset's constructor.
          * @var Sim_HashSet::_allocated @private
          *     The amount of allocated buckets in the hash table used by the hashset.
+         * @var Sim_HashSet::_tombstones @private
+         *     The amount of buckets in the hash table marked as deleted.
+         * @var Sim_HashSet::_flags @private
+         *     The storage & probing options the hashset was constructed with.
+         * @var Sim_HashSet::_slot_size @private
+         *     The size of each bucket in the hash table used by the hashset in bytes.
+         * @var Sim_HashSet::_old_data_ptr @private
+         *     Pointer to the hash table being migrated out of by an incremental resize; @c NULL
+         *     when not resizing.
+         * @var Sim_HashSet::_old_allocated @private
+         *     The amount of allocated buckets in the hash table being migrated out of.
+         * @var Sim_HashSet::_migrated @private
+         *     The amount of buckets that have been migrated out of the old hash table.
+         * @var Sim_HashSet::_resize_count @private
+         *     The amount of times new buckets have been allocated since construction.
+         * @var Sim_HashSet::_node_block_ptr @private
+         *     Pointer to the block holding the nodes created by a bulk construction; @c NULL if
+         *     there are none.
+         * @var Sim_HashSet::_node_block_size @private
+         *     The size of the node block in bytes.
+         * @var Sim_HashSet::_mapped_ptr @private
+         *     Pointer to the file mapping holding the buckets of a read-only hashset; @c NULL
+         *     if the hashset owns its buckets.
+         * @var Sim_HashSet::_mapped_size @private
+         *     The size of the file mapping in bytes.
+         * @var Sim_HashSet::_thread_count @private
+         *     The most threads that resizes & bulk insertions may split their work between.
+         * @var Sim_HashSet::_op_counters @private
+         *     Per-operation counters; only counted if the library is built with
+         *     @c SIM_HASH_OP_COUNTERS non-zero.
          */
         typedef struct Sim_HashSet {
             const struct {
@@ -52,9 +83,25 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t _initial_size; // the size of the hashset on initialization
             const size_t _base_size; // used for dynamically resizing
             size_t _allocated;  // how many buckets have been allocated
+            size_t _tombstones; // how many buckets are marked as deleted
 
             size_t count;   // amount of items stored in the hashset
             void* data_ptr; // pointer to hash buckets
+
+            const Sim_HashFlags _flags; // storage & probing options
+            const size_t _slot_size;    // size of each bucket in bytes
+
+            void* _old_data_ptr;   // buckets being migrated out of by an incremental resize
+            size_t _old_allocated; // how many old buckets were allocated
+            size_t _migrated;      // how many old buckets have been migrated
+
+            size_t _resize_count;    // how many times new buckets have been allocated
+            void* _node_block_ptr;   // nodes created at once by a bulk construction
+            size_t _node_block_size; // size of the node block in bytes
+            void* _mapped_ptr;       // file mapping holding read-only buckets
+            size_t _mapped_size;     // size of the file mapping in bytes
+            size_t _thread_count;    // most threads used by resizes & bulk insertions
+            Sim_HashOpCounters _op_counters; // per-operation counters
         } Sim_HashSet;
 
         /**
@@ -83,6 +130,7 @@ CPP_NAMESPACE_START(SimSoft)
          *     @b SIM_RC_ERR_OUTOFMEM if hash buckets couldn't be allocated;
          *     @b SIM_RC_SUCCESS      otherwise.
          * 
+         * @sa sim_hashset_construct_with_flags
          * @sa sim_hashset_destroy
          */
         extern EXPORT void C_CALL sim_hashset_construct(
@@ -94,6 +142,171 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t          initial_size
         );
 
+        /**
+         * @fn void sim_hashset_construct_with_flags(
+         *         Sim_HashSet *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const Sim_IAllocator*,
+         *         const size_t,
+         *         const Sim_HashFlags
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Constructs a new hashset with given storage & probing options.
+         * 
+         * @param[in,out] hashset_ptr         Pointer to a hashset to construct.
+         * @param[in]     item_size           Size of each item.
+         * @param[in]     item_hash_proc      Item hash function.
+         * @param[in]     item_predicate_proc Item equality predicate function.
+         * @param[in]     allocator_ptr       Pointer to allocator to use when resizing hash
+         *                                    buckets.
+         * @param[in]     initial_size        The initial allocated size of the newly created
+         *                                    hashset.
+         * @param[in]     flags               Storage & probing options; @c SIM_HASH_DEFAULT for
+         *                                    default behavior.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e item_predicate_proc @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if hash buckets couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @sa sim_hashset_construct
+         * @sa sim_hashset_destroy
+         */
+        extern EXPORT void C_CALL sim_hashset_construct_with_flags(
+            Sim_HashSet *const    hashset_ptr,
+            const size_t          item_size,
+            Sim_HashProc          item_hash_proc,
+            Sim_PredicateProc     item_predicate_proc,
+            const Sim_IAllocator* allocator_ptr,
+            const size_t          initial_size,
+            const Sim_HashFlags   flags
+        );
+
+        /**
+         * @fn void sim_hashset_construct_from(
+         *         Sim_HashSet *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const Sim_IAllocator*,
+         *         const Sim_HashFlags,
+         *         const void *const,
+         *         const size_t
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Constructs a new hashset holding the items of an array.
+         * 
+         * @param[in,out] hashset_ptr         Pointer to a hashset to construct.
+         * @param[in]     item_size           Size of each item.
+         * @param[in]     item_hash_proc      Item hash function.
+         * @param[in]     item_predicate_proc Item equality predicate function.
+         * @param[in]     allocator_ptr       Pointer to allocator to use when resizing hash
+         *                                    buckets.
+         * @param[in]     flags               Storage & probing options; @c SIM_HASH_DEFAULT for
+         *                                    default behavior.
+         * @param[in]     items_ptr           Pointer to an array of items to insert.
+         * @param[in]     item_count          The amount of items to insert.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr, @e item_predicate_proc, or @e items_ptr
+         *                            are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if hash buckets or nodes couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details The hash buckets are sized to hold every item up front, so nothing is resized
+         *          while they're inserted, & every node is carved out of a single block rather
+         *          than allocated one by one. The block is freed once the hashset is cleared or
+         *          destroyed. Duplicate items are only inserted once. The contents of a
+         *          Sim_Vector can be inserted by passing its @c data_ptr & @c count .
+         * @details A new hashset only uses the calling thread, so the items are always inserted
+         *          on it; sim_hashset_set_thread_count only affects later resizes.
+         * 
+         * @sa sim_hashset_construct_with_flags
+         * @sa sim_hashset_set_thread_count
+         */
+        extern EXPORT void C_CALL sim_hashset_construct_from(
+            Sim_HashSet *const    hashset_ptr,
+            const size_t          item_size,
+            Sim_HashProc          item_hash_proc,
+            Sim_PredicateProc     item_predicate_proc,
+            const Sim_IAllocator* allocator_ptr,
+            const Sim_HashFlags   flags,
+            const void *const     items_ptr,
+            const size_t          item_count
+        );
+
+        /**
+         * @fn void sim_hashset_construct_mapped(
+         *         Sim_HashSet *const,
+         *         FILE *const,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Constructs a read-only hashset whose buckets are mapped straight from a file
+         *        written by sim_hashset_serialize.
+         * 
+         * @param[in,out] hashset_ptr         Pointer to a hashset to construct.
+         * @param[in]     file_ptr            File to map the hashset from.
+         * @param[in]     item_hash_proc      Item hash function; must be the one the serialized
+         *                                    hashset was constructed with.
+         * @param[in]     item_predicate_proc Item equality predicate function.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e item_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_BADFILE  if @e file_ptr is @c NULL or doesn't hold a serialized
+         *                            hashset this build can use;
+         *     @b SIM_RC_ERR_INVALARG if @e item_hash_proc doesn't hash items as the serialized
+         *                            hashset's hash function did;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Nothing is copied or rehashed, so opening even a large hashset costs no more
+         *          than mapping the file. Lookups work as usual, but anything that would modify the
+         *          hashset (inserting, removing, resizing, or clearing) fails with
+         *          @b SIM_RC_ERR_UNSUPRTD, & pointers handed out by lookups or iteration point into
+         *          read-only memory. The file may be closed once the hashset is constructed; the
+         *          mapping is released when the hashset is destroyed.
+         * 
+         * @sa sim_hashset_serialize
+         */
+        extern EXPORT void C_CALL sim_hashset_construct_mapped(
+            Sim_HashSet *const hashset_ptr,
+            FILE *const        file_ptr,
+            Sim_HashProc       item_hash_proc,
+            Sim_PredicateProc  item_predicate_proc
+        );
+
+        /**
+         * @fn void sim_hashset_serialize(Sim_HashSet *const, FILE *const)
+         * @relates @capi{Sim_HashSet}
+         * @brief Writes a hashset to a file that sim_hashset_construct_mapped can map back in.
+         * 
+         * @param[in,out] hashset_ptr Pointer to a hashset to serialize.
+         * @param[in]     file_ptr    File to write the hashset to; it's written from the start.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_BADFILE  if @e file_ptr is @c NULL or couldn't be written to;
+         *     @b SIM_RC_ERR_INVALARG if the hashset wasn't constructed with
+         *                            @c SIM_HASH_FLAT_STORAGE ;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details The buckets are written behind a small header exactly as they're laid out in
+         *          memory, so only flat storage can be serialized & items must not hold
+         *          pointers. Any incremental resize is finished first. Files can only be mapped by
+         *          builds with the same byte order & word size, & only with a hash function that
+         *          gives the same hashes in every process; the default hash functions use fixed
+         *          seeds, so they qualify.
+         * 
+         * @sa sim_hashset_construct_mapped
+         */
+        extern EXPORT void C_CALL sim_hashset_serialize(
+            Sim_HashSet *const hashset_ptr,
+            FILE *const        file_ptr
+        );
+
         /**
          * @fn void sim_hashset_destroy(Sim_HashSet *const)
          * @relates @capi{Sim_HashSet}
@@ -164,6 +377,64 @@ CPP_NAMESPACE_START(SimSoft)
             const void *const  item_ptr
         );
 
+        /**
+         * @fn size_t sim_hashset_contains_many(
+         *         Sim_HashSet *const,
+         *         const void*,
+         *         const size_t,
+         *         bool *const
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Checks which of a batch of items are contained in a hashset.
+         * 
+         * @param[in,out] hashset_ptr       Pointer to hashset to search.
+         * @param[in]     items_ptr         Pointer to an array of items to compare against.
+         * @param[in]     item_count        Number of items in @e items_ptr.
+         * @param[out]    out_contained_ptr Pointer to an array of @e item_count bools to be filled
+         *                                  with whether each item is contained in the hashset.
+         * 
+         * @return The amount of items contained in the hashset; @c 0 on error (see remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashset_ptr, @e items_ptr, or @e out_contained_ptr are
+         *                           @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if any item isn't contained in the hashset;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Every item in the batch is hashed & has its buckets prefetched before any of
+         *          them are searched for, overlapping the cache misses of each lookup.
+         * 
+         * @sa sim_hashset_contains
+         */
+        extern EXPORT size_t C_CALL sim_hashset_contains_many(
+            Sim_HashSet *const hashset_ptr,
+            const void*        items_ptr,
+            const size_t       item_count,
+            bool *const        out_contained_ptr
+        );
+
+        /**
+         * @fn void sim_hashset_get_stats(Sim_HashSet *const, Sim_HashStats *const)
+         * @relates @capi{Sim_HashSet}
+         * @brief Gathers a snapshot of a hashset's load, probe lengths, & memory use.
+         * 
+         * @param[in,out] hashset_ptr   Pointer to a hashset to inspect.
+         * @param[out]    out_stats_ptr Pointer to be filled with the hashset's statistics.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashset_ptr or @e out_stats_ptr are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Every item is looked up again to measure its probe length, so this takes time
+         *          linear in the size of the hashset; it's meant for tuning & diagnostics rather
+         *          than hot paths. @e out_stats_ptr->op_counters is only filled in when the
+         *          library is built with @c SIM_HASH_OP_COUNTERS enabled.
+         */
+        extern EXPORT void C_CALL sim_hashset_get_stats(
+            Sim_HashSet *const   hashset_ptr,
+            Sim_HashStats *const out_stats_ptr
+        );
+
         /**
          * @fn void sim_hashset_resize(Sim_HashSet *const, const size_t)
          * @relates @capi{Sim_HashSet}
@@ -183,6 +454,33 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t       new_size
         );
 
+        /**
+         * @fn void sim_hashset_set_thread_count(Sim_HashSet *const, const size_t)
+         * @relates @capi{Sim_HashSet}
+         * @brief Sets how many threads a hashset's resizes may split their work
+         *        between.
+         * 
+         * @param[in,out] hashset_ptr  Pointer to a hashset to configure.
+         * @param[in]     thread_count The most threads to use; @c 0 or @c 1 to only use the
+         *                             calling thread, which is the default.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e hashset_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Work is only split up once there are several thousand items per thread.
+         *          Threads claim slots in the new buckets atomically, so every item can be found
+         *          along its probe sequence just as if it had been placed one at a time. Nodes are
+         *          still allocated on the calling thread, but the key hash & predicate functions
+         *          are called from several threads at once; they must be thread-safe & must not
+         *          throw. Robin Hood hashsets & incremental resizes always use the calling thread
+         *          alone, as do bulk constructions, which happen before a thread count can be set.
+         */
+        extern EXPORT void C_CALL sim_hashset_set_thread_count(
+            Sim_HashSet *const hashset_ptr,
+            const size_t       thread_count
+        );
+
         /**
          * @fn void sim_hashset_insert(Sim_HashSet *const, const void*)
          * @relates @capi{Sim_HashSet}
@@ -244,20 +542,242 @@ CPP_NAMESPACE_START(SimSoft)
             Sim_ConstForEachProc foreach_proc,
             Sim_Variant          userdata
         );
+
+        /**
+         * @fn void sim_hashset_union(
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Adds the items of one hashset to another, or the items of both to a third.
+         * 
+         * @param[in,out] hashset_ptr       Pointer to a hashset; modified in place if
+         *                                  @e out_hashset_ptr is @c NULL.
+         * @param[in]     other_hashset_ptr Pointer to another hashset with keys of the same size.
+         * @param[in,out] out_hashset_ptr   Pointer to a constructed hashset to be emptied & filled
+         *                                  with the items of both hashsets; @c NULL to modify
+         *                                  @e hashset_ptr in place instead.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e other_hashset_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if the hashsets' keys aren't all the same size;
+         *     @b SIM_RC_ERR_UNSUPRTD if the hashset being modified is memory-mapped;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashset being modified had to resize and was unable
+         *                            to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Items are hashed & have their buckets prefetched several at a time ahead of
+         *          being inserted. An output hashset is sized up front for the larger hashset's
+         *          items. @e out_hashset_ptr may be either of the other two hashsets.
+         */
+        extern EXPORT void C_CALL sim_hashset_union(
+            Sim_HashSet *const hashset_ptr,
+            Sim_HashSet *const other_hashset_ptr,
+            Sim_HashSet *const out_hashset_ptr
+        );
+
+        /**
+         * @fn void sim_hashset_intersect(
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Removes the items of a hashset that aren't in another, or copies the items
+         *        they have in common into a third.
+         * 
+         * @param[in,out] hashset_ptr       Pointer to a hashset; modified in place if
+         *                                  @e out_hashset_ptr is @c NULL.
+         * @param[in]     other_hashset_ptr Pointer to another hashset with keys of the same size.
+         * @param[in,out] out_hashset_ptr   Pointer to a constructed hashset to be emptied & filled
+         *                                  with the items both hashsets have; @c NULL to modify
+         *                                  @e hashset_ptr in place instead.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e other_hashset_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if the hashsets' keys aren't all the same size;
+         *     @b SIM_RC_ERR_UNSUPRTD if the hashset being modified is memory-mapped;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashset being modified had to resize and was unable
+         *                            to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Items are looked up several at a time, hashing & prefetching their buckets
+         *          ahead of probing for them. Only the smaller hashset's items are looked up when
+         *          writing into an output hashset; every item of a hashset modified in place has
+         *          to be. Removed items leave tombstones behind unless the hashset probes linearly.
+         *          @e out_hashset_ptr may be either of the other two hashsets.
+         */
+        extern EXPORT void C_CALL sim_hashset_intersect(
+            Sim_HashSet *const hashset_ptr,
+            Sim_HashSet *const other_hashset_ptr,
+            Sim_HashSet *const out_hashset_ptr
+        );
+
+        /**
+         * @fn void sim_hashset_difference(
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const,
+         *         Sim_HashSet *const
+         *     )
+         * @relates @capi{Sim_HashSet}
+         * @brief Removes the items of a hashset that are in another, or copies the items only
+         *        the first has into a third.
+         * 
+         * @param[in,out] hashset_ptr       Pointer to a hashset; modified in place if
+         *                                  @e out_hashset_ptr is @c NULL.
+         * @param[in]     other_hashset_ptr Pointer to another hashset with keys of the same size.
+         * @param[in,out] out_hashset_ptr   Pointer to a constructed hashset to be emptied & filled
+         *                                  with the items only @e hashset_ptr has; @c NULL to
+         *                                  modify @e hashset_ptr in place instead.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e other_hashset_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if the hashsets' keys aren't all the same size,
+         *                            or if @e out_hashset_ptr is @e other_hashset_ptr but not
+         *                            @e hashset_ptr;
+         *     @b SIM_RC_ERR_UNSUPRTD if the hashset being modified is memory-mapped;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashset being modified had to resize and was unable
+         *                            to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Items are looked up several at a time, hashing & prefetching their buckets
+         *          ahead of probing for them. Every item of @e hashset_ptr is looked up unless
+         *          @e other_hashset_ptr is empty. Removed items leave tombstones behind unless the
+         *          hashset probes linearly.
+         */
+        extern EXPORT void C_CALL sim_hashset_difference(
+            Sim_HashSet *const hashset_ptr,
+            Sim_HashSet *const other_hashset_ptr,
+            Sim_HashSet *const out_hashset_ptr
+        );
+
+        /**
+         * @fn bool sim_hashset_is_subset(Sim_HashSet *const, Sim_HashSet *const)
+         * @relates @capi{Sim_HashSet}
+         * @brief Checks if every item of a hashset is also in another hashset.
+         * 
+         * @param[in] hashset_ptr       Pointer to a hashset whose items are looked up.
+         * @param[in] other_hashset_ptr Pointer to a hashset with keys of the same size to look
+         *                              them up in.
+         * 
+         * @return @c true if @e other_hashset_ptr contains every item of @e hashset_ptr;
+         *         @c false otherwise or on error (see remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e hashset_ptr or @e other_hashset_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if the hashsets' keys aren't the same size;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Returns as soon as an item isn't found, or without looking anything up if
+         *          @e hashset_ptr holds more items.
+         */
+        extern EXPORT bool C_CALL sim_hashset_is_subset(
+            Sim_HashSet *const hashset_ptr,
+            Sim_HashSet *const other_hashset_ptr
+        );
     
     CPP_NAMESPACE_C_API_END /* end C API */
 
 #   ifdef __cplusplus /* C++ API */
-#       include "./exception.hpp"
-        
+
+        /**
+         * @class SimSoft::HashSet
+         * @headerfile hashset.h "simsoft/hashset.h"
+         * @brief Generic unordered set container class.
+         * 
+         * @tparam T      The type of items stored in this hashset.
+         * @tparam _Hash  Hash functor used on items.
+         * @tparam _Pred  Equality predicate functor used on items.
+         * @tparam _Alloc Allocator for slots.
+         * 
+         * @details Hashing & comparing items is inlined into each lookup; see HashTable.
+         */
         template <
             class T,
-            class _Hash,
+            class _Hash = Hash<T>,
+            class _Pred = Predicate_Equal<T>,
             class _Alloc = Allocator
         >
-        class HashSet {
+        class HashSet : public HashTable<T, void, _Hash, _Pred, _Alloc> {
         private:
-            C_API::Sim_HashSet _c_hashset;
+            typedef HashTable<T, void, _Hash, _Pred, _Alloc> Table;
+
+        public:
+            /**
+             * @typedef SimSoft::HashSet::value_type
+             * @brief The type of items stored in this hashset.
+             */
+            typedef T value_type;
+
+            /**
+             * @fn SimSoft::HashSet::HashSet(size_t, _Alloc*)
+             * @brief Constructs a new HashSet object.
+             * 
+             * @param[in] initial_size  @b Optional: The amount of slots allocated by the first
+             *                          insertion. Defaults to @e HashSet::DEFAULT_SIZE.
+             * @param[in] allocator_ptr @b Optional: Pointer to an allocator. Uses the default
+             *                          allocator if @c nullptr .
+             */
+            HashSet(
+                size_t  initial_size = Table::DEFAULT_SIZE,
+                _Alloc* allocator_ptr = nullptr
+            ) noexcept : Table(initial_size, allocator_ptr) { }
+
+            /**
+             * @fn bool SimSoft::HashSet::contains(const T&) const
+             * @brief Checks if an item is contained in the hashset.
+             * 
+             * @param[in] item Item to check.
+             */
+            bool contains(const T& item) const {
+                return Table::_find(item) != nullptr;
+            }
+
+            /**
+             * @fn bool SimSoft::HashSet::insert(const T&)
+             * @brief Inserts an item into the hashset.
+             * 
+             * @param[in] item Item to insert.
+             * 
+             * @return @c true if @e item wasn't contained in the hashset; @c false otherwise.
+             * 
+             * @throws OutOfMemoryException If the hashset needed to grow & couldn't.
+             */
+            bool insert(const T& item) {
+                bool inserted;
+                Table::_insert(inserted, item);
+                return inserted;
+            }
+            bool insert(T&& item) {
+                bool inserted;
+                Table::_insert(inserted, std::move(item));
+                return inserted;
+            }
+
+            /**
+             * @fn bool SimSoft::HashSet::foreach(PROC) const
+             * @brief Applies a given functor to each item in the hashset.
+             * 
+             * @tparam PROC Functor type; called as @c bool(const T&) .
+             * 
+             * @param[in] foreach_proc Functor returning @c false to break out of the loop.
+             * 
+             * @return @c false if the loop wasn't fully completed; @c true otherwise.
+             * 
+             * @remarks Items must not be inserted or removed during the loop.
+             */
+            template <class PROC>
+            bool foreach(PROC&& foreach_proc) const {
+                for (size_t i = 0; i < Table::_allocated; i++) {
+                    if (Table::_control_ptr[i] == Table::_CTRL_EMPTY)
+                        continue;
+
+                    if (!foreach_proc((const T&)Table::_slots_ptr[i].key))
+                        return false;
+                }
+                return true;
+            }
         };
 
 #   endif /* end C++ API */
@@ -0,0 +1,503 @@
+/**
+ * @file hashtable.hpp
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief C++ header for the hash table shared by HashMap & HashSet
+ * @version 0.1
+ * @date 2020-02-14
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_HASHTABLE_HPP_
+#define SIMSOFT_HASHTABLE_HPP_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./util.h"
+#include "./exception.hpp"
+
+#ifdef __cplusplus
+#   include <cstring>
+#   include <new>
+#   include <type_traits>
+#   include <utility>
+#endif
+
+CPP_NAMESPACE_START(SimSoft)
+#   ifdef __cplusplus /* C++ API */
+
+#       ifndef SIM_HASH_DEFAULT_SIZE
+#           define SIM_HASH_DEFAULT_SIZE 53
+#       endif
+
+        /**
+         * @struct SimSoft::Hash
+         * @headerfile hashtable.hpp "simsoft/hashtable.hpp"
+         * @brief Default hash functor used by HashMap & HashSet.
+         * 
+         * @tparam T The type being hashed; must be trivially copyable.
+         * 
+         * @details Integers, enumerations, & pointers hash to their own value, which hash tables
+         *          mix before use. Floating point numbers hash their bits, with both zeroes
+         *          hashing alike. Anything else hashes its bytes with sim_fasthash, so it must
+         *          not contain padding; provide a hash functor for such types instead.
+         */
+        template <class T>
+        struct Hash {
+            C_API::Sim_HashType operator()(const T& item) const noexcept {
+                static_assert(
+                    std::is_trivially_copyable<T>::value,
+                    "SimSoft::Hash only hashes trivially copyable types; provide a hash functor"
+                );
+
+                if constexpr (std::is_integral<T>::value || std::is_enum<T>::value)
+                    return (C_API::Sim_HashType)item;
+                else if constexpr (std::is_pointer<T>::value)
+                    return (C_API::Sim_HashType)(uintptr_t)item;
+                else if constexpr (std::is_floating_point<T>::value) {
+                    // 0.0 == -0.0, so they can't hash differently
+                    if (item == (T)0)
+                        return 0;
+                    uint64 bits = 0;
+                    memcpy(&bits, &item, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+                    return bits;
+                } else
+                    return C_API::sim_fasthash((const uint8*)&item, sizeof(T), 0);
+            }
+
+        public:
+            typedef T argument_type;
+            typedef C_API::Sim_HashType return_type;
+        };
+
+        /**
+         * @struct SimSoft::HashSlot
+         * @headerfile hashtable.hpp "simsoft/hashtable.hpp"
+         * @brief A key-value pair held by a HashMap.
+         * 
+         * @tparam K Key type.
+         * @tparam V Value type; @c void for HashSet slots, which only hold a key.
+         */
+        template <class K, class V>
+        struct HashSlot {
+            K key;
+            V value;
+        };
+        template <class K>
+        struct HashSlot<K, void> {
+            K key;
+        };
+
+        /**
+         * @class SimSoft::HashTable
+         * @headerfile hashtable.hpp "simsoft/hashtable.hpp"
+         * @brief Open-addressing hash table shared by HashMap & HashSet.
+         * 
+         * @tparam K      Key type.
+         * @tparam V      Value type; @c void for sets.
+         * @tparam _Hash  Hash functor used on keys.
+         * @tparam _Pred  Equality predicate functor used on keys.
+         * @tparam _Alloc Allocator for slots.
+         * 
+         * @details Lays out slots like a flat, power of 2 sized @capi{Sim_HashMap} probed
+         *          linearly: slots hold keys & values inline, a byte per slot holds its 7-bit
+         *          hash fingerprint or marks it as empty, & removals shift later items back
+         *          instead of leaving tombstones. Unlike the C hash tables, the probe loop is
+         *          instantiated per key type so hashing & comparing keys is inlined rather than
+         *          called through function pointers. Scalar keys compared with
+         *          Predicate_Equal skip fingerprints & compare keys directly.
+         * 
+         *          Pointers & references to keys & values are invalidated by insertions &
+         *          removals.
+         */
+        template <class K, class V, class _Hash, class _Pred, class _Alloc>
+        class HashTable {
+        protected:
+            typedef HashSlot<K, V> Slot;
+
+            static constexpr uint8 _CTRL_EMPTY = 0x80; // slot doesn't hold an item
+
+            // scalar keys are cheaper to compare than fingerprints are
+            static constexpr bool _COMPARES_KEYS =
+                std::is_scalar<K>::value && std::is_same<_Pred, Predicate_Equal<K>>::value;
+
+            Slot*  _slots_ptr { nullptr };
+            uint8* _control_ptr;
+            size_t _allocated { 1 }; // always a power of 2
+            size_t _count { 0 };
+            size_t _initial_size;
+
+            _Alloc* _allocator_ptr;
+            _Hash _hash;
+            _Pred _pred;
+
+            // Control byte of hash tables with no slots allocated; every lookup misses.
+            static uint8* _get_empty_control() noexcept {
+                static uint8 empty_control = _CTRL_EMPTY;
+                return &empty_control;
+            }
+
+            // Rounds a size up to a power of 2 amount of slots.
+            static size_t _get_capacity(size_t size) noexcept {
+                size_t capacity = 8;
+                while (capacity < size && capacity <= (SIZE_MAX >> 1))
+                    capacity <<= 1;
+                return capacity;
+            }
+
+            // Calculates the hash of a key.
+            C_API::Sim_HashType _get_hash(const K& key) const noexcept(noexcept(_hash(key))) {
+                // MurmurHash3 64-bit finalizer; user hashes may be weak
+                C_API::Sim_HashType hash = (C_API::Sim_HashType)_hash(key);
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdULL;
+                hash ^= hash >> 33;
+                hash *= 0xc4ceb9fe1a85ec53ULL;
+                hash ^= hash >> 33;
+                return hash;
+            }
+
+            // Searches for a key; sets out_index to its slot if found, or to the empty slot
+            //  ending its probe sequence if not.
+            bool _probe(
+                const K&                  key,
+                const C_API::Sim_HashType hash,
+                size_t&                   out_index
+            ) const {
+                const size_t mask = _allocated - 1;
+                const uint8 fingerprint = (uint8)(hash & 0x7F);
+
+                for (size_t index = (size_t)(hash >> 7) & mask;; index = (index + 1) & mask) {
+                    const uint8 control = _control_ptr[index];
+
+                    if (control == _CTRL_EMPTY) {
+                        out_index = index;
+                        return false;
+                    }
+
+                    bool matches;
+                    if constexpr (_COMPARES_KEYS)
+                        matches = _slots_ptr[index].key == key;
+                    else
+                        matches = control == fingerprint && _pred(_slots_ptr[index].key, key);
+
+                    if (matches) {
+                        out_index = index;
+                        return true;
+                    }
+                }
+            }
+
+            // Finds the slot holding a key; nullptr if not found.
+            Slot* _find(const K& key) const {
+                size_t index;
+                return _probe(key, _get_hash(key), index) ?
+                    _slots_ptr + index :
+                    nullptr
+                ;
+            }
+
+            // Moves every item into a new set of slots. Returns false if out of memory.
+            bool _rehash(size_t new_allocated) {
+                // slots, then control bytes
+                uint8 *const new_data_ptr = (uint8*)allocator_malloc(
+                    _allocator_ptr,
+                    (sizeof(Slot) + 1) * new_allocated
+                );
+                if (!new_data_ptr)
+                    return false;
+
+                Slot *const new_slots_ptr = (Slot*)new_data_ptr;
+                uint8 *const new_control_ptr = new_data_ptr + (sizeof(Slot) * new_allocated);
+                memset(new_control_ptr, _CTRL_EMPTY, new_allocated);
+
+                const size_t new_mask = new_allocated - 1;
+                for (size_t i = 0; _slots_ptr && i < _allocated; i++) {
+                    if (_control_ptr[i] == _CTRL_EMPTY)
+                        continue;
+
+                    const C_API::Sim_HashType hash = _get_hash(_slots_ptr[i].key);
+                    size_t index = (size_t)(hash >> 7) & new_mask;
+                    while (new_control_ptr[index] != _CTRL_EMPTY)
+                        index = (index + 1) & new_mask;
+
+                    new (new_slots_ptr + index) Slot(std::move(_slots_ptr[i]));
+                    new_control_ptr[index] = (uint8)(hash & 0x7F);
+                    _slots_ptr[i].~Slot();
+                }
+
+                if (_slots_ptr)
+                    allocator_free(_allocator_ptr, _slots_ptr);
+
+                _slots_ptr = new_slots_ptr;
+                _control_ptr = new_control_ptr;
+                _allocated = new_allocated;
+                return true;
+            }
+
+            // Finds the slot holding a key, or constructs one from the key & args if not found.
+            //  Sets out_inserted to whether a slot was constructed.
+            template <class KEY, class...ARGS>
+            Slot* _insert(bool& out_inserted, KEY&& key, ARGS&&... args) {
+                const C_API::Sim_HashType hash = _get_hash(key);
+                size_t index;
+
+                if (_probe(key, hash, index)) {
+                    out_inserted = false;
+                    return _slots_ptr + index;
+                }
+
+                // grow past 70% load, like the C hash tables
+                if ((_count + 1) * 10 > _allocated * 7) {
+                    if (!_rehash(_slots_ptr ? _allocated * 2 : _get_capacity(_initial_size)))
+                        throw OutOfMemoryException();
+                    _probe(key, hash, index);
+                }
+
+                new (_slots_ptr + index) Slot{
+                    std::forward<KEY>(key),
+                    std::forward<ARGS>(args)...
+                };
+                _control_ptr[index] = (uint8)(hash & 0x7F);
+                _count++;
+
+                out_inserted = true;
+                return _slots_ptr + index;
+            }
+
+            // Removes the item held by a slot, shifting back later items in its cluster.
+            void _erase(size_t hole) noexcept {
+                const size_t mask = _allocated - 1;
+                _slots_ptr[hole].~Slot();
+
+                for (
+                    size_t index = (hole + 1) & mask;
+                    _control_ptr[index] != _CTRL_EMPTY;
+                    index = (index + 1) & mask
+                ) {
+                    // items whose home slot is cyclically in (hole, index] must stay put
+                    const size_t home = (size_t)(_get_hash(_slots_ptr[index].key) >> 7) & mask;
+                    if (((index - home) & mask) < ((index - hole) & mask))
+                        continue;
+
+                    new (_slots_ptr + hole) Slot(std::move(_slots_ptr[index]));
+                    _control_ptr[hole] = _control_ptr[index];
+                    _slots_ptr[index].~Slot();
+                    hole = index;
+                }
+
+                _control_ptr[hole] = _CTRL_EMPTY;
+                _count--;
+            }
+
+            // Destroys every item & frees the slots.
+            void _destroy() noexcept {
+                clear();
+                if (_slots_ptr)
+                    allocator_free(_allocator_ptr, _slots_ptr);
+
+                _slots_ptr = nullptr;
+                _control_ptr = _get_empty_control();
+                _allocated = 1;
+            }
+
+            // Inserts copies of another hash table's items.
+            void _copy(const HashTable& other) {
+                if (!other._count)
+                    return;
+
+                if (!_rehash(_get_capacity(other._count * 10 / 7 + 1)))
+                    throw OutOfMemoryException();
+
+                for (size_t i = 0; i < other._allocated; i++) {
+                    if (other._control_ptr[i] == _CTRL_EMPTY)
+                        continue;
+
+                    const C_API::Sim_HashType hash = _get_hash(other._slots_ptr[i].key);
+                    size_t index;
+                    _probe(other._slots_ptr[i].key, hash, index);
+
+                    new (_slots_ptr + index) Slot(other._slots_ptr[i]);
+                    _control_ptr[index] = (uint8)(hash & 0x7F);
+                    _count++;
+                }
+            }
+
+            // Takes over another hash table's slots, leaving it empty.
+            void _steal(HashTable& other) noexcept {
+                _slots_ptr = other._slots_ptr;
+                _control_ptr = other._control_ptr;
+                _allocated = other._allocated;
+                _count = other._count;
+
+                other._slots_ptr = nullptr;
+                other._control_ptr = _get_empty_control();
+                other._allocated = 1;
+                other._count = 0;
+            }
+
+            HashTable(size_t initial_size, _Alloc* allocator_ptr) noexcept :
+                _control_ptr(_get_empty_control()),
+                _initial_size(initial_size),
+                _allocator_ptr(allocator_ptr)
+            { }
+            HashTable(const HashTable& other) :
+                _control_ptr(_get_empty_control()),
+                _initial_size(other._initial_size),
+                _allocator_ptr(other._allocator_ptr),
+                _hash(other._hash),
+                _pred(other._pred)
+            {
+                _copy(other);
+            }
+            HashTable(HashTable&& other) noexcept :
+                _control_ptr(_get_empty_control()),
+                _initial_size(other._initial_size),
+                _allocator_ptr(other._allocator_ptr),
+                _hash(std::move(other._hash)),
+                _pred(std::move(other._pred))
+            {
+                _steal(other);
+            }
+
+            ~HashTable() {
+                _destroy();
+            }
+
+            HashTable& operator=(const HashTable& other) {
+                if (this != &other) {
+                    _destroy();
+                    _allocator_ptr = other._allocator_ptr;
+                    _hash = other._hash;
+                    _pred = other._pred;
+                    _copy(other);
+                }
+                return *this;
+            }
+            HashTable& operator=(HashTable&& other) noexcept {
+                if (this != &other) {
+                    _destroy();
+                    _allocator_ptr = other._allocator_ptr;
+                    _hash = std::move(other._hash);
+                    _pred = std::move(other._pred);
+                    _steal(other);
+                }
+                return *this;
+            }
+
+        public:
+            /**
+             * @typedef SimSoft::HashTable::key_type
+             * @brief The type of keys stored in this hash table.
+             */
+            typedef K key_type;
+            /**
+             * @typedef SimSoft::HashTable::hasher
+             * @brief The hash functor used on keys.
+             */
+            typedef _Hash hasher;
+            /**
+             * @typedef SimSoft::HashTable::key_equal
+             * @brief The equality predicate functor used on keys.
+             */
+            typedef _Pred key_equal;
+            /**
+             * @typedef SimSoft::HashTable::allocator
+             * @brief The allocator type used by this hash table.
+             */
+            typedef _Alloc allocator;
+
+            /**
+             * @var SimSoft::HashTable::DEFAULT_SIZE
+             * @brief The default amount of slots allocated by the first insertion.
+             */
+            constexpr static size_t DEFAULT_SIZE = SIM_HASH_DEFAULT_SIZE;
+
+            /**
+             * @fn size_t SimSoft::HashTable::get_count() const
+             * @brief Retrieves the amount of items in the hash table.
+             */
+            size_t get_count() const noexcept {
+                return _count;
+            }
+
+            /**
+             * @fn bool SimSoft::HashTable::is_empty() const
+             * @brief Checks if the hash table holds no items.
+             */
+            bool is_empty() const noexcept {
+                return !_count;
+            }
+
+            /**
+             * @fn _Alloc* SimSoft::HashTable::get_allocator() const
+             * @brief Retrieves the allocator passed to the constructor.
+             */
+            _Alloc* get_allocator() const noexcept {
+                return _allocator_ptr;
+            }
+
+            /**
+             * @fn void SimSoft::HashTable::clear()
+             * @brief Destroys every item; keeps the slots allocated.
+             */
+            void clear() noexcept {
+                if (!_count)
+                    return;
+
+                if constexpr (!std::is_trivially_destructible<Slot>::value) {
+                    for (size_t i = 0; i < _allocated; i++)
+                        if (_control_ptr[i] != _CTRL_EMPTY)
+                            _slots_ptr[i].~Slot();
+                }
+
+                memset(_control_ptr, _CTRL_EMPTY, _allocated);
+                _count = 0;
+            }
+
+            /**
+             * @fn void SimSoft::HashTable::resize(size_t)
+             * @brief Reallocates the hash table's slots.
+             * 
+             * @param[in] new_size The amount of slots to allocate; rounded up to a power of 2
+             *                     that holds the current items under 70% load.
+             * 
+             * @throws OutOfMemoryException If the slots couldn't be allocated.
+             */
+            void resize(size_t new_size) {
+                if (new_size < _count * 10 / 7 + 1)
+                    new_size = _count * 10 / 7 + 1;
+
+                if (!_rehash(_get_capacity(new_size)))
+                    throw OutOfMemoryException();
+            }
+
+            /**
+             * @fn bool SimSoft::HashTable::remove(const K&)
+             * @brief Removes a key (& its value) from the hash table.
+             * 
+             * @param[in] key Key to remove.
+             * 
+             * @return @c false if @e key wasn't found; @c true otherwise.
+             * 
+             * @details Shrinks the hash table by half once it falls below 10% load, like the C
+             *          hash tables, unless it'd shrink below its initial size or memory runs out.
+             */
+            bool remove(const K& key) {
+                size_t index;
+                if (!_probe(key, _get_hash(key), index))
+                    return false;
+
+                _erase(index);
+
+                if (_count * 10 < _allocated && _allocated / 2 >= _get_capacity(_initial_size))
+                    _rehash(_allocated / 2);
+                return true;
+            }
+        };
+
+#   endif /* end C++ API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_HASHTABLE_HPP_ */
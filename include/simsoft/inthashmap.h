@@ -0,0 +1,294 @@
+/**
+ * @file inthashmap.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Header for hashmaps specialized for integer keys
+ * @version 0.1
+ * @date 2020-02-18
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_INTHASHMAP_H_
+#define SIMSOFT_INTHASHMAP_H_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./hashmap.h"
+
+CPP_NAMESPACE_START(SimSoft)
+    CPP_NAMESPACE_C_API_START /* C API */
+
+        /**
+         * @struct Sim_IntHashMap
+         * @headerfile inthashmap.h "simsoft/inthashmap.h"
+         * @brief Unordered key-value pair container keyed by 64-bit integers.
+         * 
+         * @details Keys are stored inline at the front of each slot & compared directly, so no
+         *          hash or predicate function is ever called. Slots are found with a
+         *          multiplicative (Fibonacci) hash & linear probing in a power of 2 sized table;
+         *          a slot is empty if its key is the empty key chosen at construction, which
+         *          can't be inserted itself. Removals shift later keys back rather than leaving
+         *          tombstones.
+         * 
+         * @var Sim_IntHashMap::_allocator_ptr @private
+         *     Pointer to allocator used to allocate the slots.
+         * @var Sim_IntHashMap::_initial_size @private
+         *     The smallest amount of slots the hashmap shrinks down to.
+         * @var Sim_IntHashMap::_allocated @private
+         *     The amount of allocated slots; always a power of 2.
+         * @var Sim_IntHashMap::_shift @private
+         *     How far multiplied keys are shifted down to select their slot.
+         * @var Sim_IntHashMap::count
+         *     The amount of key-value pairs contained in the hashmap.
+         * @var Sim_IntHashMap::data_ptr
+         *     Pointer to the slots; each slot is a key followed by its value.
+         * @var Sim_IntHashMap::_slot_size @private
+         *     The size of each slot in bytes.
+         * @var Sim_IntHashMap::_empty_key @private
+         *     The key marking a slot as empty.
+         * @var Sim_IntHashMap::_value_size @private
+         *     The size of values contained in the hashmap in bytes.
+         */
+        typedef struct Sim_IntHashMap {
+            const Sim_IAllocator *const _allocator_ptr; // slot allocator
+            const size_t _initial_size; // smallest amount of slots
+            size_t _allocated;          // how many slots have been allocated
+            size_t _shift;              // how far multiplied keys are shifted down
+
+            size_t count;   // amount of pairs stored in the hashmap
+            void* data_ptr; // pointer to slots
+
+            const size_t _slot_size; // size of each slot in bytes
+            const uint64 _empty_key; // key marking empty slots
+
+            const size_t _value_size; // size of hashmap values
+        } Sim_IntHashMap;
+
+        /**
+         * @fn void sim_inthashmap_construct(
+         *         Sim_IntHashMap *const,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const size_t,
+         *         const uint64
+         *     )
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Constructs a new integer-keyed hashmap.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to construct.
+         * @param[in]     value_size     Size of each value in bytes; may be 0 to only keep keys.
+         * @param[in]     allocator_ptr  Pointer to an allocator. Uses the default allocator if
+         *                               @c NULL.
+         * @param[in]     initial_size   The initial allocated size of the hashmap.
+         * @param[in]     empty_key      A key that will never be inserted, used to mark slots as
+         *                               empty; usually @c 0 or @c UINT64_MAX .
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the slots couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Smaller integers & pointers are used as keys by casting them to @c uint64 .
+         * 
+         * @sa sim_inthashmap_destroy
+         */
+        extern EXPORT void C_CALL sim_inthashmap_construct(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const size_t          value_size,
+            const Sim_IAllocator* allocator_ptr,
+            const size_t          initial_size,
+            const uint64          empty_key
+        );
+
+        /**
+         * @fn void sim_inthashmap_destroy(Sim_IntHashMap *const)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Destroys an integer-keyed hashmap.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to destroy.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_inthashmap_construct
+         */
+        extern EXPORT void C_CALL sim_inthashmap_destroy(
+            Sim_IntHashMap *const inthashmap_ptr
+        );
+
+        /**
+         * @fn void sim_inthashmap_clear(Sim_IntHashMap *const)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Clears an integer-keyed hashmap of all its contents.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to empty.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_inthashmap_clear(
+            Sim_IntHashMap *const inthashmap_ptr
+        );
+
+        /**
+         * @fn bool sim_inthashmap_contains_key(Sim_IntHashMap *const, const uint64)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Checks if a key is contained in an integer-keyed hashmap.
+         * 
+         * @param[in] inthashmap_ptr Pointer to an integer-keyed hashmap to search.
+         * @param[in] key            Key to search for.
+         * 
+         * @return @c true if @e key is contained in the hashmap; @c false otherwise or on error
+         *         (see remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e key is the hashmap's empty key;
+         *     @b SIM_RC_NOT_FOUND    if @e key isn't contained in the integer hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT bool C_CALL sim_inthashmap_contains_key(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const uint64          key
+        );
+
+        /**
+         * @fn void* sim_inthashmap_get_ptr(Sim_IntHashMap *const, const uint64)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Get pointer to value in an integer-keyed hashmap via a particular key.
+         * 
+         * @param[in] inthashmap_ptr Pointer to an integer-keyed hashmap to retrieve a value from.
+         * @param[in] key            Lookup key.
+         * 
+         * @return @c NULL on error (see remarks); pointer to value associated with the key
+         *         otherwise.
+         * 
+         * @remarks The pointer is invalidated by any insertion or removal.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e key is the hashmap's empty key;
+         *     @b SIM_RC_NOT_FOUND    if @e key isn't contained in the hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void* C_CALL sim_inthashmap_get_ptr(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const uint64          key
+        );
+
+        /**
+         * @fn void sim_inthashmap_get(Sim_IntHashMap *const, const uint64, void*)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Get a value from an integer-keyed hashmap via a particular key.
+         * 
+         * @param[in]  inthashmap_ptr Pointer to an integer-keyed hashmap to retrieve a value
+         *                            from.
+         * @param[in]  key            Lookup key.
+         * @param[out] out_value_ptr  Pointer to be filled with the associated value.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr or @e out_value_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e key is the hashmap's empty key;
+         *     @b SIM_RC_NOT_FOUND    if @e key isn't contained in the hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_inthashmap_get(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const uint64          key,
+            void*                 out_value_ptr
+        );
+
+        /**
+         * @fn void sim_inthashmap_insert(Sim_IntHashMap *const, const uint64, const void*)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Inserts a key-value pair into an integer-keyed hashmap or overwrites a
+         *        pre-existing pair's value.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to insert into.
+         * @param[in]     key            Key to insert.
+         * @param[in]     value_ptr      Pointer to value to insert; may be @c NULL if the
+         *                               hashmap's value size is 0.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr or a needed @e value_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e key is the hashmap's empty key;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashmap had to resize to accomodate the newly
+         *                            inserted pair and was unable to;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_inthashmap_insert(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const uint64          key,
+            const void*           value_ptr
+        );
+
+        /**
+         * @fn void sim_inthashmap_remove(Sim_IntHashMap *const, const uint64)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Removes a key-value pair from an integer-keyed hashmap via a key.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to remove from.
+         * @param[in]     key            Key to remove.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e key is the hashmap's empty key;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashmap had to resize to save space and was
+         *                            unable to;
+         *     @b SIM_RC_FAILURE      if @e key was not contained in the hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_inthashmap_remove(
+            Sim_IntHashMap *const inthashmap_ptr,
+            const uint64          key
+        );
+
+        /**
+         * @fn void sim_inthashmap_resize(Sim_IntHashMap *const, size_t)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Resizes an integer-keyed hashmap to hold at least a given amount of slots.
+         * 
+         * @param[in,out] inthashmap_ptr Pointer to an integer-keyed hashmap to resize.
+         * @param[in]     new_size       The new size of the hashmap; rounded up to a power of 2.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e inthashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e new_size < @e inthashmap_ptr->count ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the hashmap couldn't be resized;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_inthashmap_resize(
+            Sim_IntHashMap *const inthashmap_ptr,
+            size_t                new_size
+        );
+
+        /**
+         * @fn bool sim_inthashmap_foreach(Sim_IntHashMap *const, Sim_MapForEachProc, Sim_Variant)
+         * @relates @capi{Sim_IntHashMap}
+         * @brief Applies a given function to each key-value pair in an integer-keyed hashmap.
+         * 
+         * @param[in] inthashmap_ptr Pointer to an integer-keyed hashmap whose key-value pairs
+         *                           will be iterated over.
+         * @param[in] foreach_proc   Pointer to a function that will be applied to each pair in
+         *                           the hashmap; keys are passed as pointers to @c uint64 .
+         * @param[in] userdata       User-provided data for @e foreach_proc.
+         * 
+         * @return @c false on error (see remarks) or if the loop wasn't fully completed;
+         *         @c true  otherwise.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e inthashmap_ptr or @e foreach_proc are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_inthashmap_foreach(
+            Sim_IntHashMap *const inthashmap_ptr,
+            Sim_MapForEachProc    foreach_proc,
+            Sim_Variant           userdata
+        );
+
+    CPP_NAMESPACE_C_API_END /* end C API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_INTHASHMAP_H_ */
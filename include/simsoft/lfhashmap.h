@@ -0,0 +1,363 @@
+/**
+ * @file lfhashmap.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Header for hashmaps with lock-free lookups
+ * @version 0.1
+ * @date 2020-02-09
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_LFHASHMAP_H_
+#define SIMSOFT_LFHASHMAP_H_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./hashmap.h"
+
+CPP_NAMESPACE_START(SimSoft)
+    CPP_NAMESPACE_C_API_START /* C API */
+
+        /**
+         * @struct Sim_LockFreeHashMap
+         * @headerfile lfhashmap.h "simsoft/lfhashmap.h"
+         * @brief Thread-safe unordered key-value pair container whose lookups never lock.
+         * 
+         * @details Suited to read-mostly tables. Each bucket is a chain of immutable nodes.
+         *          Writers serialize on a lock, build a new node or bucket table, & publish it
+         *          with a single atomic store. Readers never take a lock or wait on writers &
+         *          only write to their own thread's reader record. Unlinked nodes & tables are
+         *          reclaimed once every thread that might still be reading them has finished
+         *          its lookup (epoch-based reclamation).
+         * 
+         * @var Sim_LockFreeHashMap::_key_properties @private
+         *     Key size, hash function, & equality predicate.
+         * @var Sim_LockFreeHashMap::_allocator_ptr @private
+         *     Pointer to allocator used to allocate nodes & bucket tables. Must be thread-safe.
+         * @var Sim_LockFreeHashMap::_value_size @private
+         *     Size of each value in bytes.
+         * @var Sim_LockFreeHashMap::_base_size @private
+         *     Minimum amount of buckets; tables never shrink below it.
+         * @var Sim_LockFreeHashMap::_flags @private
+         *     Hashing options; only @c SIM_HASH_SIPHASH affects lock-free hashmaps.
+         * @var Sim_LockFreeHashMap::_count @private
+         *     Amount of key-value pairs; updated atomically by writers.
+         * @var Sim_LockFreeHashMap::_table_ptr @private
+         *     Pointer to the current bucket table; swapped atomically on resize & clear.
+         * @var Sim_LockFreeHashMap::_writer_ptr @private
+         *     Pointer to the writer lock & the list of nodes & tables waiting to be reclaimed.
+         */
+        typedef struct Sim_LockFreeHashMap {
+            const struct {
+                size_t size;                      // Key size
+
+                Sim_HashProc hash_proc;           // Pointer to hash function
+                Sim_PredicateProc predicate_proc; // Pointer to predicate function
+            } _key_properties;  // properties of hashmap keys
+            const Sim_IAllocator *const _allocator_ptr; // node & table allocator
+            const size_t _value_size;   // size of hashmap values
+            const size_t _base_size;    // minimum amount of buckets
+            const Sim_HashFlags _flags; // hashing options
+
+            size_t _count;     // amount of pairs stored in the hashmap
+            void* _table_ptr;  // pointer to current bucket table
+            void* _writer_ptr; // pointer to writer lock & retired objects
+        } Sim_LockFreeHashMap;
+
+        /**
+         * @fn void sim_lfhashmap_construct(
+         *         Sim_LockFreeHashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const size_t,
+         *         const Sim_HashFlags
+         *     )
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Constructs a new lock-free hashmap.
+         * 
+         * @param[in,out] lfhashmap_ptr      Pointer to a lock-free hashmap to initialize.
+         * @param[in]     key_size           Size of each key in bytes.
+         * @param[in]     key_hash_proc      Pointer to a hash function used on keys. Uses a
+         *                                   default hash function if @c NULL.
+         * @param[in]     key_predicate_proc Pointer to a predicate function used on keys.
+         * @param[in]     value_size         Size of each value in bytes.
+         * @param[in]     allocator_ptr      Pointer to a thread-safe allocator. Uses the default
+         *                                   allocator if @c NULL.
+         * @param[in]     initial_size       The starting amount of buckets.
+         * @param[in]     flags              Hashing options; @c SIM_HASH_DEFAULT for default
+         *                                   behavior. Storage & probing flags are ignored.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr or @e key_predicate_proc are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the bucket table couldn't be allocated;
+         *     @b SIM_RC_FAILURE      if the writer lock couldn't be initialized;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @sa sim_lfhashmap_destroy
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_construct(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const size_t               key_size,
+            Sim_HashProc               key_hash_proc,
+            Sim_PredicateProc          key_predicate_proc,
+            const size_t               value_size,
+            const Sim_IAllocator*      allocator_ptr,
+            const size_t               initial_size,
+            const Sim_HashFlags        flags
+        );
+
+        /**
+         * @fn void sim_lfhashmap_destroy(Sim_LockFreeHashMap *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Destroys a lock-free hashmap.
+         * 
+         * @param[in,out] lfhashmap_ptr Pointer to a lock-free hashmap to destroy.
+         * 
+         * @remarks Must not be called while other threads are using the lock-free hashmap.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e lfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_lfhashmap_construct
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_destroy(
+            Sim_LockFreeHashMap *const lfhashmap_ptr
+        );
+
+        /**
+         * @fn size_t sim_lfhashmap_get_count(Sim_LockFreeHashMap *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Counts the key-value pairs in a lock-free hashmap.
+         * 
+         * @param[in] lfhashmap_ptr Pointer to a lock-free hashmap to count.
+         * 
+         * @return The amount of key-value pairs in the lock-free hashmap; @c 0 on error (see
+         *         remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e lfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT size_t C_CALL sim_lfhashmap_get_count(
+            Sim_LockFreeHashMap *const lfhashmap_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_clear(Sim_LockFreeHashMap *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Clears a lock-free hashmap of all its contents.
+         * 
+         * @param[in,out] lfhashmap_ptr Pointer to a lock-free hashmap to empty.
+         * 
+         * @remarks Readers still looking through the old contents keep seeing them until their
+         *          lookup finishes.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if an empty bucket table couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_clear(
+            Sim_LockFreeHashMap *const lfhashmap_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_read_begin(Sim_LockFreeHashMap *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Starts a read-side section on the calling thread.
+         * 
+         * @details Pointers returned by sim_lfhashmap_get_ptr() stay valid until the matching
+         *          sim_lfhashmap_read_end(). Sections may be nested & cover every lock-free
+         *          hashmap; they don't block writers, but memory retired by writers can't be
+         *          reclaimed while any thread is inside one, so keep them short. A section isn't
+         *          ended by an exception thrown inside it; call sim_lfhashmap_read_end() once it's
+         *          caught.
+         * 
+         * @param[in] lfhashmap_ptr Pointer to a lock-free hashmap that will be read from.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the calling thread's reader record couldn't be
+         *                            allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @sa sim_lfhashmap_read_end
+         * @sa sim_lfhashmap_get_ptr
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_read_begin(
+            Sim_LockFreeHashMap *const lfhashmap_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_read_end(Sim_LockFreeHashMap *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Ends a read-side section started by sim_lfhashmap_read_begin().
+         * 
+         * @param[in] lfhashmap_ptr Pointer to the lock-free hashmap passed to
+         *                          sim_lfhashmap_read_begin().
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e lfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_lfhashmap_read_begin
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_read_end(
+            Sim_LockFreeHashMap *const lfhashmap_ptr
+        );
+
+        /**
+         * @fn bool sim_lfhashmap_contains_key(Sim_LockFreeHashMap *const, const void *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Checks if a key is contained in a lock-free hashmap.
+         * 
+         * @param[in] lfhashmap_ptr Pointer to a lock-free hashmap to search.
+         * @param[in] key_ptr       Pointer to key to compare against.
+         * 
+         * @return @c false on error (see remarks) or if the key isn't contained in the
+         *         lock-free hashmap; @c true otherwise.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the calling thread's reader record couldn't be
+         *                            allocated;
+         *     @b SIM_RC_NOT_FOUND    if @e key_ptr isn't contained in the lock-free hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT bool C_CALL sim_lfhashmap_contains_key(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const void *const          key_ptr
+        );
+
+        /**
+         * @fn const void* sim_lfhashmap_get_ptr(Sim_LockFreeHashMap *const, const void *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Get a pointer to a value in a lock-free hashmap via a particular key.
+         * 
+         * @param[in] lfhashmap_ptr Pointer to a lock-free hashmap to retrieve a value from.
+         * @param[in] key_ptr       Pointer to lookup key.
+         * 
+         * @return @c NULL on error (see remarks); otherwise a pointer to the value associated
+         *         with the key.
+         * 
+         * @remarks Must be called inside a read-side section; the returned value is never
+         *          modified & stays valid until sim_lfhashmap_read_end(), even if the pair is
+         *          overwritten or removed meanwhile.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e lfhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_FAILURE     if the calling thread isn't inside a read-side section;
+         *     @b SIM_RC_NOT_FOUND   if the key isn't contained in the lock-free hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_lfhashmap_read_begin
+         */
+        extern EXPORT const void* C_CALL sim_lfhashmap_get_ptr(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const void *const          key_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_get(Sim_LockFreeHashMap *const, const void*, void*)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Get a copy of a value from a lock-free hashmap via a particular key.
+         * 
+         * @param[in]  lfhashmap_ptr Pointer to a lock-free hashmap to retrieve a value from.
+         * @param[in]  key_ptr       Pointer to lookup key.
+         * @param[out] out_value_ptr Pointer to be filled with the associated value.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr, @e key_ptr, or @e out_value_ptr are
+         *                            @c NULL;
+         *     @b SIM_RC_ERR_OUTOFMEM if the calling thread's reader record couldn't be
+         *                            allocated;
+         *     @b SIM_RC_NOT_FOUND    if the key isn't contained in the lock-free hashmap;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_get(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const void*                key_ptr,
+            void*                      out_value_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_insert(Sim_LockFreeHashMap *const, const void*, const void*)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Inserts a key-value pair into a lock-free hashmap or overwrites a pre-existing
+         *        pair if the key is already in the lock-free hashmap.
+         * 
+         * @param[in,out] lfhashmap_ptr Pointer to a lock-free hashmap to insert into.
+         * @param[in]     new_key_ptr   Pointer to a new key to add to the lock-free hashmap.
+         * @param[in]     value_ptr     Pointer to a value to associate with the key.
+         * 
+         * @remarks Overwriting a pair replaces its node; readers see either the old or the new
+         *          value, never a mix of both.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr, @e new_key_ptr, or @e value_ptr are
+         *                            @c NULL;
+         *     @b SIM_RC_ERR_OUTOFMEM if the pair's node couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_insert(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const void*                new_key_ptr,
+            const void*                value_ptr
+        );
+
+        /**
+         * @fn void sim_lfhashmap_remove(Sim_LockFreeHashMap *const, const void *const)
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Removes a key-value pair from a lock-free hashmap via a key.
+         * 
+         * @param[in,out] lfhashmap_ptr  Pointer to a lock-free hashmap to remove from.
+         * @param[in]     remove_key_ptr Pointer to a key to remove from the lock-free hashmap.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e lfhashmap_ptr or @e remove_key_ptr are @c NULL;
+         *     @b SIM_RC_FAILURE     if *remove_key_ptr was not contained in the lock-free
+         *                           hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_lfhashmap_remove(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            const void *const          remove_key_ptr
+        );
+
+        /**
+         * @fn bool sim_lfhashmap_foreach(
+         *         Sim_LockFreeHashMap *const,
+         *         Sim_MapForEachProc,
+         *         Sim_Variant
+         *     )
+         * @relates @capi{Sim_LockFreeHashMap}
+         * @brief Applies a given function to each key-value pair in a lock-free hashmap.
+         * 
+         * @param[in] lfhashmap_ptr Pointer to a lock-free hashmap whose key-value pairs will be
+         *                          iterated over.
+         * @param[in] foreach_proc  Pointer to a function that will be applied to each pair in
+         *                          the lock-free hashmap.
+         * @param[in] userdata      User-provided data for @e foreach_proc.
+         * 
+         * @return @c false on error (see remarks) or if the loop wasn't fully completed;
+         *         @c true  otherwise.
+         * 
+         * @remarks Runs inside a read-side section; pairs inserted or removed by other threads
+         *          meanwhile may or may not be visited. @e foreach_proc must not modify values.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e lfhashmap_ptr or @e foreach_proc are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the calling thread's reader record couldn't be
+         *                            allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         */
+        extern EXPORT bool C_CALL sim_lfhashmap_foreach(
+            Sim_LockFreeHashMap *const lfhashmap_ptr,
+            Sim_MapForEachProc         foreach_proc,
+            Sim_Variant                userdata
+        );
+
+    CPP_NAMESPACE_C_API_END /* end C API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_LFHASHMAP_H_ */
@@ -0,0 +1,263 @@
+/**
+ * @file perfhashmap.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Header for minimal perfect hashmaps built from static key sets
+ * @version 0.1
+ * @date 2020-02-11
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_PERFHASHMAP_H_
+#define SIMSOFT_PERFHASHMAP_H_
+
+#include "./common.h"
+#include "./allocator.h"
+#include "./hashmap.h"
+
+CPP_NAMESPACE_START(SimSoft)
+    CPP_NAMESPACE_C_API_START /* C API */
+
+        /**
+         * @struct Sim_PerfectHashMap
+         * @headerfile perfhashmap.h "simsoft/perfhashmap.h"
+         * @brief Immutable unordered key-value pair container built from a fixed set of keys.
+         * 
+         * @details Keys are placed with a minimal perfect hash function (compress, hash, &
+         *          displace): each key hashes to a small bucket, & each bucket stores the
+         *          displacement that sends its keys to slots no other key uses. Every slot holds a
+         *          pair, & every lookup reads one displacement, probes one slot, & compares one
+         *          key. Besides the pairs themselves, a perfect hashmap needs about one byte per
+         *          key.
+         * 
+         * @var Sim_PerfectHashMap::_key_properties @private
+         *     Key size, hash function, & equality predicate.
+         * @var Sim_PerfectHashMap::_allocator_ptr @private
+         *     Pointer to allocator used to allocate the pairs & displacements.
+         * @var Sim_PerfectHashMap::count
+         *     The amount of key-value pairs in the perfect hashmap.
+         * @var Sim_PerfectHashMap::data_ptr
+         *     Pointer to the pairs, followed by the displacements.
+         * @var Sim_PerfectHashMap::_slot_size @private
+         *     The size of each slot in bytes.
+         * @var Sim_PerfectHashMap::_bucket_count @private
+         *     The amount of displacement buckets.
+         * @var Sim_PerfectHashMap::_seed @private
+         *     Seed mixed into key hashes; picked while building the perfect hash function.
+         * @var Sim_PerfectHashMap::_value_size @private
+         *     The size of values contained in the perfect hashmap in bytes.
+         */
+        typedef struct Sim_PerfectHashMap {
+            const struct {
+                size_t size;                      // Key size
+
+                Sim_HashProc hash_proc;           // Pointer to hash function
+                Sim_PredicateProc predicate_proc; // Pointer to predicate function
+            } _key_properties;  // properties of perfect hashmap keys
+            const Sim_IAllocator *const _allocator_ptr; // pair & displacement allocator
+
+            const size_t count;   // amount of pairs stored in the perfect hashmap
+            void *const data_ptr; // pointer to pairs, then displacements
+
+            const size_t _slot_size;    // size of each slot
+            const size_t _bucket_count; // amount of displacement buckets
+            const uint64 _seed;         // seed mixed into key hashes
+
+            const size_t _value_size; // size of perfect hashmap values
+        } Sim_PerfectHashMap;
+
+        /**
+         * @fn void sim_perfhashmap_construct(
+         *         Sim_PerfectHashMap *const,
+         *         const size_t,
+         *         Sim_HashProc,
+         *         Sim_PredicateProc,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         const void *const,
+         *         const void *const,
+         *         const size_t
+         *     )
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Builds a perfect hashmap holding the key-value pairs of parallel arrays.
+         * 
+         * @param[in,out] perfhashmap_ptr    Pointer to a perfect hashmap to construct.
+         * @param[in]     key_size           Size of each key in bytes.
+         * @param[in]     key_hash_proc      Pointer to a hash function used on keys. Uses a
+         *                                   default hash function if @c NULL.
+         * @param[in]     key_predicate_proc Pointer to a predicate function used on keys.
+         * @param[in]     value_size         Size of each value in bytes; may be 0 to only keep
+         *                                   keys.
+         * @param[in]     allocator_ptr      Pointer to an allocator. Uses the default allocator
+         *                                   if @c NULL.
+         * @param[in]     keys_ptr           Pointer to an array of distinct keys.
+         * @param[in]     values_ptr         Pointer to an array of values; one per key.
+         * @param[in]     item_count         The amount of key-value pairs.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e perfhashmap_ptr or @e key_predicate_proc are @c NULL,
+         *                            or if @e keys_ptr or @e values_ptr are @c NULL while
+         *                            they're needed;
+         *     @b SIM_RC_ERR_INVALARG if any two keys are equal or hash to the same value, or if
+         *                            @e item_count is too large;
+         *     @b SIM_RC_ERR_OUTOFMEM if the pairs or the build's scratch space couldn't be
+         *                            allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Building takes time linear in @e item_count on average, with scratch space of
+         *          a few words per key. @e keys_ptr & @e values_ptr may be @c NULL if
+         *          @e item_count is 0, & @e values_ptr may be @c NULL if @e value_size is 0.
+         * 
+         * @sa sim_perfhashmap_destroy
+         */
+        extern EXPORT void C_CALL sim_perfhashmap_construct(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            const size_t              key_size,
+            Sim_HashProc              key_hash_proc,
+            Sim_PredicateProc         key_predicate_proc,
+            const size_t              value_size,
+            const Sim_IAllocator*     allocator_ptr,
+            const void *const         keys_ptr,
+            const void *const         values_ptr,
+            const size_t              item_count
+        );
+
+        /**
+         * @fn void sim_perfhashmap_destroy(Sim_PerfectHashMap *const)
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Destroys a perfect hashmap.
+         * 
+         * @param[in,out] perfhashmap_ptr Pointer to a perfect hashmap to destroy.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr is @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @sa sim_perfhashmap_construct
+         */
+        extern EXPORT void C_CALL sim_perfhashmap_destroy(
+            Sim_PerfectHashMap *const perfhashmap_ptr
+        );
+
+        /**
+         * @fn size_t sim_perfhashmap_get_index(Sim_PerfectHashMap *const, const void *const)
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Finds the index of the slot holding a key in a perfect hashmap.
+         * 
+         * @param[in] perfhashmap_ptr Pointer to a perfect hashmap to search.
+         * @param[in] key_ptr         Pointer to lookup key.
+         * 
+         * @return (size_t)-1 on error (see remarks); an index below @c perfhashmap_ptr->count
+         *         otherwise.
+         * 
+         * @remarks Each key the perfect hashmap was built from has its own index, so indices can
+         *          be used to look up data kept in other arrays.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if @e key_ptr isn't contained in the perfect hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT size_t C_CALL sim_perfhashmap_get_index(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            const void *const         key_ptr
+        );
+
+        /**
+         * @fn bool sim_perfhashmap_contains_key(Sim_PerfectHashMap *const, const void *const)
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Checks if a key is contained in a perfect hashmap.
+         * 
+         * @param[in] perfhashmap_ptr Pointer to a perfect hashmap to check.
+         * @param[in] key_ptr         Pointer to key to check.
+         * 
+         * @return @c true if @e key_ptr is contained in the perfect hashmap; @c false otherwise
+         *         or on error (see remarks).
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if @e key_ptr isn't contained in the perfect hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_perfhashmap_contains_key(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            const void *const         key_ptr
+        );
+
+        /**
+         * @fn void* sim_perfhashmap_get_ptr(Sim_PerfectHashMap *const, const void *const)
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Get pointer to value in a perfect hashmap via a particular key.
+         * 
+         * @param[in] perfhashmap_ptr Pointer to a perfect hashmap to retrieve a value from.
+         * @param[in] key_ptr         Pointer to lookup key.
+         * 
+         * @return @c NULL on error (see remarks); pointer to value associated with the key
+         *         otherwise.
+         * 
+         * @remarks Values may be modified through the pointer; keys may not.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr or @e key_ptr are @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if @e key_ptr isn't contained in the perfect hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void* C_CALL sim_perfhashmap_get_ptr(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            const void *const         key_ptr
+        );
+
+        /**
+         * @fn void sim_perfhashmap_get(Sim_PerfectHashMap *const, const void*, void*)
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Get a value from a perfect hashmap via a particular key.
+         * 
+         * @param[in]  perfhashmap_ptr Pointer to a perfect hashmap to retrieve a value from.
+         * @param[in]  key_ptr         Pointer to lookup key.
+         * @param[out] out_value_ptr   Pointer to be filled with the associated value.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr, @e key_ptr, or @e out_value_ptr are
+         *                           @c NULL ;
+         *     @b SIM_RC_NOT_FOUND   if the key isn't contained in the perfect hashmap;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT void C_CALL sim_perfhashmap_get(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            const void*               key_ptr,
+            void*                     out_value_ptr
+        );
+
+        /**
+         * @fn bool sim_perfhashmap_foreach(
+         *         Sim_PerfectHashMap *const,
+         *         Sim_MapForEachProc,
+         *         Sim_Variant
+         *     )
+         * @relates @capi{Sim_PerfectHashMap}
+         * @brief Applies a given function to each key-value pair in a perfect hashmap.
+         * 
+         * @param[in] perfhashmap_ptr Pointer to a perfect hashmap whose key-value pairs will be
+         *                            iterated over.
+         * @param[in] foreach_proc    Pointer to a function that will be applied to each pair in
+         *                            the perfect hashmap.
+         * @param[in] userdata        User-provided data for @e foreach_proc.
+         * 
+         * @return @c false on error (see remarks) or if the loop wasn't fully completed;
+         *         @c true  otherwise.
+         * 
+         * @remarks Pairs are visited in index order, so the index passed to @e foreach_proc is
+         *          the one sim_perfhashmap_get_index returns for the same key.
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e perfhashmap_ptr or @e foreach_proc are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         */
+        extern EXPORT bool C_CALL sim_perfhashmap_foreach(
+            Sim_PerfectHashMap *const perfhashmap_ptr,
+            Sim_MapForEachProc        foreach_proc,
+            Sim_Variant               userdata
+        );
+
+    CPP_NAMESPACE_C_API_END /* end C API */
+CPP_NAMESPACE_END(SimSoft) /* end SimSoft namespace */
+
+#endif /* SIMSOFT_PERFHASHMAP_H_ */
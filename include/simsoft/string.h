@@ -416,11 +416,28 @@ CPP_NAMESPACE_START(SimSoft)
          */
         extern EXPORT Sim_HashProc C_CALL sim_string_get_default_hash_proc(void);
 
+        /**
+         * @fn Sim_HashProc sim_string_get_fast_hash_proc(void)
+         * @relates @capi{Sim_String}
+         * @headerfile string.h "simsoft/string.h"
+         * @brief Retrieves a string hash function based on sim_fasthash.
+         * @details The function offers no protection against hash flooding, so it should only be
+         *          set for strings that don't come from untrusted input.
+         * 
+         * @returns A sim_fasthash based hash function for strings.
+         * 
+         * @sa sim_string_set_default_hash_proc
+         */
+        extern EXPORT Sim_HashProc C_CALL sim_string_get_fast_hash_proc(void);
+
         /**
          * @fn Sim_HashProc sim_string_set_default_hash_proc(Sim_HashProc)
          * @relates @capi{Sim_String}
          * @headerfile string.h "simsoft/string.h"
          * @brief Sets the string hash function.
+         * @details The default hash function uses sim_siphash, since strings are often
+         *          untrusted input; set the one from sim_string_get_fast_hash_proc for faster
+         *          hashing of trusted strings.
          * 
          * @param[in] hash_proc The hash function for strings to use; @c NULL for the default.
          */
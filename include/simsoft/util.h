@@ -44,6 +44,28 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t       data_size,
             const Sim_HashKey key
         );
+
+        /**
+         * @fn Sim_HashType sim_fasthash(const uint8*, const size_t, uint64)
+         * @headerfile util.h "simsoft/util.h"
+         * @brief Fast non-cryptographic hash function.
+         * @details Uses wyhash-style mixing for inputs up to 512 bytes & an XXH3-style striped
+         *          accumulator (SIMD accelerated where supported) for longer inputs. Hashes are
+         *          not compatible with either reference implementation. Unlike sim_siphash, this
+         *          offers no protection against hash flooding; use sim_siphash with a secret key
+         *          for hash tables exposed to untrusted input.
+         * 
+         * @param[in] data_ptr  Pointer to data to create a hash for.
+         * @param[in] data_size The size of the data pointed to by @e data_ptr.
+         * @param[in] seed      Seed used in generating the hash.
+         * 
+         * @return A hash key; 0 if @e data_ptr is @c NULL .
+         */
+        extern EXPORT Sim_HashType C_CALL sim_fasthash(
+            const uint8* data_ptr,
+            const size_t data_size,
+            uint64       seed
+        );
     
     CPP_NAMESPACE_C_API_END /* end C API */
 
@@ -14,6 +14,17 @@
 
 #include "./common.h"
 #include "./allocator.h"
+#include "./exception.hpp"
+
+#ifdef __cplusplus
+#   include <algorithm>
+#   include <cstddef>
+#   include <cstring>
+#   include <iterator>
+#   include <new>
+#   include <type_traits>
+#   include <utility>
+#endif
 
 CPP_NAMESPACE_START(SimSoft)
     CPP_NAMESPACE_C_API_START /* C API */
@@ -25,6 +36,41 @@ CPP_NAMESPACE_START(SimSoft)
 #       ifndef SIM_DEFAULT_VECTOR_SIZE
 #           define SIM_DEFAULT_VECTOR_SIZE 32
 #       endif
+
+        /**
+         * @def SIM_VECTOR_DEFAULT_GROWTH_PERCENT
+         * @brief The growth percentage used by vectors constructed without a policy.
+         */
+#       ifndef SIM_VECTOR_DEFAULT_GROWTH_PERCENT
+#           define SIM_VECTOR_DEFAULT_GROWTH_PERCENT 200
+#       endif
+
+        /**
+         * @def SIM_VECTOR_DEFAULT_SHRINK_PERCENT
+         * @brief The shrink percentage used by vectors constructed without a policy.
+         */
+#       ifndef SIM_VECTOR_DEFAULT_SHRINK_PERCENT
+#           define SIM_VECTOR_DEFAULT_SHRINK_PERCENT 25
+#       endif
+
+        /**
+         * @struct Sim_VectorPolicy
+         * @headerfile vector.h "simsoft/vector.h"
+         * @brief How a vector grows & shrinks its internal array.
+         * 
+         * @var Sim_VectorPolicy::growth_percent
+         *     How large the internal array becomes when full, as a percentage of its current
+         *     size; e.g. 200 doubles it & 150 grows it by half. Must be over 100.
+         * @var Sim_VectorPolicy::shrink_percent
+         *     The load, as a percentage, at or below which removals shrink the internal array
+         *     back down by the growth factor, never below its initial size; 0 never shrinks it.
+         *     Must be under 10000 / @e growth_percent so a shrunk array has room to spare; the
+         *     gap between the two keeps pushing & popping around a boundary from reallocating.
+         */
+        typedef struct Sim_VectorPolicy {
+            uint16 growth_percent;
+            uint16 shrink_percent;
+        } Sim_VectorPolicy;
         
         /**
          * @struct Sim_Vector
@@ -40,11 +86,17 @@ CPP_NAMESPACE_START(SimSoft)
          *     Pointer to the internal array used by the vector.
          * @var Sim_Vector::_allocated @private
          *     The number of items allocated for the internal array.
+         * @var Sim_Vector::_initial_size @private
+         *     The number of items initially allocated; the internal array never shrinks below it.
+         * @var Sim_Vector::_policy @private
+         *     How the internal array grows & shrinks.
          */
         typedef struct Sim_Vector {
             const size_t _item_size;
             const Sim_IAllocator *const _allocator_ptr;
             size_t _allocated; // how much has been allocated
+            size_t _initial_size;
+            Sim_VectorPolicy _policy;
 
             size_t count;
             void*  data_ptr;
@@ -64,12 +116,17 @@ CPP_NAMESPACE_START(SimSoft)
          * @param[in]     item_size     Size of each item.
          * @param[in]     allocator_ptr Pointer to allocator to use when resizing internal array.
          * @param[in]     initial_size  The initial size of the newly created vector.
-         *
+         * 
          * @remarks sim_return_code() is set to one of the following:
          *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL ;
          *     @b SIM_RC_ERR_OUTOFMEM if the vector size requested couldn't be allocated;
          *     @b SIM_RC_SUCCESS      otherwise.
          * 
+         * @details Uses the default growth policy: full internal arrays grow by
+         *          @c SIM_VECTOR_DEFAULT_GROWTH_PERCENT & shrink once at or below
+         *          @c SIM_VECTOR_DEFAULT_SHRINK_PERCENT load.
+         * 
+         * @sa sim_vector_construct_with_policy
          * @sa sim_vector_destroy
          */
         extern EXPORT void C_CALL sim_vector_construct(
@@ -79,6 +136,47 @@ CPP_NAMESPACE_START(SimSoft)
             size_t                initial_size
         );
 
+        /**
+         * @fn void sim_vector_construct_with_policy(
+         *         Sim_Vector *const,
+         *         const size_t,
+         *         const Sim_IAllocator*,
+         *         size_t,
+         *         const Sim_VectorPolicy *const
+         *     )
+         * @relates @capi{Sim_Vector}
+         * @brief Constructs a new vector that grows & shrinks with a given policy.
+         * 
+         * @param[in,out] vector_ptr    Pointer to a vector to construct.
+         * @param[in]     item_size     Size of each item.
+         * @param[in]     allocator_ptr Pointer to allocator to use when resizing internal array.
+         * @param[in]     initial_size  The initial size of the newly created vector.
+         * @param[in]     policy_ptr    Pointer to the growth policy to use; the default policy
+         *                              if @c NULL .
+         * 
+         * @remarks sim_return_code() is set to one of the following:
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_INVALARG if @e policy_ptr's @c growth_percent is 100 or under, or
+         *                            its @c shrink_percent isn't under
+         *                            10000 / @c growth_percent ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the vector size requested couldn't be allocated;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Scratch vectors that are cleared & refilled over & over should disable
+         *          shrinking & be cleared with sim_vector_clear, which keeps the internal array,
+         *          so refilling them doesn't reallocate.
+         * 
+         * @sa sim_vector_construct
+         * @sa sim_vector_reserve
+         */
+        extern EXPORT void C_CALL sim_vector_construct_with_policy(
+            Sim_Vector *const             vector_ptr,
+            const size_t                  item_size,
+            const Sim_IAllocator*         allocator_ptr,
+            size_t                        initial_size,
+            const Sim_VectorPolicy *const policy_ptr
+        );
+
         /**
          * @fn void sim_vector_destroy(Sim_Vector *const)
          * @relates @capi{Sim_Vector}
@@ -123,6 +221,9 @@ CPP_NAMESPACE_START(SimSoft)
          * @remarks sim_return_code() is set to one of the following:
          *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL ;
          *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Keeps the internal array allocated so refilling the vector doesn't
+         *          reallocate it; use sim_vector_resize to give memory back.
          */
         extern EXPORT void C_CALL sim_vector_clear(
             Sim_Vector *const vector_ptr
@@ -147,6 +248,29 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t      size
         );
 
+        /**
+         * @fn void sim_vector_reserve(Sim_Vector *const, const size_t)
+         * @relates @capi{Sim_Vector}
+         * @brief Grows a vector to hold at least a given amount of items without reallocating.
+         * 
+         * @param[in,out] vector_ptr Pointer to a vector to grow.
+         * @param[in]     size       The amount of items to make room for.
+         * 
+         * @remarks sim_return_code() is set to one of the following:
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFMEM if the vector couldn't be resized;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Never shrinks the vector. Removals may still shrink it later, as set by its
+         *          growth policy.
+         * 
+         * @sa sim_vector_resize
+         */
+        extern EXPORT void C_CALL sim_vector_reserve(
+            Sim_Vector *const vector_ptr,
+            const size_t      size
+        );
+
         /**
          * @fn void sim_vector_get(Sim_Vector *const, const size_t, void*)
          * @relates @capi{Sim_Vector}
@@ -174,7 +298,7 @@ CPP_NAMESPACE_START(SimSoft)
          * 
          * @param[in,out] vector_ptr Pointer to vector to index into.
          * @param[in]     index      Index into the vector.
-         *
+         * 
          * @return @c NULL on error (see remarks); pointer to data otherwise.
          * 
          * @remarks sim_return_code() is set to one of the following:
@@ -199,18 +323,23 @@ CPP_NAMESPACE_START(SimSoft)
          * 
          * @param[in,out] vector_ptr     Pointer to vector to search.
          * @param[in]     item_ptr       Pointer to item to compare against.
-         * @param[in]     predicate_proc Pointer to equality predicate function.
+         * @param[in]     predicate_proc Pointer to equality predicate function; items are
+         *                               compared bytewise if @c NULL .
          * @param[in]     starting_index Index into the vector in which to begin the search.
          * 
          * @return (size_t)-1 on error (see remarks); vector index otherwise.
          * 
          * @remarks sim_return_code() is set to one of the following:
-         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr, @e item_ptr, or @e predicate_proc
-         *                            are @c NULL ;
-         *     @b SIM_RC_ERR_OUTOFBND if @e starting_index >= @c vector_ptr->count ;
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr or @e item_ptr are @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFBND if @e starting_index > @c vector_ptr->count ;
          *     @b SIM_RC_NOT_FOUND    if no item in the vector is equivalent to @e item_ptr;
          *     @b SIM_RC_SUCCESS      otherwise.
          * 
+         * @details Bytewise searches of vectors of 1, 2, 4, or 8-byte items compare a block of
+         *          items per SIMD instruction where SSE2 or NEON are available, rather than
+         *          calling a predicate function per item. Items with padding bytes should be
+         *          searched with a predicate function instead.
+         * 
          * @sa sim_vector_contains
          */
         extern EXPORT size_t C_CALL sim_vector_find(
@@ -231,15 +360,16 @@ CPP_NAMESPACE_START(SimSoft)
          * 
          * @param[in,out] vector_ptr     Pointer to vector to search.
          * @param[in]     item_ptr       Pointer to item to compare against.
-         * @param[in]     predicate_proc Pointer to equality predicate function.
+         * @param[in]     predicate_proc Pointer to equality predicate function; items are
+         *                               compared bytewise if @c NULL , as with
+         *                               sim_vector_find.
          * 
          * @return @c false on error (see remarks) or if @e item_ptr isn't contained in
          *            @e vector_ptr;
          *         @c true otherwise.
          * 
          * @remarks sim_return_code() is set to one of the following:
-         *     @b SIM_RC_ERR_NULLPTR if @e vector_ptr, @e item_ptr, or @e predicate_proc
-         *                           are @c NULL ;
+         *     @b SIM_RC_ERR_NULLPTR if @e vector_ptr or @e item_ptr are @c NULL ;
          *     @b SIM_RC_NOT_FOUND   if no item in the vector is equivalent to @e item_ptr;
          *     @b SIM_RC_SUCCESS     otherwise.
          * 
@@ -294,6 +424,64 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t      index
         );
 
+        /**
+         * @fn void sim_vector_append_n(Sim_Vector *const, const void*, const size_t)
+         * @relates @capi{Sim_Vector}
+         * @brief Push an array of new items to the back of a vector.
+         * 
+         * @param[in,out] vector_ptr Pointer to vector to push items into.
+         * @param[in]     items_ptr  Pointer to an array of new items to push into vector; mustn't
+         *                           point into the vector itself.
+         * @param[in]     item_count The amount of items in @e items_ptr.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL , or @e items_ptr is @c NULL &
+         *                            @e item_count isn't 0;
+         *     @b SIM_RC_ERR_OUTOFMEM if @e vector_ptr couldn't be resized to fit the new items;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Grows the vector at most once & copies the items in with a single
+         *          @c memcpy .
+         * 
+         * @sa sim_vector_insert_n
+         */
+        extern EXPORT void C_CALL sim_vector_append_n(
+            Sim_Vector *const vector_ptr,
+            const void*       items_ptr,
+            const size_t      item_count
+        );
+
+        /**
+         * @fn void sim_vector_insert_n(Sim_Vector *const, const void*, const size_t, const size_t)
+         * @relates @capi{Sim_Vector}
+         * @brief Insert an array of new items into a vector at a given index.
+         * 
+         * @param[in,out] vector_ptr Pointer to the vector to insert items into.
+         * @param[in]     items_ptr  Pointer to an array of new items to insert into vector;
+         *                           mustn't point into the vector itself.
+         * @param[in]     item_count The amount of items in @e items_ptr.
+         * @param[in]     index      Index into vector in which to insert the first new item.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL , or @e items_ptr is @c NULL &
+         *                            @e item_count isn't 0;
+         *     @b SIM_RC_ERR_OUTOFBND if @e index > vector_ptr->count ;
+         *     @b SIM_RC_ERR_OUTOFMEM if @e vector_ptr couldn't be resized to fit the new items;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Grows the vector at most once & shifts later items back with a single
+         *          @c memmove , rather than once per item.
+         * 
+         * @sa sim_vector_append_n
+         * @sa sim_vector_remove_range
+         */
+        extern EXPORT void C_CALL sim_vector_insert_n(
+            Sim_Vector *const vector_ptr,
+            const void*       items_ptr,
+            const size_t      item_count,
+            const size_t      index
+        );
+
         /**
          * @fn void sim_vector_pop(Sim_Vector *const, void*)
          * @relates @capi{Sim_Vector}
@@ -336,6 +524,35 @@ CPP_NAMESPACE_START(SimSoft)
             const size_t      index
         );
 
+        /**
+         * @fn void sim_vector_remove_range(Sim_Vector *const, void*, const size_t, const size_t)
+         * @relates @capi{Sim_Vector}
+         * @brief Removes a range of consecutive items from the vector.
+         * 
+         * @param[in,out] vector_ptr    Pointer to vector to remove items from.
+         * @param[out]    items_out_ptr Pointer to an array to fill with removed items; may be
+         *                              @c NULL .
+         * @param[in]     start_index   Index into vector of the first item to remove.
+         * @param[in]     item_count    The amount of items to remove.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR  if @e vector_ptr is @c NULL ;
+         *     @b SIM_RC_ERR_OUTOFBND if @e start_index + @e item_count > vector_ptr->count ;
+         *     @b SIM_RC_SUCCESS      otherwise.
+         * 
+         * @details Shifts later items forward with a single @c memmove & shrinks the vector at
+         *          most once, as set by its growth policy.
+         * 
+         * @sa sim_vector_remove
+         * @sa sim_vector_insert_n
+         */
+        extern EXPORT void C_CALL sim_vector_remove_range(
+            Sim_Vector *const vector_ptr,
+            void*             items_out_ptr,
+            const size_t      start_index,
+            const size_t      item_count
+        );
+
         /**
          * @fn bool sim_vector_foreach(Sim_Vector *const, Sim_ForEachProc, Sim_Variant)
          * @relates @capi{Sim_Vector}
@@ -385,6 +602,7 @@ CPP_NAMESPACE_START(SimSoft)
          *          @e out_vector_ptr if it isn't @c NULL .
          * 
          * @sa sim_vector_select
+         * @sa sim_vector_retain
          */
         extern EXPORT void C_CALL sim_vector_extract(
             Sim_Vector *const vector_ptr,
@@ -426,89 +644,367 @@ CPP_NAMESPACE_START(SimSoft)
             Sim_Variant       userdata,
             Sim_Vector *const out_vector_ptr
         );
+        /**
+         * @fn size_t sim_vector_retain(
+         *         Sim_Vector *const,
+         *         Sim_FilterProc,
+         *         Sim_Variant,
+         *         const bool
+         *     )
+         * @relates @capi{Sim_Vector}
+         * @brief Removes every item failing a given function from the vector in place.
+         * 
+         * @param[in,out] vector_ptr  Pointer to vector whose items will be filtered via the
+         *                            given function.
+         * @param[in]     filter_proc Pointer to filter function; called once per item.
+         * @param[in]     userdata    User-provided data to @e filter_proc.
+         * @param[in]     stable      Whether kept items keep their order.
+         * 
+         * @return 0 on error (see remarks); the amount of removed items otherwise.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e vector_ptr or @e filter_proc are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Unlike sim_vector_extract, nothing is allocated: a stable retain moves each
+         *          run of kept items back in one block copy, while an unstable retain fills each
+         *          removed item's slot with a kept item from the back of the vector, copying
+         *          fewer items. The internal array isn't shrunk; see sim_vector_resize.
+         * 
+         * @sa sim_vector_partition
+         * @sa sim_vector_extract
+         */
+        extern EXPORT size_t C_CALL sim_vector_retain(
+            Sim_Vector *const vector_ptr,
+            Sim_FilterProc    filter_proc,
+            Sim_Variant       userdata,
+            const bool        stable
+        );
+
+        /**
+         * @fn size_t sim_vector_partition(
+         *         Sim_Vector *const,
+         *         Sim_FilterProc,
+         *         Sim_Variant,
+         *         const bool
+         *     )
+         * @relates @capi{Sim_Vector}
+         * @brief Moves every item passing a given function in front of those failing it.
+         * 
+         * @param[in,out] vector_ptr  Pointer to vector whose items will be partitioned via the
+         *                            given function.
+         * @param[in]     filter_proc Pointer to filter function; called once per item.
+         * @param[in]     userdata    User-provided data to @e filter_proc.
+         * @param[in]     stable      Whether both groups of items keep their order.
+         * 
+         * @return 0 on error (see remarks); the index of the first item failing
+         *         @e filter_proc otherwise, or @c vector_ptr->count if every item passed.
+         * 
+         * @remarks sim_return_code() is set to one of the folliwng:
+         *     @b SIM_RC_ERR_NULLPTR if @e vector_ptr or @e filter_proc are @c NULL ;
+         *     @b SIM_RC_SUCCESS     otherwise.
+         * 
+         * @details Items are swapped in place without allocating. An unstable partition swaps
+         *          failing items from the front with passing items from the back in one pass; a
+         *          stable partition rotates partitioned halves into place, moving O(n log n)
+         *          items.
+         * 
+         * @sa sim_vector_retain
+         */
+        extern EXPORT size_t C_CALL sim_vector_partition(
+            Sim_Vector *const vector_ptr,
+            Sim_FilterProc    filter_proc,
+            Sim_Variant       userdata,
+            const bool        stable
+        );
 
     CPP_NAMESPACE_C_API_END /* end C API */
 
 #   ifdef __cplusplus /* C++ API */
-#       include "./exception.hpp"
 
         /**
          * @class SimSoft::Vector
+         * @headerfile vector.h "simsoft/vector.h"
          * @brief Generic dynamic array container class.
          * 
          * @tparam T      The type being stored in this vector.
          * @tparam _Pred  Predicate used to check for equality.
          * @tparam _Alloc Allocator for internal array.
+         * 
+         * @details Element access, insertion, & iteration are inlined rather than going through
+         *          the C API. Growing the internal array reallocates it in place when @e T is
+         *          trivially copyable, like @capi{Sim_Vector}; otherwise items are
+         *          move-constructed into a new array, or copied if their move constructor may
+         *          throw. The internal array doubles when full & is allocated by the first
+         *          insertion; it only shrinks when resized.
+         * 
+         *          Pointers, references, & iterators to items are invalidated by insertions that
+         *          grow the vector, & by insertions & removals before them.
          */
         template <
             class T,
             class _Pred = Predicate_Equal<T>,
             class _Alloc = Allocator
         >
-        class Vector : private C_API::Sim_Vector {
+        class Vector {
         private:
-            template <bool Reversed>
+            static_assert(
+                alignof(T) <= alignof(std::max_align_t),
+                "SimSoft::Vector can't hold over-aligned types"
+            );
+
+            // trivially copyable items can be moved around as bytes
+            static constexpr bool _RELOCATES_BYTES = std::is_trivially_copyable<T>::value;
+
+            template <class U, bool REVERSED>
             class Iterator {
             private:
-                T* _item_ptr;
-            
-            public:
-                Iterator(T* item_ptr) : _item_ptr(item_ptr);
-            };
+                template <class, bool> friend class Iterator;
 
-            template <bool Reversed>
-            class ConstIterator {
-                const T* _item_ptr;
+                // reverse iterators point one past their item, like std::reverse_iterator
+                U* _item_ptr;
 
             public:
-                ConstIterator(const T* item_ptr) : _item_ptr(item_ptr);
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef typename std::remove_const<U>::type value_type;
+                typedef ptrdiff_t difference_type;
+                typedef U* pointer;
+                typedef U& reference;
+
+                Iterator(U* item_ptr = nullptr) noexcept : _item_ptr(item_ptr) { }
+
+                // iterators convert to const iterators
+                template <
+                    class V,
+                    class = typename std::enable_if<
+                        !std::is_same<V, U>::value && std::is_same<const V, U>::value
+                    >::type
+                >
+                Iterator(const Iterator<V, REVERSED>& other) noexcept :
+                    _item_ptr(other._item_ptr)
+                { }
+
+                U& operator*() const noexcept {
+                    return REVERSED ? _item_ptr[-1] : *_item_ptr;
+                }
+                U* operator->() const noexcept {
+                    return &**this;
+                }
+                U& operator[](ptrdiff_t offset) const noexcept {
+                    return *(*this + offset);
+                }
+
+                Iterator& operator+=(ptrdiff_t offset) noexcept {
+                    _item_ptr += REVERSED ? -offset : offset;
+                    return *this;
+                }
+                Iterator& operator-=(ptrdiff_t offset) noexcept {
+                    return *this += -offset;
+                }
+                Iterator& operator++() noexcept {
+                    return *this += 1;
+                }
+                Iterator& operator--() noexcept {
+                    return *this -= 1;
+                }
+                Iterator operator++(int) noexcept {
+                    Iterator temp = *this;
+                    *this += 1;
+                    return temp;
+                }
+                Iterator operator--(int) noexcept {
+                    Iterator temp = *this;
+                    *this -= 1;
+                    return temp;
+                }
+
+                friend Iterator operator+(Iterator iter, ptrdiff_t offset) noexcept {
+                    return iter += offset;
+                }
+                friend Iterator operator+(ptrdiff_t offset, Iterator iter) noexcept {
+                    return iter += offset;
+                }
+                friend Iterator operator-(Iterator iter, ptrdiff_t offset) noexcept {
+                    return iter -= offset;
+                }
+                friend ptrdiff_t operator-(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return REVERSED ?
+                        iter2._item_ptr - iter1._item_ptr :
+                        iter1._item_ptr - iter2._item_ptr
+                    ;
+                }
+
+                friend bool operator==(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1._item_ptr == iter2._item_ptr;
+                }
+                friend bool operator!=(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1._item_ptr != iter2._item_ptr;
+                }
+                friend bool operator<(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1 - iter2 < 0;
+                }
+                friend bool operator>(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1 - iter2 > 0;
+                }
+                friend bool operator<=(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1 - iter2 <= 0;
+                }
+                friend bool operator>=(const Iterator& iter1, const Iterator& iter2) noexcept {
+                    return iter1 - iter2 >= 0;
+                }
             };
 
-            static bool _predicate_helper(const T *const item1, const T *const item2) const {
-                return _Pred(*item1, *item2);
+            T*     _data_ptr { nullptr };
+            size_t _allocated { 0 };
+            size_t _count { 0 };
+            size_t _initial_size;
+
+            _Alloc* _allocator_ptr;
+            _Pred _pred;
+
+            // Destroys the items from a given index onwards.
+            void _destroy_from(size_t index) noexcept {
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    for (size_t i = index; i < _count; i++)
+                        _data_ptr[i].~T();
+                }
+                _count = index;
+            }
+
+            // Reallocates the internal array to hold a given amount of items. Returns false if
+            //  out of memory.
+            bool _reallocate(size_t new_allocated) {
+                if (new_allocated > SIZE_MAX / sizeof(T))
+                    return false;
+
+                if (!new_allocated) {
+                    if (_data_ptr)
+                        allocator_free(_allocator_ptr, _data_ptr);
+                    _data_ptr = nullptr;
+                    _allocated = 0;
+                    return true;
+                }
+
+                T* new_data_ptr;
+                if constexpr (_RELOCATES_BYTES) {
+                    new_data_ptr = (T*)(_data_ptr ?
+                        allocator_realloc(_allocator_ptr, _data_ptr, sizeof(T) * new_allocated) :
+                        allocator_malloc(_allocator_ptr, sizeof(T) * new_allocated)
+                    );
+                    if (!new_data_ptr)
+                        return false;
+                } else {
+                    new_data_ptr = (T*)allocator_malloc(_allocator_ptr, sizeof(T) * new_allocated);
+                    if (!new_data_ptr)
+                        return false;
+
+                    // leave the vector untouched if copying an item throws
+                    size_t i = 0;
+                    try {
+                        for (; i < _count; i++)
+                            new (new_data_ptr + i) T(std::move_if_noexcept(_data_ptr[i]));
+                    } catch (...) {
+                        while (i--)
+                            new_data_ptr[i].~T();
+                        allocator_free(_allocator_ptr, new_data_ptr);
+                        throw;
+                    }
+
+                    const size_t count = _count;
+                    _destroy_from(0);
+                    _count = count;
+
+                    if (_data_ptr)
+                        allocator_free(_allocator_ptr, _data_ptr);
+                }
+
+                _data_ptr = new_data_ptr;
+                _allocated = new_allocated;
+                return true;
+            }
+
+            // Doubles the internal array if it's full.
+            void _grow() {
+                if (_count < _allocated)
+                    return;
+
+                const size_t new_allocated = _allocated ?
+                    _allocated * 2 :
+                    (_initial_size ? _initial_size : 1)
+                ;
+                if (new_allocated < _allocated || !_reallocate(new_allocated))
+                    throw OutOfMemoryException();
+            }
+
+            // Constructs copies of another vector's items.
+            void _copy(const Vector& other) {
+                if (!other._count)
+                    return;
+
+                if (!_reallocate(other._count))
+                    throw OutOfMemoryException();
+
+                if constexpr (_RELOCATES_BYTES) {
+                    memcpy(_data_ptr, other._data_ptr, sizeof(T) * other._count);
+                    _count = other._count;
+                } else {
+                    for (; _count < other._count; _count++)
+                        new (_data_ptr + _count) T(other._data_ptr[_count]);
+                }
             }
 
-            static C_API::Sim_Vector* _get_c_vector() {
-                return (C_API::Sim_Vector*)((uint8*)this) + offsetof(Vector<T>, _item_size);
+            // Takes over another vector's internal array, leaving it empty.
+            void _steal(Vector& other) noexcept {
+                _data_ptr = other._data_ptr;
+                _allocated = other._allocated;
+                _count = other._count;
+
+                other._data_ptr = nullptr;
+                other._allocated = 0;
+                other._count = 0;
+            }
+
+            // Destroys every item & frees the internal array.
+            void _destroy() noexcept {
+                _destroy_from(0);
+                if (_data_ptr)
+                    allocator_free(_allocator_ptr, _data_ptr);
+
+                _data_ptr = nullptr;
+                _allocated = 0;
             }
 
         public:
             /**
              * @typedef SimSoft::Vector::value_type
-             * @brief The type being stored in this Vector.
+             * @brief The type of items stored in this vector.
              */
             typedef T value_type;
             /**
              * @typedef SimSoft::Vector::reference
-             * @brief Reference to @e value_type.
+             * @brief Reference to an item stored in this vector.
              */
             typedef T& reference;
             /**
              * @typedef SimSoft::Vector::const_reference
-             * @brief Const reference to @e value_type.
+             * @brief Const reference to an item stored in this vector.
              */
             typedef const T& const_reference;
             /**
              * @typedef SimSoft::Vector::pointer
-             * @brief Pointer to @e value_type.
+             * @brief Pointer to an item stored in this vector.
              */
             typedef T* pointer;
             /**
              * @typedef SimSoft::Vector::const_pointer
-             * @brief Const pointer to @e value_type.
+             * @brief Const pointer to an item stored in this vector.
              */
             typedef const T* const_pointer;
             /**
-             * @typedef SimSoft::Vector::pointer_const
-             * @brief Pointer const to @e value_type.
+             * @typedef SimSoft::Vector::predicate
+             * @brief The equality predicate functor used on items.
              */
-            typedef T *const pointer_const;
-            /**
-             * @typedef SimSoft::Vector::const_pointer_const
-             * @brief Const pointer const to @e value_type.
-             */
-            typedef const T *const const_pointer_const;
-
+            typedef _Pred predicate;
             /**
              * @typedef SimSoft::Vector::allocator
              * @brief The allocator type used by this vector.
@@ -517,215 +1013,406 @@ CPP_NAMESPACE_START(SimSoft)
 
             /**
              * @typedef SimSoft::Vector::iterator
-             * @brief Vector forward iterator type.
+             * @brief Random access iterator over the items in this vector.
              */
-            typedef Iterator<false> iterator;
+            typedef Iterator<T, false> iterator;
             /**
              * @typedef SimSoft::Vector::reverse_iterator
-             * @brief Vector reverse iterator type.
+             * @brief Random access iterator over the items in this vector, back to front.
              */
-            typedef Iterator<true>  reverse_iterator;
+            typedef Iterator<T, true> reverse_iterator;
             /**
              * @typedef SimSoft::Vector::const_iterator
-             * @brief Vector const forward iterator type.
+             * @brief Random access iterator over the const items in this vector.
              */
-            typedef ConstIterator<false> const_iterator;
+            typedef Iterator<const T, false> const_iterator;
             /**
              * @typedef SimSoft::Vector::const_reverse_iterator
-             * @brief Vector const reverse iterator type.
+             * @brief Random access iterator over the const items in this vector, back to front.
              */
-            typedef ConstIterator<true>  const_reverse_iterator;
+            typedef Iterator<const T, true> const_reverse_iterator;
 
             /**
              * @var SimSoft::Vector::DEFAULT_SIZE
-             * @brief The default size used when intializing a new vector.
+             * @brief The default amount of items allocated by the first insertion.
              */
             constexpr static size_t DEFAULT_SIZE = SIM_DEFAULT_VECTOR_SIZE;
 
             /**
-             * @fn SimSoft::Vector::Vector(size_t)
+             * @fn SimSoft::Vector::Vector(size_t, _Alloc*)
              * @brief Constructs a new Vector object.
              * 
-             * @param[in] initial_size @b Optional: The initial size of the newly created Vector.
-             *                         Defaults to @e Vector::DEFAULT_SIZE.
-             * 
-             * @throws Exception If the @e initial_size requested couldn't be allocated.
-             */
-            Vector(size_t initial_size = DEFAULT_SIZE) throws Exception {
-                C_API::sim_vector_construct(
-                    _get_c_vector(),
-                    sizeof(value_type),
-                    allocator::get_c_allocator(),
-                    initial_size
-                );
-                ReturnCode rc == (ReturnCode)C_API::sim_return_code();
-                if (rc > ReturnCode::FAILURE)
-                    throw Exception();
+             * @param[in] initial_size  @b Optional: The amount of items allocated by the first
+             *                          insertion. Defaults to @e Vector::DEFAULT_SIZE.
+             * @param[in] allocator_ptr @b Optional: Pointer to an allocator. Uses the default
+             *                          allocator if @c nullptr .
+             */
+            Vector(
+                size_t  initial_size = DEFAULT_SIZE,
+                _Alloc* allocator_ptr = nullptr
+            ) noexcept :
+                _initial_size(initial_size),
+                _allocator_ptr(allocator_ptr)
+            { }
+            Vector(const Vector& other) :
+                _initial_size(other._initial_size),
+                _allocator_ptr(other._allocator_ptr),
+                _pred(other._pred)
+            {
+                _copy(other);
+            }
+            Vector(Vector&& other) noexcept :
+                _initial_size(other._initial_size),
+                _allocator_ptr(other._allocator_ptr),
+                _pred(std::move(other._pred))
+            {
+                _steal(other);
             }
 
             ~Vector() {
-                sim_vector_destroy(_get_c_vector());
-            }
-
-            void clear() {
-                sim_vector_clear(_get_c_vector());
-            }
-
-            void resize(size_t new_size) throws Exception {
-                ReturnCode rc;
-                
-                if ((rc = (ReturnCode)sim_vector_resize(
-                    &_c_vector,
-                    new_size
-                )))
-                    throw Exception(rc);
-            }
-
-            T& get(size_t index) throws Exception {
-                ReturnCode rc;
-                T* ptr;
-                
-                if ((rc = (ReturnCode)sim_vector_get_ptr(
-                    &_c_vector,
-                    index,
-                    &((void*)ptr)
-                )))
-                    throw Exception(rc);
-                
-                return *ptr;
-            }
-            const T& get(size_t index) const throws Exception {
-                ReturnCode rc;
-                const T* ptr;
-                
-                if ((rc = (ReturnCode)sim_vector_get_ptr(
-                    &_c_vector,
-                    index,
-                    &((void*)const_cast<T*>(ptr))
-                )))
-                    throw Exception(rc);
-                
-                return *ptr;
-            }
-
-            T& operator[](size_t index) throws Exception {
-                return get(index);
-            }
-            const T& operator[](size_t index) const throws Exception {
-                return get(index);
-            }
-
-            void push(const T& item) throws Exception {
-                ReturnCode rc;
-                
-                if ((rc = (ReturnCode)sim_vector_push(
-                    &_c_vector,
-                    &item
-                )))
-                    throw Exception(rc);
-            }
-            void push(T&& item) throws Exception {
-                ReturnCode rc;
-                
-                if ((rc = (ReturnCode)sim_vector_push(
-                    &_c_vector,
-                    &item
-                )))
-                    throw Exception(rc);
-            }
-
-            void insert(const T& item, size_t index) throws Exception {
-                ReturnCode rc;
-                
-                if ((rc = (ReturnCode)sim_vector_insert(
-                    &_c_vector,
-                    &item,
-                    index
-                )))
-                    throw Exception(rc);
-            }
-            void insert(T&& item, size_t index) throws Exception {
-                ReturnCode rc;
-                
-                if ((rc = (ReturnCode)sim_vector_insert(
-                    &_c_vector,
-                    &item,
-                    index
-                )))
-                    throw Exception(rc);
-            }
-
-            T pop() throws Exception {
-                ReturnCode rc;
-                T temp;
-
-                if ((rc = (ReturnCode)sim_vector_pop(
-                    &_c_vector,
-                    &temp
-                )))
-                    throw Exception(rc);
-
-                return temp;
-            }
-
-            T remove(size_t index) throws Exception {
-                ReturnCode rc;
-                T temp;
-
-                if ((rc = (ReturnCode)sim_vector_remove(
-                    &_c_vector,
-                    &temp,
-                    index
-                )))
-                    throw Exception(rc);
-
-                return temp;
-            }
-
-            size_t find(const T& item, size_t starting_index = 0) throws Exception {
-                ReturnCode rc;
-                size_t index;
-
-                if ((rc = (ReturnCode)sim_vector_find(
-                    &_c_vector,
-                    &item,
-                    ::_predicate_helper,
-                    starting_index,
-                    &index
-                )))
-                    throw Exception(rc);
-                
-                return index;
-            }
-            size_t find(T&& item, size_t starting_index = 0) throws Exception {
-                ReturnCode rc;
-                size_t index;
-
-                if ((rc = (ReturnCode)sim_vector_find(
-                    &_c_vector,
-                    &item,
-                    ::_predicate_helper,
-                    starting_index,
-                    &index
-                )))
-                    throw Exception(rc);
-                
-                return index;
-            }
-
-            bool contains(const T& item) noexcept const {
-                return sim_vector_contains(
-                    &_c_vector,
-                    &item,
-                    ::_predicate_helper
-                );
+                _destroy();
+            }
+
+            Vector& operator=(const Vector& other) {
+                if (this != &other) {
+                    _destroy();
+                    _allocator_ptr = other._allocator_ptr;
+                    _pred = other._pred;
+                    _copy(other);
+                }
+                return *this;
+            }
+            Vector& operator=(Vector&& other) noexcept {
+                if (this != &other) {
+                    _destroy();
+                    _allocator_ptr = other._allocator_ptr;
+                    _pred = std::move(other._pred);
+                    _steal(other);
+                }
+                return *this;
+            }
+
+            /**
+             * @fn size_t SimSoft::Vector::get_count() const
+             * @brief Retrieves the amount of items in the vector.
+             */
+            size_t get_count() const noexcept {
+                return _count;
+            }
+
+            /**
+             * @fn size_t SimSoft::Vector::get_capacity() const
+             * @brief Retrieves the amount of items the internal array can hold.
+             */
+            size_t get_capacity() const noexcept {
+                return _allocated;
+            }
+
+            /**
+             * @fn bool SimSoft::Vector::is_empty() const
+             * @brief Checks if the vector holds no items.
+             */
+            bool is_empty() const noexcept {
+                return !_count;
+            }
+
+            /**
+             * @fn T* SimSoft::Vector::get_data_ptr()
+             * @brief Retrieves the vector's internal array; @c nullptr if not yet allocated.
+             */
+            T* get_data_ptr() noexcept {
+                return _data_ptr;
+            }
+            const T* get_data_ptr() const noexcept {
+                return _data_ptr;
+            }
+
+            /**
+             * @fn _Alloc* SimSoft::Vector::get_allocator() const
+             * @brief Retrieves the allocator passed to the constructor.
+             */
+            _Alloc* get_allocator() const noexcept {
+                return _allocator_ptr;
+            }
+
+            /**
+             * @fn void SimSoft::Vector::clear()
+             * @brief Destroys every item; keeps the internal array allocated.
+             */
+            void clear() noexcept {
+                _destroy_from(0);
+            }
+
+            /**
+             * @fn void SimSoft::Vector::resize(size_t)
+             * @brief Reallocates the vector's internal array.
+             * 
+             * @param[in] new_size The amount of items to allocate; frees the internal array if
+             *                     0.
+             * 
+             * @throws InvalidArgumentException If @e new_size is less than the vector's count.
+             * @throws OutOfMemoryException     If the internal array couldn't be allocated.
+             */
+            void resize(size_t new_size) {
+                if (new_size < _count)
+                    throw InvalidArgumentException();
+
+                if (new_size != _allocated && !_reallocate(new_size))
+                    throw OutOfMemoryException();
             }
-            bool contains(T&& item) noexcept const {
-                return sim_vector_contains(
-                    &_c_vector,
-                    &item,
-                    ::_predicate_helper
+
+            /**
+             * @fn void SimSoft::Vector::reserve(size_t)
+             * @brief Grows the vector's internal array to hold at least a given amount of items.
+             * 
+             * @param[in] size The amount of items to make room for.
+             * 
+             * @throws OutOfMemoryException If the internal array couldn't be allocated.
+             */
+            void reserve(size_t size) {
+                if (size > _allocated && !_reallocate(size))
+                    throw OutOfMemoryException();
+            }
+
+            /**
+             * @fn T& SimSoft::Vector::get(size_t)
+             * @brief Get an item from the vector at a given index.
+             * 
+             * @param[in] index Index of the item.
+             * 
+             * @throws OutOfBoundsException If @e index is past the end of the vector.
+             */
+            T& get(size_t index) {
+                if (index >= _count)
+                    throw OutOfBoundsException();
+                return _data_ptr[index];
+            }
+            const T& get(size_t index) const {
+                return const_cast<Vector*>(this)->get(index);
+            }
+
+            /**
+             * @fn T& SimSoft::Vector::operator[](size_t)
+             * @brief Get an item from the vector at a given index without bounds checking.
+             * 
+             * @param[in] index Index of the item; must be less than the vector's count.
+             */
+            T& operator[](size_t index) noexcept {
+                return _data_ptr[index];
+            }
+            const T& operator[](size_t index) const noexcept {
+                return _data_ptr[index];
+            }
+
+            /**
+             * @fn T& SimSoft::Vector::emplace(ARGS&&...)
+             * @brief Constructs a new item at the back of the vector.
+             * 
+             * @param[in] args Arguments passed to the item's constructor.
+             * 
+             * @return Reference to the new item.
+             * 
+             * @throws OutOfMemoryException If the vector needed to grow & couldn't.
+             */
+            template <class...ARGS>
+            T& emplace(ARGS&&... args) {
+                if (_count < _allocated)
+                    new (_data_ptr + _count) T(std::forward<ARGS>(args)...);
+                else {
+                    // the arguments may refer to items that growing would move
+                    T item(std::forward<ARGS>(args)...);
+                    _grow();
+                    new (_data_ptr + _count) T(std::move(item));
+                }
+                return _data_ptr[_count++];
+            }
+
+            /**
+             * @fn void SimSoft::Vector::push(const T&)
+             * @brief Push a new item to the back of the vector.
+             * 
+             * @param[in] item Item to push.
+             * 
+             * @throws OutOfMemoryException If the vector needed to grow & couldn't.
+             */
+            void push(const T& item) {
+                emplace(item);
+            }
+            void push(T&& item) {
+                emplace(std::move(item));
+            }
+
+            /**
+             * @fn void SimSoft::Vector::insert(const T&, size_t)
+             * @brief Insert a new item into the vector at a given index.
+             * 
+             * @param[in] item  Item to insert.
+             * @param[in] index Index to insert the item at; later items are shifted back.
+             * 
+             * @throws OutOfBoundsException If @e index is past the end of the vector.
+             * @throws OutOfMemoryException If the vector needed to grow & couldn't.
+             */
+            void insert(const T& item, size_t index) {
+                insert(T(item), index);
+            }
+            void insert(T&& item, size_t index) {
+                if (index > _count)
+                    throw OutOfBoundsException();
+                if (index == _count) {
+                    emplace(std::move(item));
+                    return;
+                }
+
+                // item may be one of the vector's own
+                T temp(std::move(item));
+                _grow();
+
+                new (_data_ptr + _count) T(std::move(_data_ptr[_count - 1]));
+                _count++;
+                std::move_backward(
+                    _data_ptr + index,
+                    _data_ptr + _count - 2,
+                    _data_ptr + _count - 1
                 );
+                _data_ptr[index] = std::move(temp);
+            }
+
+            /**
+             * @fn T SimSoft::Vector::pop()
+             * @brief Removes the item at the back of the vector.
+             * 
+             * @return The removed item.
+             * 
+             * @throws OutOfBoundsException If the vector is empty.
+             */
+            T pop() {
+                if (!_count)
+                    throw OutOfBoundsException();
+
+                T item(std::move(_data_ptr[_count - 1]));
+                _destroy_from(_count - 1);
+                return item;
+            }
+
+            /**
+             * @fn T SimSoft::Vector::remove(size_t)
+             * @brief Removes an item from the vector at a given index.
+             * 
+             * @param[in] index Index of the item; later items are shifted forward.
+             * 
+             * @return The removed item.
+             * 
+             * @throws OutOfBoundsException If @e index is past the end of the vector.
+             */
+            T remove(size_t index) {
+                if (index >= _count)
+                    throw OutOfBoundsException();
+
+                T item(std::move(_data_ptr[index]));
+                std::move(_data_ptr + index + 1, _data_ptr + _count, _data_ptr + index);
+                _destroy_from(_count - 1);
+                return item;
+            }
+
+            /**
+             * @fn size_t SimSoft::Vector::find(const T&, size_t) const
+             * @brief Find the index of the first item in the vector that tests equal to a given
+             *        item.
+             * 
+             * @param[in] item           Item to compare against.
+             * @param[in] starting_index @b Optional: Index to begin the search at.
+             * 
+             * @return (size_t)-1 if no item from @e starting_index onwards is equal to
+             *         @e item; vector index otherwise.
+             */
+            size_t find(const T& item, size_t starting_index = 0) const {
+                for (size_t i = starting_index; i < _count; i++)
+                    if (_pred(_data_ptr[i], item))
+                        return i;
+                return (size_t)-1;
+            }
+
+            /**
+             * @fn bool SimSoft::Vector::contains(const T&) const
+             * @brief Checks if an item is contained in the vector.
+             * 
+             * @param[in] item Item to compare against.
+             */
+            bool contains(const T& item) const {
+                return find(item) != (size_t)-1;
+            }
+
+            /**
+             * @fn bool SimSoft::Vector::foreach(PROC)
+             * @brief Applies a given functor to each item in the vector, front to back.
+             * 
+             * @param[in] foreach_proc Functor taking a reference to an item & its index;
+             *                         returns @c false to stop iterating.
+             * 
+             * @return @c false if the loop wasn't fully completed; @c true otherwise.
+             */
+            template <class PROC>
+            bool foreach(PROC&& foreach_proc) {
+                for (size_t i = 0; i < _count; i++)
+                    if (!foreach_proc(_data_ptr[i], i))
+                        return false;
+                return true;
+            }
+
+            /**
+             * @fn iterator SimSoft::Vector::begin()
+             * @brief Retrieves an iterator to the front of the vector.
+             */
+            iterator begin() noexcept {
+                return _data_ptr;
+            }
+            const_iterator begin() const noexcept {
+                return _data_ptr;
+            }
+            const_iterator cbegin() const noexcept {
+                return _data_ptr;
+            }
+
+            /**
+             * @fn iterator SimSoft::Vector::end()
+             * @brief Retrieves an iterator past the back of the vector.
+             */
+            iterator end() noexcept {
+                return _data_ptr + _count;
+            }
+            const_iterator end() const noexcept {
+                return _data_ptr + _count;
+            }
+            const_iterator cend() const noexcept {
+                return _data_ptr + _count;
+            }
+
+            /**
+             * @fn reverse_iterator SimSoft::Vector::rbegin()
+             * @brief Retrieves a reverse iterator to the back of the vector.
+             */
+            reverse_iterator rbegin() noexcept {
+                return _data_ptr + _count;
+            }
+            const_reverse_iterator rbegin() const noexcept {
+                return _data_ptr + _count;
+            }
+            const_reverse_iterator crbegin() const noexcept {
+                return _data_ptr + _count;
+            }
+
+            /**
+             * @fn reverse_iterator SimSoft::Vector::rend()
+             * @brief Retrieves a reverse iterator past the front of the vector.
+             */
+            reverse_iterator rend() noexcept {
+                return _data_ptr;
+            }
+            const_reverse_iterator rend() const noexcept {
+                return _data_ptr;
+            }
+            const_reverse_iterator crend() const noexcept {
+                return _data_ptr;
             }
         };
 
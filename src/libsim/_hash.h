@@ -0,0 +1,192 @@
+/**
+ * @file _hash.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Internal header for simsoft/hashmap.h & simsoft/hashset.h based implementations
+ * @version 0.1
+ * @date 2020-01-10
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT__HASH_H_
+#define SIMSOFT__HASH_H_
+
+#include "./_internal.h"
+#include "simsoft/hashmap.h"
+#include "simsoft/hashset.h"
+#include "simsoft/util.h"
+
+// Hashmap/hashset aliasing to allow for identical internal implementation
+typedef union _Sim_HashPtr {
+    Sim_HashMap *const hashmap_ptr;
+    Sim_HashSet *const hashset_ptr;
+} _Sim_HashPtr;
+
+typedef union _Sim_HashForEachProc {
+    Sim_ConstForEachProc set_foreach_proc;
+    Sim_MapForEachProc   map_foreach_proc;
+} _Sim_HashForEachProc;
+
+// Slot control bytes; every slot in a hash table has one describing its state.
+//  Slots holding an item have the item's 7-bit hash fingerprint as their control byte instead.
+#define _SIM_HASH_CTRL_EMPTY   ((uint8)0x80) // slot has never held an item
+#define _SIM_HASH_CTRL_DELETED ((uint8)0xFE) // slot held an item that was removed (tombstone)
+#define _SIM_HASH_CTRL_BUSY    ((uint8)0xFF) // slot is being filled by another thread
+
+// Checks if a control byte belongs to a slot holding an item
+#define _SIM_HASH_CTRL_IS_FULL(ctrl) (!((ctrl) & 0x80))
+
+// Retrieves the 7-bit fingerprint of a hash
+#define _SIM_HASH_FINGERPRINT(hash) ((uint8)((hash) & 0x7F))
+
+// Per-operation counters; only counted if SIM_HASH_OP_COUNTERS is non-zero
+#if SIM_HASH_OP_COUNTERS
+#   define _SIM_HASH_COUNT(hashmap_ptr, counter, amount) \
+        ((hashmap_ptr)->_op_counters.counter += (amount))
+#   define _SIM_HASH_PROBES_PTR(probes_ptr) (probes_ptr)
+#else
+#   define _SIM_HASH_COUNT(hashmap_ptr, counter, amount) ((void)(amount))
+#   define _SIM_HASH_PROBES_PTR(probes_ptr) NULL
+#endif
+
+// Amount of old buckets migrated by each operation during an incremental resize
+#define _SIM_HASH_MIGRATION_STEP 32
+
+// View into a hash table's bucket arrays
+typedef struct _Sim_HashTable {
+    uint8* slots_ptr;          // array of slots holding either node pointers or inline items
+    Sim_HashType* hashes_ptr;  // array of each slot's cached hash; NULL if not caching hashes
+    uint8* control_ptr;        // array of control bytes; one per slot
+    uint8* distances_ptr;      // array of each slot's distance from home; NULL unless Robin Hood
+    size_t allocated;          // number of slots
+} _Sim_HashTable;
+
+// Mixes the bits of a hash so that every bit depends on every input bit.
+static inline Sim_HashType _sim_hash_mix(
+    Sim_HashType hash
+) {
+    // MurmurHash3 64-bit finalizer
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Hashes a key's bytes when no hash function was provided.
+//  The secondary hash uses a different key/seed & is used for double hashing.
+static inline Sim_HashType _sim_hash_get_default_hash(
+    const Sim_HashMap *const hashmap_ptr,
+    const void *const        key_ptr,
+    const bool               secondary
+) {
+    if (hashmap_ptr->_flags & SIM_HASH_SIPHASH)
+        return sim_siphash(
+            key_ptr,
+            hashmap_ptr->_key_properties.size,
+            secondary ?
+                (Sim_HashKey){SIPHASH_KEY3, SIPHASH_KEY4} :
+                (Sim_HashKey){SIPHASH_KEY1, SIPHASH_KEY2}
+        );
+
+    return sim_fasthash(
+        key_ptr,
+        hashmap_ptr->_key_properties.size,
+        secondary ?
+            FASTHASH_SEED2 :
+            FASTHASH_SEED1
+    );
+}
+
+// Calculates the hash of a key.
+static inline Sim_HashType _sim_hash_get_hash(
+    const Sim_HashMap *const hashmap_ptr,
+    const void *const        key_ptr
+) {
+    Sim_HashProc hash_proc = hashmap_ptr->_key_properties.hash_proc;
+
+    const Sim_HashType hash = hash_proc ?
+        (*hash_proc)(key_ptr, 0) :
+        _sim_hash_get_default_hash(hashmap_ptr, key_ptr, false)
+    ;
+
+    // user hashes may be weak; spread them out before they're split into an index & fingerprint
+    return (hashmap_ptr->_flags & (SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO)) ?
+        _sim_hash_mix(hash) :
+        hash
+    ;
+}
+
+// Retrieves a pointer to the item (key followed by value) held by a given slot.
+static inline uint8* _sim_hash_get_item(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    uint8 *const slot_ptr = table_ptr->slots_ptr + (hashmap_ptr->_slot_size * index);
+
+    return (hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE) ?
+        slot_ptr :
+        *(uint8**)slot_ptr
+    ;
+}
+
+extern size_t _sim_hash_get_slot_size(const size_t item_size, const Sim_HashFlags flags);
+
+extern void _sim_hash_construct(
+    _Sim_HashPtr          hash_ptr,
+    const size_t          key_size,
+    Sim_HashProc          key_hash_proc,
+    Sim_PredicateProc     key_predicate_proc,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const size_t          initial_size,
+    const Sim_HashFlags   requested_flags,
+    const size_t          reserved_count
+);
+
+extern void _sim_hash_clear(_Sim_HashPtr hash_ptr);
+
+extern void _sim_hash_destroy(_Sim_HashPtr hash_ptr);
+
+extern void _sim_hash_migrate(Sim_HashMap *const hashmap_ptr, const size_t max_slots);
+
+extern void _sim_hash_erase_linear(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+);
+
+extern bool _sim_hash_find(
+    const Sim_HashMap *const hashmap_ptr,
+    const void *const        key_ptr,
+    const Sim_HashType       key_hash,
+    _Sim_HashTable *const    out_table_ptr,
+    size_t *const            out_index_ptr,
+    size_t *const            out_probes_ptr
+);
+
+extern void _sim_hash_insert_hashed(
+    _Sim_HashPtr       hash_ptr,
+    const void*        key_ptr,
+    const Sim_HashType hash,
+    const void*        value_ptr
+);
+
+extern void _sim_hash_remove_hashed(
+    _Sim_HashPtr       hash_ptr,
+    const void*        key_ptr,
+    const Sim_HashType hash
+);
+
+extern bool _sim_hash_foreach_tables(
+    const Sim_HashMap *const hashmap_ptr,
+    const bool               is_hashmap,
+    _Sim_HashForEachProc     foreach_proc,
+    Sim_Variant              userdata,
+    size_t *const            item_num_ptr
+);
+
+#endif /* SIMSOFT__HASH_H_ */
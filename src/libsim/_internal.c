@@ -65,7 +65,7 @@ bool _sim_is_prime(const size_t num) {
         return true;
     
     size_t threshold = (size_t)floor(sqrt((double)num));
-    for (size_t i = 3; i < threshold; i += 2)
+    for (size_t i = 3; i <= threshold; i += 2)
         if (num % i == 0)
             return false;
     
@@ -50,7 +50,7 @@
 #elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
 #   include <x86intrin.h> // IA-32/AMD64 MMX/SSE extensions
 #   define ARCH_X86
-#elif defined(__GNUC__) && defined(__ARM_NEON__)
+#elif defined(__GNUC__) && (defined(__ARM_NEON__) || defined(__ARM_NEON))
 #   include <arm_neon.h> // ARM NEON
 #   define ARCH_ARM_NEON
 #elif defined(__GNUC__) && defined(__IWMMXT__)
@@ -78,6 +78,142 @@ extern size_t _sim_prev_prime(size_t num);
 #define SIPHASH_KEY3 0x62d76395429756a9ULL
 #define SIPHASH_KEY4 0xe26534637479058cULL
 
+// == Fasthash seeds ==============================================================================
+
+// Seeds for hash fallback + double hashing
+#define FASTHASH_SEED1 0x3c6ef372fe94f82bULL
+#define FASTHASH_SEED2 0xa54ff53a5f1d36f1ULL
+
+// == Reader-writer locks =========================================================================
+
+#ifdef _WIN32
+    typedef SRWLOCK _Sim_RWLock;
+#   define _sim_rwlock_init(lock_ptr)         (InitializeSRWLock(lock_ptr), true)
+#   define _sim_rwlock_destroy(lock_ptr)      ((void)(lock_ptr))
+#   define _sim_rwlock_read_lock(lock_ptr)    AcquireSRWLockShared(lock_ptr)
+#   define _sim_rwlock_read_unlock(lock_ptr)  ReleaseSRWLockShared(lock_ptr)
+#   define _sim_rwlock_write_lock(lock_ptr)   AcquireSRWLockExclusive(lock_ptr)
+#   define _sim_rwlock_write_unlock(lock_ptr) ReleaseSRWLockExclusive(lock_ptr)
+#else
+#   include <pthread.h>
+    typedef pthread_rwlock_t _Sim_RWLock;
+#   define _sim_rwlock_init(lock_ptr)         (pthread_rwlock_init((lock_ptr), NULL) == 0)
+#   define _sim_rwlock_destroy(lock_ptr)      pthread_rwlock_destroy(lock_ptr)
+#   define _sim_rwlock_read_lock(lock_ptr)    pthread_rwlock_rdlock(lock_ptr)
+#   define _sim_rwlock_read_unlock(lock_ptr)  pthread_rwlock_unlock(lock_ptr)
+#   define _sim_rwlock_write_lock(lock_ptr)   pthread_rwlock_wrlock(lock_ptr)
+#   define _sim_rwlock_write_unlock(lock_ptr) pthread_rwlock_unlock(lock_ptr)
+#endif
+
+// == Atomic operations ===========================================================================
+
+// Atomics on pointer-sized variables (pointers & size_t) & bytes.
+//  Loads have acquire semantics, stores have release semantics, & exchanges, compare-and-swaps,
+//  & fences are full barriers.
+#ifdef _MSC_VER
+    // relies on MSVC's default volatile semantics (/volatile:ms) for acquire/release ordering
+#   define _sim_atomic_load_ptr(var_ptr)  ((void*)*(void *volatile *)(var_ptr))
+#   define _sim_atomic_load_size(var_ptr) ((size_t)*(volatile size_t*)(var_ptr))
+#   define _sim_atomic_store_ptr(var_ptr, value) \
+        ((void)(*(void *volatile *)(var_ptr) = (void*)(value)))
+#   define _sim_atomic_store_size(var_ptr, value) \
+        ((void)(*(volatile size_t*)(var_ptr) = (size_t)(value)))
+#   define _sim_atomic_exchange_size(var_ptr, value) \
+        ((size_t)InterlockedExchangePointer((PVOID volatile*)(var_ptr), (PVOID)(size_t)(value)))
+#   define _sim_atomic_cas_ptr(var_ptr, expected, desired) (                    \
+        InterlockedCompareExchangePointer(                                       \
+            (PVOID volatile*)(var_ptr), (PVOID)(desired), (PVOID)(expected)      \
+        ) == (PVOID)(expected)                                                   \
+    )
+#   define _sim_atomic_cas_size(var_ptr, expected, desired) \
+        _sim_atomic_cas_ptr((var_ptr), (size_t)(expected), (size_t)(desired))
+#   define _sim_atomic_load_uint8(var_ptr) ((uint8)*(volatile uint8*)(var_ptr))
+#   define _sim_atomic_store_uint8(var_ptr, value) \
+        ((void)(*(volatile uint8*)(var_ptr) = (uint8)(value)))
+#   define _sim_atomic_cas_uint8(var_ptr, expected, desired) (                \
+        _InterlockedCompareExchange8(                                           \
+            (char volatile*)(var_ptr), (char)(desired), (char)(expected)        \
+        ) == (char)(expected)                                                   \
+    )
+#   define _sim_atomic_fence() MemoryBarrier()
+#else
+#   define _sim_atomic_load_ptr(var_ptr)  __atomic_load_n((var_ptr), __ATOMIC_ACQUIRE)
+#   define _sim_atomic_load_size(var_ptr) __atomic_load_n((var_ptr), __ATOMIC_ACQUIRE)
+#   define _sim_atomic_store_ptr(var_ptr, value) \
+        __atomic_store_n((var_ptr), (value), __ATOMIC_RELEASE)
+#   define _sim_atomic_store_size(var_ptr, value) \
+        __atomic_store_n((var_ptr), (value), __ATOMIC_RELEASE)
+#   define _sim_atomic_exchange_size(var_ptr, value) \
+        __atomic_exchange_n((var_ptr), (value), __ATOMIC_SEQ_CST)
+#   define _sim_atomic_cas_ptr(var_ptr, expected, desired) \
+        __sync_bool_compare_and_swap((var_ptr), (expected), (desired))
+#   define _sim_atomic_cas_size(var_ptr, expected, desired) \
+        __sync_bool_compare_and_swap((var_ptr), (expected), (desired))
+#   define _sim_atomic_load_uint8(var_ptr) __atomic_load_n((var_ptr), __ATOMIC_ACQUIRE)
+#   define _sim_atomic_store_uint8(var_ptr, value) \
+        __atomic_store_n((var_ptr), (uint8)(value), __ATOMIC_RELEASE)
+#   define _sim_atomic_cas_uint8(var_ptr, expected, desired) \
+        __sync_bool_compare_and_swap((var_ptr), (uint8)(expected), (uint8)(desired))
+#   define _sim_atomic_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+// == One-time initialization & thread-specific storage ===========================================
+
+#ifdef _WIN32
+    typedef INIT_ONCE _Sim_Once;
+#   define _SIM_ONCE_INIT INIT_ONCE_STATIC_INIT
+
+    // Calls the void(void) function passed as the parameter of InitOnceExecuteOnce.
+    static inline BOOL CALLBACK _sim_win32_once_proc(
+        PINIT_ONCE once_ptr,
+        PVOID      proc_ptr,
+        PVOID*     context_ptr
+    ) {
+        (void)once_ptr;
+        (void)context_ptr;
+        (*(void (*)(void))proc_ptr)();
+        return TRUE;
+    }
+#   define _sim_once(once_ptr, proc) \
+        ((void)InitOnceExecuteOnce((once_ptr), _sim_win32_once_proc, (PVOID)(proc), NULL))
+
+    // fiber-local storage is used since, unlike TlsAlloc, it calls destructors on thread exit
+    typedef DWORD _Sim_ThreadKey;
+#   define _SIM_THREAD_KEY_CALL WINAPI // calling convention of thread key destructors
+#   define _sim_thread_key_create(key_ptr, destructor_proc) \
+        ((*(key_ptr) = FlsAlloc(destructor_proc)) != FLS_OUT_OF_INDEXES)
+#   define _sim_thread_key_set(key, value_ptr) ((void)FlsSetValue((key), (value_ptr)))
+#else
+    typedef pthread_once_t _Sim_Once;
+#   define _SIM_ONCE_INIT PTHREAD_ONCE_INIT
+#   define _sim_once(once_ptr, proc) ((void)pthread_once((once_ptr), (proc)))
+
+    typedef pthread_key_t _Sim_ThreadKey;
+#   define _SIM_THREAD_KEY_CALL
+#   define _sim_thread_key_create(key_ptr, destructor_proc) \
+        (pthread_key_create((key_ptr), (destructor_proc)) == 0)
+#   define _sim_thread_key_set(key, value_ptr) ((void)pthread_setspecific((key), (value_ptr)))
+#endif
+
+// == Worker threads ==============================================================================
+
+#ifdef _WIN32
+    typedef HANDLE _Sim_Thread;
+    typedef DWORD _Sim_ThreadResult;
+#   define _SIM_THREAD_CALL WINAPI // calling convention of thread procedures
+#   define _sim_thread_create(thread_ptr, proc, arg_ptr) \
+        ((*(thread_ptr) = CreateThread(NULL, 0, (proc), (arg_ptr), 0, NULL)) != NULL)
+#   define _sim_thread_join(thread) \
+        ((void)WaitForSingleObject((thread), INFINITE), (void)CloseHandle(thread))
+#else
+    typedef pthread_t _Sim_Thread;
+    typedef void* _Sim_ThreadResult;
+#   define _SIM_THREAD_CALL
+#   define _sim_thread_create(thread_ptr, proc, arg_ptr) \
+        (pthread_create((thread_ptr), NULL, (proc), (arg_ptr)) == 0)
+#   define _sim_thread_join(thread) ((void)pthread_join((thread), NULL))
+#endif
+
 // == Thread-local return code ====================================================================
 
 #ifdef __cplusplus
@@ -0,0 +1,571 @@
+/**
+ * @file cache.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Source file/implementation for simsoft/cache.h
+ * @version 0.1
+ * @date 2020-02-20
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_CACHE_C_
+#define SIMSOFT_CACHE_C_
+
+#include <string.h>
+
+#include "simsoft/cache.h"
+#include "./_hash.h"
+
+// == BOUNDED CACHE ===============================================================================
+//  Entries are kept in one array & indexed by a hashmap from keys to their position in it.
+//  Removed & evicted entries are threaded onto a free list, so a full cache recycles its entries
+//  instead of allocating. LRU caches also thread their entries onto a list in order of use;
+//  CLOCK caches sweep a hand over the array instead, using each entry's reference bit.
+
+#define _SIM_CACHE_NONE        SIZE_MAX // no entry
+#define _SIM_CACHE_MIN_ENTRIES 16       // entries first allocated by caches weighing entries
+
+// Reference state of a cache entry
+#define _SIM_CACHE_FREE         ((uint8)0) // entry holds no pair
+#define _SIM_CACHE_UNREFERENCED ((uint8)1) // entry hasn't been used since the clock hand passed
+#define _SIM_CACHE_REFERENCED   ((uint8)2) // entry has been used since the clock hand passed
+
+// Header at the front of each cache entry; followed by the key, then the value
+typedef struct _Sim_CacheEntry {
+    size_t prev;       // more recently used entry (LRU only)
+    size_t next;       // less recently used entry (LRU only), or next removed entry
+    size_t charge;     // how much of the cache's capacity the entry takes up
+    Sim_HashType hash; // hash of the entry's key
+    uint8 state;       // reference state
+} _Sim_CacheEntry;
+
+// Retrieves a cache's entry at a given index.
+static inline _Sim_CacheEntry* _sim_cache_get_entry(
+    const Sim_Cache *const cache_ptr,
+    const size_t           index
+) {
+    return (_Sim_CacheEntry*)((uint8*)cache_ptr->data_ptr + (cache_ptr->_entry_size * index));
+}
+
+// Retrieves the key held by a cache entry.
+static inline uint8* _sim_cache_get_key(
+    _Sim_CacheEntry *const entry_ptr
+) {
+    return (uint8*)(entry_ptr + 1);
+}
+
+// Retrieves the value held by a cache entry.
+static inline uint8* _sim_cache_get_value(
+    const Sim_Cache *const cache_ptr,
+    _Sim_CacheEntry *const entry_ptr
+) {
+    return _sim_cache_get_key(entry_ptr) + cache_ptr->_index._key_properties.size;
+}
+
+// Finds the index of the entry holding a key in a cache.
+static inline bool _sim_cache_find(
+    const Sim_Cache *const cache_ptr,
+    const void *const      key_ptr,
+    const Sim_HashType     hash,
+    size_t *const          out_index_ptr
+) {
+    _Sim_HashTable table;
+    size_t slot;
+
+    if (!_sim_hash_find(&cache_ptr->_index, key_ptr, hash, &table, &slot, NULL))
+        return false;
+
+    memcpy(
+        out_index_ptr,
+        _sim_hash_get_item(&cache_ptr->_index, &table, slot) +
+            cache_ptr->_index._key_properties.size,
+        sizeof(size_t)
+    );
+    return true;
+}
+
+// Unlinks an entry from an LRU cache's list.
+static inline void _sim_cache_unlink(
+    Sim_Cache *const cache_ptr,
+    const size_t     index
+) {
+    _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+
+    if (entry_ptr->prev != _SIM_CACHE_NONE)
+        _sim_cache_get_entry(cache_ptr, entry_ptr->prev)->next = entry_ptr->next;
+    else
+        cache_ptr->_head = entry_ptr->next;
+
+    if (entry_ptr->next != _SIM_CACHE_NONE)
+        _sim_cache_get_entry(cache_ptr, entry_ptr->next)->prev = entry_ptr->prev;
+    else
+        cache_ptr->_tail = entry_ptr->prev;
+}
+
+// Links an entry onto the front of an LRU cache's list.
+static inline void _sim_cache_link_front(
+    Sim_Cache *const cache_ptr,
+    const size_t     index
+) {
+    _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+
+    entry_ptr->prev = _SIM_CACHE_NONE;
+    entry_ptr->next = cache_ptr->_head;
+
+    if (cache_ptr->_head != _SIM_CACHE_NONE)
+        _sim_cache_get_entry(cache_ptr, cache_ptr->_head)->prev = index;
+    else
+        cache_ptr->_tail = index;
+    cache_ptr->_head = index;
+}
+
+// Marks a cache entry as used.
+static inline void _sim_cache_touch(
+    Sim_Cache *const cache_ptr,
+    const size_t     index
+) {
+    if (cache_ptr->_policy == SIM_CACHE_CLOCK)
+        _sim_cache_get_entry(cache_ptr, index)->state = _SIM_CACHE_REFERENCED;
+    else if (cache_ptr->_head != index) {
+        _sim_cache_unlink(cache_ptr, index);
+        _sim_cache_link_front(cache_ptr, index);
+    }
+}
+
+// Removes a cache entry's key from the index & puts the entry on the free list.
+static void _sim_cache_release(
+    Sim_Cache *const cache_ptr,
+    const size_t     index
+) {
+    _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+    Sim_HashMap *const index_ptr = &cache_ptr->_index;
+
+    // the index is linearly probed, so removing from it shifts keys back & never resizes
+    _Sim_HashTable table;
+    size_t slot;
+    const bool found = _sim_hash_find(
+        index_ptr,
+        _sim_cache_get_key(entry_ptr),
+        entry_ptr->hash,
+        &table,
+        &slot,
+        NULL
+    );
+    if (found) {
+        _sim_hash_erase_linear(index_ptr, &table, slot);
+        index_ptr->count--;
+        _SIM_HASH_COUNT(index_ptr, removes, 1);
+    }
+
+    if (cache_ptr->_policy == SIM_CACHE_LRU)
+        _sim_cache_unlink(cache_ptr, index);
+
+    entry_ptr->state = _SIM_CACHE_FREE;
+    entry_ptr->next = cache_ptr->_free;
+    cache_ptr->_free = index;
+
+    cache_ptr->count--;
+    cache_ptr->charge -= entry_ptr->charge;
+}
+
+// Evicts an entry from a cache, other than the one at a given index.
+static void _sim_cache_evict(
+    Sim_Cache *const cache_ptr,
+    const size_t     keep_index
+) {
+    size_t index = cache_ptr->_tail;
+
+    if (cache_ptr->_policy == SIM_CACHE_CLOCK)
+        // clear reference bits until an entry that hasn't been used since the last sweep is found
+        for (;;) {
+            if (cache_ptr->_hand >= cache_ptr->_used)
+                cache_ptr->_hand = 0;
+            index = cache_ptr->_hand++;
+
+            _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+            if (index == keep_index || entry_ptr->state == _SIM_CACHE_FREE)
+                continue;
+            if (entry_ptr->state == _SIM_CACHE_UNREFERENCED)
+                break;
+            entry_ptr->state = _SIM_CACHE_UNREFERENCED;
+        }
+
+    _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+    if (cache_ptr->_evict_proc)
+        (*cache_ptr->_evict_proc)(
+            _sim_cache_get_key(entry_ptr),
+            _sim_cache_get_value(cache_ptr, entry_ptr),
+            cache_ptr->_evict_userdata
+        );
+
+    _sim_cache_release(cache_ptr, index);
+    cache_ptr->_evictions++;
+}
+
+// -- Bounded cache public API --------------------------------------------------------------------
+
+// sim_cache_construct(11): Constructs a new cache.
+void sim_cache_construct(
+    Sim_Cache *const      cache_ptr,
+    const size_t          key_size,
+    Sim_HashProc          key_hash_proc,
+    Sim_PredicateProc     key_predicate_proc,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const Sim_CachePolicy policy,
+    const size_t          capacity,
+    Sim_CacheChargeProc   charge_proc,
+    Sim_CacheEvictProc    evict_proc,
+    Sim_Variant           evict_userdata
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_predicate_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (!capacity)
+        THROW(SIM_RC_ERR_INVALARG);
+    if (policy != SIM_CACHE_LRU && policy != SIM_CACHE_CLOCK)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    // check for overflow
+    if (key_size > SIZE_MAX / 4 || value_size > SIZE_MAX / 4)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
+
+    const size_t entry_size = _sim_hash_get_slot_size(
+        sizeof(_Sim_CacheEntry) + key_size + value_size,
+        SIM_HASH_FLAT_STORAGE
+    );
+
+    // caches counting entries allocate every one of them up front; others grow while warming up
+    const size_t starting_entries = charge_proc ? _SIM_CACHE_MIN_ENTRIES : capacity;
+    if (starting_entries > SIZE_MAX / entry_size)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    // the index reserves room for a cache's every entry so that it never resizes once full
+    Sim_HashMap index;
+    _sim_hash_construct(
+        (_Sim_HashPtr){ .hashmap_ptr = &index },
+        key_size,
+        key_hash_proc,
+        key_predicate_proc,
+        sizeof(size_t),
+        allocator_ptr,
+        0,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_POWER_OF_TWO | SIM_HASH_CACHE_HASHES,
+        charge_proc ? 0 : capacity
+    );
+
+    void *const data_ptr = allocator_ptr->malloc(entry_size * starting_entries);
+    if (!data_ptr) {
+        _sim_hash_destroy((_Sim_HashPtr){ .hashmap_ptr = &index });
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    Sim_Cache cache = {
+        ._index = index,
+        ._allocator_ptr = allocator_ptr,
+
+        .count = 0,
+        .charge = 0,
+        .capacity = capacity,
+        .data_ptr = data_ptr,
+
+        ._allocated = starting_entries,
+        ._used = 0,
+        ._free = _SIM_CACHE_NONE,
+        ._head = _SIM_CACHE_NONE,
+        ._tail = _SIM_CACHE_NONE,
+        ._hand = 0,
+
+        ._policy = policy,
+        ._charge_proc = charge_proc,
+        ._evict_proc = evict_proc,
+        ._evict_userdata = evict_userdata,
+        ._entry_size = entry_size,
+
+        ._hits = 0,
+        ._misses = 0,
+        ._insertions = 0,
+        ._evictions = 0,
+
+        ._value_size = value_size
+    };
+    memcpy(cache_ptr, &cache, sizeof(Sim_Cache));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_destroy(1): Destroys a cache.
+void sim_cache_destroy(
+    Sim_Cache *const cache_ptr
+) {
+    // check for nullptr
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_hash_destroy((_Sim_HashPtr){ .hashmap_ptr = &cache_ptr->_index });
+    cache_ptr->_allocator_ptr->free(cache_ptr->data_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_clear(1): Clears a cache of all its entries, keeping its memory for reuse.
+void sim_cache_clear(
+    Sim_Cache *const cache_ptr
+) {
+    // check for nullptr
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_hash_clear((_Sim_HashPtr){ .hashmap_ptr = &cache_ptr->_index });
+
+    // every entry is unused again, so the free list can start over
+    cache_ptr->count = 0;
+    cache_ptr->charge = 0;
+    cache_ptr->_used = 0;
+    cache_ptr->_free = _SIM_CACHE_NONE;
+    cache_ptr->_head = _SIM_CACHE_NONE;
+    cache_ptr->_tail = _SIM_CACHE_NONE;
+    cache_ptr->_hand = 0;
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_contains_key(2): Checks if a key is contained in a cache without counting as a use of
+//                            it.
+bool sim_cache_contains_key(
+    Sim_Cache *const  cache_ptr,
+    const void *const key_ptr
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_hash_get_hash(&cache_ptr->_index, key_ptr);
+    size_t index;
+    if (_sim_cache_find(cache_ptr, key_ptr, hash, &index))
+        RETURN(SIM_RC_SUCCESS, true);
+    RETURN(SIM_RC_NOT_FOUND, false);
+}
+
+// sim_cache_get_ptr(2): Get pointer to value in a cache via a particular key, marking it as used.
+void* sim_cache_get_ptr(
+    Sim_Cache *const  cache_ptr,
+    const void *const key_ptr
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t index;
+    if (!_sim_cache_find(
+        cache_ptr,
+        key_ptr,
+        _sim_hash_get_hash(&cache_ptr->_index, key_ptr),
+        &index
+    )) {
+        cache_ptr->_misses++;
+        RETURN(SIM_RC_NOT_FOUND, NULL);
+    }
+
+    cache_ptr->_hits++;
+    _sim_cache_touch(cache_ptr, index);
+
+    RETURN(
+        SIM_RC_SUCCESS,
+        _sim_cache_get_value(cache_ptr, _sim_cache_get_entry(cache_ptr, index))
+    );
+}
+
+// sim_cache_get(3): Get a value from a cache via a particular key, marking it as used.
+void sim_cache_get(
+    Sim_Cache *const cache_ptr,
+    const void*      key_ptr,
+    void*            out_value_ptr
+) {
+    void* value_ptr;
+
+    if (!out_value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // use get_ptr to avoid duplicating the lookup
+    value_ptr = sim_cache_get_ptr(cache_ptr, key_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    memcpy(out_value_ptr, value_ptr, cache_ptr->_value_size);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_put(3): Puts a key-value pair into a cache or overwrites a pre-existing pair's value,
+//                   evicting entries until it fits.
+void sim_cache_put(
+    Sim_Cache *const cache_ptr,
+    const void*      key_ptr,
+    const void*      value_ptr
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t charge = cache_ptr->_charge_proc ?
+        (*cache_ptr->_charge_proc)(key_ptr, value_ptr) :
+        1
+    ;
+    if (charge > cache_ptr->capacity)
+        RETURN(SIM_RC_FAILURE,);
+
+    const Sim_HashType hash = _sim_hash_get_hash(&cache_ptr->_index, key_ptr);
+    size_t index;
+
+    if (_sim_cache_find(cache_ptr, key_ptr, hash, &index)) {
+        _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+
+        memcpy(_sim_cache_get_value(cache_ptr, entry_ptr), value_ptr, cache_ptr->_value_size);
+        cache_ptr->charge = cache_ptr->charge - entry_ptr->charge + charge;
+        entry_ptr->charge = charge;
+        _sim_cache_touch(cache_ptr, index);
+
+        // a heavier value may push other entries out
+        while (cache_ptr->charge > cache_ptr->capacity)
+            _sim_cache_evict(cache_ptr, index);
+
+        RETURN(SIM_RC_SUCCESS,);
+    }
+
+    while (cache_ptr->charge + charge > cache_ptr->capacity)
+        _sim_cache_evict(cache_ptr, _SIM_CACHE_NONE);
+
+    // reuse a removed entry if there is one; only caches still warming up run out of entries
+    index = (cache_ptr->_free != _SIM_CACHE_NONE) ? cache_ptr->_free : cache_ptr->_used;
+    if (index == cache_ptr->_allocated) {
+        if (cache_ptr->_allocated > SIZE_MAX / 2 / cache_ptr->_entry_size)
+            THROW(SIM_RC_ERR_OUTOFMEM);
+
+        void *const data_ptr = cache_ptr->_allocator_ptr->realloc(
+            cache_ptr->data_ptr,
+            cache_ptr->_entry_size * cache_ptr->_allocated * 2
+        );
+        if (!data_ptr)
+            THROW(SIM_RC_ERR_OUTOFMEM);
+
+        cache_ptr->data_ptr = data_ptr;
+        cache_ptr->_allocated *= 2;
+    }
+
+    // index the key before taking the entry; the index may have to grow while warming up
+    _sim_hash_insert_hashed(
+        (_Sim_HashPtr){ .hashmap_ptr = &cache_ptr->_index },
+        key_ptr,
+        hash,
+        &index
+    );
+    THROW(sim_get_return_code());
+
+    _Sim_CacheEntry *const entry_ptr = _sim_cache_get_entry(cache_ptr, index);
+    if (index == cache_ptr->_free)
+        cache_ptr->_free = entry_ptr->next;
+    else
+        cache_ptr->_used++;
+
+    entry_ptr->charge = charge;
+    entry_ptr->hash = hash;
+    entry_ptr->state = _SIM_CACHE_REFERENCED;
+    memcpy(_sim_cache_get_key(entry_ptr), key_ptr, cache_ptr->_index._key_properties.size);
+    memcpy(_sim_cache_get_value(cache_ptr, entry_ptr), value_ptr, cache_ptr->_value_size);
+
+    if (cache_ptr->_policy == SIM_CACHE_LRU)
+        _sim_cache_link_front(cache_ptr, index);
+
+    cache_ptr->count++;
+    cache_ptr->charge += charge;
+    cache_ptr->_insertions++;
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_remove(2): Removes a key-value pair from a cache via a key.
+void sim_cache_remove(
+    Sim_Cache *const  cache_ptr,
+    const void *const remove_key_ptr
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!remove_key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t index;
+    if (!_sim_cache_find(
+        cache_ptr,
+        remove_key_ptr,
+        _sim_hash_get_hash(&cache_ptr->_index, remove_key_ptr),
+        &index
+    ))
+        RETURN(SIM_RC_FAILURE,);
+
+    _sim_cache_release(cache_ptr, index);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_get_stats(2): Gathers a snapshot of a cache's size & hit, miss, & eviction counters.
+void sim_cache_get_stats(
+    Sim_Cache *const      cache_ptr,
+    Sim_CacheStats *const out_stats_ptr
+) {
+    // check for nullptrs
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_stats_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t lookups = cache_ptr->_hits + cache_ptr->_misses;
+
+    *out_stats_ptr = (Sim_CacheStats){
+        .count = cache_ptr->count,
+        .charge = cache_ptr->charge,
+        .capacity = cache_ptr->capacity,
+
+        .hits = cache_ptr->_hits,
+        .misses = cache_ptr->_misses,
+        .insertions = cache_ptr->_insertions,
+        .evictions = cache_ptr->_evictions,
+        .hit_rate = lookups ? (double)cache_ptr->_hits / (double)lookups : 0.0
+    };
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_cache_reset_stats(1): Resets a cache's hit, miss, insertion, & eviction counters to 0.
+void sim_cache_reset_stats(
+    Sim_Cache *const cache_ptr
+) {
+    // check for nullptr
+    if (!cache_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    cache_ptr->_hits = 0;
+    cache_ptr->_misses = 0;
+    cache_ptr->_insertions = 0;
+    cache_ptr->_evictions = 0;
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+#endif /* SIMSOFT_CACHE_C_ */
@@ -12,6 +12,8 @@
 #ifndef SIMSOFT_COMMON_C_
 #define SIMSOFT_COMMON_C_
 
+#include <string.h>
+
 #include "./_internal.h"
 
 // thread-local return code value
@@ -180,7 +182,7 @@ jmp_buf *const sim_cexcept_push(void) {
 
 // sim_cexcept_pop(0): Deletes the current jump buffer.
 Sim_ReturnCode sim_cexcept_pop(void) {
-    if (_sim_current_jump_buffer_node)
+    if (!_sim_current_jump_buffer_node)
         RETURN(SIM_RC_NO_JMPBUF, SIM_RC_NO_JMPBUF);
 
     // set current node to the previous one
@@ -211,7 +213,7 @@ void sim_cexcept_on_reset(Sim_CExceptOnResetProc on_reset_proc) {
     if (!on_reset_proc)
         THROW(SIM_RC_ERR_NULLPTR);
 
-    _Sim_CExceptOnResetNode* node_ptr = malloc(sizeof _sim_last_on_reset_node);
+    _Sim_CExceptOnResetNode* node_ptr = malloc(sizeof *_sim_last_on_reset_node);
     if (!node_ptr)
         THROW(SIM_RC_ERR_OUTOFMEM);
 
@@ -230,7 +232,7 @@ void sim_cexcept_on_throw(Sim_CExceptOnThrowProc on_throw_proc) {
     if (!on_throw_proc)
         THROW(SIM_RC_ERR_NULLPTR);
 
-    _Sim_CExceptOnThrowNode* node_ptr = malloc(sizeof _sim_last_on_throw_node);
+    _Sim_CExceptOnThrowNode* node_ptr = malloc(sizeof *_sim_last_on_throw_node);
     if (!node_ptr)
         THROW(SIM_RC_ERR_OUTOFMEM);
 
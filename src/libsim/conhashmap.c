@@ -0,0 +1,444 @@
+/**
+ * @file conhashmap.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Source file/implementation for simsoft/conhashmap.h
+ * @version 0.1
+ * @date 2020-02-05
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_CONHASHMAP_C_
+#define SIMSOFT_CONHASHMAP_C_
+
+#include <string.h>
+
+#include "simsoft/conhashmap.h"
+#include "./_hash.h"
+
+// == CONCURRENT HASHMAP ==========================================================================
+
+// Shard of a concurrent hashmap
+typedef struct _Sim_HashShard {
+    _Sim_RWLock lock;    // guards the shard's hashmap
+    Sim_HashMap hashmap; // items whose hash selects this shard
+} _Sim_HashShard;
+
+// Size of each shard; padded to a cache line so that neighbouring shards' locks don't share one
+#define _SIM_HASH_SHARD_SIZE ((sizeof(_Sim_HashShard) + 63) & ~(size_t)63)
+
+// Shard lock held by the current thread; released if an exception is thrown while it's held
+static THREAD_LOCAL _Sim_RWLock* _sim_conhashmap_held_lock_ptr = NULL;
+static THREAD_LOCAL bool _sim_conhashmap_held_exclusive = false;
+static THREAD_LOCAL bool _sim_conhashmap_on_throw_registered = false;
+
+// Releases the current thread's shard lock when an exception is thrown.
+static void _sim_conhashmap_on_throw(
+    Sim_ReturnCode error_code
+) {
+    (void)error_code;
+
+    if (!_sim_conhashmap_held_lock_ptr)
+        return;
+
+    if (_sim_conhashmap_held_exclusive)
+        _sim_rwlock_write_unlock(_sim_conhashmap_held_lock_ptr);
+    else
+        _sim_rwlock_read_unlock(_sim_conhashmap_held_lock_ptr);
+    _sim_conhashmap_held_lock_ptr = NULL;
+}
+
+// Retrieves a concurrent hashmap's shard at a given index.
+static inline _Sim_HashShard* _sim_conhashmap_get_shard(
+    const Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const size_t                       index
+) {
+    return (_Sim_HashShard*)((uint8*)conhashmap_ptr->_shards_ptr + (_SIM_HASH_SHARD_SIZE * index));
+}
+
+// Retrieves the shard of a concurrent hashmap a key with a given hash belongs to.
+static inline _Sim_HashShard* _sim_conhashmap_select_shard(
+    const Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const Sim_HashType                 key_hash
+) {
+    // shards are picked from re-mixed upper bits so that they're independent of bucket indices
+    return _sim_conhashmap_get_shard(
+        conhashmap_ptr,
+        (size_t)(_sim_hash_mix(key_hash) >> 32) & (conhashmap_ptr->_shard_count - 1)
+    );
+}
+
+// Locks a concurrent hashmap shard for reading or writing.
+static inline void _sim_conhashmap_lock(
+    _Sim_HashShard *const shard_ptr,
+    const bool            exclusive
+) {
+    if (!_sim_conhashmap_on_throw_registered) {
+        sim_cexcept_on_throw(_sim_conhashmap_on_throw);
+        _sim_conhashmap_on_throw_registered = true;
+    }
+
+    if (exclusive)
+        _sim_rwlock_write_lock(&shard_ptr->lock);
+    else
+        _sim_rwlock_read_lock(&shard_ptr->lock);
+
+    _sim_conhashmap_held_lock_ptr = &shard_ptr->lock;
+    _sim_conhashmap_held_exclusive = exclusive;
+}
+
+// Unlocks a concurrent hashmap shard.
+static inline void _sim_conhashmap_unlock(
+    _Sim_HashShard *const shard_ptr,
+    const bool            exclusive
+) {
+    _sim_conhashmap_held_lock_ptr = NULL;
+
+    if (exclusive)
+        _sim_rwlock_write_unlock(&shard_ptr->lock);
+    else
+        _sim_rwlock_read_unlock(&shard_ptr->lock);
+}
+
+// Destroys the first given amount of a concurrent hashmap's shards & frees them.
+static void _sim_conhashmap_destroy_shards(
+    const Sim_IAllocator *const allocator_ptr,
+    uint8 *const                shards_ptr,
+    const size_t                shard_count
+) {
+    for (size_t i = 0; i < shard_count; i++) {
+        _Sim_HashShard *const shard_ptr = (_Sim_HashShard*)(
+            shards_ptr + (_SIM_HASH_SHARD_SIZE * i)
+        );
+
+        _sim_hash_destroy((_Sim_HashPtr){ .hashmap_ptr = &shard_ptr->hashmap });
+        _sim_rwlock_destroy(&shard_ptr->lock);
+    }
+
+    allocator_ptr->free(shards_ptr);
+}
+
+// Constructs a concurrent hashmap shard's hashmap, catching any error it throws so that the
+//  shards before it can be freed. Returns the error code, or SIM_RC_SUCCESS.
+static Sim_ReturnCode _sim_conhashmap_construct_shard(
+    _Sim_HashShard *const       shard_ptr,
+    const size_t                key_size,
+    Sim_HashProc                key_hash_proc,
+    Sim_PredicateProc           key_predicate_proc,
+    const size_t                value_size,
+    const Sim_IAllocator *const allocator_ptr,
+    const size_t                initial_size,
+    const Sim_HashFlags         flags
+) {
+    switch (setjmp(*sim_cexcept_push())) {
+    case 0:
+        _sim_hash_construct(
+            (_Sim_HashPtr){ .hashmap_ptr = &shard_ptr->hashmap },
+            key_size,
+            key_hash_proc,
+            key_predicate_proc,
+            value_size,
+            allocator_ptr,
+            initial_size,
+            flags,
+            0
+        );
+        break;
+    }
+
+    return sim_cexcept_pop();
+}
+
+// sim_conhashmap_construct(9): Constructs a new concurrent hashmap.
+void sim_conhashmap_construct(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const size_t                 key_size,
+    Sim_HashProc                 key_hash_proc,
+    Sim_PredicateProc            key_predicate_proc,
+    const size_t                 value_size,
+    const Sim_IAllocator*        allocator_ptr,
+    const size_t                 initial_size,
+    const size_t                 shard_count,
+    const Sim_HashFlags          flags
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_predicate_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
+
+    // round shard count up to a power of 2
+    const size_t requested_shards = shard_count ? shard_count : SIM_CONHASHMAP_DEFAULT_SHARDS;
+    size_t shards = 1;
+    while (shards < requested_shards && shards <= (SIZE_MAX >> 1))
+        shards <<= 1;
+
+    if (shards > SIZE_MAX / _SIM_HASH_SHARD_SIZE)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    uint8 *const shards_ptr = allocator_ptr->malloc(_SIM_HASH_SHARD_SIZE * shards);
+    if (!shards_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    memset(shards_ptr, 0, _SIM_HASH_SHARD_SIZE * shards);
+
+    for (size_t i = 0; i < shards; i++) {
+        _Sim_HashShard *const shard_ptr = (_Sim_HashShard*)(
+            shards_ptr + (_SIM_HASH_SHARD_SIZE * i)
+        );
+
+        if (!_sim_rwlock_init(&shard_ptr->lock)) {
+            _sim_conhashmap_destroy_shards(allocator_ptr, shards_ptr, i);
+            RETURN(SIM_RC_FAILURE,);
+        }
+
+        const Sim_ReturnCode rc = _sim_conhashmap_construct_shard(
+            shard_ptr,
+            key_size,
+            key_hash_proc,
+            key_predicate_proc,
+            value_size,
+            allocator_ptr,
+            initial_size / shards,
+            flags
+        );
+        if (rc < 0) {
+            _sim_rwlock_destroy(&shard_ptr->lock);
+            _sim_conhashmap_destroy_shards(allocator_ptr, shards_ptr, i);
+            THROW(rc);
+        }
+    }
+
+    Sim_ConcurrentHashMap conhashmap = {
+        ._allocator_ptr = allocator_ptr,
+        ._shard_count = shards,
+        ._shards_ptr = shards_ptr
+    };
+    memcpy(conhashmap_ptr, &conhashmap, sizeof(Sim_ConcurrentHashMap));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_conhashmap_destroy(1): Destroys a concurrent hashmap.
+void sim_conhashmap_destroy(
+    Sim_ConcurrentHashMap *const conhashmap_ptr
+) {
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_conhashmap_destroy_shards(
+        conhashmap_ptr->_allocator_ptr,
+        conhashmap_ptr->_shards_ptr,
+        conhashmap_ptr->_shard_count
+    );
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_conhashmap_get_count(1): Counts the key-value pairs in a concurrent hashmap.
+size_t sim_conhashmap_get_count(
+    Sim_ConcurrentHashMap *const conhashmap_ptr
+) {
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t count = 0;
+    for (size_t i = 0; i < conhashmap_ptr->_shard_count; i++) {
+        _Sim_HashShard *const shard_ptr = _sim_conhashmap_get_shard(conhashmap_ptr, i);
+
+        _sim_conhashmap_lock(shard_ptr, false);
+        count += shard_ptr->hashmap.count;
+        _sim_conhashmap_unlock(shard_ptr, false);
+    }
+
+    RETURN(SIM_RC_SUCCESS, count);
+}
+
+// sim_conhashmap_clear(1): Clears a concurrent hashmap of all its contents.
+void sim_conhashmap_clear(
+    Sim_ConcurrentHashMap *const conhashmap_ptr
+) {
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    for (size_t i = 0; i < conhashmap_ptr->_shard_count; i++) {
+        _Sim_HashShard *const shard_ptr = _sim_conhashmap_get_shard(conhashmap_ptr, i);
+
+        _sim_conhashmap_lock(shard_ptr, true);
+        _sim_hash_clear((_Sim_HashPtr){ .hashmap_ptr = &shard_ptr->hashmap });
+        _sim_conhashmap_unlock(shard_ptr, true);
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_conhashmap_contains_key(2): Checks if a key is contained in a concurrent hashmap.
+bool sim_conhashmap_contains_key(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const void *const            key_ptr
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // every shard shares the same hash function & flags
+    const Sim_HashType hash = _sim_hash_get_hash(
+        &_sim_conhashmap_get_shard(conhashmap_ptr, 0)->hashmap,
+        key_ptr
+    );
+    _Sim_HashShard *const shard_ptr = _sim_conhashmap_select_shard(conhashmap_ptr, hash);
+
+    _Sim_HashTable table;
+    size_t index;
+
+    // lookups don't migrate incrementally resized buckets; only writers may modify a shard
+    _sim_conhashmap_lock(shard_ptr, false);
+    const bool found = _sim_hash_find(&shard_ptr->hashmap, key_ptr, hash, &table, &index, NULL);
+    _sim_conhashmap_unlock(shard_ptr, false);
+
+    if (found)
+        RETURN(SIM_RC_SUCCESS, true);
+    RETURN(SIM_RC_NOT_FOUND, false);
+}
+
+// sim_conhashmap_get(3): Get a copy of a value from a concurrent hashmap via a given key.
+void sim_conhashmap_get(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const void*                  key_ptr,
+    void*                        out_value_ptr
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_hash_get_hash(
+        &_sim_conhashmap_get_shard(conhashmap_ptr, 0)->hashmap,
+        key_ptr
+    );
+    _Sim_HashShard *const shard_ptr = _sim_conhashmap_select_shard(conhashmap_ptr, hash);
+    Sim_HashMap *const hashmap_ptr = &shard_ptr->hashmap;
+
+    _Sim_HashTable table;
+    size_t index;
+
+    _sim_conhashmap_lock(shard_ptr, false);
+    const bool found = _sim_hash_find(hashmap_ptr, key_ptr, hash, &table, &index, NULL);
+
+    // copy the value out while its shard can't be modified
+    if (found)
+        memcpy(
+            out_value_ptr,
+            _sim_hash_get_item(hashmap_ptr, &table, index) + hashmap_ptr->_key_properties.size,
+            hashmap_ptr->_value_size
+        );
+    _sim_conhashmap_unlock(shard_ptr, false);
+
+    if (found)
+        RETURN(SIM_RC_SUCCESS,);
+    RETURN(SIM_RC_NOT_FOUND,);
+}
+
+// sim_conhashmap_insert(3): Inserts a key-value pair into a concurrent hashmap or overwrites a
+//                           pre-existing pair if the key is already in the concurrent hashmap.
+void sim_conhashmap_insert(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const void*                  new_key_ptr,
+    const void*                  value_ptr
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!new_key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // hash outside of the lock
+    const Sim_HashType hash = _sim_hash_get_hash(
+        &_sim_conhashmap_get_shard(conhashmap_ptr, 0)->hashmap,
+        new_key_ptr
+    );
+    _Sim_HashShard *const shard_ptr = _sim_conhashmap_select_shard(conhashmap_ptr, hash);
+
+    _sim_conhashmap_lock(shard_ptr, true);
+    _sim_hash_migrate(&shard_ptr->hashmap, _SIM_HASH_MIGRATION_STEP);
+    _sim_hash_insert_hashed(
+        (_Sim_HashPtr){ .hashmap_ptr = &shard_ptr->hashmap },
+        new_key_ptr,
+        hash,
+        value_ptr
+    );
+    _sim_conhashmap_unlock(shard_ptr, true);
+}
+
+// sim_conhashmap_remove(2): Removes a key-value pair from a concurrent hashmap via a key.
+void sim_conhashmap_remove(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    const void *const            remove_key_ptr
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!remove_key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_hash_get_hash(
+        &_sim_conhashmap_get_shard(conhashmap_ptr, 0)->hashmap,
+        remove_key_ptr
+    );
+    _Sim_HashShard *const shard_ptr = _sim_conhashmap_select_shard(conhashmap_ptr, hash);
+
+    _sim_conhashmap_lock(shard_ptr, true);
+    _sim_hash_migrate(&shard_ptr->hashmap, _SIM_HASH_MIGRATION_STEP);
+    _sim_hash_remove_hashed(
+        (_Sim_HashPtr){ .hashmap_ptr = &shard_ptr->hashmap },
+        remove_key_ptr,
+        hash
+    );
+    _sim_conhashmap_unlock(shard_ptr, true);
+}
+
+// sim_conhashmap_foreach(3): Applies a given function to each key-value pair in a concurrent
+//                            hashmap.
+bool sim_conhashmap_foreach(
+    Sim_ConcurrentHashMap *const conhashmap_ptr,
+    Sim_MapForEachProc           foreach_proc,
+    Sim_Variant                  userdata
+) {
+    // check for nullptrs
+    if (!conhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!foreach_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t item_num = 0;
+
+    for (size_t i = 0; i < conhashmap_ptr->_shard_count; i++) {
+        _Sim_HashShard *const shard_ptr = _sim_conhashmap_get_shard(conhashmap_ptr, i);
+
+        _sim_conhashmap_lock(shard_ptr, false);
+        const bool completed = _sim_hash_foreach_tables(
+            &shard_ptr->hashmap,
+            true,
+            (_Sim_HashForEachProc){ .map_foreach_proc = foreach_proc },
+            userdata,
+            &item_num
+        );
+        _sim_conhashmap_unlock(shard_ptr, false);
+
+        if (!completed)
+            RETURN(SIM_RC_SUCCESS, false);
+    }
+
+    RETURN(SIM_RC_SUCCESS, true);
+}
+
+#endif /* SIMSOFT_CONHASHMAP_C_ */
@@ -192,39 +192,41 @@ size_t sim_debug_get_backtrace_info(
         RETURN(SIM_RC_SUCCESS, index);
 
 #   elif defined(__GLIBC__)
-        // get backtrace addresses
-        void* backtrace_ptr_array[backtrace_size];
+        // get backtrace addresses; skipped frames are retrieved too
+        void* backtrace_ptr_array[backtrace_size + skip_frames];
         int num_entries = backtrace(backtrace_ptr_array, (int)(backtrace_size + skip_frames));
         
         // get backtrace symbols
-        char* backtrace_symbol_array = backtrace_symbols(
+        char** backtrace_symbol_array = backtrace_symbols(
             backtrace_ptr_array,
             num_entries
         );
 
-        int i;
-        for (i = skip_frames; i < num_entries; i++) {
-            backtrace_array[i - skip_frames].function_address = backtrace_ptr_array[i];
-            backtrace_array[i - skip_frames].line_number = 0;
-            backtrace_array[i - skip_frames].file_name = NULL;
+        size_t index = 0;
+        for (size_t i = skip_frames; i < (size_t)num_entries; i++, index++) {
+            backtrace_array[index].function_address = backtrace_ptr_array[i];
+            backtrace_array[index].line_number = 0;
+            backtrace_array[index].file_name = NULL;
 
             // get function name
             if (backtrace_symbol_array && backtrace_symbol_array[i]) {
-                backtrace_array[i - skip_frames].function_name = strdup(backtrace_symbol_array[i]);
-                if (!backtrace_array[i - skip_frames].function_name) {
-                    for (int j = i; j >= 0; j--) {
+                backtrace_array[index].function_name = strdup(backtrace_symbol_array[i]);
+                if (!backtrace_array[index].function_name) {
+                    for (size_t j = 0; j < index; j++) {
                         free(backtrace_array[j].function_name);
+                        backtrace_array[j].function_name = NULL;
                         backtrace_array[j].function_address = NULL;
                     }
                     
+                    free(backtrace_symbol_array);
                     THROW(SIM_RC_ERR_OUTOFMEM);
                 }
             } else
-                backtrace_array[i - skip_frames].function_name = NULL;
+                backtrace_array[index].function_name = NULL;
         }
 
         free(backtrace_symbol_array);
-        RETURN(SIM_RC_SUCCESS, i);
+        RETURN(SIM_RC_SUCCESS, index);
 
 #   else
 #       warning("sim_get_backtrace_info(3) is unsupported")
@@ -81,8 +81,9 @@ const char* Exception::what() noexcept {
                 strlen(_message) + (_extended_message ? strlen(_extended_message) : 0) + 1 \
             );                                                                             \
             if (_cached_message) {                                                         \
-                strcat(_cached_message, _message);                                         \
-                strcat(_cached_message, _extended_message);                                \
+                strcpy(_cached_message, _message);                                         \
+                if (_extended_message)                                                     \
+                    strcat(_cached_message, _extended_message);                            \
             }                                                                              \
         }                                                                                  \
                                                                                            \
@@ -12,24 +12,263 @@
 #ifndef SIMSOFT_HASH_C_
 #define SIMSOFT_HASH_C_
 
+#include <string.h>
+
 #include "simsoft/hashmap.h"
 #include "simsoft/hashset.h"
+#include "simsoft/memmgmt.h"
+#include "simsoft/vector.h"
 #include "simsoft/util.h"
-#include "./_internal.h"
+#include "./_hash.h"
+
+// Robin Hood displacements are stored in a byte per slot; larger ones are recalculated from hashes
+#define _SIM_HASH_DISTANCE_SATURATED ((uint8)0xFF)
+#define _SIM_HASH_DISTANCE(distance) ((uint8)(                                             \
+    ((distance) < _SIM_HASH_DISTANCE_SATURATED) ? (distance) : _SIM_HASH_DISTANCE_SATURATED \
+))
+
+// == SIMD GROUP PROBING ==========================================================================
+
+// Amount of slots whose control bytes are matched at once when group probing
+#define _SIM_HASH_GROUP_SIZE 16
+
+#if defined(ARCH_X86) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define _SIM_HASH_GROUP_SSE2
+#   define _SIM_HASH_GROUP_MASK_SHIFT 0 // 1 bit per slot
+#elif defined(ARCH_ARM_NEON)
+#   define _SIM_HASH_GROUP_NEON
+#   define _SIM_HASH_GROUP_MASK_SHIFT 2 // 4 bits per slot
+#else
+#   define _SIM_HASH_GROUP_MASK_SHIFT 0 // 1 bit per slot
+#endif
+
+// Bitmask of the slots in a group whose control bytes matched
+typedef uint64 _Sim_HashGroupMask;
+
+// Matches every control byte in a group against a given control byte.
+static inline _Sim_HashGroupMask _sim_hash_group_match(
+    const uint8 *const group_ptr,
+    const uint8        ctrl
+) {
+#   if defined(_SIM_HASH_GROUP_SSE2)
+        const __m128i group = _mm_loadu_si128((const __m128i*)group_ptr);
+        return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)ctrl)));
+#   elif defined(_SIM_HASH_GROUP_NEON)
+        // NEON lacks movemask; narrow each matched byte down to a nibble instead
+        const uint8x16_t matches = vceqq_u8(vld1q_u8(group_ptr), vdupq_n_u8(ctrl));
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+#   else
+        _Sim_HashGroupMask mask = 0;
+        for (size_t i = 0; i < _SIM_HASH_GROUP_SIZE; i++)
+            mask |= (_Sim_HashGroupMask)(group_ptr[i] == ctrl) << i;
+        return mask;
+#   endif
+}
+
+// Matches every control byte in a group belonging to a slot that doesn't hold an item.
+static inline _Sim_HashGroupMask _sim_hash_group_match_free(
+    const uint8 *const group_ptr
+) {
+#   if defined(_SIM_HASH_GROUP_SSE2)
+        // empty & deleted control bytes are the only ones with their high bit set
+        return (uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group_ptr));
+#   elif defined(_SIM_HASH_GROUP_NEON)
+        const uint8x16_t frees = vtstq_u8(vld1q_u8(group_ptr), vdupq_n_u8(0x80));
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(frees), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+#   else
+        _Sim_HashGroupMask mask = 0;
+        for (size_t i = 0; i < _SIM_HASH_GROUP_SIZE; i++)
+            mask |= (_Sim_HashGroupMask)(group_ptr[i] >> 7) << i;
+        return mask;
+#   endif
+}
+
+// Retrieves the index within a group of the lowest slot in a non-zero group mask.
+static inline size_t _sim_hash_group_mask_first(
+    const _Sim_HashGroupMask mask
+) {
+#   if defined(_MSC_VER)
+        unsigned long index; // MSVC builds use at most 1 bit for each of the 16 slots
+        _BitScanForward(&index, (unsigned long)mask);
+        return index >> _SIM_HASH_GROUP_MASK_SHIFT;
+#   else
+        return (size_t)__builtin_ctzll(mask) >> _SIM_HASH_GROUP_MASK_SHIFT;
+#   endif
+}
+
+// Amount of keys hashed & prefetched ahead of being probed by batched operations
+#define _SIM_HASH_BATCH_SIZE 16
 
-// Hashmap/hashset aliasing to allow for identical internal implementation
-typedef union _Sim_HashPtr {
-    Sim_HashMap *const hashmap_ptr;
-    Sim_HashSet *const hashset_ptr;
-} _Sim_HashPtr;
+// Fewest items worth handing to each thread of a parallel rehash or bulk insertion
+#define _SIM_HASH_PARALLEL_MIN_SHARE 8192
 
-typedef union _Sim_HashForEachProc {
-    Sim_ConstForEachProc set_foreach_proc;
-    Sim_MapForEachProc   map_foreach_proc;
-} _Sim_HashForEachProc;
+// Most threads a parallel rehash or bulk insertion is split between
+#define _SIM_HASH_MAX_THREADS 64
+
+// Hints that memory is about to be read
+#if defined(__GNUC__) || defined(__clang__)
+#   define _SIM_HASH_PREFETCH(ptr) __builtin_prefetch(ptr)
+#elif defined(_MSC_VER) && defined(ARCH_X86)
+#   define _SIM_HASH_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#   define _SIM_HASH_PREFETCH(ptr) ((void)(ptr))
+#endif
 
 // == INTERNAL IMPLEMENTATION FUNCTIONS ===========================================================
 
+// Calculates the size of each slot in a hash table.
+size_t _sim_hash_get_slot_size(
+    const size_t        item_size,
+    const Sim_HashFlags flags
+) {
+    // nodes are stored as pointers
+    if (!(flags & SIM_HASH_FLAT_STORAGE))
+        return sizeof(void*);
+
+    // align inline items to the largest power of 2 (up to 8) that fits in them
+    size_t alignment = 1;
+    while (alignment < sizeof(uint64) && alignment * 2 <= item_size)
+        alignment *= 2;
+
+    return (item_size + alignment - 1) & ~(alignment - 1);
+}
+
+// Calculates the amount of slots a hash table should allocate to hold a given size.
+static size_t _sim_hash_get_capacity(
+    const size_t        size,
+    const Sim_HashFlags flags
+) {
+    if (flags & (SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO)) {
+        // group probing uses a power of 2 amount of groups
+        size_t capacity = (flags & SIM_HASH_GROUP_PROBING) ?
+            _SIM_HASH_GROUP_SIZE :
+            1
+        ;
+        while (capacity < size && capacity <= (SIZE_MAX >> 1))
+            capacity <<= 1;
+        return capacity;
+    }
+
+    return _sim_next_prime(size);
+}
+
+// Calculates the offsets of the hash & control byte arrays within a hash table's allocation.
+//  Returns the size of the entire allocation. Robin Hood displacements follow the control bytes.
+static inline size_t _sim_hash_get_layout(
+    const Sim_HashMap *const hashmap_ptr,
+    const size_t             allocated,
+    size_t *const            out_hashes_offset_ptr,
+    size_t *const            out_control_offset_ptr
+) {
+    const size_t slots_size = hashmap_ptr->_slot_size * allocated;
+
+    // slots, then hashes (aligned), then control bytes
+    if (hashmap_ptr->_flags & SIM_HASH_CACHE_HASHES) {
+        *out_hashes_offset_ptr =
+            (slots_size + sizeof(Sim_HashType) - 1) & ~(sizeof(Sim_HashType) - 1);
+        *out_control_offset_ptr = *out_hashes_offset_ptr + (sizeof(Sim_HashType) * allocated);
+    } else
+        *out_hashes_offset_ptr = *out_control_offset_ptr = slots_size;
+
+    return *out_control_offset_ptr + (
+        (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD) ?
+            allocated * 2 :
+            allocated
+    );
+}
+
+// Creates a view of bucket arrays sharing a given allocation.
+static inline _Sim_HashTable _sim_hash_make_table(
+    const Sim_HashMap *const hashmap_ptr,
+    uint8 *const             slots_ptr,
+    const size_t             allocated
+) {
+    size_t hashes_offset, control_offset;
+    _sim_hash_get_layout(hashmap_ptr, allocated, &hashes_offset, &control_offset);
+
+    return (_Sim_HashTable){
+        .slots_ptr = slots_ptr,
+        .hashes_ptr = (hashmap_ptr->_flags & SIM_HASH_CACHE_HASHES) ?
+            (Sim_HashType*)(slots_ptr + hashes_offset) :
+            NULL
+        ,
+        .control_ptr = slots_ptr + control_offset,
+        .distances_ptr = (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD) ?
+            slots_ptr + control_offset + allocated :
+            NULL
+        ,
+        .allocated = allocated
+    };
+}
+
+// Retrieves a view of the bucket arrays a hash table is currently using.
+static inline _Sim_HashTable _sim_hash_get_table(
+    const Sim_HashMap *const hashmap_ptr
+) {
+    return _sim_hash_make_table(hashmap_ptr, hashmap_ptr->data_ptr, hashmap_ptr->_allocated);
+}
+
+// Allocates bucket arrays for a hash table with every slot marked as empty.
+static bool _sim_hash_alloc_table(
+    const Sim_HashMap *const hashmap_ptr,
+    const size_t             allocated,
+    _Sim_HashTable *const    out_table_ptr
+) {
+    // check for overflow
+    if (allocated > (SIZE_MAX / 2) / (hashmap_ptr->_slot_size + sizeof(Sim_HashType) + 2))
+        return false;
+
+    size_t hashes_offset, control_offset;
+    const size_t total_size = _sim_hash_get_layout(
+        hashmap_ptr,
+        allocated,
+        &hashes_offset,
+        &control_offset
+    );
+
+    // slots, hashes, & control bytes share a single allocation
+    uint8* slots_ptr = hashmap_ptr->_allocator_ptr->malloc(total_size);
+    if (!slots_ptr)
+        return false;
+
+    *out_table_ptr = _sim_hash_make_table(hashmap_ptr, slots_ptr, allocated);
+
+    memset(out_table_ptr->control_ptr, _SIM_HASH_CTRL_EMPTY, allocated);
+    return true;
+}
+
+// Retrieves how far the item held by a slot in a Robin Hood hash table is from its home slot.
+static inline size_t _sim_hash_get_distance(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    const uint8 distance = table_ptr->distances_ptr[index];
+    if (distance != _SIM_HASH_DISTANCE_SATURATED)
+        return distance;
+
+    const Sim_HashType hash = table_ptr->hashes_ptr ?
+        table_ptr->hashes_ptr[index] :
+        _sim_hash_get_hash(hashmap_ptr, _sim_hash_get_item(hashmap_ptr, table_ptr, index))
+    ;
+    return (index - (size_t)(hash >> 7)) & (table_ptr->allocated - 1);
+}
+
+// Records how far an item just placed in a slot is from its home slot if Robin Hood hashing.
+static inline void _sim_hash_set_distance(
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index,
+    const Sim_HashType          key_hash
+) {
+    if (table_ptr->distances_ptr)
+        table_ptr->distances_ptr[index] = _SIM_HASH_DISTANCE(
+            (index - (size_t)(key_hash >> 7)) & (table_ptr->allocated - 1)
+        );
+}
+
 // Creates a new hash table node.
 static void* _sim_hash_create_node(
     const void*                 key_ptr,
@@ -44,48 +283,516 @@ static void* _sim_hash_create_node(
 
     // copy key to front of node
     memcpy(node_ptr, key_ptr, key_size);
-    // copy value to back of node
-    memcpy(node_ptr + key_size, val_ptr, val_size);
+    // copy value to back of node; hashset nodes have none
+    if (val_size)
+        memcpy(node_ptr + key_size, val_ptr, val_size);
 
     return node_ptr;
 }
 
+// Checks if a hash table node was carved out of a bulk construction's block.
+static inline bool _sim_hash_is_block_node(
+    const Sim_HashMap *const hashmap_ptr,
+    const void *const        node_ptr
+) {
+    return hashmap_ptr->_node_block_ptr &&
+        (uintptr_t)node_ptr - (uintptr_t)hashmap_ptr->_node_block_ptr <
+            hashmap_ptr->_node_block_size
+    ;
+}
+
 // Destroys a hash table node.
-inline void _sim_hash_destroy_node(
-    void*                       node_ptr,
-    const Sim_IAllocator *const allocator_ptr
+static inline void _sim_hash_destroy_node(
+    const Sim_HashMap *const hashmap_ptr,
+    void*                    node_ptr
+) {
+    // nodes carved out of a bulk construction's block are freed along with the block
+    if (_sim_hash_is_block_node(hashmap_ptr, node_ptr))
+        return;
+
+    hashmap_ptr->_allocator_ptr->free(node_ptr);
+}
+
+// Fills an empty slot with a new item.
+static bool _sim_hash_fill_slot(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index,
+    const Sim_HashType          key_hash,
+    const void*                 key_ptr,
+    const void*                 value_ptr
+) {
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    uint8 *const slot_ptr = table_ptr->slots_ptr + (hashmap_ptr->_slot_size * index);
+
+    if (hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE) {
+        memcpy(slot_ptr, key_ptr, key_size);
+        if (value_ptr)
+            memcpy(slot_ptr + key_size, value_ptr, hashmap_ptr->_value_size);
+    } else {
+        void* node_ptr = _sim_hash_create_node(
+            key_ptr,
+            key_size,
+            value_ptr,
+            value_ptr ?
+                hashmap_ptr->_value_size :
+                0
+            ,
+            hashmap_ptr->_allocator_ptr
+        );
+        if (!node_ptr)
+            return false;
+
+        *(void**)slot_ptr = node_ptr;
+    }
+
+    if (table_ptr->hashes_ptr)
+        table_ptr->hashes_ptr[index] = key_hash;
+    table_ptr->control_ptr[index] = _SIM_HASH_FINGERPRINT(key_hash);
+    _sim_hash_set_distance(table_ptr, index, key_hash);
+    return true;
+}
+
+// Checks if the item held by a slot with a matching fingerprint has a given key.
+static inline bool _sim_hash_slot_matches(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc
+) {
+    // compare cached hashes before keys
+    if (table_ptr->hashes_ptr && table_ptr->hashes_ptr[index] != key_hash)
+        return false;
+
+    return (*predicate_proc)(key_ptr, _sim_hash_get_item(hashmap_ptr, table_ptr, index));
+}
+
+// Searches a hash table for a key one slot at a time via double hashing.
+static bool _sim_hash_probe_slots(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr,
+    size_t *const               out_probes_ptr
+) {
+    Sim_HashProc hash_proc = hashmap_ptr->_key_properties.hash_proc;
+    const uint8 *const control_ptr = table_ptr->control_ptr;
+    const uint8 fingerprint = _SIM_HASH_FINGERPRINT(key_hash);
+    const size_t allocated = table_ptr->allocated;
+
+    size_t attempt = 0;
+    size_t hash = key_hash % allocated;
+    size_t hash2 = 0;
+    size_t index = hash;
+    size_t free_index = (size_t)-1;
+
+    // probe sequences must be derived from the cached hash alone if caching hashes;
+    //  every step size visits every slot in a prime sized table
+    const size_t step = table_ptr->hashes_ptr ?
+        1 + (size_t)(_sim_hash_mix(key_hash) % (allocated - 1)) :
+        0
+    ;
+
+    while (control_ptr[index] != _SIM_HASH_CTRL_EMPTY) {
+        // remember the first tombstone; the key can be inserted there if it isn't found
+        if (control_ptr[index] == _SIM_HASH_CTRL_DELETED) {
+            if (!predicate_proc) {
+                *out_index_ptr = index;
+                if (out_probes_ptr)
+                    *out_probes_ptr = attempt + 1;
+                return false;
+            }
+            if (free_index == (size_t)-1)
+                free_index = index;
+        }
+
+        // only compare keys whose fingerprints match
+        else if (
+            predicate_proc &&
+            control_ptr[index] == fingerprint &&
+            _sim_hash_slot_matches(
+                hashmap_ptr,
+                table_ptr,
+                index,
+                key_ptr,
+                key_hash,
+                predicate_proc
+            )
+        ) {
+            *out_index_ptr = index;
+            if (out_probes_ptr)
+                *out_probes_ptr = attempt + 1;
+            return true;
+        }
+
+        // give up once as many slots as there are in the table have been probed
+        if (++attempt == allocated) {
+            *out_index_ptr = free_index;
+            if (out_probes_ptr)
+                *out_probes_ptr = attempt;
+            return false;
+        }
+
+        if (step)
+            hash = index + step;
+        else if (hash_proc)
+            hash = (*hash_proc)(key_ptr, attempt);
+        else {
+            if (attempt == 1)
+                hash2 = _sim_hash_get_default_hash(hashmap_ptr, key_ptr, true) % allocated;
+            hash += hash2 + attempt;
+        }
+        index = hash % allocated;
+    }
+
+    *out_index_ptr = (free_index != (size_t)-1) ?
+        free_index :
+        index
+    ;
+    if (out_probes_ptr)
+        *out_probes_ptr = attempt + 1;
+    return false;
+}
+
+// Searches a power of 2 sized hash table for a key one slot at a time via linear probing.
+static bool _sim_hash_probe_linear(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr,
+    size_t *const               out_probes_ptr
+) {
+    const uint8 *const control_ptr = table_ptr->control_ptr;
+    const uint8 fingerprint = _SIM_HASH_FINGERPRINT(key_hash);
+    const size_t mask = table_ptr->allocated - 1;
+
+    // fingerprint comes from the low bits; index from the ones above it
+    size_t index = (size_t)(key_hash >> 7) & mask;
+    size_t free_index = (size_t)-1;
+
+    for (size_t attempt = 0; attempt <= mask; attempt++) {
+        const uint8 ctrl = control_ptr[index];
+
+        if (ctrl == _SIM_HASH_CTRL_EMPTY) {
+            *out_index_ptr = (free_index != (size_t)-1) ?
+                free_index :
+                index
+            ;
+            if (out_probes_ptr)
+                *out_probes_ptr = attempt + 1;
+            return false;
+        }
+
+        // remember the first tombstone; the key can be inserted there if it isn't found
+        if (ctrl == _SIM_HASH_CTRL_DELETED) {
+            if (!predicate_proc) {
+                *out_index_ptr = index;
+                if (out_probes_ptr)
+                    *out_probes_ptr = attempt + 1;
+                return false;
+            }
+            if (free_index == (size_t)-1)
+                free_index = index;
+        }
+
+        // only compare keys whose fingerprints match
+        else if (
+            predicate_proc &&
+            ctrl == fingerprint &&
+            _sim_hash_slot_matches(
+                hashmap_ptr,
+                table_ptr,
+                index,
+                key_ptr,
+                key_hash,
+                predicate_proc
+            )
+        ) {
+            *out_index_ptr = index;
+            if (out_probes_ptr)
+                *out_probes_ptr = attempt + 1;
+            return true;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    *out_index_ptr = free_index;
+    if (out_probes_ptr)
+        *out_probes_ptr = mask + 1;
+    return false;
+}
+
+// Searches a hash table for a key via linear probing with Robin Hood hashing.
+//  Gives up at the first item closer to its home slot than the key would be, since the key would
+//  have taken that item's place when inserted. If the key isn't found, *out_index_ptr is set to
+//  the slot it belongs in, which may hold an item that has to be shifted along first.
+static bool _sim_hash_probe_robin_hood(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr,
+    size_t *const               out_probes_ptr
+) {
+    const uint8 *const control_ptr = table_ptr->control_ptr;
+    const uint8 fingerprint = _SIM_HASH_FINGERPRINT(key_hash);
+    const size_t mask = table_ptr->allocated - 1;
+
+    size_t index = (size_t)(key_hash >> 7) & mask;
+
+    for (size_t distance = 0; distance <= mask; distance++) {
+        const uint8 ctrl = control_ptr[index];
+
+        if (ctrl == _SIM_HASH_CTRL_EMPTY) {
+            *out_index_ptr = index;
+            if (out_probes_ptr)
+                *out_probes_ptr = distance + 1;
+            return false;
+        }
+
+        // tombstones are only left in old buckets during an incremental resize; their
+        //  distances are stale, so they're skipped over
+        if (ctrl == _SIM_HASH_CTRL_DELETED) {
+            if (!predicate_proc) {
+                *out_index_ptr = index;
+                if (out_probes_ptr)
+                    *out_probes_ptr = distance + 1;
+                return false;
+            }
+        } else {
+            // only compare keys whose fingerprints match
+            if (
+                predicate_proc &&
+                ctrl == fingerprint &&
+                _sim_hash_slot_matches(
+                    hashmap_ptr,
+                    table_ptr,
+                    index,
+                    key_ptr,
+                    key_hash,
+                    predicate_proc
+                )
+            ) {
+                *out_index_ptr = index;
+                if (out_probes_ptr)
+                    *out_probes_ptr = distance + 1;
+                return true;
+            }
+
+            if (_sim_hash_get_distance(hashmap_ptr, table_ptr, index) < distance) {
+                *out_index_ptr = index;
+                if (out_probes_ptr)
+                    *out_probes_ptr = distance + 1;
+                return false;
+            }
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    *out_index_ptr = (size_t)-1;
+    if (out_probes_ptr)
+        *out_probes_ptr = mask + 1;
+    return false;
+}
+
+// Searches a hash table for a key a group of slots at a time.
+//  Groups are visited in triangular order, which covers every group in a power of 2 sized table.
+static bool _sim_hash_probe_groups(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr,
+    size_t *const               out_probes_ptr
+) {
+    const uint8 *const control_ptr = table_ptr->control_ptr;
+    const uint8 fingerprint = _SIM_HASH_FINGERPRINT(key_hash);
+    const size_t group_count = table_ptr->allocated / _SIM_HASH_GROUP_SIZE;
+
+    size_t group = (size_t)(key_hash >> 7) & (group_count - 1);
+    size_t free_index = (size_t)-1;
+
+    for (size_t stride = 1; stride <= group_count; stride++) {
+        const size_t group_index = group * _SIM_HASH_GROUP_SIZE;
+        const uint8 *const group_ptr = control_ptr + group_index;
+
+        // without keys to compare, any slot not holding an item will do
+        if (!predicate_proc) {
+            const _Sim_HashGroupMask frees = _sim_hash_group_match_free(group_ptr);
+            if (frees) {
+                *out_index_ptr = group_index + _sim_hash_group_mask_first(frees);
+                if (out_probes_ptr)
+                    *out_probes_ptr = stride;
+                return false;
+            }
+        }
+
+        // only compare keys whose fingerprints match
+        else {
+            _Sim_HashGroupMask matches = _sim_hash_group_match(group_ptr, fingerprint);
+            while (matches) {
+                const size_t index = group_index + _sim_hash_group_mask_first(matches);
+
+                if (_sim_hash_slot_matches(
+                    hashmap_ptr,
+                    table_ptr,
+                    index,
+                    key_ptr,
+                    key_hash,
+                    predicate_proc
+                )) {
+                    *out_index_ptr = index;
+                    if (out_probes_ptr)
+                        *out_probes_ptr = stride;
+                    return true;
+                }
+                matches &= matches - 1;
+            }
+        }
+
+        // the key can't be further along if this group has an empty slot
+        const _Sim_HashGroupMask empties = _sim_hash_group_match(group_ptr, _SIM_HASH_CTRL_EMPTY);
+        if (empties) {
+            *out_index_ptr = (free_index != (size_t)-1) ?
+                free_index :
+                group_index + _sim_hash_group_mask_first(empties)
+            ;
+            if (out_probes_ptr)
+                *out_probes_ptr = stride;
+            return false;
+        }
+
+        // remember the first tombstone; the key can be inserted there if it isn't found
+        if (free_index == (size_t)-1) {
+            const _Sim_HashGroupMask tombstones =
+                _sim_hash_group_match(group_ptr, _SIM_HASH_CTRL_DELETED);
+            if (tombstones)
+                free_index = group_index + _sim_hash_group_mask_first(tombstones);
+        }
+
+        group = (group + stride) & (group_count - 1);
+    }
+
+    *out_index_ptr = free_index;
+    if (out_probes_ptr)
+        *out_probes_ptr = group_count;
+    return false;
+}
+
+// Searches a hash table for a key.
+//  Returns true if the key was found, setting *out_index_ptr to the slot holding it; otherwise
+//  returns false, setting *out_index_ptr to the first tombstone or empty slot in the key's probe
+//  sequence or (size_t)-1 if there are none. Keys are not compared if predicate_proc is NULL, in
+//  which case the first tombstone or empty slot is returned without searching any further. Robin
+//  Hood hashing may return a slot holding an item instead; see _sim_hash_probe_robin_hood. If
+//  out_probes_ptr isn't NULL, it's set to how many slots (or groups) were probed.
+static inline bool _sim_hash_probe(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr,
+    size_t *const               out_probes_ptr
 ) {
-    allocator_ptr->free(node_ptr);
+    if (hashmap_ptr->_flags & SIM_HASH_GROUP_PROBING)
+        return _sim_hash_probe_groups(
+            hashmap_ptr,
+            table_ptr,
+            key_ptr,
+            key_hash,
+            predicate_proc,
+            out_index_ptr,
+            out_probes_ptr
+        );
+    if (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD)
+        return _sim_hash_probe_robin_hood(
+            hashmap_ptr,
+            table_ptr,
+            key_ptr,
+            key_hash,
+            predicate_proc,
+            out_index_ptr,
+            out_probes_ptr
+        );
+    
+    return (hashmap_ptr->_flags & SIM_HASH_POWER_OF_TWO) ?
+        _sim_hash_probe_linear(
+            hashmap_ptr,
+            table_ptr,
+            key_ptr,
+            key_hash,
+            predicate_proc,
+            out_index_ptr,
+            out_probes_ptr
+        ) :
+        _sim_hash_probe_slots(
+            hashmap_ptr,
+            table_ptr,
+            key_ptr,
+            key_hash,
+            predicate_proc,
+            out_index_ptr,
+            out_probes_ptr
+        )
+    ;
 }
 
-// Initializes a hash table (map or set).
-static void _sim_hash_construct(
+// Initializes a hash table (map or set) with room for a given amount of items without resizing.
+void _sim_hash_construct(
     _Sim_HashPtr          hash_ptr,
     const size_t          key_size,
     Sim_HashProc          key_hash_proc,
     Sim_PredicateProc     key_predicate_proc,
     const size_t          value_size,
     const Sim_IAllocator* allocator_ptr,
-    const size_t          initial_size
+    const size_t          initial_size,
+    const Sim_HashFlags   requested_flags,
+    const size_t          reserved_count
 ) {
     // check for nullptr
     if (!hash_ptr.hashmap_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
     if (!key_predicate_proc)
         THROW(SIM_RC_ERR_NULLPTR);
+
+    // check for overflow
+    if (reserved_count > SIZE_MAX / 2)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    // Robin Hood hashing probes linearly in a power of 2 sized table unless group probing
+    const Sim_HashFlags flags = (requested_flags & SIM_HASH_GROUP_PROBING) ?
+        (Sim_HashFlags)(requested_flags & ~SIM_HASH_ROBIN_HOOD) :
+        (requested_flags & SIM_HASH_ROBIN_HOOD) ?
+            (Sim_HashFlags)(requested_flags | SIM_HASH_POWER_OF_TWO) :
+            requested_flags
+    ;
         
     allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
 
-    // allocate buckets
-    size_t starting_size = _sim_next_prime(initial_size);
-    if (starting_size < SIM_HASH_DEFAULT_SIZE)
-        starting_size = SIM_HASH_DEFAULT_SIZE;
-    void** data_ptr = allocator_ptr->falloc(
-        (sizeof *data_ptr) * starting_size,
-        0
+    // keep the reserved items under the 70% load at which the hash table grows
+    const size_t reserved_size = reserved_count + (reserved_count / 7) * 3 + 3;
+    const size_t minimum_size = (initial_size < SIM_HASH_DEFAULT_SIZE) ?
+        SIM_HASH_DEFAULT_SIZE :
+        initial_size
+    ;
+    const size_t starting_size = _sim_hash_get_capacity(
+        (reserved_count && reserved_size > minimum_size) ?
+            reserved_size :
+            minimum_size
+        ,
+        flags
     );
-    if (!data_ptr)
-        THROW(SIM_RC_ERR_OUTOFMEM);
         
     Sim_HashMap hashmap = {
         ._key_properties = {
@@ -99,11 +806,30 @@ static void _sim_hash_construct(
         ._allocated = starting_size,
 
         .count = 0,
-        .data_ptr = (void*)data_ptr,
+        .data_ptr = NULL,
+
+        ._flags = flags,
+        ._slot_size = _sim_hash_get_slot_size(key_size + value_size, flags),
+        ._tombstones = 0,
+        ._old_data_ptr = NULL,
+        ._old_allocated = 0,
+        ._migrated = 0,
+        ._resize_count = 0,
+        ._node_block_ptr = NULL,
+        ._node_block_size = 0,
+        ._mapped_ptr = NULL,
+        ._mapped_size = 0,
+        ._thread_count = 1,
 
         ._value_size = value_size
     };
 
+    // allocate buckets
+    _Sim_HashTable table;
+    if (!_sim_hash_alloc_table(&hashmap, starting_size, &table))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    hashmap.data_ptr = table.slots_ptr;
+
     // copy to hash table pointer
     memcpy(
         hash_ptr.hashmap_ptr,
@@ -116,34 +842,433 @@ static void _sim_hash_construct(
     RETURN(SIM_RC_SUCCESS,);
 }
 
+// Destroys the nodes held by a hash table's buckets & marks every slot as empty.
+static void _sim_hash_clear_table(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr
+) {
+    // destroy hash table nodes
+    if (!(hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE))
+        for (size_t i = 0; i < table_ptr->allocated; i++)
+            if (_SIM_HASH_CTRL_IS_FULL(table_ptr->control_ptr[i]))
+                _sim_hash_destroy_node(
+                    hashmap_ptr,
+                    _sim_hash_get_item(hashmap_ptr, table_ptr, i)
+                );
+    
+    // mark every slot as empty
+    memset(table_ptr->control_ptr, _SIM_HASH_CTRL_EMPTY, table_ptr->allocated);
+}
+
+// Makes room at a slot in a Robin Hood hash table by shifting the item held there & the rest of
+//  its cluster one slot further from home.
+static void _sim_hash_shift_robin_hood(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    uint8 *const control_ptr = table_ptr->control_ptr;
+    uint8 *const distances_ptr = table_ptr->distances_ptr;
+    const size_t mask = table_ptr->allocated - 1;
+
+    // the load factor guarantees that the cluster ends somewhere
+    size_t end = index;
+    while (_SIM_HASH_CTRL_IS_FULL(control_ptr[end]))
+        end = (end + 1) & mask;
+
+    for (size_t i = end; i != index; i = (i - 1) & mask) {
+        const size_t prev = (i - 1) & mask;
+
+        memcpy(
+            table_ptr->slots_ptr + (slot_size * i),
+            table_ptr->slots_ptr + (slot_size * prev),
+            slot_size
+        );
+        if (table_ptr->hashes_ptr)
+            table_ptr->hashes_ptr[i] = table_ptr->hashes_ptr[prev];
+        control_ptr[i] = control_ptr[prev];
+        distances_ptr[i] = _SIM_HASH_DISTANCE((size_t)distances_ptr[prev] + 1);
+    }
+}
+
+// Moves the item held by a slot in one set of buckets into another, leaving a tombstone behind.
+static void _sim_hash_move_slot(
+    Sim_HashMap *const          hashmap_ptr,
+    const _Sim_HashTable *const from_table_ptr,
+    const size_t                from_index,
+    const _Sim_HashTable *const to_table_ptr
+) {
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    const uint8 *const item_ptr = _sim_hash_get_item(hashmap_ptr, from_table_ptr, from_index);
+    const Sim_HashType hash = from_table_ptr->hashes_ptr ?
+        from_table_ptr->hashes_ptr[from_index] :
+        _sim_hash_get_hash(hashmap_ptr, item_ptr)
+    ;
+
+    // keys are unique, so only a free slot needs to be found
+    size_t index;
+    _sim_hash_probe(hashmap_ptr, to_table_ptr, item_ptr, hash, NULL, &index, NULL);
+    if (to_table_ptr->control_ptr[index] == _SIM_HASH_CTRL_DELETED)
+        hashmap_ptr->_tombstones--;
+    else if (
+        to_table_ptr->distances_ptr &&
+        _SIM_HASH_CTRL_IS_FULL(to_table_ptr->control_ptr[index])
+    )
+        _sim_hash_shift_robin_hood(hashmap_ptr, to_table_ptr, index);
+
+    // move node pointer or inline item into its new slot
+    memcpy(
+        to_table_ptr->slots_ptr + (slot_size * index),
+        from_table_ptr->slots_ptr + (slot_size * from_index),
+        slot_size
+    );
+    if (to_table_ptr->hashes_ptr)
+        to_table_ptr->hashes_ptr[index] = hash;
+    to_table_ptr->control_ptr[index] = from_table_ptr->control_ptr[from_index];
+    _sim_hash_set_distance(to_table_ptr, index, hash);
+
+    // probe sequences passing through the old slot must stay intact
+    from_table_ptr->control_ptr[from_index] = _SIM_HASH_CTRL_DELETED;
+}
+
+// Retrieves the first slot a key's probe sequence visits.
+static inline size_t _sim_hash_get_home(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const Sim_HashType          key_hash
+) {
+
+    if (hashmap_ptr->_flags & SIM_HASH_GROUP_PROBING)
+        return ((size_t)(key_hash >> 7) & (table_ptr->allocated / _SIM_HASH_GROUP_SIZE - 1)) *
+            _SIM_HASH_GROUP_SIZE;
+    if (hashmap_ptr->_flags & SIM_HASH_POWER_OF_TWO)
+        return (size_t)(key_hash >> 7) & (table_ptr->allocated - 1);
+    return key_hash % table_ptr->allocated;
+}
+
+// Prefetches the first slot a key's probe sequence visits.
+static inline void _sim_hash_prefetch(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    _SIM_HASH_PREFETCH(table_ptr->control_ptr + index);
+    if (table_ptr->hashes_ptr)
+        _SIM_HASH_PREFETCH(table_ptr->hashes_ptr + index);
+    _SIM_HASH_PREFETCH(table_ptr->slots_ptr + (hashmap_ptr->_slot_size * index));
+}
+
+// Swaps the items held by two slots.
+static void _sim_hash_swap_slots(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index_a,
+    const size_t                index_b
+) {
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    uint8 *const slot_a_ptr = table_ptr->slots_ptr + (slot_size * index_a);
+    uint8 *const slot_b_ptr = table_ptr->slots_ptr + (slot_size * index_b);
+
+    for (size_t i = 0; i < slot_size; i++) {
+        const uint8 byte = slot_a_ptr[i];
+        slot_a_ptr[i] = slot_b_ptr[i];
+        slot_b_ptr[i] = byte;
+    }
+
+    if (table_ptr->hashes_ptr) {
+        const Sim_HashType hash = table_ptr->hashes_ptr[index_a];
+        table_ptr->hashes_ptr[index_a] = table_ptr->hashes_ptr[index_b];
+        table_ptr->hashes_ptr[index_b] = hash;
+    }
+
+    const uint8 ctrl = table_ptr->control_ptr[index_a];
+    table_ptr->control_ptr[index_a] = table_ptr->control_ptr[index_b];
+    table_ptr->control_ptr[index_b] = ctrl;
+}
+
+// Rehashes a hash table's items into the buckets they're already in, dropping every tombstone
+//  without allocating new buckets. Returns false if an item's probe sequence had no free slot left;
+//  the items that weren't placed yet are then left where they are for the caller to rebuild.
+static bool _sim_hash_rehash_in_place(
+    Sim_HashMap *const hashmap_ptr
+) {
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    uint8 *const control_ptr = table.control_ptr;
+
+    // tombstones become empty slots; items are marked as deleted until they've been placed
+    for (size_t i = 0; i < table.allocated; i++)
+        control_ptr[i] = _SIM_HASH_CTRL_IS_FULL(control_ptr[i]) ?
+            _SIM_HASH_CTRL_DELETED :
+            _SIM_HASH_CTRL_EMPTY
+        ;
+
+    for (size_t i = 0; i < table.allocated; i++) {
+        // place each item at the first free slot in its probe sequence; items placed earlier are
+        //  never moved again, so none of their probe sequences are broken
+        while (control_ptr[i] == _SIM_HASH_CTRL_DELETED) {
+            const uint8 *const item_ptr = _sim_hash_get_item(hashmap_ptr, &table, i);
+            const Sim_HashType hash = table.hashes_ptr ?
+                table.hashes_ptr[i] :
+                _sim_hash_get_hash(hashmap_ptr, item_ptr)
+            ;
+
+            size_t index;
+            _sim_hash_probe(hashmap_ptr, &table, item_ptr, hash, NULL, &index, NULL);
+
+            if (index == i) {
+                control_ptr[i] = _SIM_HASH_FINGERPRINT(hash);
+                break;
+            }
+
+            // probe sequences may not visit every slot; mark the rest as items again
+            if (index == (size_t)-1) {
+                for (size_t j = i; j < table.allocated; j++)
+                    if (control_ptr[j] == _SIM_HASH_CTRL_DELETED)
+                        control_ptr[j] = _SIM_HASH_FINGERPRINT(
+                            table.hashes_ptr ?
+                                table.hashes_ptr[j] :
+                                _sim_hash_get_hash(
+                                    hashmap_ptr,
+                                    _sim_hash_get_item(hashmap_ptr, &table, j)
+                                )
+                        );
+
+                hashmap_ptr->_tombstones = 0;
+                return false;
+            }
+
+            // swap with an item that hasn't been placed yet & place that one next
+            _sim_hash_swap_slots(hashmap_ptr, &table, i, index);
+            control_ptr[index] = _SIM_HASH_FINGERPRINT(hash);
+        }
+    }
+
+    hashmap_ptr->_tombstones = 0;
+    return true;
+}
+
+// Removes the item held by a slot in a linearly probed hash table by shifting the items after it
+//  back into the gap instead of leaving a tombstone.
+void _sim_hash_erase_linear(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    uint8 *const control_ptr = table_ptr->control_ptr;
+    const size_t mask = table_ptr->allocated - 1;
+
+    size_t hole = index;
+    size_t i = (index + 1) & mask;
+
+    for (size_t attempt = 0; attempt < mask && control_ptr[i] != _SIM_HASH_CTRL_EMPTY; attempt++) {
+        if (_SIM_HASH_CTRL_IS_FULL(control_ptr[i])) {
+            const Sim_HashType hash = table_ptr->hashes_ptr ?
+                table_ptr->hashes_ptr[i] :
+                _sim_hash_get_hash(hashmap_ptr, _sim_hash_get_item(hashmap_ptr, table_ptr, i))
+            ;
+            const size_t home = (size_t)(hash >> 7) & mask;
+
+            // items can only move back as far as their home slot
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                memcpy(
+                    table_ptr->slots_ptr + (slot_size * hole),
+                    table_ptr->slots_ptr + (slot_size * i),
+                    slot_size
+                );
+                if (table_ptr->hashes_ptr)
+                    table_ptr->hashes_ptr[hole] = hash;
+                control_ptr[hole] = control_ptr[i];
+                hole = i;
+            }
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    control_ptr[hole] = _SIM_HASH_CTRL_EMPTY;
+}
+
+// Removes the item held by a slot in a Robin Hood hash table by shifting the rest of its cluster
+//  one slot closer to home, stopping at the first item already in its home slot.
+static void _sim_hash_erase_robin_hood(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                index
+) {
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    uint8 *const control_ptr = table_ptr->control_ptr;
+    const size_t mask = table_ptr->allocated - 1;
+
+    size_t hole = index;
+    size_t i = (index + 1) & mask;
+
+    while (_SIM_HASH_CTRL_IS_FULL(control_ptr[i])) {
+        const size_t distance = _sim_hash_get_distance(hashmap_ptr, table_ptr, i);
+        if (!distance)
+            break;
+
+        memcpy(
+            table_ptr->slots_ptr + (slot_size * hole),
+            table_ptr->slots_ptr + (slot_size * i),
+            slot_size
+        );
+        if (table_ptr->hashes_ptr)
+            table_ptr->hashes_ptr[hole] = table_ptr->hashes_ptr[i];
+        control_ptr[hole] = control_ptr[i];
+        table_ptr->distances_ptr[hole] = _SIM_HASH_DISTANCE(distance - 1);
+
+        hole = i;
+        i = (i + 1) & mask;
+    }
+
+    control_ptr[hole] = _SIM_HASH_CTRL_EMPTY;
+}
+
+// Migrates up to a given amount of old buckets into the current ones during an incremental
+//  resize, freeing the old buckets once all of them have been migrated.
+void _sim_hash_migrate(
+    Sim_HashMap *const hashmap_ptr,
+    const size_t       max_slots
+) {
+    if (!hashmap_ptr->_old_data_ptr)
+        return;
+
+    const _Sim_HashTable old_table = _sim_hash_make_table(
+        hashmap_ptr,
+        hashmap_ptr->_old_data_ptr,
+        hashmap_ptr->_old_allocated
+    );
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+
+    const size_t end = (old_table.allocated - hashmap_ptr->_migrated > max_slots) ?
+        hashmap_ptr->_migrated + max_slots :
+        old_table.allocated
+    ;
+
+    for (; hashmap_ptr->_migrated < end; hashmap_ptr->_migrated++)
+        if (_SIM_HASH_CTRL_IS_FULL(old_table.control_ptr[hashmap_ptr->_migrated]))
+            _sim_hash_move_slot(hashmap_ptr, &old_table, hashmap_ptr->_migrated, &table);
+
+    if (hashmap_ptr->_migrated == old_table.allocated) {
+        hashmap_ptr->_allocator_ptr->free(hashmap_ptr->_old_data_ptr);
+        hashmap_ptr->_old_data_ptr = NULL;
+        hashmap_ptr->_old_allocated = 0;
+        hashmap_ptr->_migrated = 0;
+    }
+}
+
+// Searches both the current & old (if resizing incrementally) buckets of a hash table for a key.
+//  If the key isn't found, *out_table_ptr & *out_index_ptr refer to the current buckets as they
+//  would with _sim_hash_probe. If out_probes_ptr isn't NULL, it's set to the total amount of
+//  probes made.
+bool _sim_hash_find(
+    const Sim_HashMap *const hashmap_ptr,
+    const void *const        key_ptr,
+    const Sim_HashType       key_hash,
+    _Sim_HashTable *const    out_table_ptr,
+    size_t *const            out_index_ptr,
+    size_t *const            out_probes_ptr
+) {
+    Sim_PredicateProc predicate_proc = hashmap_ptr->_key_properties.predicate_proc;
+
+    *out_table_ptr = _sim_hash_get_table(hashmap_ptr);
+    if (_sim_hash_probe(
+        hashmap_ptr,
+        out_table_ptr,
+        key_ptr,
+        key_hash,
+        predicate_proc,
+        out_index_ptr,
+        out_probes_ptr
+    ))
+        return true;
+
+    if (hashmap_ptr->_old_data_ptr) {
+        const _Sim_HashTable old_table = _sim_hash_make_table(
+            hashmap_ptr,
+            hashmap_ptr->_old_data_ptr,
+            hashmap_ptr->_old_allocated
+        );
+        size_t old_index;
+        size_t old_probes = 0;
+
+        const bool found = _sim_hash_probe(
+            hashmap_ptr,
+            &old_table,
+            key_ptr,
+            key_hash,
+            predicate_proc,
+            &old_index,
+            out_probes_ptr ? &old_probes : NULL
+        );
+        if (out_probes_ptr)
+            *out_probes_ptr += old_probes;
+
+        if (found) {
+            *out_table_ptr = old_table;
+            *out_index_ptr = old_index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // Clears a hash table.
-static void _sim_hash_clear(
+void _sim_hash_clear(
     _Sim_HashPtr hash_ptr
 ) {
     Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
 
     if (!hashmap_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
+    if (hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
         
-    // destroy hash table nodes
-    void** item_ptr = hashmap_ptr->data_ptr;
-    for (size_t i = 0; i < hashmap_ptr->_allocated; i++)
-        if (item_ptr[i] && item_ptr[i] != (void*)1)
-            _sim_hash_destroy_node(item_ptr[i], hashmap_ptr->_allocator_ptr);
-    
-    // zero out hash table data
-    memset(hashmap_ptr->data_ptr, 0, (sizeof *item_ptr) * hashmap_ptr->_allocated);
+    _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    _sim_hash_clear_table(hashmap_ptr, &table);
+
+    // abandon any incremental resize
+    if (hashmap_ptr->_old_data_ptr) {
+        table = _sim_hash_make_table(
+            hashmap_ptr,
+            hashmap_ptr->_old_data_ptr,
+            hashmap_ptr->_old_allocated
+        );
+        _sim_hash_clear_table(hashmap_ptr, &table);
+
+        hashmap_ptr->_allocator_ptr->free(hashmap_ptr->_old_data_ptr);
+        hashmap_ptr->_old_data_ptr = NULL;
+        hashmap_ptr->_old_allocated = 0;
+        hashmap_ptr->_migrated = 0;
+    }
+
+    // every node carved out of a bulk construction's block is gone
+    if (hashmap_ptr->_node_block_ptr) {
+        hashmap_ptr->_allocator_ptr->free(hashmap_ptr->_node_block_ptr);
+        hashmap_ptr->_node_block_ptr = NULL;
+        hashmap_ptr->_node_block_size = 0;
+    }
 
     // reset count
     hashmap_ptr->count = 0;
+    hashmap_ptr->_tombstones = 0;
 
     RETURN(SIM_RC_SUCCESS,);
 }
 
 // Destroys a hash table.
-static void _sim_hash_destroy(
+void _sim_hash_destroy(
     _Sim_HashPtr hash_ptr
 ) {
+    // mapped hash tables own nothing but their mapping
+    if (hash_ptr.hashmap_ptr && hash_ptr.hashmap_ptr->_mapped_ptr) {
+        sim_memmgmt_unmap(hash_ptr.hashmap_ptr->_mapped_ptr, hash_ptr.hashmap_ptr->_mapped_size);
+        RETURN(SIM_RC_SUCCESS,);
+    }
+
     _sim_hash_clear(hash_ptr);
     
     THROW(sim_get_return_code());
@@ -158,190 +1283,1047 @@ static void _sim_hash_destroy(
     RETURN(SIM_RC_SUCCESS,);
 }
 
-#define HASH_TABLE_IF_CONTAIN(                                                         \
-    key_ptr,                                                                           \
-    key_size,                                                                          \
-    hash_data_ptr,                                                                     \
-    allocated,                                                                         \
-    hash_proc,                                                                         \
-    pred_proc,                                                                         \
-    ...                                                                                \
-)                                                                                      \
-                                                                                       \
-    uint8** data_ptr = (uint8**)hash_data_ptr;                                         \
-    size_t attempt = 0;                                                                \
-    uint8* current_node_ptr;                                                           \
-    size_t index;                                                                      \
-                                                                                       \
-    size_t hash = (hash_proc ?                                                         \
-        (*hash_proc)(key_ptr, 0) :                                                     \
-        sim_siphash(key_ptr, key_size, (Sim_HashKey){SIPHASH_KEY1, SIPHASH_KEY2})      \
-    ) % allocated;                                                                     \
-    size_t hash2 = 0;                                                                  \
-                                                                                       \
-    index = hash % allocated;                                                          \
-    current_node_ptr = data_ptr[index];                                                \
-                                                                                       \
-    while (current_node_ptr) {                                                         \
-        if (current_node_ptr != (void*)1 && (*pred_proc)(key_ptr, current_node_ptr)) { \
-            UNPACK(__VA_ARGS__);                                                       \
-        }                                                                              \
-                                                                                       \
-        attempt++;                                                                     \
-        if (hash_proc)                                                                 \
-            hash = (*hash_proc)(key_ptr, attempt);                                     \
-        else {                                                                         \
-            if (attempt == 1)                                                          \
-                hash2 = sim_siphash(                                                   \
-                    key_ptr,                                                           \
-                    key_size,                                                          \
-                    (Sim_HashKey){SIPHASH_KEY3, SIPHASH_KEY4}                          \
-                ) % allocated;                                                         \
-            hash += hash2 + attempt;                                                   \
-        }                                                                              \
-        index = hash % allocated;                                                      \
-        current_node_ptr = data_ptr[index];                                            \
-    }
-
-#define HASH_IF_CONTAIN(hashmap_ptr, key_ptr, ...)   \
-    HASH_TABLE_IF_CONTAIN(                           \
-        key_ptr,                                     \
-        hashmap_ptr->_key_properties.size,           \
-        hashmap_ptr->data_ptr,                       \
-        hashmap_ptr->_allocated,                     \
-        hashmap_ptr->_key_properties.hash_proc,      \
-        hashmap_ptr->_key_properties.predicate_proc, \
-        __VA_ARGS__                                  \
-    )
-
-// resize hash table to new size
-static void _sim_hash_resize(
-    _Sim_HashPtr hash_ptr,
-    const size_t new_size
+// -- Parallel rehashing & bulk insertion ---------------------------------------------------------
+
+// Probe sequence of a key being placed by several threads at once; visits the same slots in the
+//  same order as _sim_hash_probe.
+typedef struct _Sim_HashProbeSeq {
+    size_t index;   // slot being visited
+    size_t attempt; // amount of slots visited before it
+    size_t hash;    // running hash if double hashing; current group if group probing
+    size_t step;    // step between slots if double hashing with cached hashes or a 2nd hash
+} _Sim_HashProbeSeq;
+
+// Starts the probe sequence of a key.
+static inline void _sim_hash_probe_seq_start(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const Sim_HashType          key_hash,
+    _Sim_HashProbeSeq *const    out_seq_ptr
 ) {
-    // resize only if larger than or equal to the initial size
-    if (new_size > hash_ptr.hashmap_ptr->_initial_size) {
-        Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
-
-        // initialize new hash table
-        uint8** new_data_ptr = hashmap_ptr->_allocator_ptr->falloc(
-            (sizeof *new_data_ptr) * new_size,
-            0
-        );
-        if (!new_data_ptr)
-            THROW(SIM_RC_ERR_OUTOFMEM);
-        
-        // re-hash old data and move them into new hash table
-        uint8** hash_data_ptr = hashmap_ptr->data_ptr;
-        for (size_t i = 0; i < hashmap_ptr->_allocated; i++) {
-            uint8* hash_node = hash_data_ptr[i];
-            if (hash_node && hash_node != (void*)1) {
-                bool test = false;
-                HASH_TABLE_IF_CONTAIN(
-                    hash_node,
-                    hashmap_ptr->_key_properties.size,
-                    new_data_ptr,
-                    new_size,
-                    hashmap_ptr->_key_properties.hash_proc,
-                    hashmap_ptr->_key_properties.predicate_proc,
+    const size_t allocated = table_ptr->allocated;
+
+    out_seq_ptr->attempt = 0;
+    out_seq_ptr->hash = 0;
+    out_seq_ptr->step = 0;
+
+    if (hashmap_ptr->_flags & SIM_HASH_GROUP_PROBING) {
+        out_seq_ptr->hash = (size_t)(key_hash >> 7) & (allocated / _SIM_HASH_GROUP_SIZE - 1);
+        out_seq_ptr->index = out_seq_ptr->hash * _SIM_HASH_GROUP_SIZE;
+    } else if (hashmap_ptr->_flags & SIM_HASH_POWER_OF_TWO)
+        out_seq_ptr->index = (size_t)(key_hash >> 7) & (allocated - 1);
+    else {
+        out_seq_ptr->hash = out_seq_ptr->index = key_hash % allocated;
+        if (table_ptr->hashes_ptr)
+            out_seq_ptr->step = 1 + (size_t)(_sim_hash_mix(key_hash) % (allocated - 1));
+    }
+}
 
-                    test = true;
-                    break;
-                );
-                if (!test)
-                    data_ptr[index] = hash_node;
-            }
+// Moves a probe sequence onto its next slot. Returns false once every slot has been visited.
+static inline bool _sim_hash_probe_seq_next(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    _Sim_HashProbeSeq *const    seq_ptr
+) {
+    const size_t allocated = table_ptr->allocated;
+    const size_t attempt = ++seq_ptr->attempt;
+
+    if (attempt == allocated)
+        return false;
+
+    // slots within a group are visited in order; groups in triangular order
+    if (hashmap_ptr->_flags & SIM_HASH_GROUP_PROBING) {
+        if (attempt % _SIM_HASH_GROUP_SIZE == 0)
+            seq_ptr->hash = (seq_ptr->hash + attempt / _SIM_HASH_GROUP_SIZE) &
+                (allocated / _SIM_HASH_GROUP_SIZE - 1);
+        seq_ptr->index = seq_ptr->hash * _SIM_HASH_GROUP_SIZE + attempt % _SIM_HASH_GROUP_SIZE;
+    } else if (hashmap_ptr->_flags & SIM_HASH_POWER_OF_TWO)
+        seq_ptr->index = (seq_ptr->index + 1) & (allocated - 1);
+    else {
+        Sim_HashProc hash_proc = hashmap_ptr->_key_properties.hash_proc;
+
+        if (table_ptr->hashes_ptr)
+            seq_ptr->hash = seq_ptr->index + seq_ptr->step;
+        else if (hash_proc)
+            seq_ptr->hash = (*hash_proc)(key_ptr, attempt);
+        else {
+            if (attempt == 1)
+                seq_ptr->step = _sim_hash_get_default_hash(hashmap_ptr, key_ptr, true) % allocated;
+            seq_ptr->hash += seq_ptr->step + attempt;
         }
-
-        // free old array & reassign data_ptr to new array
-        hashmap_ptr->data_ptr = new_data_ptr;
-        hashmap_ptr->_allocated = new_size;
-        hashmap_ptr->_allocator_ptr->free(hash_data_ptr);
+        seq_ptr->index = seq_ptr->hash % allocated;
     }
 
-    RETURN(SIM_RC_SUCCESS,);
+    return true;
 }
 
-void _sim_hash_insert(
-    _Sim_HashPtr hash_ptr,
-    const void*  key_ptr,
-    const void*  value_ptr
+// Claims an empty slot for a key in buckets that several threads are filling at once.
+//  Returns true with *out_index_ptr set to a slot marked as busy, which the caller fills before
+//  publishing the key's fingerprint. If predicate_proc isn't NULL & the key has already been
+//  published, returns false with *out_index_ptr set to its slot instead. Buckets must not hold
+//  any tombstones.
+static bool _sim_hash_claim_slot(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const void *const           key_ptr,
+    const Sim_HashType          key_hash,
+    Sim_PredicateProc           predicate_proc,
+    size_t *const               out_index_ptr
 ) {
-    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    uint8 *const control_ptr = table_ptr->control_ptr;
+    const uint8 fingerprint = _SIM_HASH_FINGERPRINT(key_hash);
 
-    // check how much of the hash table is used & resize up if necessary
+    _Sim_HashProbeSeq seq;
+    _sim_hash_probe_seq_start(hashmap_ptr, table_ptr, key_hash, &seq);
+
+    do {
+        uint8 ctrl = _sim_atomic_load_uint8(control_ptr + seq.index);
+
+        for (;;) {
+            if (ctrl == _SIM_HASH_CTRL_EMPTY) {
+                if (_sim_atomic_cas_uint8(control_ptr + seq.index, ctrl, _SIM_HASH_CTRL_BUSY)) {
+                    *out_index_ptr = seq.index;
+                    return true;
+                }
+            }
+
+            // the key may be the one another thread is placing; wait for it to be published
+            else if (ctrl != _SIM_HASH_CTRL_BUSY || !predicate_proc)
+                break;
+
+            ctrl = _sim_atomic_load_uint8(control_ptr + seq.index);
+        }
+
+        // only compare keys whose fingerprints match
+        if (
+            predicate_proc &&
+            ctrl == fingerprint &&
+            _sim_hash_slot_matches(
+                hashmap_ptr,
+                table_ptr,
+                seq.index,
+                key_ptr,
+                key_hash,
+                predicate_proc
+            )
+        ) {
+            *out_index_ptr = seq.index;
+            return false;
+        }
+    } while (_sim_hash_probe_seq_next(hashmap_ptr, table_ptr, key_ptr, &seq));
+
+    *out_index_ptr = (size_t)-1;
+    return false;
+}
+
+struct _Sim_HashParallelTask;
+
+// Function processing the items or slots in [begin, end) of a parallel task; returns how many
+//  items it placed & counts the ones there wasn't a free slot for.
+typedef size_t (*_Sim_HashShareProc)(
+    const struct _Sim_HashParallelTask *const task_ptr,
+    const size_t                              begin,
+    const size_t                              end,
+    size_t *const                             out_failed_ptr
+);
+
+// Work split between the threads of a parallel rehash or bulk insertion
+typedef struct _Sim_HashParallelTask {
+    _Sim_HashShareProc share_proc; // processes each thread's share
+    size_t total;                  // amount of items or slots to split between threads
+    size_t share_count;            // amount of threads to split them between
+
+    const Sim_HashMap* hashmap_ptr;
+    _Sim_HashTable from_table; // buckets being rehashed out of
+    _Sim_HashTable to_table;   // buckets being filled
+
+    const uint8* keys_ptr;     // keys being inserted
+    const uint8* values_ptr;   // values being inserted; NULL if hashset
+    size_t* key_sources_ptr;   // per slot; 1 + index of the first of its keys being inserted
+    size_t* value_sources_ptr; // per slot; 1 + index of the last of its keys being inserted
+
+    size_t failed; // amount of items there wasn't a free slot for
+} _Sim_HashParallelTask;
+
+// A thread's share of a parallel task
+typedef struct _Sim_HashWorker {
+    const _Sim_HashParallelTask* task_ptr;
+    size_t share;  // which share of the task is processed
+    size_t placed; // amount of items placed
+    size_t failed; // amount of items there wasn't a free slot for
+    _Sim_Thread thread;
+    bool started;
+} _Sim_HashWorker;
+
+// Processes a worker's share of a parallel task.
+static void _sim_hash_run_share(
+    _Sim_HashWorker *const worker_ptr
+) {
+    const _Sim_HashParallelTask *const task_ptr = worker_ptr->task_ptr;
+    const size_t size = task_ptr->total / task_ptr->share_count;
+    const size_t extra = task_ptr->total % task_ptr->share_count;
+    const size_t share = worker_ptr->share;
+
+    // the first few shares take one of the leftover items each
+    const size_t begin = size * share + (share < extra ? share : extra);
+    const size_t end = begin + size + (share < extra ? 1 : 0);
+
+    worker_ptr->placed = (*task_ptr->share_proc)(task_ptr, begin, end, &worker_ptr->failed);
+}
+
+static _Sim_ThreadResult _SIM_THREAD_CALL _sim_hash_worker_proc(
+    void* worker_ptr
+) {
+    _sim_hash_run_share(worker_ptr);
+    return (_Sim_ThreadResult)0;
+}
+
+// Splits a task between worker threads, processing the first share on the calling thread &
+//  any share whose thread couldn't be started afterwards. Returns how many items were placed &
+//  adds how many couldn't be to task_ptr->failed.
+static size_t _sim_hash_run_parallel(
+    _Sim_HashParallelTask *const task_ptr
+) {
+    _Sim_HashWorker workers[_SIM_HASH_MAX_THREADS];
+    const size_t share_count = task_ptr->share_count;
+
+    for (size_t i = 0; i < share_count; i++) {
+        workers[i] = (_Sim_HashWorker){ .task_ptr = task_ptr, .share = i };
+        if (i > 0)
+            workers[i].started =
+                _sim_thread_create(&workers[i].thread, _sim_hash_worker_proc, &workers[i]);
+    }
+
+    size_t placed = 0;
+    for (size_t i = 0; i < share_count; i++) {
+        if (workers[i].started)
+            _sim_thread_join(workers[i].thread);
+        else
+            _sim_hash_run_share(&workers[i]);
+        placed += workers[i].placed;
+        task_ptr->failed += workers[i].failed;
+    }
+    return placed;
+}
+
+// Retrieves how many threads to split work on a given amount of items between.
+static inline size_t _sim_hash_get_worker_count(
+    const Sim_HashMap *const hashmap_ptr,
+    const size_t             item_count
+) {
+    // Robin Hood insertions shift items other threads may be reading
+    if (hashmap_ptr->_thread_count <= 1 || (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD))
+        return 1;
+
+    size_t worker_count = item_count / _SIM_HASH_PARALLEL_MIN_SHARE;
+    if (worker_count > hashmap_ptr->_thread_count)
+        worker_count = hashmap_ptr->_thread_count;
+    if (worker_count > _SIM_HASH_MAX_THREADS)
+        worker_count = _SIM_HASH_MAX_THREADS;
+
+    return worker_count ? worker_count : 1;
+}
+
+// Moves the items in a range of old slots into new buckets.
+static size_t _sim_hash_rehash_share(
+    const _Sim_HashParallelTask *const task_ptr,
+    const size_t                       begin,
+    const size_t                       end,
+    size_t *const                      out_failed_ptr
+) {
+    const Sim_HashMap *const hashmap_ptr = task_ptr->hashmap_ptr;
+    const _Sim_HashTable *const from_table_ptr = &task_ptr->from_table;
+    const _Sim_HashTable *const to_table_ptr = &task_ptr->to_table;
+    const size_t slot_size = hashmap_ptr->_slot_size;
+
+    size_t placed = 0;
+    for (size_t i = begin; i < end; i++) {
+        const uint8 ctrl = from_table_ptr->control_ptr[i];
+        if (!_SIM_HASH_CTRL_IS_FULL(ctrl))
+            continue;
+
+        const uint8 *const item_ptr = _sim_hash_get_item(hashmap_ptr, from_table_ptr, i);
+        const Sim_HashType hash = from_table_ptr->hashes_ptr ?
+            from_table_ptr->hashes_ptr[i] :
+            _sim_hash_get_hash(hashmap_ptr, item_ptr)
+        ;
+
+        // keys are unique, so only a free slot needs to be claimed
+        size_t index;
+        if (!_sim_hash_claim_slot(hashmap_ptr, to_table_ptr, item_ptr, hash, NULL, &index)) {
+            (*out_failed_ptr)++;
+            continue;
+        }
+
+        // move node pointer or inline item into its new slot
+        memcpy(
+            to_table_ptr->slots_ptr + (slot_size * index),
+            from_table_ptr->slots_ptr + (slot_size * i),
+            slot_size
+        );
+        if (to_table_ptr->hashes_ptr)
+            to_table_ptr->hashes_ptr[index] = hash;
+        _sim_atomic_store_uint8(to_table_ptr->control_ptr + index, ctrl);
+        placed++;
+    }
+    return placed;
+}
+
+// Places the keys in a range of a batch being inserted, recording which of the batch's keys &
+//  values each slot is to hold. Duplicate keys keep their first key & their last value.
+static size_t _sim_hash_insert_share(
+    const _Sim_HashParallelTask *const task_ptr,
+    const size_t                       begin,
+    const size_t                       end,
+    size_t *const                      out_failed_ptr
+) {
+    const Sim_HashMap *const hashmap_ptr = task_ptr->hashmap_ptr;
+    const _Sim_HashTable *const table_ptr = &task_ptr->to_table;
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    size_t *const key_sources_ptr = task_ptr->key_sources_ptr;
+    size_t *const value_sources_ptr = task_ptr->value_sources_ptr;
+
+    size_t placed = 0;
+    for (size_t i = begin; i < end; i++) {
+        const uint8 *const key_ptr = task_ptr->keys_ptr + (key_size * i);
+        const Sim_HashType hash = _sim_hash_get_hash(hashmap_ptr, key_ptr);
+
+        size_t index;
+        if (_sim_hash_claim_slot(
+            hashmap_ptr,
+            table_ptr,
+            key_ptr,
+            hash,
+            hashmap_ptr->_key_properties.predicate_proc,
+            &index
+        )) {
+            // nodes are created afterwards; until then node slots point at the key being inserted
+            uint8 *const slot_ptr = table_ptr->slots_ptr + (slot_size * index);
+            if (hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE)
+                memcpy(slot_ptr, key_ptr, key_size);
+            else
+                *(const uint8**)slot_ptr = key_ptr;
+
+            if (table_ptr->hashes_ptr)
+                table_ptr->hashes_ptr[index] = hash;
+            key_sources_ptr[index] = value_sources_ptr[index] = i + 1;
+            _sim_atomic_store_uint8(table_ptr->control_ptr + index, _SIM_HASH_FINGERPRINT(hash));
+            placed++;
+            continue;
+        }
+
+        // probe sequences of user hash functions may not visit every slot
+        if (index == (size_t)-1) {
+            (*out_failed_ptr)++;
+            continue;
+        }
+
+        // keep the earliest key & the latest value among duplicates, whichever thread has them;
+        //  keys that were already in the hash table have no source & are kept as they are
+        size_t source = _sim_atomic_load_size(key_sources_ptr + index);
+        while (source > i + 1 && !_sim_atomic_cas_size(key_sources_ptr + index, source, i + 1))
+            source = _sim_atomic_load_size(key_sources_ptr + index);
+
+        source = _sim_atomic_load_size(value_sources_ptr + index);
+        while (source < i + 1 && !_sim_atomic_cas_size(value_sources_ptr + index, source, i + 1))
+            source = _sim_atomic_load_size(value_sources_ptr + index);
+    }
+    return placed;
+}
+
+// Copies the keys & values a batch inserted in parallel into a range of flat slots.
+static size_t _sim_hash_insert_flat_share(
+    const _Sim_HashParallelTask *const task_ptr,
+    const size_t                       begin,
+    const size_t                       end,
+    size_t *const                      out_failed_ptr
+) {
+    const Sim_HashMap *const hashmap_ptr = task_ptr->hashmap_ptr;
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const size_t value_size = hashmap_ptr->_value_size;
+    const size_t slot_size = hashmap_ptr->_slot_size;
+
+    (void)out_failed_ptr;
+
+    for (size_t i = begin; i < end; i++) {
+        uint8 *const slot_ptr = task_ptr->to_table.slots_ptr + (slot_size * i);
+        const size_t key_source = task_ptr->key_sources_ptr[i];
+        const size_t value_source = task_ptr->value_sources_ptr[i];
+
+        if (key_source)
+            memcpy(slot_ptr, task_ptr->keys_ptr + (key_size * (key_source - 1)), key_size);
+        if (value_source && task_ptr->values_ptr)
+            memcpy(
+                slot_ptr + key_size,
+                task_ptr->values_ptr + (value_size * (value_source - 1)),
+                value_size
+            );
+    }
+    return 0;
+}
+
+// Creates the nodes of the keys a batch inserted in parallel & copies its values into them.
+//  Nodes are created on the calling thread since allocators needn't be thread-safe; slots whose
+//  nodes couldn't be allocated are turned into tombstones. Returns how many nodes were created.
+static size_t _sim_hash_insert_nodes(
+    Sim_HashMap *const                 hashmap_ptr,
+    const _Sim_HashParallelTask *const task_ptr
+) {
+    const _Sim_HashTable *const table_ptr = &task_ptr->to_table;
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const size_t value_size = hashmap_ptr->_value_size;
+    const size_t slot_size = hashmap_ptr->_slot_size;
+
+    size_t created = 0;
+    bool out_of_memory = false;
+
+    for (size_t i = 0; i < table_ptr->allocated; i++) {
+        uint8 *const slot_ptr = table_ptr->slots_ptr + (slot_size * i);
+        const size_t key_source = task_ptr->key_sources_ptr[i];
+        const size_t value_source = task_ptr->value_sources_ptr[i];
+        const uint8 *const value_ptr = (value_source && task_ptr->values_ptr) ?
+            task_ptr->values_ptr + (value_size * (value_source - 1)) :
+            NULL
+        ;
+
+        // overwrite the values of keys that were already in the hash table
+        if (!key_source) {
+            if (value_ptr)
+                memcpy(*(uint8**)slot_ptr + key_size, value_ptr, value_size);
+            continue;
+        }
+
+        void* node_ptr = out_of_memory ?
+            NULL :
+            _sim_hash_create_node(
+                task_ptr->keys_ptr + (key_size * (key_source - 1)),
+                key_size,
+                value_ptr,
+                value_ptr ?
+                    value_size :
+                    0
+                ,
+                hashmap_ptr->_allocator_ptr
+            )
+        ;
+        if (!node_ptr) {
+            out_of_memory = true;
+            table_ptr->control_ptr[i] = _SIM_HASH_CTRL_DELETED;
+            hashmap_ptr->_tombstones++;
+            continue;
+        }
+
+        *(void**)slot_ptr = node_ptr;
+        created++;
+    }
+    return created;
+}
+
+// Moves every item into newly allocated buckets of a given size, splitting the work between
+//  threads if the hash table has enough items & may use more than one thread.
+static bool _sim_hash_rebuild(
+    Sim_HashMap *const hashmap_ptr,
+    const size_t       new_size
+) {
+    _Sim_HashTable new_table;
+    if (!_sim_hash_alloc_table(hashmap_ptr, new_size, &new_table))
+        return false;
+
+    const _Sim_HashTable old_table = _sim_hash_get_table(hashmap_ptr);
+    _Sim_HashParallelTask task = {
+        .share_proc = _sim_hash_rehash_share,
+        .total = old_table.allocated,
+        .share_count = _sim_hash_get_worker_count(hashmap_ptr, hashmap_ptr->count),
+        .hashmap_ptr = hashmap_ptr,
+        .from_table = old_table,
+        .to_table = new_table
+    };
+
+    // the old buckets are only read, so they're rehashed one slot at a time if any item
+    //  couldn't be placed
+    if (task.share_count > 1) {
+        _sim_hash_run_parallel(&task);
+        if (task.failed)
+            memset(new_table.control_ptr, _SIM_HASH_CTRL_EMPTY, new_table.allocated);
+    }
+    if (task.share_count <= 1 || task.failed)
+        for (size_t i = 0; i < old_table.allocated; i++)
+            if (_SIM_HASH_CTRL_IS_FULL(old_table.control_ptr[i]))
+                _sim_hash_move_slot(hashmap_ptr, &old_table, i, &new_table);
+
+    // free old array & reassign data_ptr to new array
+    hashmap_ptr->data_ptr = new_table.slots_ptr;
+    hashmap_ptr->_allocated = new_size;
+    hashmap_ptr->_tombstones = 0;
+    hashmap_ptr->_resize_count++;
+    hashmap_ptr->_allocator_ptr->free(old_table.slots_ptr);
+    return true;
+}
+
+// resize hash table to new size
+static void _sim_hash_resize(
+    _Sim_HashPtr hash_ptr,
+    size_t       new_size
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // mapped hash tables are read-only
+    if (hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
+
+    // finish any incremental resize first
+    _sim_hash_migrate(hashmap_ptr, SIZE_MAX);
+
+    // resize only if larger than or equal to the initial size
+    if (new_size > hashmap_ptr->_initial_size) {
+        new_size = _sim_hash_get_capacity(new_size, hashmap_ptr->_flags);
+
+        // re-hash old items and move them into new hash table
+        if (!_sim_hash_rebuild(hashmap_ptr, new_size))
+            THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Resizes a hash table as items are inserted or removed; incrementally if constructed to do so.
+static void _sim_hash_auto_resize(
+    _Sim_HashPtr hash_ptr,
+    size_t       new_size
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    if (!(hashmap_ptr->_flags & SIM_HASH_INCREMENTAL_RESIZE)) {
+        _sim_hash_resize(hash_ptr, new_size);
+        return;
+    }
+
+    // never shrink below the default size; tiny tables would just be migrated back out again
+    if (new_size < hashmap_ptr->_allocated && new_size < SIM_HASH_DEFAULT_SIZE) {
+        if (
+            hashmap_ptr->_allocated <=
+            _sim_hash_get_capacity(SIM_HASH_DEFAULT_SIZE, hashmap_ptr->_flags)
+        )
+            RETURN(SIM_RC_SUCCESS,);
+
+        new_size = SIM_HASH_DEFAULT_SIZE;
+    }
+
+    // finish any incremental resize first
+    _sim_hash_migrate(hashmap_ptr, SIZE_MAX);
+
+    // resize only if larger than or equal to the initial size
+    if (new_size > hashmap_ptr->_initial_size) {
+        new_size = _sim_hash_get_capacity(new_size, hashmap_ptr->_flags);
+
+        _Sim_HashTable new_table;
+        if (!_sim_hash_alloc_table(hashmap_ptr, new_size, &new_table))
+            THROW(SIM_RC_ERR_OUTOFMEM);
+
+        // keep the current buckets around; items are migrated out of them a few at a time
+        hashmap_ptr->_old_data_ptr = hashmap_ptr->data_ptr;
+        hashmap_ptr->_old_allocated = hashmap_ptr->_allocated;
+        hashmap_ptr->_migrated = 0;
+
+        hashmap_ptr->data_ptr = new_table.slots_ptr;
+        hashmap_ptr->_allocated = new_size;
+        hashmap_ptr->_tombstones = 0;
+        hashmap_ptr->_resize_count++;
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Inserts an item with a pre-calculated hash into a hash table or overwrites a pre-existing
+//  item's value.
+void _sim_hash_insert_hashed(
+    _Sim_HashPtr       hash_ptr,
+    const void*        key_ptr,
+    const Sim_HashType hash,
+    const void*        value_ptr
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    _SIM_HASH_COUNT(hashmap_ptr, inserts, 1);
+
+    // check how much of the hash table is used & resize up if necessary
     const size_t load = hashmap_ptr->count * 100 / hashmap_ptr->_allocated;
     if (load > 70) {
-        _sim_hash_resize(hash_ptr, hashmap_ptr->_base_size * 2);
+        _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated * 2);
         THROW(sim_get_return_code());
         if (sim_get_return_code() > 0)
             RETURN(sim_get_return_code(),);
     }
 
-    HASH_IF_CONTAIN(hashmap_ptr, key_ptr,
-        // copy contents of value_ptr to node if hashmap
+    // drop tombstones without resizing if they're what's filling up the hash table; items that
+    //  can't be placed in their own buckets again have to be moved into larger ones all at once
+    else if (
+        (hashmap_ptr->count + hashmap_ptr->_tombstones) * 100 / hashmap_ptr->_allocated > 70 &&
+        !_sim_hash_rehash_in_place(hashmap_ptr)
+    ) {
+        _sim_hash_resize(hash_ptr, hashmap_ptr->_allocated * 2);
+        THROW(sim_get_return_code());
+        if (sim_get_return_code() > 0)
+            RETURN(sim_get_return_code(),);
+    }
+
+    _Sim_HashTable table;
+    size_t index;
+
+    if (_sim_hash_find(hashmap_ptr, key_ptr, hash, &table, &index, NULL)) {
+        // copy contents of value_ptr to item if hashmap
         if (value_ptr)
             memcpy(
-                current_node_ptr + hashmap_ptr->_value_size,
+                _sim_hash_get_item(hashmap_ptr, &table, index) +
+                    hashmap_ptr->_key_properties.size,
                 value_ptr,
                 hashmap_ptr->_value_size
             );
         RETURN(SIM_RC_SUCCESS,);
-    );
+    }
+
+    // no empty slots left in the key's probe sequence; grow & search again
+    if (index == (size_t)-1) {
+        _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated * 2);
+        THROW(sim_get_return_code());
+        if (sim_get_return_code() > 0)
+            RETURN(sim_get_return_code(),);
+
+        table = _sim_hash_get_table(hashmap_ptr);
+        _sim_hash_probe(hashmap_ptr, &table, key_ptr, hash, NULL, &index, NULL);
+        if (index == (size_t)-1)
+            THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    const bool reuses_tombstone = table.control_ptr[index] == _SIM_HASH_CTRL_DELETED;
+
+    // Robin Hood hashing takes the place of the first item closer to its home slot
+    const bool shifts = table.distances_ptr && _SIM_HASH_CTRL_IS_FULL(table.control_ptr[index]);
+    if (shifts)
+        _sim_hash_shift_robin_hood(hashmap_ptr, &table, index);
 
     // insert new item
-    void* node = _sim_hash_create_node(
+    if (!_sim_hash_fill_slot(
+        hashmap_ptr,
+        &table,
+        index,
+        hash,
         key_ptr,
-        hashmap_ptr->_key_properties.size,
-        value_ptr,
-        value_ptr ?
-            hashmap_ptr->_value_size :
-            0
-        ,
-        hashmap_ptr->_allocator_ptr
-    );
-    if (!node)
+        value_ptr
+    )) {
+        // shift the displaced items back
+        if (shifts)
+            _sim_hash_erase_robin_hood(hashmap_ptr, &table, index);
         THROW(SIM_RC_ERR_OUTOFMEM);
+    }
     
-    data_ptr[index] = node;
+    if (reuses_tombstone)
+        hashmap_ptr->_tombstones--;
     hashmap_ptr->count++;
     RETURN(SIM_RC_SUCCESS,);
 }
 
-// Removes an item from a hash table.
-static void _sim_hash_remove(
+// Inserts an item into a hash table or overwrites a pre-existing item's value.
+static void _sim_hash_insert(
     _Sim_HashPtr hash_ptr,
-    const void*  key_ptr
+    const void*  key_ptr,
+    const void*  value_ptr
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // mapped hash tables are read-only
+    if (hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
+
+    _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+    _sim_hash_insert_hashed(
+        hash_ptr,
+        key_ptr,
+        _sim_hash_get_hash(hashmap_ptr, key_ptr),
+        value_ptr
+    );
+}
+
+// Inserts a batch of items into a hash table, splitting the work between threads. Keys are
+//  placed in parallel first, then their nodes are created & values copied in; duplicates keep
+//  their first key & their last value, as if inserted one after another.
+static void _sim_hash_insert_parallel(
+    _Sim_HashPtr       hash_ptr,
+    const void *const  keys_ptr,
+    const void *const  values_ptr,
+    const size_t       item_count,
+    const size_t       worker_count
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // check for overflow
+    if (item_count > SIZE_MAX / 4 - hashmap_ptr->count)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    // claimed slots can't take the place of tombstones or items in old buckets, so start from
+    //  fresh buckets with room for every item
+    _sim_hash_migrate(hashmap_ptr, SIZE_MAX);
+
+    const size_t needed = hashmap_ptr->count + item_count;
+    const size_t reserved_size = needed + (needed / 7) * 3 + 3;
+    if (reserved_size > hashmap_ptr->_allocated || hashmap_ptr->_tombstones) {
+        const size_t new_size = _sim_hash_get_capacity(
+            (reserved_size > hashmap_ptr->_allocated) ?
+                reserved_size :
+                hashmap_ptr->_allocated
+            ,
+            hashmap_ptr->_flags
+        );
+        if (!_sim_hash_rebuild(hashmap_ptr, new_size))
+            THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+
+    // record which keys & values each slot is to hold
+    size_t *const sources_ptr =
+        hashmap_ptr->_allocator_ptr->malloc(sizeof(size_t) * 2 * table.allocated);
+    if (!sources_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    memset(sources_ptr, 0, sizeof(size_t) * 2 * table.allocated);
+
+    _Sim_HashParallelTask task = {
+        .share_proc = _sim_hash_insert_share,
+        .total = item_count,
+        .share_count = worker_count,
+        .hashmap_ptr = hashmap_ptr,
+        .to_table = table,
+        .keys_ptr = keys_ptr,
+        .values_ptr = values_ptr,
+        .key_sources_ptr = sources_ptr,
+        .value_sources_ptr = sources_ptr + table.allocated
+    };
+    size_t placed = _sim_hash_run_parallel(&task);
+
+    if (hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE) {
+        task.share_proc = _sim_hash_insert_flat_share;
+        task.total = table.allocated;
+        _sim_hash_run_parallel(&task);
+    } else {
+        const size_t created = _sim_hash_insert_nodes(hashmap_ptr, &task);
+        if (created < placed) {
+            hashmap_ptr->count += created;
+            hashmap_ptr->_allocator_ptr->free(sources_ptr);
+            THROW(SIM_RC_ERR_OUTOFMEM);
+        }
+    }
+
+    hashmap_ptr->count += placed;
+    hashmap_ptr->_allocator_ptr->free(sources_ptr);
+
+    if (!task.failed) {
+        _SIM_HASH_COUNT(hashmap_ptr, inserts, item_count);
+        RETURN(SIM_RC_SUCCESS,);
+    }
+
+    // insert keys whose probe sequences were full one after another; reinserting the whole batch
+    //  keeps the values of duplicates in order
+    const uint8 *const key_bytes = keys_ptr;
+    const uint8 *const value_bytes = values_ptr;
+
+    for (size_t i = 0; i < item_count; i++) {
+        _sim_hash_insert(
+            hash_ptr,
+            key_bytes + (hashmap_ptr->_key_properties.size * i),
+            value_bytes ?
+                value_bytes + (hashmap_ptr->_value_size * i) :
+                NULL
+        );
+        THROW(sim_get_return_code());
+        if (sim_get_return_code() > 0)
+            RETURN(sim_get_return_code(),);
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Inserts a batch of items into a hash table, hashing & prefetching several items ahead of
+//  inserting them so that their cache misses overlap.
+static void _sim_hash_insert_many(
+    _Sim_HashPtr       hash_ptr,
+    const void *const  keys_ptr,
+    const void *const  values_ptr,
+    const size_t       item_count
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const size_t value_size = hashmap_ptr->_value_size;
+    const uint8 *const key_bytes = keys_ptr;
+    const uint8 *const value_bytes = values_ptr;
+
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];
+
+    // mapped hash tables are read-only
+    if (hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
+
+    // large batches are split between threads if the hash table may use more than one
+    const size_t worker_count = _sim_hash_get_worker_count(hashmap_ptr, item_count);
+    if (worker_count > 1) {
+        _sim_hash_insert_parallel(hash_ptr, keys_ptr, values_ptr, item_count, worker_count);
+        return;
+    }
+
+    for (size_t batch = 0; batch < item_count; batch += _SIM_HASH_BATCH_SIZE) {
+        const size_t batch_count = (item_count - batch < _SIM_HASH_BATCH_SIZE) ?
+            item_count - batch :
+            _SIM_HASH_BATCH_SIZE
+        ;
+
+        _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+        // grow up front so that prefetched buckets aren't replaced partway through the batch
+        if ((hashmap_ptr->count + batch_count) * 100 / hashmap_ptr->_allocated > 70) {
+            _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated * 2);
+            THROW(sim_get_return_code());
+            if (sim_get_return_code() > 0)
+                RETURN(sim_get_return_code(),);
+        }
+
+        const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+        for (size_t i = 0; i < batch_count; i++) {
+            hashes[i] = _sim_hash_get_hash(hashmap_ptr, key_bytes + (key_size * (batch + i)));
+            _sim_hash_prefetch(
+                hashmap_ptr,
+                &table,
+                _sim_hash_get_home(hashmap_ptr, &table, hashes[i])
+            );
+        }
+
+        for (size_t i = 0; i < batch_count; i++) {
+            _sim_hash_insert_hashed(
+                hash_ptr,
+                key_bytes + (key_size * (batch + i)),
+                hashes[i],
+                value_bytes ?
+                    value_bytes + (value_size * (batch + i)) :
+                    NULL
+            );
+            THROW(sim_get_return_code());
+            if (sim_get_return_code() > 0)
+                RETURN(sim_get_return_code(),);
+        }
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Constructs a hash table holding a given set of items, sizing its buckets for all of them up
+//  front & carving their nodes out of a single block instead of allocating each one separately.
+//  Keys & values are read with the given strides, allowing for both parallel arrays & arrays of
+//  key-value pairs. Later duplicate keys overwrite the values of earlier ones.
+static void _sim_hash_construct_from(
+    _Sim_HashPtr          hash_ptr,
+    const size_t          key_size,
+    Sim_HashProc          key_hash_proc,
+    Sim_PredicateProc     key_predicate_proc,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const Sim_HashFlags   flags,
+    const uint8 *const    keys_ptr,
+    const size_t          key_stride,
+    const uint8 *const    values_ptr,
+    const size_t          value_stride,
+    const size_t          item_count
+) {
+    // check for nullptrs
+    if (item_count && !keys_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (item_count && value_size && !values_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_hash_construct(
+        hash_ptr,
+        key_size,
+        key_hash_proc,
+        key_predicate_proc,
+        value_size,
+        allocator_ptr,
+        0,
+        flags,
+        item_count
+    );
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    const bool flat = hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE;
+    const size_t node_size = key_size + value_size;
+
+    uint8* node_ptr = NULL;
+    if (!flat && item_count) {
+        // check for overflow
+        if (node_size && item_count > SIZE_MAX / node_size) {
+            _sim_hash_destroy(hash_ptr);
+            THROW(SIM_RC_ERR_OUTOFMEM);
+        }
+
+        node_ptr = hashmap_ptr->_allocator_ptr->malloc(node_size * item_count);
+        if (!node_ptr) {
+            _sim_hash_destroy(hash_ptr);
+            THROW(SIM_RC_ERR_OUTOFMEM);
+        }
+        hashmap_ptr->_node_block_ptr = node_ptr;
+        hashmap_ptr->_node_block_size = node_size * item_count;
+    }
+
+    // the buckets were sized to hold every item, so they're never resized
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    Sim_PredicateProc predicate_proc = hashmap_ptr->_key_properties.predicate_proc;
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];
+
+    for (size_t batch = 0; batch < item_count; batch += _SIM_HASH_BATCH_SIZE) {
+        const size_t batch_count = (item_count - batch < _SIM_HASH_BATCH_SIZE) ?
+            item_count - batch :
+            _SIM_HASH_BATCH_SIZE
+        ;
+
+        for (size_t i = 0; i < batch_count; i++) {
+            hashes[i] = _sim_hash_get_hash(hashmap_ptr, keys_ptr + (key_stride * (batch + i)));
+            _sim_hash_prefetch(
+                hashmap_ptr,
+                &table,
+                _sim_hash_get_home(hashmap_ptr, &table, hashes[i])
+            );
+        }
+
+        for (size_t i = 0; i < batch_count; i++) {
+            const uint8 *const key_ptr = keys_ptr + (key_stride * (batch + i));
+            const uint8 *const value_ptr = value_size ?
+                values_ptr + (value_stride * (batch + i)) :
+                NULL
+            ;
+            const Sim_HashType hash = hashes[i];
+
+            size_t index;
+            if (_sim_hash_probe(
+                hashmap_ptr,
+                &table,
+                key_ptr,
+                hash,
+                predicate_proc,
+                &index,
+                NULL
+            )) {
+                if (value_ptr)
+                    memcpy(
+                        _sim_hash_get_item(hashmap_ptr, &table, index) + key_size,
+                        value_ptr,
+                        value_size
+                    );
+                continue;
+            }
+
+            // Robin Hood hashing takes the place of the first item closer to its home slot
+            if (table.distances_ptr && _SIM_HASH_CTRL_IS_FULL(table.control_ptr[index]))
+                _sim_hash_shift_robin_hood(hashmap_ptr, &table, index);
+
+            uint8 *const slot_ptr = table.slots_ptr + (hashmap_ptr->_slot_size * index);
+            uint8* item_ptr = slot_ptr;
+            if (!flat) {
+                item_ptr = node_ptr;
+                node_ptr += node_size;
+                *(void**)slot_ptr = item_ptr;
+            }
+
+            memcpy(item_ptr, key_ptr, key_size);
+            if (value_ptr)
+                memcpy(item_ptr + key_size, value_ptr, value_size);
+
+            if (table.hashes_ptr)
+                table.hashes_ptr[index] = hash;
+            table.control_ptr[index] = _SIM_HASH_FINGERPRINT(hash);
+            _sim_hash_set_distance(&table, index, hash);
+
+            hashmap_ptr->count++;
+        }
+    }
+
+    _SIM_HASH_COUNT(hashmap_ptr, inserts, item_count);
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Removes an item with a pre-calculated hash from a hash table.
+void _sim_hash_remove_hashed(
+    _Sim_HashPtr       hash_ptr,
+    const void*        key_ptr,
+    const Sim_HashType hash
 ) {
     Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
 
     // check how much of the hash table is used & resize down if necessary
     const size_t load = hashmap_ptr->count * 100 / hashmap_ptr->_allocated;
-    if (load < 10) {
-        _sim_hash_resize(hash_ptr, hashmap_ptr->_base_size * 2);
+    if (load < 10 && !hashmap_ptr->_old_data_ptr) {
+        _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated / 2);
         
         THROW(sim_get_return_code());
         if (sim_get_return_code() > 0)
             RETURN(sim_get_return_code(),);
     }
 
-    HASH_IF_CONTAIN(hashmap_ptr, key_ptr, 
+    _Sim_HashTable table;
+    size_t index;
+
+    if (_sim_hash_find(hashmap_ptr, key_ptr, hash, &table, &index, NULL)) {
         // destroy node
-        _sim_hash_destroy_node(current_node_ptr, hashmap_ptr->_allocator_ptr);
+        if (!(hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE))
+            _sim_hash_destroy_node(
+                hashmap_ptr,
+                _sim_hash_get_item(hashmap_ptr, &table, index)
+            );
         
-        // set data_ptr @ index to deleted node
-        data_ptr[index] = (void*)1;
+        // old buckets being migrated keep their tombstones; the current ones are counted, or
+        //  avoided entirely in linearly probed tables by shifting later items back
+        if (table.slots_ptr != hashmap_ptr->data_ptr)
+            table.control_ptr[index] = _SIM_HASH_CTRL_DELETED;
+        else if (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD)
+            _sim_hash_erase_robin_hood(hashmap_ptr, &table, index);
+        else if (
+            (hashmap_ptr->_flags & (SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO)) ==
+                SIM_HASH_POWER_OF_TWO
+        )
+            _sim_hash_erase_linear(hashmap_ptr, &table, index);
+        else {
+            table.control_ptr[index] = _SIM_HASH_CTRL_DELETED;
+            hashmap_ptr->_tombstones++;
+        }
 
         // decrement count
         hashmap_ptr->count--;
+        _SIM_HASH_COUNT(hashmap_ptr, removes, 1);
 
         RETURN(SIM_RC_SUCCESS,);
-    );
+    }
     
     // failed to remove item; item not in hash table
     RETURN(SIM_RC_FAILURE,);
 }
 
+// Removes an item from a hash table.
+static void _sim_hash_remove(
+    _Sim_HashPtr hash_ptr,
+    const void*  key_ptr
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // mapped hash tables are read-only
+    if (hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
+
+    _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+    _sim_hash_remove_hashed(hash_ptr, key_ptr, _sim_hash_get_hash(hashmap_ptr, key_ptr));
+}
+
 // Checks if an item/key is contained in a hash table.
 static bool _sim_hash_contains(
     _Sim_HashPtr hash_ptr,
@@ -355,13 +2337,183 @@ static bool _sim_hash_contains(
     if (!key_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
     
-    HASH_IF_CONTAIN(hashmap_ptr, key_ptr,
-        RETURN(SIM_RC_SUCCESS, true);
+    _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+    _Sim_HashTable table;
+    size_t index;
+    size_t probes = 0;
+
+    const bool found = _sim_hash_find(
+        hashmap_ptr,
+        key_ptr,
+        _sim_hash_get_hash(hashmap_ptr, key_ptr),
+        &table,
+        &index,
+        _SIM_HASH_PROBES_PTR(&probes)
     );
+    _SIM_HASH_COUNT(hashmap_ptr, lookups, 1);
+    _SIM_HASH_COUNT(hashmap_ptr, lookup_probes, probes);
+
+    if (found)
+        RETURN(SIM_RC_SUCCESS, true);
 
     RETURN(SIM_RC_NOT_FOUND, false);
 }
 
+// Searches a hash table for a batch of keys, hashing & prefetching several keys ahead of probing
+//  for them so that their cache misses overlap. Returns how many of the keys were found.
+static size_t _sim_hash_find_many(
+    _Sim_HashPtr      hash_ptr,
+    const void *const keys_ptr,
+    const size_t      key_count,
+    void* *const      out_value_ptrs,
+    bool *const       out_contained_ptr
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const uint8 *const key_bytes = keys_ptr;
+
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];
+    size_t homes[_SIM_HASH_BATCH_SIZE];
+    size_t found_count = 0;
+
+    for (size_t batch = 0; batch < key_count; batch += _SIM_HASH_BATCH_SIZE) {
+        const size_t batch_count = (key_count - batch < _SIM_HASH_BATCH_SIZE) ?
+            key_count - batch :
+            _SIM_HASH_BATCH_SIZE
+        ;
+
+        _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+        // hash the whole batch first & prefetch where each key's probe sequence starts
+        const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+        for (size_t i = 0; i < batch_count; i++) {
+            hashes[i] = _sim_hash_get_hash(hashmap_ptr, key_bytes + (key_size * (batch + i)));
+            homes[i] = _sim_hash_get_home(hashmap_ptr, &table, hashes[i]);
+            _sim_hash_prefetch(hashmap_ptr, &table, homes[i]);
+        }
+
+        // nodes are a second cache miss; prefetch the ones likely to hold each key
+        if (!(hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE))
+            for (size_t i = 0; i < batch_count; i++)
+                if (table.control_ptr[homes[i]] == _SIM_HASH_FINGERPRINT(hashes[i]))
+                    _SIM_HASH_PREFETCH(_sim_hash_get_item(hashmap_ptr, &table, homes[i]));
+
+        // then resolve each probe
+        for (size_t i = 0; i < batch_count; i++) {
+            _Sim_HashTable found_table;
+            size_t index;
+            size_t probes = 0;
+
+            const bool found = _sim_hash_find(
+                hashmap_ptr,
+                key_bytes + (key_size * (batch + i)),
+                hashes[i],
+                &found_table,
+                &index,
+                _SIM_HASH_PROBES_PTR(&probes)
+            );
+            _SIM_HASH_COUNT(hashmap_ptr, lookups, 1);
+            _SIM_HASH_COUNT(hashmap_ptr, lookup_probes, probes);
+
+            if (out_value_ptrs)
+                out_value_ptrs[batch + i] = found ?
+                    _sim_hash_get_item(hashmap_ptr, &found_table, index) + key_size :
+                    NULL
+                ;
+            if (out_contained_ptr)
+                out_contained_ptr[batch + i] = found;
+
+            found_count += found;
+        }
+    }
+
+    return found_count;
+}
+
+// Apply a function for each item in a hash table's buckets.
+//  Returns false if iteration was broken out of.
+static bool _sim_hash_foreach_table(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const bool                  is_hashmap,
+    _Sim_HashForEachProc        foreach_proc,
+    Sim_Variant                 userdata,
+    size_t *const               item_num_ptr
+) {
+    // iterate through allocated
+    for (size_t i = 0; i < table_ptr->allocated; i++) {
+        // if the item exists...
+        if (!_SIM_HASH_CTRL_IS_FULL(table_ptr->control_ptr[i]))
+            continue;
+
+        uint8 *const item_ptr = _sim_hash_get_item(hashmap_ptr, table_ptr, i);
+
+        if (is_hashmap ?
+            !foreach_proc.map_foreach_proc(
+                item_ptr,
+                item_ptr + hashmap_ptr->_key_properties.size,
+                *item_num_ptr,
+                userdata
+            ) :
+            !foreach_proc.set_foreach_proc(
+                item_ptr,
+                *item_num_ptr,
+                userdata
+            )
+        )
+            return false;
+        
+        (*item_num_ptr)++;
+    }
+
+    return true;
+}
+
+// Apply a function for each item in both the current & old (if resizing incrementally) buckets
+//  of a hash table, numbering items from *item_num_ptr onwards.
+//  Returns false if iteration was broken out of.
+bool _sim_hash_foreach_tables(
+    const Sim_HashMap *const hashmap_ptr,
+    const bool               is_hashmap,
+    _Sim_HashForEachProc     foreach_proc,
+    Sim_Variant              userdata,
+    size_t *const            item_num_ptr
+) {
+    _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+
+    if (!_sim_hash_foreach_table(
+        hashmap_ptr,
+        &table,
+        is_hashmap,
+        foreach_proc,
+        userdata,
+        item_num_ptr
+    ))
+        return false;
+
+    // items not yet migrated by an incremental resize
+    if (hashmap_ptr->_old_data_ptr) {
+        table = _sim_hash_make_table(
+            hashmap_ptr,
+            hashmap_ptr->_old_data_ptr,
+            hashmap_ptr->_old_allocated
+        );
+
+        if (!_sim_hash_foreach_table(
+            hashmap_ptr,
+            &table,
+            is_hashmap,
+            foreach_proc,
+            userdata,
+            item_num_ptr
+        ))
+            return false;
+    }
+
+    return true;
+}
+
 // Apply a function for each item in hash table.
 static bool _sim_hash_foreach(
     _Sim_HashPtr         hash_ptr,
@@ -372,47 +2524,848 @@ static bool _sim_hash_foreach(
     Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
 
     // check for nullptrs
-    if (!hashmap_ptr)
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!foreach_proc.set_foreach_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+    
+    size_t item_num = 0;
+
+    RETURN(
+        SIM_RC_SUCCESS,
+        _sim_hash_foreach_tables(hashmap_ptr, is_hashmap, foreach_proc, userdata, &item_num)
+    );
+}
+
+// Records the probe length of every item in one of a hash table's bucket arrays, along with the
+//  size of every node allocated on its own. Returns the sum of their displacements.
+static size_t _sim_hash_get_table_stats(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    const size_t                node_size,
+    Sim_HashStats *const        stats_ptr
+) {
+    size_t total_displacement = 0;
+
+    for (size_t i = 0; i < table_ptr->allocated; i++) {
+        if (!_SIM_HASH_CTRL_IS_FULL(table_ptr->control_ptr[i]))
+            continue;
+
+        const uint8 *const item_ptr = _sim_hash_get_item(hashmap_ptr, table_ptr, i);
+        const Sim_HashType hash = table_ptr->hashes_ptr ?
+            table_ptr->hashes_ptr[i] :
+            _sim_hash_get_hash(hashmap_ptr, item_ptr)
+        ;
+
+        // look the item up exactly as a lookup would, counting probes across both bucket arrays
+        _Sim_HashTable found_table;
+        size_t index;
+        size_t probes = 0;
+        _sim_hash_find(hashmap_ptr, item_ptr, hash, &found_table, &index, &probes);
+
+        const size_t displacement = probes ? probes - 1 : 0;
+        stats_ptr->probe_histogram[
+            (displacement < SIM_HASH_STATS_HISTOGRAM_SIZE) ?
+                displacement :
+                SIM_HASH_STATS_HISTOGRAM_SIZE - 1
+        ]++;
+        if (displacement > stats_ptr->max_displacement)
+            stats_ptr->max_displacement = displacement;
+        total_displacement += displacement;
+
+        if (node_size && !_sim_hash_is_block_node(hashmap_ptr, item_ptr))
+            stats_ptr->allocated_bytes += node_size;
+    }
+
+    return total_displacement;
+}
+
+// Gathers a snapshot of a hash table's load, probe lengths, & memory use.
+static void _sim_hash_get_stats(
+    _Sim_HashPtr         hash_ptr,
+    const bool           is_hashmap,
+    Sim_HashStats *const out_stats_ptr
+) {
+    const Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // check for nullptrs
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_stats_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    Sim_HashStats stats = {
+        .count = hashmap_ptr->count,
+        .allocated = hashmap_ptr->_allocated + hashmap_ptr->_old_allocated,
+        .tombstones = hashmap_ptr->_tombstones,
+        .resize_count = hashmap_ptr->_resize_count
+    };
+    stats.load_factor = (double)stats.count / (double)stats.allocated;
+
+    // each item has its own node unless stored inline or carved out of a bulk construction's block
+    const size_t node_size = (hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE) ?
+        0 :
+        hashmap_ptr->_key_properties.size + (is_hashmap ? hashmap_ptr->_value_size : 0)
+    ;
+
+    // mapped buckets belong to the file mapping rather than the allocator
+    size_t hashes_offset, control_offset;
+    stats.allocated_bytes = hashmap_ptr->_node_block_size;
+    if (!hashmap_ptr->_mapped_ptr)
+        stats.allocated_bytes += _sim_hash_get_layout(
+            hashmap_ptr,
+            hashmap_ptr->_allocated,
+            &hashes_offset,
+            &control_offset
+        );
+
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    size_t total_displacement = _sim_hash_get_table_stats(hashmap_ptr, &table, node_size, &stats);
+
+    if (hashmap_ptr->_old_data_ptr) {
+        const _Sim_HashTable old_table = _sim_hash_make_table(
+            hashmap_ptr,
+            hashmap_ptr->_old_data_ptr,
+            hashmap_ptr->_old_allocated
+        );
+
+        stats.allocated_bytes += _sim_hash_get_layout(
+            hashmap_ptr,
+            hashmap_ptr->_old_allocated,
+            &hashes_offset,
+            &control_offset
+        );
+        total_displacement += _sim_hash_get_table_stats(
+            hashmap_ptr,
+            &old_table,
+            node_size,
+            &stats
+        );
+    }
+
+    stats.average_displacement = stats.count ?
+        (double)total_displacement / (double)stats.count :
+        0.0
+    ;
+
+    stats.op_counters = hashmap_ptr->_op_counters;
+
+    memcpy(out_stats_ptr, &stats, sizeof(Sim_HashStats));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// -- Set algebra ----------------------------------------------------------------------------------
+
+// Items gathered from one hash table's slots to be looked up in or inserted into others
+typedef struct _Sim_HashItemBatch {
+    uint8* item_ptrs[_SIM_HASH_BATCH_SIZE];       // items held by the gathered slots
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];    // each item's hash in its own hash table
+    size_t indices[_SIM_HASH_BATCH_SIZE];         // gathered slots
+    size_t count;                                 // amount of gathered slots
+} _Sim_HashItemBatch;
+
+// Checks if keys hash the same in two hash tables, letting one's hashes be used in the other.
+static inline bool _sim_hash_shares_hashes(
+    const Sim_HashMap *const hashmap_ptr,
+    const Sim_HashMap *const other_hashmap_ptr
+) {
+    // hashes are mixed in power of 2 sized tables
+    const Sim_HashFlags mixed = SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO;
+    Sim_HashProc hash_proc = hashmap_ptr->_key_properties.hash_proc;
+
+    return
+        hash_proc == other_hashmap_ptr->_key_properties.hash_proc &&
+        !(hashmap_ptr->_flags & mixed) == !(other_hashmap_ptr->_flags & mixed) && (
+            hash_proc ||
+            (hashmap_ptr->_flags & SIM_HASH_SIPHASH) ==
+                (other_hashmap_ptr->_flags & SIM_HASH_SIPHASH)
+        )
+    ;
+}
+
+// Gathers the items held by the next few full slots of a hash table's current buckets, starting
+//  at *cursor_ptr & moving it past them. Returns how many items were gathered.
+static size_t _sim_hash_gather_batch(
+    const Sim_HashMap *const    hashmap_ptr,
+    const _Sim_HashTable *const table_ptr,
+    size_t *const               cursor_ptr,
+    _Sim_HashItemBatch *const   out_batch_ptr
+) {
+    size_t count = 0;
+    size_t i = *cursor_ptr;
+
+    for (; i < table_ptr->allocated && count < _SIM_HASH_BATCH_SIZE; i++) {
+        if (!_SIM_HASH_CTRL_IS_FULL(table_ptr->control_ptr[i]))
+            continue;
+
+        out_batch_ptr->item_ptrs[count] = _sim_hash_get_item(hashmap_ptr, table_ptr, i);
+        out_batch_ptr->hashes[count] = table_ptr->hashes_ptr ?
+            table_ptr->hashes_ptr[i] :
+            0
+        ;
+        out_batch_ptr->indices[count] = i;
+        count++;
+    }
+
+    *cursor_ptr = i;
+    return out_batch_ptr->count = count;
+}
+
+// Hashes a batch of gathered items for another hash table & prefetches where each item's probe
+//  sequence starts in it.
+static void _sim_hash_rehash_batch(
+    const Sim_HashMap *const        hashmap_ptr,
+    const Sim_HashMap *const        other_hashmap_ptr,
+    const _Sim_HashItemBatch *const batch_ptr,
+    Sim_HashType *const             out_hashes
+) {
+    const _Sim_HashTable table = _sim_hash_get_table(other_hashmap_ptr);
+    const bool reuses_hashes =
+        (hashmap_ptr->_flags & SIM_HASH_CACHE_HASHES) &&
+        _sim_hash_shares_hashes(hashmap_ptr, other_hashmap_ptr)
+    ;
+
+    for (size_t i = 0; i < batch_ptr->count; i++) {
+        out_hashes[i] = reuses_hashes ?
+            batch_ptr->hashes[i] :
+            _sim_hash_get_hash(other_hashmap_ptr, batch_ptr->item_ptrs[i])
+        ;
+        _sim_hash_prefetch(
+            other_hashmap_ptr,
+            &table,
+            _sim_hash_get_home(other_hashmap_ptr, &table, out_hashes[i])
+        );
+    }
+}
+
+// Looks up a batch of gathered items in another hash table, filling out_found with whether each
+//  one was found.
+static void _sim_hash_lookup_batch(
+    const Sim_HashMap *const        hashmap_ptr,
+    Sim_HashMap *const              other_hashmap_ptr,
+    const _Sim_HashItemBatch *const batch_ptr,
+    bool *const                     out_found
+) {
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];
+    _sim_hash_rehash_batch(hashmap_ptr, other_hashmap_ptr, batch_ptr, hashes);
+
+    for (size_t i = 0; i < batch_ptr->count; i++) {
+        _Sim_HashTable found_table;
+        size_t index;
+        size_t probes = 0;
+
+        out_found[i] = _sim_hash_find(
+            other_hashmap_ptr,
+            batch_ptr->item_ptrs[i],
+            hashes[i],
+            &found_table,
+            &index,
+            _SIM_HASH_PROBES_PTR(&probes)
+        );
+        _SIM_HASH_COUNT(other_hashmap_ptr, lookups, 1);
+        _SIM_HASH_COUNT(other_hashmap_ptr, lookup_probes, probes);
+    }
+}
+
+// Inserts the items of one hash table into another. If filter_ptr isn't NULL, only the items
+//  that are (or, if keep_found is false, aren't) contained in it are inserted.
+static void _sim_hash_insert_from(
+    _Sim_HashPtr             hash_ptr,
+    const Sim_HashMap *const from_hashmap_ptr,
+    Sim_HashMap *const       filter_ptr,
+    const bool               keep_found
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    const _Sim_HashTable from_table = _sim_hash_get_table(from_hashmap_ptr);
+
+    _Sim_HashItemBatch batch;
+    Sim_HashType hashes[_SIM_HASH_BATCH_SIZE];
+    bool found[_SIM_HASH_BATCH_SIZE];
+
+    size_t cursor = 0;
+    while (_sim_hash_gather_batch(from_hashmap_ptr, &from_table, &cursor, &batch)) {
+        if (filter_ptr)
+            _sim_hash_lookup_batch(from_hashmap_ptr, filter_ptr, &batch, found);
+
+        _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+        // grow up front so that prefetched buckets aren't replaced partway through the batch
+        if ((hashmap_ptr->count + batch.count) * 100 / hashmap_ptr->_allocated > 70) {
+            _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated * 2);
+            THROW(sim_get_return_code());
+            if (sim_get_return_code() > 0)
+                RETURN(sim_get_return_code(),);
+        }
+
+        _sim_hash_rehash_batch(from_hashmap_ptr, hashmap_ptr, &batch, hashes);
+        for (size_t i = 0; i < batch.count; i++) {
+            if (filter_ptr && found[i] != keep_found)
+                continue;
+
+            _sim_hash_insert_hashed(hash_ptr, batch.item_ptrs[i], hashes[i], NULL);
+            THROW(sim_get_return_code());
+            if (sim_get_return_code() > 0)
+                RETURN(sim_get_return_code(),);
+        }
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Removes the items of a hash table that are (or, if keep_found is true, aren't) contained in
+//  another. Removed items are marked as deleted while the buckets are being scanned; linearly
+//  probed buckets then shift the items after them back, & emptied hash tables shrink.
+static void _sim_hash_erase_where(
+    _Sim_HashPtr       hash_ptr,
+    Sim_HashMap *const filter_ptr,
+    const bool         keep_found
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    const bool shifts = (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD) ||
+        (hashmap_ptr->_flags & (SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO)) ==
+            SIM_HASH_POWER_OF_TWO
+    ;
+
+    _Sim_HashItemBatch batch;
+    bool found[_SIM_HASH_BATCH_SIZE];
+    size_t removed = 0;
+
+    size_t cursor = 0;
+    while (_sim_hash_gather_batch(hashmap_ptr, &table, &cursor, &batch)) {
+        _sim_hash_lookup_batch(hashmap_ptr, filter_ptr, &batch, found);
+
+        for (size_t i = 0; i < batch.count; i++) {
+            if (found[i] == keep_found)
+                continue;
+
+            if (!(hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE))
+                _sim_hash_destroy_node(hashmap_ptr, batch.item_ptrs[i]);
+            table.control_ptr[batch.indices[i]] = _SIM_HASH_CTRL_DELETED;
+            removed++;
+        }
+    }
+
+    hashmap_ptr->count -= removed;
+    _SIM_HASH_COUNT(hashmap_ptr, removes, removed);
+
+    // shifting clusters back from their ends keeps every item reachable from its home slot; going
+    //  backwards from an empty slot, no slot after a deleted one is still waiting to be shifted,
+    //  even in clusters that wrap around the end of the buckets
+    if (shifts) {
+        const size_t mask = table.allocated - 1;
+
+        size_t i = 0;
+        while (i < table.allocated && table.control_ptr[i] != _SIM_HASH_CTRL_EMPTY)
+            i++;
+
+        for (size_t n = 0; n < table.allocated; n++) {
+            i = (i - 1) & mask;
+            if (table.control_ptr[i] == _SIM_HASH_CTRL_DELETED) {
+                if (hashmap_ptr->_flags & SIM_HASH_ROBIN_HOOD)
+                    _sim_hash_erase_robin_hood(hashmap_ptr, &table, i);
+                else
+                    _sim_hash_erase_linear(hashmap_ptr, &table, i);
+            }
+        }
+    } else
+        hashmap_ptr->_tombstones += removed;
+
+    // check how much of the hash table is used & resize down if necessary
+    if (removed && hashmap_ptr->count * 100 / hashmap_ptr->_allocated < 10) {
+        _sim_hash_auto_resize(hash_ptr, hashmap_ptr->_allocated / 2);
+        THROW(sim_get_return_code());
+        if (sim_get_return_code() > 0)
+            RETURN(sim_get_return_code(),);
+    }
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Checks the hash sets taking part in a set operation & finishes any incremental resizes of its
+//  operands so that only their current buckets need to be scanned. out_hashmap_ptr may be NULL.
+static void _sim_hash_prepare_set_op(
+    Sim_HashMap *const hashmap_ptr,
+    Sim_HashMap *const other_hashmap_ptr,
+    Sim_HashMap *const out_hashmap_ptr
+) {
+    if (!hashmap_ptr || !other_hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    if (
+        other_hashmap_ptr->_key_properties.size != key_size ||
+        (out_hashmap_ptr && out_hashmap_ptr->_key_properties.size != key_size)
+    )
+        THROW(SIM_RC_ERR_INVALARG);
+
+    _sim_hash_migrate(hashmap_ptr, SIZE_MAX);
+    _sim_hash_migrate(other_hashmap_ptr, SIZE_MAX);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Empties the hash set a set operation's result is written into.
+static void _sim_hash_prepare_set_result(
+    _Sim_HashPtr out_ptr
+) {
+    // mapped hash sets are read-only, so can only be operands
+    if (out_ptr.hashmap_ptr->_mapped_ptr)
+        THROW(SIM_RC_ERR_UNSUPRTD);
+
+    _sim_hash_clear(out_ptr);
+}
+
+// Adds the items of another hash set to a hash set, or the items of both to an output hash set
+//  if out_ptr isn't NULL.
+static void _sim_hash_union(
+    _Sim_HashPtr hash_ptr,
+    _Sim_HashPtr other_ptr,
+    _Sim_HashPtr out_ptr
+) {
+    _sim_hash_prepare_set_op(hash_ptr.hashmap_ptr, other_ptr.hashmap_ptr, out_ptr.hashmap_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    // unions are the same either way round
+    const bool swaps = out_ptr.hashmap_ptr == other_ptr.hashmap_ptr;
+    Sim_HashMap *const hashmap_ptr = swaps ? other_ptr.hashmap_ptr : hash_ptr.hashmap_ptr;
+    Sim_HashMap *const other_hashmap_ptr = swaps ? hash_ptr.hashmap_ptr : other_ptr.hashmap_ptr;
+
+    if (!out_ptr.hashmap_ptr || out_ptr.hashmap_ptr == hashmap_ptr) {
+        if (hashmap_ptr->_mapped_ptr)
+            THROW(SIM_RC_ERR_UNSUPRTD);
+
+        if (other_hashmap_ptr != hashmap_ptr)
+            _sim_hash_insert_from(
+                ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+                other_hashmap_ptr,
+                NULL,
+                false
+            );
+        return;
+    }
+
+    _sim_hash_prepare_set_result(out_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    // every item of the larger hash set is in the union; size the output for them up front
+    const Sim_HashMap *const larger_ptr = (hashmap_ptr->count >= other_hashmap_ptr->count) ?
+        hashmap_ptr :
+        other_hashmap_ptr
+    ;
+    const Sim_HashMap *const smaller_ptr = (larger_ptr == hashmap_ptr) ?
+        other_hashmap_ptr :
+        hashmap_ptr
+    ;
+    const size_t reserved_size = larger_ptr->count + (larger_ptr->count / 7) * 3 + 3;
+    if (reserved_size > out_ptr.hashmap_ptr->_allocated) {
+        _sim_hash_resize(out_ptr, reserved_size);
+        THROW(sim_get_return_code());
+        if (sim_get_return_code() > 0)
+            RETURN(sim_get_return_code(),);
+    }
+
+    _sim_hash_insert_from(out_ptr, larger_ptr, NULL, false);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    _sim_hash_insert_from(out_ptr, smaller_ptr, NULL, false);
+}
+
+// Removes the items of a hash set that aren't in another hash set, or adds the items both have in
+//  common to an output hash set if out_ptr isn't NULL.
+static void _sim_hash_intersect(
+    _Sim_HashPtr hash_ptr,
+    _Sim_HashPtr other_ptr,
+    _Sim_HashPtr out_ptr
+) {
+    _sim_hash_prepare_set_op(hash_ptr.hashmap_ptr, other_ptr.hashmap_ptr, out_ptr.hashmap_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    // intersections are the same either way round
+    const bool swaps = out_ptr.hashmap_ptr == other_ptr.hashmap_ptr;
+    Sim_HashMap *const hashmap_ptr = swaps ? other_ptr.hashmap_ptr : hash_ptr.hashmap_ptr;
+    Sim_HashMap *const other_hashmap_ptr = swaps ? hash_ptr.hashmap_ptr : other_ptr.hashmap_ptr;
+
+    // every item of the hash set being modified has to be checked
+    if (!out_ptr.hashmap_ptr || out_ptr.hashmap_ptr == hashmap_ptr) {
+        if (hashmap_ptr->_mapped_ptr)
+            THROW(SIM_RC_ERR_UNSUPRTD);
+
+        if (other_hashmap_ptr != hashmap_ptr)
+            _sim_hash_erase_where(
+                ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+                other_hashmap_ptr,
+                true
+            );
+        return;
+    }
+
+    _sim_hash_prepare_set_result(out_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    // otherwise only the smaller hash set's items have to be checked
+    if (hashmap_ptr->count <= other_hashmap_ptr->count)
+        _sim_hash_insert_from(out_ptr, hashmap_ptr, other_hashmap_ptr, true);
+    else
+        _sim_hash_insert_from(out_ptr, other_hashmap_ptr, hashmap_ptr, true);
+}
+
+// Removes the items of a hash set that are in another hash set, or adds the items only the first
+//  has to an output hash set if out_ptr isn't NULL.
+static void _sim_hash_difference(
+    _Sim_HashPtr hash_ptr,
+    _Sim_HashPtr other_ptr,
+    _Sim_HashPtr out_ptr
+) {
+    _sim_hash_prepare_set_op(hash_ptr.hashmap_ptr, other_ptr.hashmap_ptr, out_ptr.hashmap_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    // the other hash set's items would be read while it's being overwritten
+    if (
+        out_ptr.hashmap_ptr == other_ptr.hashmap_ptr &&
+        out_ptr.hashmap_ptr != hash_ptr.hashmap_ptr
+    )
+        THROW(SIM_RC_ERR_INVALARG);
+
+    // nothing needs to be looked up in an empty hash set
+    Sim_HashMap *const filter_ptr = other_ptr.hashmap_ptr->count ?
+        other_ptr.hashmap_ptr :
+        NULL
+    ;
+
+    if (!out_ptr.hashmap_ptr || out_ptr.hashmap_ptr == hash_ptr.hashmap_ptr) {
+        if (hash_ptr.hashmap_ptr->_mapped_ptr)
+            THROW(SIM_RC_ERR_UNSUPRTD);
+
+        if (filter_ptr)
+            _sim_hash_erase_where(hash_ptr, filter_ptr, false);
+        return;
+    }
+
+    _sim_hash_prepare_set_result(out_ptr);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(),);
+
+    _sim_hash_insert_from(out_ptr, hash_ptr.hashmap_ptr, filter_ptr, false);
+}
+
+// Checks if every item of a hash set is also in another hash set.
+static bool _sim_hash_is_subset(
+    _Sim_HashPtr hash_ptr,
+    _Sim_HashPtr other_ptr
+) {
+    _sim_hash_prepare_set_op(hash_ptr.hashmap_ptr, other_ptr.hashmap_ptr, NULL);
+    THROW(sim_get_return_code());
+    if (sim_get_return_code() > 0)
+        RETURN(sim_get_return_code(), false);
+
+    const Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+    if (hashmap_ptr->count > other_ptr.hashmap_ptr->count)
+        RETURN(SIM_RC_SUCCESS, false);
+
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+    _Sim_HashItemBatch batch;
+    bool found[_SIM_HASH_BATCH_SIZE];
+
+    size_t cursor = 0;
+    while (_sim_hash_gather_batch(hashmap_ptr, &table, &cursor, &batch)) {
+        _sim_hash_lookup_batch(hashmap_ptr, other_ptr.hashmap_ptr, &batch, found);
+
+        for (size_t i = 0; i < batch.count; i++)
+            if (!found[i])
+                RETURN(SIM_RC_SUCCESS, false);
+    }
+
+    RETURN(SIM_RC_SUCCESS, true);
+}
+
+// == SERIALIZATION ===============================================================================
+
+// Identifies serialized hash tables & the byte order they were written in ("SIMHASH\0")
+#define _SIM_HASH_FILE_MAGIC   0x0048534148534D49ULL
+#define _SIM_HASH_FILE_VERSION 1
+
+// Header preceding the buckets of a serialized hash table.
+//  The buckets follow exactly as they're laid out in memory, so they're used in place once mapped.
+typedef struct _Sim_HashFileHeader {
+    uint64 magic;      // _SIM_HASH_FILE_MAGIC
+    uint32 version;    // _SIM_HASH_FILE_VERSION
+    uint32 flags;      // storage & probing options the hash table was constructed with
+    uint64 key_size;   // size of each key
+    uint64 value_size; // size of each value; 0 for hashsets
+    uint64 slot_size;  // size of each slot
+    uint64 allocated;  // amount of slots
+    uint64 count;      // amount of items
+    uint64 tombstones; // amount of slots marked as deleted
+} _Sim_HashFileHeader;
+
+// Writes a given amount of zeroed bytes to a file.
+static bool _sim_hash_write_zeros(
+    FILE *const file_ptr,
+    size_t      size
+) {
+    static const uint8 zeros[64] = { 0 };
+
+    while (size) {
+        const size_t chunk = (size < sizeof(zeros)) ?
+            size :
+            sizeof(zeros)
+        ;
+        if (fwrite(zeros, 1, chunk, file_ptr) != chunk)
+            return false;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+// Writes a hash table's buckets to a file in a form that can be mapped back in & used in place.
+static void _sim_hash_serialize(
+    _Sim_HashPtr hash_ptr,
+    const bool   is_hashmap,
+    FILE *const  file_ptr
+) {
+    Sim_HashMap *const hashmap_ptr = hash_ptr.hashmap_ptr;
+
+    // check for nullptrs
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!file_ptr)
+        THROW(SIM_RC_ERR_BADFILE);
+
+    // nodes are referred to by pointers, which mean nothing once written out
+    if (!(hashmap_ptr->_flags & SIM_HASH_FLAT_STORAGE))
+        THROW(SIM_RC_ERR_INVALARG);
+
+    // only the current buckets are written
+    if (!hashmap_ptr->_mapped_ptr)
+        _sim_hash_migrate(hashmap_ptr, SIZE_MAX);
+
+    const size_t key_size = hashmap_ptr->_key_properties.size;
+    const size_t value_size = is_hashmap ?
+        hashmap_ptr->_value_size :
+        0
+    ;
+    const size_t slot_size = hashmap_ptr->_slot_size;
+    const _Sim_HashTable table = _sim_hash_get_table(hashmap_ptr);
+
+    const _Sim_HashFileHeader header = {
+        .magic = _SIM_HASH_FILE_MAGIC,
+        .version = _SIM_HASH_FILE_VERSION,
+        .flags = (uint32)(hashmap_ptr->_flags & ~SIM_HASH_INCREMENTAL_RESIZE),
+        .key_size = key_size,
+        .value_size = value_size,
+        .slot_size = slot_size,
+        .allocated = table.allocated,
+        .count = hashmap_ptr->count,
+        .tombstones = hashmap_ptr->_tombstones
+    };
+    if (
+        fseek(file_ptr, 0, SEEK_SET) ||
+        fwrite(&header, sizeof(_Sim_HashFileHeader), 1, file_ptr) != 1
+    )
+        THROW(SIM_RC_ERR_BADFILE);
+
+    // free slots & padding are written as zeroes rather than whatever happened to be in memory
+    bool written = true;
+    for (size_t i = 0; written && i < table.allocated; i++)
+        written = _SIM_HASH_CTRL_IS_FULL(table.control_ptr[i]) ?
+            fwrite(
+                table.slots_ptr + (slot_size * i),
+                1,
+                key_size + value_size,
+                file_ptr
+            ) == key_size + value_size &&
+                _sim_hash_write_zeros(file_ptr, slot_size - key_size - value_size) :
+            _sim_hash_write_zeros(file_ptr, slot_size)
+        ;
+
+    size_t hashes_offset, control_offset;
+    _sim_hash_get_layout(hashmap_ptr, table.allocated, &hashes_offset, &control_offset);
+    written = written &&
+        _sim_hash_write_zeros(file_ptr, hashes_offset - (slot_size * table.allocated));
+
+    if (table.hashes_ptr)
+        for (size_t i = 0; written && i < table.allocated; i++) {
+            const Sim_HashType hash = _SIM_HASH_CTRL_IS_FULL(table.control_ptr[i]) ?
+                table.hashes_ptr[i] :
+                0
+            ;
+            written = fwrite(&hash, sizeof(Sim_HashType), 1, file_ptr) == 1;
+        }
+
+    written = written &&
+        fwrite(table.control_ptr, 1, table.allocated, file_ptr) == table.allocated;
+
+    if (table.distances_ptr)
+        for (size_t i = 0; written && i < table.allocated; i++)
+            written = fputc(
+                _SIM_HASH_CTRL_IS_FULL(table.control_ptr[i]) ?
+                    table.distances_ptr[i] :
+                    0
+                ,
+                file_ptr
+            ) != EOF;
+
+    if (!written)
+        THROW(SIM_RC_ERR_BADFILE);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// Constructs a read-only hash table using the buckets of a serialized hash table mapped straight
+//  from a file.
+static void _sim_hash_construct_mapped(
+    _Sim_HashPtr      hash_ptr,
+    const bool        is_hashmap,
+    FILE *const       file_ptr,
+    Sim_HashProc      key_hash_proc,
+    Sim_PredicateProc key_predicate_proc
+) {
+    // check for nullptrs
+    if (!hash_ptr.hashmap_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
-    if (!foreach_proc.set_foreach_proc)
+    if (!key_predicate_proc)
         THROW(SIM_RC_ERR_NULLPTR);
-    
-    uint8** data_ptr = hashmap_ptr->data_ptr;
-    size_t item_num = 0;
+    if (!file_ptr)
+        THROW(SIM_RC_ERR_BADFILE);
+
+    _Sim_HashFileHeader header;
+    if (
+        fseek(file_ptr, 0, SEEK_SET) ||
+        fread(&header, sizeof(_Sim_HashFileHeader), 1, file_ptr) != 1 ||
+        header.magic != _SIM_HASH_FILE_MAGIC ||
+        header.version != _SIM_HASH_FILE_VERSION
+    )
+        THROW(SIM_RC_ERR_BADFILE);
+
+    const Sim_HashFlags flags = (Sim_HashFlags)header.flags;
+    const size_t key_size = (size_t)header.key_size;
+    const size_t value_size = (size_t)header.value_size;
+    const size_t allocated = (size_t)header.allocated;
+
+    // check that the buckets are laid out as this build would lay them out
+    if (
+        !(flags & SIM_HASH_FLAT_STORAGE) ||
+        (!is_hashmap && value_size) ||
+        header.key_size > SIZE_MAX / 2 ||
+        header.value_size > SIZE_MAX / 2 ||
+        header.allocated > SIZE_MAX / 2 ||
+        header.count > header.allocated ||
+        allocated < 2 ||
+        (
+            (flags & (SIM_HASH_GROUP_PROBING | SIM_HASH_POWER_OF_TWO)) &&
+            (allocated & (allocated - 1))
+        ) ||
+        header.slot_size != _sim_hash_get_slot_size(key_size + value_size, flags)
+    )
+        THROW(SIM_RC_ERR_BADFILE);
 
-    // iterate through allocated
-    if (is_hashmap) {
-        for (size_t i = 0; i < hashmap_ptr->_allocated; i++) {
-            // if the item exists...
-            if (data_ptr[i] && data_ptr[i] != (void*)1) {
-                if (!foreach_proc.map_foreach_proc(
-                    data_ptr[i],
-                    (uint8*)data_ptr[i] + hashmap_ptr->_value_size,
-                    item_num,
-                    userdata
-                ))
-                    RETURN(SIM_RC_SUCCESS, false);
-                
-                item_num++;
-            }
-        }
-    } else {
-        for (size_t i = 0; i < hashmap_ptr->_allocated; i++) {
-            // if the item exists...
-            if (data_ptr[i] && data_ptr[i] != (void*)1) {
-                if (!foreach_proc.set_foreach_proc(
-                    data_ptr[i],
-                    item_num,
-                    userdata
-                ))
-                    RETURN(SIM_RC_SUCCESS, false);
-                
-                item_num++;
-            }
+    Sim_HashMap hashmap = {
+        ._key_properties = {
+            .size = key_size,
+            .hash_proc = key_hash_proc,
+            .predicate_proc = key_predicate_proc
+        },
+        ._allocator_ptr = sim_allocator_get_default(),
+        ._initial_size = allocated,
+        ._base_size = allocated,
+        ._allocated = allocated,
+
+        .count = (size_t)header.count,
+        .data_ptr = NULL,
+
+        ._flags = flags,
+        ._slot_size = (size_t)header.slot_size,
+        ._tombstones = (size_t)header.tombstones,
+        ._old_data_ptr = NULL,
+        ._old_allocated = 0,
+        ._migrated = 0,
+        ._resize_count = 0,
+        ._node_block_ptr = NULL,
+        ._node_block_size = 0,
+        ._mapped_ptr = NULL,
+        ._mapped_size = 0,
+        ._thread_count = 1,
+
+        ._value_size = value_size
+    };
+
+    // the file must hold every bucket, or reading past its end would fault
+    size_t hashes_offset, control_offset;
+    const size_t mapped_size = sizeof(_Sim_HashFileHeader) +
+        _sim_hash_get_layout(&hashmap, allocated, &hashes_offset, &control_offset);
+    if (
+        fseek(file_ptr, 0, SEEK_END) ||
+        ftell(file_ptr) < 0 ||
+        (size_t)ftell(file_ptr) < mapped_size
+    )
+        THROW(SIM_RC_ERR_BADFILE);
+
+    uint8 *const mapped_ptr = sim_memmgmt_map_file_ptr(
+        file_ptr,
+        mapped_size,
+        0,
+        SIM_MEMACCESS_READABLE
+    );
+    if (mapped_ptr == (void*)-1)
+        RETURN(sim_get_return_code() ? sim_get_return_code() : SIM_RC_FAILURE,);
+
+    hashmap._mapped_ptr = mapped_ptr;
+    hashmap._mapped_size = mapped_size;
+    hashmap.data_ptr = mapped_ptr + sizeof(_Sim_HashFileHeader);
+
+    // a hash function other than the one the buckets were built with would find nothing
+    const _Sim_HashTable table = _sim_hash_get_table(&hashmap);
+    for (size_t i = 0; i < allocated; i++) {
+        if (!_SIM_HASH_CTRL_IS_FULL(table.control_ptr[i]))
+            continue;
+
+        const uint8 *const item_ptr = _sim_hash_get_item(&hashmap, &table, i);
+        _Sim_HashTable found_table;
+        size_t index;
+
+        if (
+            !_sim_hash_find(
+                &hashmap,
+                item_ptr,
+                _sim_hash_get_hash(&hashmap, item_ptr),
+                &found_table,
+                &index,
+                NULL
+            ) ||
+            index != i
+        ) {
+            sim_memmgmt_unmap(mapped_ptr, mapped_size);
+            THROW(SIM_RC_ERR_INVALARG);
         }
+        break;
     }
 
-    RETURN(SIM_RC_SUCCESS, true);
+    // copy to hash table pointer
+    memcpy(
+        hash_ptr.hashmap_ptr,
+        &hashmap,
+        is_hashmap ?
+            sizeof(Sim_HashMap) :
+            sizeof(Sim_HashSet)
+    );
+
+    RETURN(SIM_RC_SUCCESS,);
 }
 
 // == HASHSET PUBLIC API ==========================================================================
@@ -425,6 +3378,28 @@ void sim_hashset_construct(
     Sim_PredicateProc     item_predicate_proc,
     const Sim_IAllocator* allocator_ptr,
     const size_t          initial_size
+) {
+    sim_hashset_construct_with_flags(
+        hashset_ptr,
+        item_size,
+        item_hash_proc,
+        item_predicate_proc,
+        allocator_ptr,
+        initial_size,
+        SIM_HASH_DEFAULT
+    );
+}
+
+// sim_hashset_construct_with_flags(7): Constructs a new hashset with given storage & probing
+//                                      options.
+void sim_hashset_construct_with_flags(
+    Sim_HashSet*          hashset_ptr,
+    const size_t          item_size,
+    Sim_HashProc          item_hash_proc,
+    Sim_PredicateProc     item_predicate_proc,
+    const Sim_IAllocator* allocator_ptr,
+    const size_t          initial_size,
+    const Sim_HashFlags   flags
 ) {
     _sim_hash_construct(
         ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
@@ -433,7 +3408,65 @@ void sim_hashset_construct(
         item_predicate_proc,
         0,
         allocator_ptr,
-        initial_size
+        initial_size,
+        flags,
+        0
+    );
+}
+
+// sim_hashset_construct_from(7): Constructs a new hashset holding the items of an array.
+void sim_hashset_construct_from(
+    Sim_HashSet *const    hashset_ptr,
+    const size_t          item_size,
+    Sim_HashProc          item_hash_proc,
+    Sim_PredicateProc     item_predicate_proc,
+    const Sim_IAllocator* allocator_ptr,
+    const Sim_HashFlags   flags,
+    const void *const     items_ptr,
+    const size_t          item_count
+) {
+    _sim_hash_construct_from(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        item_size,
+        item_hash_proc,
+        item_predicate_proc,
+        0,
+        allocator_ptr,
+        flags,
+        items_ptr,
+        item_size,
+        NULL,
+        0,
+        item_count
+    );
+}
+
+// sim_hashset_construct_mapped(4): Constructs a read-only hashset mapped from a file written by
+//  sim_hashset_serialize.
+void sim_hashset_construct_mapped(
+    Sim_HashSet *const hashset_ptr,
+    FILE *const        file_ptr,
+    Sim_HashProc       item_hash_proc,
+    Sim_PredicateProc  item_predicate_proc
+) {
+    _sim_hash_construct_mapped(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        false,
+        file_ptr,
+        item_hash_proc,
+        item_predicate_proc
+    );
+}
+
+// sim_hashset_serialize(2): Writes a hashset to a file that can be mapped back in.
+void sim_hashset_serialize(
+    Sim_HashSet *const hashset_ptr,
+    FILE *const        file_ptr
+) {
+    _sim_hash_serialize(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        false,
+        file_ptr
     );
 }
 
@@ -475,6 +3508,49 @@ bool sim_hashset_contains(
     );
 }
 
+// sim_hashset_contains_many(4): Checks which of a batch of items are contained in a hashset.
+size_t sim_hashset_contains_many(
+    Sim_HashSet *const hashset_ptr,
+    const void*        items_ptr,
+    const size_t       item_count,
+    bool *const        out_contained_ptr
+) {
+    if (!hashset_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_contained_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!items_ptr && item_count)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t found_count = _sim_hash_find_many(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        items_ptr,
+        item_count,
+        NULL,
+        out_contained_ptr
+    );
+
+    RETURN(
+        (found_count == item_count) ?
+            SIM_RC_SUCCESS :
+            SIM_RC_NOT_FOUND
+        ,
+        found_count
+    );
+}
+
+// sim_hashset_get_stats(2): Gathers a snapshot of a hashset's load, probe lengths, & memory use.
+void sim_hashset_get_stats(
+    Sim_HashSet *const   hashset_ptr,
+    Sim_HashStats *const out_stats_ptr
+) {
+    _sim_hash_get_stats(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        false,
+        out_stats_ptr
+    );
+}
+
 // sim_hashset_resize(2): Resizes a hashset to a given size.
 void sim_hashset_resize(
     Sim_HashSet *const hashset_ptr,
@@ -491,6 +3567,18 @@ void sim_hashset_resize(
     );
 }
 
+// sim_hashset_set_thread_count(2): Sets the most threads a hashset's resizes use.
+void sim_hashset_set_thread_count(
+    Sim_HashSet *const hashset_ptr,
+    const size_t       thread_count
+) {
+    if (!hashset_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    hashset_ptr->_thread_count = thread_count ? thread_count : 1;
+    RETURN(SIM_RC_SUCCESS,);
+}
+
 // sim_hashset_add(2): Adds an item into a hashset.
 void sim_hashset_insert(
     Sim_HashSet *const hashset_ptr,
@@ -540,6 +3628,56 @@ bool sim_hashset_foreach(
     );
 }
 
+// sim_hashset_union(3): Adds the items of another hashset to a hashset or to an output hashset.
+void sim_hashset_union(
+    Sim_HashSet *const hashset_ptr,
+    Sim_HashSet *const other_hashset_ptr,
+    Sim_HashSet *const out_hashset_ptr
+) {
+    _sim_hash_union(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = other_hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = out_hashset_ptr })
+    );
+}
+
+// sim_hashset_intersect(3): Keeps the items two hashsets have in common.
+void sim_hashset_intersect(
+    Sim_HashSet *const hashset_ptr,
+    Sim_HashSet *const other_hashset_ptr,
+    Sim_HashSet *const out_hashset_ptr
+) {
+    _sim_hash_intersect(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = other_hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = out_hashset_ptr })
+    );
+}
+
+// sim_hashset_difference(3): Keeps the items of a hashset that aren't in another hashset.
+void sim_hashset_difference(
+    Sim_HashSet *const hashset_ptr,
+    Sim_HashSet *const other_hashset_ptr,
+    Sim_HashSet *const out_hashset_ptr
+) {
+    _sim_hash_difference(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = other_hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = out_hashset_ptr })
+    );
+}
+
+// sim_hashset_is_subset(2): Checks if every item of a hashset is also in another hashset.
+bool sim_hashset_is_subset(
+    Sim_HashSet *const hashset_ptr,
+    Sim_HashSet *const other_hashset_ptr
+) {
+    return _sim_hash_is_subset(
+        ((_Sim_HashPtr){ .hashset_ptr = hashset_ptr }),
+        ((_Sim_HashPtr){ .hashset_ptr = other_hashset_ptr })
+    );
+}
+
 // == HASHMAP PUBLIC API ==========================================================================
 
 // sim_hashmap_construct(7): Initializes a new hashmap.
@@ -551,6 +3689,30 @@ void sim_hashmap_construct(
     const size_t          value_size,
     const Sim_IAllocator* allocator_ptr,
     const size_t          initial_size
+) {
+    sim_hashmap_construct_with_flags(
+        hashmap_ptr,
+        key_size,
+        key_hash_proc,
+        key_predicate_proc,
+        value_size,
+        allocator_ptr,
+        initial_size,
+        SIM_HASH_DEFAULT
+    );
+}
+
+// sim_hashmap_construct_with_flags(8): Initializes a new hashmap with given storage & probing
+//                                      options.
+void sim_hashmap_construct_with_flags(
+    Sim_HashMap *const    hashmap_ptr,
+    const size_t          key_size,
+    Sim_HashProc          key_hash_proc,
+    Sim_PredicateProc     key_predicate_proc,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const size_t          initial_size,
+    const Sim_HashFlags   flags
 ) {
     _sim_hash_construct(
         ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
@@ -559,7 +3721,109 @@ void sim_hashmap_construct(
         key_predicate_proc,
         value_size,
         allocator_ptr,
-        initial_size
+        initial_size,
+        flags,
+        0
+    );
+}
+
+// sim_hashmap_construct_from(10): Constructs a new hashmap holding the key-value pairs of parallel
+//  arrays.
+void sim_hashmap_construct_from(
+    Sim_HashMap *const    hashmap_ptr,
+    const size_t          key_size,
+    Sim_HashProc          key_hash_proc,
+    Sim_PredicateProc     key_predicate_proc,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const Sim_HashFlags   flags,
+    const void *const     keys_ptr,
+    const void *const     values_ptr,
+    const size_t          item_count
+) {
+    _sim_hash_construct_from(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        key_size,
+        key_hash_proc,
+        key_predicate_proc,
+        value_size,
+        allocator_ptr,
+        flags,
+        keys_ptr,
+        key_size,
+        values_ptr,
+        value_size,
+        item_count
+    );
+}
+
+// sim_hashmap_construct_from_vector(8): Constructs a new hashmap holding the key-value pairs in a
+//  vector.
+void sim_hashmap_construct_from_vector(
+    Sim_HashMap *const      hashmap_ptr,
+    const size_t            key_size,
+    Sim_HashProc            key_hash_proc,
+    Sim_PredicateProc       key_predicate_proc,
+    const size_t            value_size,
+    const Sim_IAllocator*   allocator_ptr,
+    const Sim_HashFlags     flags,
+    const Sim_Vector *const pairs_vector_ptr
+) {
+    // check for nullptr
+    if (!pairs_vector_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // each pair is a key followed by its value
+    if (pairs_vector_ptr->_item_size != key_size + value_size)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    const uint8 *const pairs_ptr = pairs_vector_ptr->data_ptr;
+
+    _sim_hash_construct_from(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        key_size,
+        key_hash_proc,
+        key_predicate_proc,
+        value_size,
+        allocator_ptr,
+        flags,
+        pairs_ptr,
+        key_size + value_size,
+        pairs_ptr ?
+            pairs_ptr + key_size :
+            NULL
+        ,
+        key_size + value_size,
+        pairs_vector_ptr->count
+    );
+}
+
+// sim_hashmap_construct_mapped(4): Constructs a read-only hashmap mapped from a file written by
+//  sim_hashmap_serialize.
+void sim_hashmap_construct_mapped(
+    Sim_HashMap *const hashmap_ptr,
+    FILE *const        file_ptr,
+    Sim_HashProc       key_hash_proc,
+    Sim_PredicateProc  key_predicate_proc
+) {
+    _sim_hash_construct_mapped(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        true,
+        file_ptr,
+        key_hash_proc,
+        key_predicate_proc
+    );
+}
+
+// sim_hashmap_serialize(2): Writes a hashmap to a file that can be mapped back in.
+void sim_hashmap_serialize(
+    Sim_HashMap *const hashmap_ptr,
+    FILE *const        file_ptr
+) {
+    _sim_hash_serialize(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        true,
+        file_ptr
     );
 }
 
@@ -581,6 +3845,15 @@ bool sim_hashmap_is_empty(Sim_HashMap *const hashmap_ptr) {
     RETURN(SIM_RC_SUCCESS, hashmap_ptr->count == 0);
 }
 
+// sim_hashmap_clear(1): Clears a hashmap of all its contents.
+void sim_hashmap_clear(
+    Sim_HashMap *const hashmap_ptr
+) {
+    _sim_hash_clear(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr })
+    );
+}
+
 // sim_hashmap_contains_key(2): Checks if a key is contained in the hashmap.
 bool sim_hashmap_contains_key(
     Sim_HashMap *const hashmap_ptr,
@@ -592,6 +3865,18 @@ bool sim_hashmap_contains_key(
     );
 }
 
+// sim_hashmap_get_stats(2): Gathers a snapshot of a hashmap's load, probe lengths, & memory use.
+void sim_hashmap_get_stats(
+    Sim_HashMap *const   hashmap_ptr,
+    Sim_HashStats *const out_stats_ptr
+) {
+    _sim_hash_get_stats(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        true,
+        out_stats_ptr
+    );
+}
+
 // sim_hashmap_resize(2): Resize the hashmap to a new size.
 void sim_hashmap_resize(
     Sim_HashMap *const hashmap_ptr,
@@ -608,6 +3893,18 @@ void sim_hashmap_resize(
     );
 }
 
+// sim_hashmap_set_thread_count(2): Sets the most threads a hashmap's resizes & bulk inserts use.
+void sim_hashmap_set_thread_count(
+    Sim_HashMap *const hashmap_ptr,
+    const size_t       thread_count
+) {
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    hashmap_ptr->_thread_count = thread_count ? thread_count : 1;
+    RETURN(SIM_RC_SUCCESS,);
+}
+
 // sim_hashmap_get_ptr(2): Get pointer to value in a hashmap via a given key.
 void* sim_hashmap_get_ptr(
     Sim_HashMap *const hashmap_ptr,
@@ -618,13 +3915,64 @@ void* sim_hashmap_get_ptr(
     else if (!key_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
     
-    HASH_IF_CONTAIN(hashmap_ptr, key_ptr,
-        RETURN(SIM_RC_SUCCESS, current_node_ptr + hashmap_ptr->_key_properties.size);
+    _sim_hash_migrate(hashmap_ptr, _SIM_HASH_MIGRATION_STEP);
+
+    _Sim_HashTable table;
+    size_t index;
+    size_t probes = 0;
+
+    const bool found = _sim_hash_find(
+        hashmap_ptr,
+        key_ptr,
+        _sim_hash_get_hash(hashmap_ptr, key_ptr),
+        &table,
+        &index,
+        _SIM_HASH_PROBES_PTR(&probes)
     );
+    _SIM_HASH_COUNT(hashmap_ptr, lookups, 1);
+    _SIM_HASH_COUNT(hashmap_ptr, lookup_probes, probes);
+
+    if (found)
+        RETURN(
+            SIM_RC_SUCCESS,
+            _sim_hash_get_item(hashmap_ptr, &table, index) + hashmap_ptr->_key_properties.size
+        );
 
     RETURN(SIM_RC_NOT_FOUND, NULL);
 }
 
+// sim_hashmap_get_many(4): Get pointers to the values in a hashmap associated with each of a
+//                          batch of keys.
+size_t sim_hashmap_get_many(
+    Sim_HashMap *const hashmap_ptr,
+    const void*        keys_ptr,
+    const size_t       key_count,
+    void* *const       out_value_ptrs
+) {
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_value_ptrs)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!keys_ptr && key_count)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t found_count = _sim_hash_find_many(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        keys_ptr,
+        key_count,
+        out_value_ptrs,
+        NULL
+    );
+
+    RETURN(
+        (found_count == key_count) ?
+            SIM_RC_SUCCESS :
+            SIM_RC_NOT_FOUND
+        ,
+        found_count
+    );
+}
+
 // sim_hashmap_get(3): Get a value from a hashmap via a given key.
 void sim_hashmap_get(
     Sim_HashMap *const hashmap_ptr,
@@ -636,7 +3984,7 @@ void sim_hashmap_get(
     if (!out_value_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
 
-    // use get_ptr to save on macro-expanded code >:^)
+    // use get_ptr to avoid duplicating the lookup
     value_ptr = sim_hashmap_get_ptr(hashmap_ptr, key_ptr);
     THROW(sim_get_return_code());
     if (sim_get_return_code() > 0)
@@ -673,6 +4021,28 @@ void sim_hashmap_insert(
     );
 }
 
+// sim_hashmap_insert_many(4): Inserts a batch of key-value pairs into the hashmap, overwriting
+//                             pre-existing pairs with the same keys.
+void sim_hashmap_insert_many(
+    Sim_HashMap *const hashmap_ptr,
+    const void*        keys_ptr,
+    const void*        values_ptr,
+    const size_t       item_count
+) {
+    // check for nullptrs
+    if (!hashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if ((!keys_ptr || !values_ptr) && item_count)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_hash_insert_many(
+        ((_Sim_HashPtr){ .hashmap_ptr = hashmap_ptr }),
+        keys_ptr,
+        values_ptr,
+        item_count
+    );
+}
+
 // sim_hashmap_remove(2): Removes a key-value pair from the hashmap via a key.
 void sim_hashmap_remove(
     Sim_HashMap *const hashmap_ptr,
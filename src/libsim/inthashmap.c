@@ -0,0 +1,472 @@
+/**
+ * @file inthashmap.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Source file/implementation for simsoft/inthashmap.h
+ * @version 0.1
+ * @date 2020-02-18
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_INTHASHMAP_C_
+#define SIMSOFT_INTHASHMAP_C_
+
+#include <string.h>
+
+#include "simsoft/inthashmap.h"
+#include "./_internal.h"
+
+// == INTEGER HASHMAP =============================================================================
+//  Keys are 64-bit integers stored inline at the front of each slot. A key is placed by Fibonacci
+//  hashing: multiplying by 2^64 / phi & keeping the top bits spreads even sequential IDs evenly
+//  over a power of 2 sized table. Empty slots hold a reserved key, so probing only ever compares
+//  integers.
+
+#define _SIM_INTHASH_MULTIPLIER 0x9e3779b97f4a7c15ULL // 2^64 / golden ratio
+
+// Calculates the slot a key hashes to in an integer hashmap.
+static inline size_t _sim_inthash_get_home(
+    const uint64 key,
+    const size_t shift
+) {
+    return (size_t)((key * _SIM_INTHASH_MULTIPLIER) >> shift);
+}
+
+// Retrieves the key at the front of a slot.
+static inline uint64 _sim_inthash_get_key(
+    const uint8 *const slot_ptr
+) {
+    return *(const uint64*)slot_ptr;
+}
+
+// Copies a value into or out of a slot; common value sizes are copied with a single move.
+static inline void _sim_inthash_copy_value(
+    void *const       dest_ptr,
+    const void *const src_ptr,
+    const size_t      value_size
+) {
+    switch (value_size) {
+        case 0:
+            break;
+        case sizeof(uint32):
+            memcpy(dest_ptr, src_ptr, sizeof(uint32));
+            break;
+        case sizeof(uint64):
+            memcpy(dest_ptr, src_ptr, sizeof(uint64));
+            break;
+        default:
+            memcpy(dest_ptr, src_ptr, value_size);
+    }
+}
+
+// Allocates slots for an integer hashmap & marks each of them as empty.
+static uint8* _sim_inthash_alloc_slots(
+    const Sim_IAllocator *const allocator_ptr,
+    const size_t                slot_size,
+    const size_t                slot_count,
+    const uint64                empty_key
+) {
+    // check for overflow
+    if (slot_count > SIZE_MAX / slot_size)
+        return NULL;
+
+    // empty keys whose bytes are all the same can be filled in by the allocator
+    if (empty_key == 0 || empty_key == UINT64_MAX)
+        return allocator_ptr->falloc(slot_size * slot_count, (uint8)empty_key);
+
+    uint8 *const slots_ptr = allocator_ptr->malloc(slot_size * slot_count);
+    if (slots_ptr)
+        for (size_t i = 0; i < slot_count; i++)
+            *(uint64*)(slots_ptr + (slot_size * i)) = empty_key;
+
+    return slots_ptr;
+}
+
+// Finds the slot holding a key in an integer hashmap, or the empty slot it would be inserted
+//  into. The hashmap is never full, so an empty slot always ends the probe.
+static inline uint8* _sim_inthash_probe(
+    const Sim_IntHashMap *const inthashmap_ptr,
+    const uint64                key
+) {
+    uint8 *const slots_ptr = inthashmap_ptr->data_ptr;
+    const size_t slot_size = inthashmap_ptr->_slot_size;
+    const size_t mask = inthashmap_ptr->_allocated - 1;
+    const uint64 empty_key = inthashmap_ptr->_empty_key;
+
+    size_t index = _sim_inthash_get_home(key, inthashmap_ptr->_shift);
+    for (;;) {
+        uint8 *const slot_ptr = slots_ptr + (slot_size * index);
+        const uint64 slot_key = _sim_inthash_get_key(slot_ptr);
+
+        if ((slot_key == key) | (slot_key == empty_key))
+            return slot_ptr;
+        index = (index + 1) & mask;
+    }
+}
+
+// Finds the slot holding a key in an integer hashmap; NULL if it isn't contained in it.
+static inline uint8* _sim_inthash_find(
+    const Sim_IntHashMap *const inthashmap_ptr,
+    const uint64                key
+) {
+    uint8 *const slot_ptr = _sim_inthash_probe(inthashmap_ptr, key);
+
+    return (_sim_inthash_get_key(slot_ptr) == key) ? slot_ptr : NULL;
+}
+
+// Moves an integer hashmap's pairs into a new set of slots.
+static bool _sim_inthash_rebuild(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const size_t          new_size
+) {
+    const size_t slot_size = inthashmap_ptr->_slot_size;
+    const uint64 empty_key = inthashmap_ptr->_empty_key;
+
+    uint8 *const new_slots_ptr = _sim_inthash_alloc_slots(
+        inthashmap_ptr->_allocator_ptr,
+        slot_size,
+        new_size,
+        empty_key
+    );
+    if (!new_slots_ptr)
+        return false;
+
+    uint8 *const old_slots_ptr = inthashmap_ptr->data_ptr;
+    const size_t old_size = inthashmap_ptr->_allocated;
+
+    size_t shift = sizeof(uint64) * 8;
+    for (size_t size = new_size; size > 1; size >>= 1)
+        shift--;
+
+    inthashmap_ptr->data_ptr = new_slots_ptr;
+    inthashmap_ptr->_allocated = new_size;
+    inthashmap_ptr->_shift = shift;
+
+    // keys are distinct, so each one just takes the first empty slot it probes
+    for (size_t i = 0; i < old_size; i++) {
+        const uint8 *const old_slot_ptr = old_slots_ptr + (slot_size * i);
+
+        if (_sim_inthash_get_key(old_slot_ptr) != empty_key)
+            memcpy(
+                _sim_inthash_probe(inthashmap_ptr, _sim_inthash_get_key(old_slot_ptr)),
+                old_slot_ptr,
+                slot_size
+            );
+    }
+
+    inthashmap_ptr->_allocator_ptr->free(old_slots_ptr);
+    return true;
+}
+
+// Calculates the power of 2 amount of slots an integer hashmap should allocate to hold a given
+//  size.
+static inline size_t _sim_inthash_get_capacity(
+    const size_t size
+) {
+    size_t capacity = 2;
+    while (capacity < size && capacity <= (SIZE_MAX >> 1))
+        capacity <<= 1;
+    return capacity;
+}
+
+// Empties the slot at an index in an integer hashmap, shifting later keys of the same run back
+//  into the gap so lookups never need tombstones.
+static void _sim_inthash_erase(
+    Sim_IntHashMap *const inthashmap_ptr,
+    size_t                hole
+) {
+    uint8 *const slots_ptr = inthashmap_ptr->data_ptr;
+    const size_t slot_size = inthashmap_ptr->_slot_size;
+    const size_t mask = inthashmap_ptr->_allocated - 1;
+    const uint64 empty_key = inthashmap_ptr->_empty_key;
+
+    for (size_t index = (hole + 1) & mask;; index = (index + 1) & mask) {
+        const uint8 *const slot_ptr = slots_ptr + (slot_size * index);
+        const uint64 key = _sim_inthash_get_key(slot_ptr);
+        if (key == empty_key)
+            break;
+
+        // keys may only move back as far as their home slot
+        const size_t home = _sim_inthash_get_home(key, inthashmap_ptr->_shift);
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            memcpy(slots_ptr + (slot_size * hole), slot_ptr, slot_size);
+            hole = index;
+        }
+    }
+
+    *(uint64*)(slots_ptr + (slot_size * hole)) = empty_key;
+}
+
+// -- Integer hashmap public API ------------------------------------------------------------------
+
+// sim_inthashmap_construct(5): Constructs a new integer-keyed hashmap.
+void sim_inthashmap_construct(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const size_t          value_size,
+    const Sim_IAllocator* allocator_ptr,
+    const size_t          initial_size,
+    const uint64          empty_key
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // check for overflow
+    if (value_size > SIZE_MAX / 2)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
+
+    // keep keys 8-byte aligned by padding values up to a multiple of 8
+    const size_t slot_size = sizeof(uint64) +
+        ((value_size + sizeof(uint64) - 1) & ~(sizeof(uint64) - 1));
+    const size_t starting_size = _sim_inthash_get_capacity(
+        (initial_size < SIM_HASH_DEFAULT_SIZE) ?
+            SIM_HASH_DEFAULT_SIZE :
+            initial_size
+    );
+
+    Sim_IntHashMap inthashmap = {
+        ._allocator_ptr = allocator_ptr,
+        ._initial_size = starting_size,
+        ._allocated = 0,
+        ._shift = 0,
+
+        .count = 0,
+        .data_ptr = NULL,
+
+        ._slot_size = slot_size,
+        ._empty_key = empty_key,
+
+        ._value_size = value_size
+    };
+
+    if (!_sim_inthash_rebuild(&inthashmap, starting_size))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    memcpy(inthashmap_ptr, &inthashmap, sizeof(Sim_IntHashMap));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_destroy(1): Destroys an integer-keyed hashmap.
+void sim_inthashmap_destroy(
+    Sim_IntHashMap *const inthashmap_ptr
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    inthashmap_ptr->_allocator_ptr->free(inthashmap_ptr->data_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_clear(1): Clears an integer-keyed hashmap of all its contents.
+void sim_inthashmap_clear(
+    Sim_IntHashMap *const inthashmap_ptr
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    uint8 *const slots_ptr = inthashmap_ptr->data_ptr;
+    for (size_t i = 0; i < inthashmap_ptr->_allocated; i++)
+        *(uint64*)(slots_ptr + (inthashmap_ptr->_slot_size * i)) = inthashmap_ptr->_empty_key;
+    inthashmap_ptr->count = 0;
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_contains_key(2): Checks if a key is contained in an integer-keyed hashmap.
+bool sim_inthashmap_contains_key(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const uint64          key
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // the empty key marks empty slots, so it would always be "found"
+    if (key == inthashmap_ptr->_empty_key)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    if (_sim_inthash_find(inthashmap_ptr, key))
+        RETURN(SIM_RC_SUCCESS, true);
+    RETURN(SIM_RC_NOT_FOUND, false);
+}
+
+// sim_inthashmap_get_ptr(2): Get pointer to value in an integer-keyed hashmap via a particular
+//                            key.
+void* sim_inthashmap_get_ptr(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const uint64          key
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (key == inthashmap_ptr->_empty_key)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    uint8 *const slot_ptr = _sim_inthash_find(inthashmap_ptr, key);
+
+    if (slot_ptr)
+        RETURN(SIM_RC_SUCCESS, slot_ptr + sizeof(uint64));
+    RETURN(SIM_RC_NOT_FOUND, NULL);
+}
+
+// sim_inthashmap_get(3): Get a value from an integer-keyed hashmap via a particular key.
+void sim_inthashmap_get(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const uint64          key,
+    void*                 out_value_ptr
+) {
+    // check for nullptrs
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (key == inthashmap_ptr->_empty_key)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    const uint8 *const slot_ptr = _sim_inthash_find(inthashmap_ptr, key);
+    if (!slot_ptr)
+        RETURN(SIM_RC_NOT_FOUND,);
+
+    _sim_inthash_copy_value(out_value_ptr, slot_ptr + sizeof(uint64), inthashmap_ptr->_value_size);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_insert(3): Inserts a key-value pair into an integer-keyed hashmap or overwrites
+//                           a pre-existing pair's value.
+void sim_inthashmap_insert(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const uint64          key,
+    const void*           value_ptr
+) {
+    // check for nullptrs
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!value_ptr && inthashmap_ptr->_value_size)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (key == inthashmap_ptr->_empty_key)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    uint8* slot_ptr = _sim_inthash_probe(inthashmap_ptr, key);
+
+    if (_sim_inthash_get_key(slot_ptr) != key) {
+        // check how much of the hashmap is used & resize up if necessary
+        if ((inthashmap_ptr->count + 1) * 100 / inthashmap_ptr->_allocated > 70) {
+            if (
+                inthashmap_ptr->_allocated > (SIZE_MAX >> 1) ||
+                !_sim_inthash_rebuild(inthashmap_ptr, inthashmap_ptr->_allocated * 2)
+            )
+                THROW(SIM_RC_ERR_OUTOFMEM);
+            slot_ptr = _sim_inthash_probe(inthashmap_ptr, key);
+        }
+
+        *(uint64*)slot_ptr = key;
+        inthashmap_ptr->count++;
+    }
+
+    _sim_inthash_copy_value(slot_ptr + sizeof(uint64), value_ptr, inthashmap_ptr->_value_size);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_remove(2): Removes a key-value pair from an integer-keyed hashmap via a key.
+void sim_inthashmap_remove(
+    Sim_IntHashMap *const inthashmap_ptr,
+    const uint64          key
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (key == inthashmap_ptr->_empty_key)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    // check how much of the hashmap is used & resize down if necessary
+    if (
+        inthashmap_ptr->count * 100 / inthashmap_ptr->_allocated < 10 &&
+        inthashmap_ptr->_allocated > inthashmap_ptr->_initial_size
+    )
+        if (!_sim_inthash_rebuild(inthashmap_ptr, inthashmap_ptr->_allocated / 2))
+            THROW(SIM_RC_ERR_OUTOFMEM);
+
+    uint8 *const slot_ptr = _sim_inthash_find(inthashmap_ptr, key);
+    if (!slot_ptr)
+        RETURN(SIM_RC_FAILURE,);
+
+    _sim_inthash_erase(
+        inthashmap_ptr,
+        (size_t)(slot_ptr - (uint8*)inthashmap_ptr->data_ptr) / inthashmap_ptr->_slot_size
+    );
+    inthashmap_ptr->count--;
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_resize(2): Resizes an integer-keyed hashmap to hold at least a given amount of
+//                           slots.
+void sim_inthashmap_resize(
+    Sim_IntHashMap *const inthashmap_ptr,
+    size_t                new_size
+) {
+    // check for nullptr
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (new_size < inthashmap_ptr->count)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    // keep the pairs under the 70% load at which the hashmap grows
+    if (new_size < inthashmap_ptr->count + (inthashmap_ptr->count / 7) * 3 + 3)
+        new_size = inthashmap_ptr->count + (inthashmap_ptr->count / 7) * 3 + 3;
+
+    // resize only if larger than or equal to the initial size
+    new_size = _sim_inthash_get_capacity(
+        (new_size < inthashmap_ptr->_initial_size) ?
+            inthashmap_ptr->_initial_size :
+            new_size
+    );
+
+    if (new_size != inthashmap_ptr->_allocated && !_sim_inthash_rebuild(inthashmap_ptr, new_size))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_inthashmap_foreach(3): Applies a given function to each key-value pair in an integer-keyed
+//                            hashmap.
+bool sim_inthashmap_foreach(
+    Sim_IntHashMap *const inthashmap_ptr,
+    Sim_MapForEachProc    foreach_proc,
+    Sim_Variant           userdata
+) {
+    // check for nullptrs
+    if (!inthashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!foreach_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t index = 0;
+    for (size_t i = 0; i < inthashmap_ptr->_allocated; i++) {
+        uint8 *const slot_ptr = (uint8*)inthashmap_ptr->data_ptr + (inthashmap_ptr->_slot_size * i);
+
+        if (_sim_inthash_get_key(slot_ptr) == inthashmap_ptr->_empty_key)
+            continue;
+
+        if (!(*foreach_proc)(slot_ptr, slot_ptr + sizeof(uint64), index++, userdata))
+            RETURN(SIM_RC_SUCCESS, false);
+    }
+
+    RETURN(SIM_RC_SUCCESS, true);
+}
+
+#endif /* SIMSOFT_INTHASHMAP_C_ */
@@ -0,0 +1,859 @@
+/**
+ * @file lfhashmap.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Source file/implementation for simsoft/lfhashmap.h
+ * @version 0.1
+ * @date 2020-02-09
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_LFHASHMAP_C_
+#define SIMSOFT_LFHASHMAP_C_
+
+#include <string.h>
+
+#include "simsoft/lfhashmap.h"
+#include "./_hash.h"
+
+// == LOCK-FREE HASHMAP ===========================================================================
+
+// -- Epoch-based reclamation ---------------------------------------------------------------------
+//  Readers announce the global epoch they started reading in. Writers tag each unlinked object with
+//  the epoch it was retired in, & the global epoch only advances once every reader has announced
+//  the current one. An object retired in epoch e can't be reachable by any reader once the global
+//  epoch reaches e + 2, so it's freed then.
+
+// Reader record of a thread; each thread that has read from a lock-free hashmap owns one
+typedef struct _Sim_EpochRecord {
+    size_t epoch;   // epoch the thread's read-side section started in; 0 outside of one
+    size_t in_use;  // 1 while owned by a live thread
+    size_t nesting; // depth of nested read-side sections; only accessed by the owning thread
+    struct _Sim_EpochRecord* next_ptr; // next record; never changes once published
+} _Sim_EpochRecord;
+
+// Size of each reader record; padded to a cache line so that readers never share one
+#define _SIM_EPOCH_RECORD_SIZE ((sizeof(_Sim_EpochRecord) + 63) & ~(size_t)63)
+
+static size_t _sim_epoch_global = 1;                    // current global epoch
+static _Sim_EpochRecord* _sim_epoch_records_ptr = NULL; // every thread's reader record
+static _Sim_Once _sim_epoch_once = _SIM_ONCE_INIT;
+static _Sim_ThreadKey _sim_epoch_key; // releases a thread's reader record when it exits
+static bool _sim_epoch_key_created = false;
+
+static THREAD_LOCAL _Sim_EpochRecord* _sim_epoch_record_ptr = NULL;
+
+// Releases an exited thread's reader record so that another thread may reuse it.
+static void _SIM_THREAD_KEY_CALL _sim_epoch_release_record(
+    void* record_ptr
+) {
+    _Sim_EpochRecord *const epoch_record_ptr = (_Sim_EpochRecord*)record_ptr;
+
+    epoch_record_ptr->nesting = 0;
+    _sim_atomic_store_size(&epoch_record_ptr->epoch, 0);
+    _sim_atomic_store_size(&epoch_record_ptr->in_use, 0);
+}
+
+// Creates the thread key used to release reader records.
+static void _sim_epoch_create_key(void) {
+    _sim_epoch_key_created = _sim_thread_key_create(&_sim_epoch_key, _sim_epoch_release_record);
+}
+
+// Retrieves the current thread's reader record, claiming or allocating one if needed.
+//  Returns NULL if a record couldn't be allocated.
+static _Sim_EpochRecord* _sim_epoch_get_record(void) {
+    if (_sim_epoch_record_ptr)
+        return _sim_epoch_record_ptr;
+
+    _sim_once(&_sim_epoch_once, _sim_epoch_create_key);
+
+    // reuse the record of a thread that has exited
+    _Sim_EpochRecord* record_ptr = _sim_atomic_load_ptr(&_sim_epoch_records_ptr);
+    for (; record_ptr; record_ptr = record_ptr->next_ptr)
+        if (
+            !_sim_atomic_load_size(&record_ptr->in_use) &&
+            _sim_atomic_cas_size(&record_ptr->in_use, 0, 1)
+        )
+            break;
+
+    if (!record_ptr) {
+        // records are never freed, so the unaligned allocation doesn't need to be kept
+        uint8 *const allocation_ptr = malloc(_SIM_EPOCH_RECORD_SIZE + 63);
+        if (!allocation_ptr)
+            return NULL;
+
+        record_ptr = (_Sim_EpochRecord*)(((uintptr_t)allocation_ptr + 63) & ~(uintptr_t)63);
+        memset(record_ptr, 0, sizeof(_Sim_EpochRecord));
+        record_ptr->in_use = 1;
+
+        do
+            record_ptr->next_ptr = _sim_atomic_load_ptr(&_sim_epoch_records_ptr);
+        while (!_sim_atomic_cas_ptr(&_sim_epoch_records_ptr, record_ptr->next_ptr, record_ptr));
+    }
+
+    if (_sim_epoch_key_created)
+        _sim_thread_key_set(_sim_epoch_key, record_ptr);
+
+    return _sim_epoch_record_ptr = record_ptr;
+}
+
+// Enters a read-side section on the current thread.
+//  Returns false if the thread's reader record couldn't be allocated.
+static bool _sim_epoch_enter(void) {
+    _Sim_EpochRecord *const record_ptr = _sim_epoch_get_record();
+    if (!record_ptr)
+        return false;
+
+    // the announcement must be visible to writers before any shared pointer is loaded
+    if (record_ptr->nesting++ == 0)
+        (void)_sim_atomic_exchange_size(
+            &record_ptr->epoch,
+            _sim_atomic_load_size(&_sim_epoch_global)
+        );
+
+    return true;
+}
+
+// Leaves a read-side section on the current thread.
+static void _sim_epoch_exit(void) {
+    _Sim_EpochRecord *const record_ptr = _sim_epoch_record_ptr;
+
+    if (record_ptr && record_ptr->nesting && --record_ptr->nesting == 0)
+        _sim_atomic_store_size(&record_ptr->epoch, 0);
+}
+
+// Advances the global epoch if every thread inside a read-side section has announced it.
+//  Returns the global epoch.
+static size_t _sim_epoch_try_advance(void) {
+    const size_t epoch = _sim_atomic_load_size(&_sim_epoch_global);
+
+    for (
+        _Sim_EpochRecord* record_ptr = _sim_atomic_load_ptr(&_sim_epoch_records_ptr);
+        record_ptr;
+        record_ptr = record_ptr->next_ptr
+    ) {
+        const size_t record_epoch = _sim_atomic_load_size(&record_ptr->epoch);
+
+        if (record_epoch && record_epoch != epoch)
+            return epoch;
+    }
+
+    // another writer may have advanced it first
+    if (_sim_atomic_cas_size(&_sim_epoch_global, epoch, epoch + 1))
+        return epoch + 1;
+    return _sim_atomic_load_size(&_sim_epoch_global);
+}
+
+// -- Lock-free hashmap internals -----------------------------------------------------------------
+
+#define _SIM_LFHASH_MIN_BUCKETS 8 // minimum amount of buckets in a lock-free hashmap's table
+
+// Header of objects waiting to be reclaimed
+typedef struct _Sim_LFHashRetired {
+    struct _Sim_LFHashRetired* next_ptr; // next retired object; older objects come later
+    size_t epoch;  // epoch the object was retired in
+    bool is_table; // whether the object is a bucket table (which owns its nodes) or a node
+} _Sim_LFHashRetired;
+
+// Lock-free hashmap node; immutable once published. Followed by its key, then its value.
+typedef struct _Sim_LFHashNode {
+    _Sim_LFHashRetired retired;       // reclamation header
+    struct _Sim_LFHashNode* next_ptr; // next node in the bucket's chain
+    Sim_HashType hash;                // hash of the node's key
+} _Sim_LFHashNode;
+
+// Lock-free hashmap bucket table
+typedef struct _Sim_LFHashTable {
+    _Sim_LFHashRetired retired; // reclamation header
+    size_t bucket_count;        // amount of buckets; always a power of 2
+    _Sim_LFHashNode* buckets[]; // chain heads
+} _Sim_LFHashTable;
+
+// Lock-free hashmap writer state
+typedef struct _Sim_LFHashWriter {
+    _Sim_RWLock lock;                // serializes writers; never taken by readers
+    _Sim_LFHashRetired* retired_ptr; // objects waiting to be reclaimed; newest first
+} _Sim_LFHashWriter;
+
+// Writer lock held by the current thread; released if an exception is thrown while it's held
+static THREAD_LOCAL _Sim_RWLock* _sim_lfhashmap_held_lock_ptr = NULL;
+static THREAD_LOCAL bool _sim_lfhashmap_on_throw_registered = false;
+
+// Nesting depth the current thread's read-side sections are unwound to if an exception is thrown
+//  inside one the library entered itself; SIZE_MAX outside of those. Sections started by
+//  sim_lfhashmap_read_begin() are left for sim_lfhashmap_read_end().
+static THREAD_LOCAL size_t _sim_lfhashmap_unwind_nesting = SIZE_MAX;
+
+// Releases the current thread's writer lock & leaves the read-side sections the library entered
+//  when an exception is thrown.
+static void _sim_lfhashmap_on_throw(
+    Sim_ReturnCode error_code
+) {
+    (void)error_code;
+
+    if (_sim_lfhashmap_held_lock_ptr) {
+        _sim_rwlock_write_unlock(_sim_lfhashmap_held_lock_ptr);
+        _sim_lfhashmap_held_lock_ptr = NULL;
+    }
+
+    // pointers obtained inside the library's sections are unreachable once the stack is unwound
+    _Sim_EpochRecord *const record_ptr = _sim_epoch_record_ptr;
+    const size_t unwind_nesting = _sim_lfhashmap_unwind_nesting;
+    if (record_ptr && unwind_nesting != SIZE_MAX && record_ptr->nesting > unwind_nesting) {
+        record_ptr->nesting = unwind_nesting;
+        if (unwind_nesting == 0)
+            _sim_atomic_store_size(&record_ptr->epoch, 0);
+    }
+    _sim_lfhashmap_unwind_nesting = SIZE_MAX;
+}
+
+// Registers the current thread's on_throw function if it hasn't been already.
+static inline void _sim_lfhashmap_register_on_throw(void) {
+    if (!_sim_lfhashmap_on_throw_registered) {
+        sim_cexcept_on_throw(_sim_lfhashmap_on_throw);
+        _sim_lfhashmap_on_throw_registered = true;
+    }
+}
+
+// Enters a read-side section for a lock-free hashmap lookup, saving the depth to unwind to before
+//  it so that it can be restored by _sim_lfhashmap_read_end().
+//  Returns false if the thread's reader record couldn't be allocated.
+static inline bool _sim_lfhashmap_read_begin(
+    size_t *const out_unwind_nesting_ptr
+) {
+    _sim_lfhashmap_register_on_throw();
+    if (!_sim_epoch_enter())
+        return false;
+
+    *out_unwind_nesting_ptr = _sim_lfhashmap_unwind_nesting;
+    _sim_lfhashmap_unwind_nesting = _sim_epoch_record_ptr->nesting - 1;
+    return true;
+}
+
+// Leaves a read-side section entered by _sim_lfhashmap_read_begin().
+static inline void _sim_lfhashmap_read_end(
+    const size_t unwind_nesting
+) {
+    _sim_lfhashmap_unwind_nesting = unwind_nesting;
+    _sim_epoch_exit();
+}
+
+// Calculates the hash of a key.
+static inline Sim_HashType _sim_lfhashmap_get_hash(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const                key_ptr
+) {
+    Sim_HashProc hash_proc = lfhashmap_ptr->_key_properties.hash_proc;
+
+    // user hashes may be weak; spread them out since buckets are picked from the low bits
+    if (hash_proc)
+        return _sim_hash_mix((*hash_proc)(key_ptr, 0));
+
+    if (lfhashmap_ptr->_flags & SIM_HASH_SIPHASH)
+        return sim_siphash(
+            key_ptr,
+            lfhashmap_ptr->_key_properties.size,
+            (Sim_HashKey){SIPHASH_KEY1, SIPHASH_KEY2}
+        );
+
+    return sim_fasthash(key_ptr, lfhashmap_ptr->_key_properties.size, FASTHASH_SEED1);
+}
+
+// Allocates an empty bucket table.
+//  Returns NULL if it couldn't be allocated.
+static _Sim_LFHashTable* _sim_lfhashmap_alloc_table(
+    const Sim_IAllocator *const allocator_ptr,
+    const size_t                bucket_count
+) {
+    if (bucket_count > (SIZE_MAX - sizeof(_Sim_LFHashTable)) / sizeof(_Sim_LFHashNode*))
+        return NULL;
+
+    _Sim_LFHashTable *const table_ptr = allocator_ptr->malloc(
+        sizeof(_Sim_LFHashTable) + (sizeof(_Sim_LFHashNode*) * bucket_count)
+    );
+    if (!table_ptr)
+        return NULL;
+
+    table_ptr->retired = (_Sim_LFHashRetired){ .next_ptr = NULL, .epoch = 0, .is_table = true };
+    table_ptr->bucket_count = bucket_count;
+    memset(table_ptr->buckets, 0, sizeof(_Sim_LFHashNode*) * bucket_count);
+
+    return table_ptr;
+}
+
+// Creates a new node holding a key-value pair.
+//  Returns NULL if it couldn't be allocated.
+static _Sim_LFHashNode* _sim_lfhashmap_create_node(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const                key_ptr,
+    const void *const                value_ptr,
+    const Sim_HashType               hash
+) {
+    const size_t key_size = lfhashmap_ptr->_key_properties.size;
+
+    _Sim_LFHashNode *const node_ptr = lfhashmap_ptr->_allocator_ptr->malloc(
+        sizeof(_Sim_LFHashNode) + key_size + lfhashmap_ptr->_value_size
+    );
+    if (!node_ptr)
+        return NULL;
+
+    node_ptr->retired = (_Sim_LFHashRetired){ .next_ptr = NULL, .epoch = 0, .is_table = false };
+    node_ptr->next_ptr = NULL;
+    node_ptr->hash = hash;
+    memcpy(node_ptr + 1, key_ptr, key_size);
+    memcpy((uint8*)(node_ptr + 1) + key_size, value_ptr, lfhashmap_ptr->_value_size);
+
+    return node_ptr;
+}
+
+// Retrieves a pointer to a node's value.
+static inline void* _sim_lfhashmap_get_value(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashNode *const           node_ptr
+) {
+    return (uint8*)(node_ptr + 1) + lfhashmap_ptr->_key_properties.size;
+}
+
+// Frees a bucket table along with every node in its chains.
+static void _sim_lfhashmap_free_table(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashTable *const          table_ptr
+) {
+    for (size_t i = 0; i < table_ptr->bucket_count; i++) {
+        _Sim_LFHashNode* node_ptr = table_ptr->buckets[i];
+
+        while (node_ptr) {
+            _Sim_LFHashNode *const next_ptr = node_ptr->next_ptr;
+
+            lfhashmap_ptr->_allocator_ptr->free(node_ptr);
+            node_ptr = next_ptr;
+        }
+    }
+
+    lfhashmap_ptr->_allocator_ptr->free(table_ptr);
+}
+
+// Frees a list of retired objects.
+static void _sim_lfhashmap_free_retired(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashRetired*              retired_ptr
+) {
+    while (retired_ptr) {
+        _Sim_LFHashRetired *const next_ptr = retired_ptr->next_ptr;
+
+        if (retired_ptr->is_table)
+            _sim_lfhashmap_free_table(lfhashmap_ptr, (_Sim_LFHashTable*)retired_ptr);
+        else
+            lfhashmap_ptr->_allocator_ptr->free(retired_ptr);
+
+        retired_ptr = next_ptr;
+    }
+}
+
+// Queues an object that was just unlinked to be freed once no reader can reach it.
+static void _sim_lfhashmap_retire(
+    _Sim_LFHashWriter *const  writer_ptr,
+    _Sim_LFHashRetired *const retired_ptr
+) {
+    // the unlinking store must be visible to readers before the epoch it's tagged with is read
+    _sim_atomic_fence();
+
+    retired_ptr->epoch = _sim_atomic_load_size(&_sim_epoch_global);
+    retired_ptr->next_ptr = writer_ptr->retired_ptr;
+    writer_ptr->retired_ptr = retired_ptr;
+}
+
+// Frees retired objects that can no longer be reached by any reader.
+static void _sim_lfhashmap_reclaim(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashWriter *const         writer_ptr
+) {
+    if (!writer_ptr->retired_ptr)
+        return;
+
+    // with no thread reading, two advances make everything retired so far reclaimable
+    _sim_epoch_try_advance();
+    const size_t epoch = _sim_epoch_try_advance();
+
+    // objects are retired newest first, so everything after the first reclaimable one is too
+    _Sim_LFHashRetired** link_ptr = &writer_ptr->retired_ptr;
+    while (*link_ptr && (*link_ptr)->epoch + 2 > epoch)
+        link_ptr = &(*link_ptr)->next_ptr;
+
+    _Sim_LFHashRetired *const reclaimable_ptr = *link_ptr;
+    *link_ptr = NULL;
+    _sim_lfhashmap_free_retired(lfhashmap_ptr, reclaimable_ptr);
+}
+
+// Locks a lock-free hashmap for writing.
+static inline _Sim_LFHashWriter* _sim_lfhashmap_lock(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    _Sim_LFHashWriter *const writer_ptr = lfhashmap_ptr->_writer_ptr;
+
+    _sim_lfhashmap_register_on_throw();
+    _sim_rwlock_write_lock(&writer_ptr->lock);
+    _sim_lfhashmap_held_lock_ptr = &writer_ptr->lock;
+
+    return writer_ptr;
+}
+
+// Reclaims what readers can no longer reach & unlocks a lock-free hashmap.
+static inline void _sim_lfhashmap_unlock(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashWriter *const   writer_ptr
+) {
+    _sim_lfhashmap_reclaim(lfhashmap_ptr, writer_ptr);
+
+    _sim_lfhashmap_held_lock_ptr = NULL;
+    _sim_rwlock_write_unlock(&writer_ptr->lock);
+}
+
+// Searches the current bucket table for a key without locking.
+//  Must be called inside a read-side section.
+static _Sim_LFHashNode* _sim_lfhashmap_find(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const          key_ptr,
+    const Sim_HashType         hash
+) {
+    Sim_PredicateProc predicate_proc = lfhashmap_ptr->_key_properties.predicate_proc;
+    _Sim_LFHashTable *const table_ptr = _sim_atomic_load_ptr(&lfhashmap_ptr->_table_ptr);
+
+    for (
+        _Sim_LFHashNode* node_ptr = _sim_atomic_load_ptr(
+            &table_ptr->buckets[hash & (table_ptr->bucket_count - 1)]
+        );
+        node_ptr;
+        node_ptr = _sim_atomic_load_ptr(&node_ptr->next_ptr)
+    )
+        if (node_ptr->hash == hash && (*predicate_proc)(key_ptr, node_ptr + 1))
+            return node_ptr;
+
+    return NULL;
+}
+
+// Searches a bucket table for the link pointing to a key's node.
+//  Returns the link at the end of the key's bucket chain if the key isn't in the table. Must be
+//  called with the writer lock held.
+static _Sim_LFHashNode** _sim_lfhashmap_find_link(
+    const Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashTable *const          table_ptr,
+    const void *const                key_ptr,
+    const Sim_HashType               hash
+) {
+    Sim_PredicateProc predicate_proc = lfhashmap_ptr->_key_properties.predicate_proc;
+
+    // only writers modify links, so they can be read without atomics while the lock is held
+    _Sim_LFHashNode** link_ptr = &table_ptr->buckets[hash & (table_ptr->bucket_count - 1)];
+    for (; *link_ptr; link_ptr = &(*link_ptr)->next_ptr)
+        if ((*link_ptr)->hash == hash && (*predicate_proc)(key_ptr, *link_ptr + 1))
+            break;
+
+    return link_ptr;
+}
+
+// Copies every node of the current bucket table into a new table of a given size, publishes it,
+//  & retires the old table. Must be called with the writer lock held.
+//  Returns false (leaving the current table in place) if the new table couldn't be allocated.
+static bool _sim_lfhashmap_rebuild(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    _Sim_LFHashWriter *const   writer_ptr,
+    const size_t               bucket_count
+) {
+    _Sim_LFHashTable *const old_table_ptr = lfhashmap_ptr->_table_ptr;
+    _Sim_LFHashTable *const new_table_ptr =
+        _sim_lfhashmap_alloc_table(lfhashmap_ptr->_allocator_ptr, bucket_count);
+    if (!new_table_ptr)
+        return false;
+
+    // nodes in the old table may still be traversed by readers, so they're copied, not relinked
+    for (size_t i = 0; i < old_table_ptr->bucket_count; i++)
+        for (
+            _Sim_LFHashNode* node_ptr = old_table_ptr->buckets[i];
+            node_ptr;
+            node_ptr = node_ptr->next_ptr
+        ) {
+            _Sim_LFHashNode *const copy_ptr = _sim_lfhashmap_create_node(
+                lfhashmap_ptr,
+                node_ptr + 1,
+                _sim_lfhashmap_get_value(lfhashmap_ptr, node_ptr),
+                node_ptr->hash
+            );
+            if (!copy_ptr) {
+                _sim_lfhashmap_free_table(lfhashmap_ptr, new_table_ptr);
+                return false;
+            }
+
+            const size_t index = node_ptr->hash & (bucket_count - 1);
+            copy_ptr->next_ptr = new_table_ptr->buckets[index];
+            new_table_ptr->buckets[index] = copy_ptr;
+        }
+
+    _sim_atomic_store_ptr(&lfhashmap_ptr->_table_ptr, new_table_ptr);
+    _sim_lfhashmap_retire(writer_ptr, &old_table_ptr->retired);
+
+    return true;
+}
+
+// sim_lfhashmap_construct(8): Constructs a new lock-free hashmap.
+void sim_lfhashmap_construct(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const size_t               key_size,
+    Sim_HashProc               key_hash_proc,
+    Sim_PredicateProc          key_predicate_proc,
+    const size_t               value_size,
+    const Sim_IAllocator*      allocator_ptr,
+    const size_t               initial_size,
+    const Sim_HashFlags        flags
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_predicate_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
+
+    // round bucket count up to a power of 2
+    size_t bucket_count = _SIM_LFHASH_MIN_BUCKETS;
+    while (bucket_count < initial_size && bucket_count <= (SIZE_MAX >> 1))
+        bucket_count <<= 1;
+
+    _Sim_LFHashWriter *const writer_ptr = allocator_ptr->malloc(sizeof(_Sim_LFHashWriter));
+    if (!writer_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    writer_ptr->retired_ptr = NULL;
+
+    if (!_sim_rwlock_init(&writer_ptr->lock)) {
+        allocator_ptr->free(writer_ptr);
+        RETURN(SIM_RC_FAILURE,);
+    }
+
+    _Sim_LFHashTable *const table_ptr = _sim_lfhashmap_alloc_table(allocator_ptr, bucket_count);
+    if (!table_ptr) {
+        _sim_rwlock_destroy(&writer_ptr->lock);
+        allocator_ptr->free(writer_ptr);
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    Sim_LockFreeHashMap lfhashmap = {
+        ._key_properties = {
+            .size = key_size,
+            .hash_proc = key_hash_proc,
+            .predicate_proc = key_predicate_proc
+        },
+        ._allocator_ptr = allocator_ptr,
+        ._value_size = value_size,
+        ._base_size = bucket_count,
+        ._flags = flags,
+        ._count = 0,
+        ._table_ptr = table_ptr,
+        ._writer_ptr = writer_ptr
+    };
+    memcpy(lfhashmap_ptr, &lfhashmap, sizeof(Sim_LockFreeHashMap));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_destroy(1): Destroys a lock-free hashmap.
+void sim_lfhashmap_destroy(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _Sim_LFHashWriter *const writer_ptr = lfhashmap_ptr->_writer_ptr;
+
+    // no thread may be reading anymore, so retired objects can be freed regardless of epoch
+    _sim_lfhashmap_free_retired(lfhashmap_ptr, writer_ptr->retired_ptr);
+    _sim_lfhashmap_free_table(lfhashmap_ptr, lfhashmap_ptr->_table_ptr);
+
+    _sim_rwlock_destroy(&writer_ptr->lock);
+    lfhashmap_ptr->_allocator_ptr->free(writer_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_get_count(1): Counts the key-value pairs in a lock-free hashmap.
+size_t sim_lfhashmap_get_count(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    RETURN(SIM_RC_SUCCESS, _sim_atomic_load_size(&lfhashmap_ptr->_count));
+}
+
+// sim_lfhashmap_clear(1): Clears a lock-free hashmap of all its contents.
+void sim_lfhashmap_clear(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // allocate outside of the lock
+    _Sim_LFHashTable *const empty_table_ptr =
+        _sim_lfhashmap_alloc_table(lfhashmap_ptr->_allocator_ptr, lfhashmap_ptr->_base_size);
+    if (!empty_table_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    _Sim_LFHashWriter *const writer_ptr = _sim_lfhashmap_lock(lfhashmap_ptr);
+    _Sim_LFHashTable *const old_table_ptr = lfhashmap_ptr->_table_ptr;
+
+    _sim_atomic_store_ptr(&lfhashmap_ptr->_table_ptr, empty_table_ptr);
+    _sim_atomic_store_size(&lfhashmap_ptr->_count, 0);
+    _sim_lfhashmap_retire(writer_ptr, &old_table_ptr->retired);
+
+    _sim_lfhashmap_unlock(lfhashmap_ptr, writer_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_read_begin(1): Starts a read-side section on the calling thread.
+void sim_lfhashmap_read_begin(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (!_sim_epoch_enter())
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_read_end(1): Ends a read-side section started by sim_lfhashmap_read_begin().
+void sim_lfhashmap_read_end(
+    Sim_LockFreeHashMap *const lfhashmap_ptr
+) {
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    _sim_epoch_exit();
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_contains_key(2): Checks if a key is contained in a lock-free hashmap.
+bool sim_lfhashmap_contains_key(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const          key_ptr
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_lfhashmap_get_hash(lfhashmap_ptr, key_ptr);
+
+    size_t unwind_nesting;
+    if (!_sim_lfhashmap_read_begin(&unwind_nesting))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    const bool found = _sim_lfhashmap_find(lfhashmap_ptr, key_ptr, hash) != NULL;
+    _sim_lfhashmap_read_end(unwind_nesting);
+
+    if (found)
+        RETURN(SIM_RC_SUCCESS, true);
+    RETURN(SIM_RC_NOT_FOUND, false);
+}
+
+// sim_lfhashmap_get_ptr(2): Get a pointer to a value in a lock-free hashmap via a particular key.
+const void* sim_lfhashmap_get_ptr(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const          key_ptr
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // the value could be freed as soon as it's returned outside of a read-side section
+    if (!_sim_epoch_record_ptr || !_sim_epoch_record_ptr->nesting)
+        RETURN(SIM_RC_FAILURE, NULL);
+
+    _Sim_LFHashNode *const node_ptr = _sim_lfhashmap_find(
+        lfhashmap_ptr,
+        key_ptr,
+        _sim_lfhashmap_get_hash(lfhashmap_ptr, key_ptr)
+    );
+
+    if (node_ptr)
+        RETURN(SIM_RC_SUCCESS, _sim_lfhashmap_get_value(lfhashmap_ptr, node_ptr));
+    RETURN(SIM_RC_NOT_FOUND, NULL);
+}
+
+// sim_lfhashmap_get(3): Get a copy of a value from a lock-free hashmap via a particular key.
+void sim_lfhashmap_get(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void*                key_ptr,
+    void*                      out_value_ptr
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_lfhashmap_get_hash(lfhashmap_ptr, key_ptr);
+
+    size_t unwind_nesting;
+    if (!_sim_lfhashmap_read_begin(&unwind_nesting))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    // nodes are immutable, so the copy can't be torn by a concurrent overwrite
+    _Sim_LFHashNode *const node_ptr = _sim_lfhashmap_find(lfhashmap_ptr, key_ptr, hash);
+    if (node_ptr)
+        memcpy(
+            out_value_ptr,
+            _sim_lfhashmap_get_value(lfhashmap_ptr, node_ptr),
+            lfhashmap_ptr->_value_size
+        );
+    _sim_lfhashmap_read_end(unwind_nesting);
+
+    if (node_ptr)
+        RETURN(SIM_RC_SUCCESS,);
+    RETURN(SIM_RC_NOT_FOUND,);
+}
+
+// sim_lfhashmap_insert(3): Inserts a key-value pair into a lock-free hashmap or overwrites a
+//                          pre-existing pair if the key is already in the lock-free hashmap.
+void sim_lfhashmap_insert(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void*                new_key_ptr,
+    const void*                value_ptr
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!new_key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // hash & allocate outside of the lock
+    const Sim_HashType hash = _sim_lfhashmap_get_hash(lfhashmap_ptr, new_key_ptr);
+    _Sim_LFHashNode *const node_ptr =
+        _sim_lfhashmap_create_node(lfhashmap_ptr, new_key_ptr, value_ptr, hash);
+    if (!node_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    _Sim_LFHashWriter *const writer_ptr = _sim_lfhashmap_lock(lfhashmap_ptr);
+    _Sim_LFHashTable *const table_ptr = lfhashmap_ptr->_table_ptr;
+
+    _Sim_LFHashNode **const link_ptr =
+        _sim_lfhashmap_find_link(lfhashmap_ptr, table_ptr, new_key_ptr, hash);
+    _Sim_LFHashNode *const old_node_ptr = *link_ptr;
+
+    if (old_node_ptr) {
+        // replace the old node; readers standing on it can still follow its link
+        node_ptr->next_ptr = old_node_ptr->next_ptr;
+        _sim_atomic_store_ptr(link_ptr, node_ptr);
+        _sim_lfhashmap_retire(writer_ptr, &old_node_ptr->retired);
+    } else {
+        // append to the end of the bucket's chain
+        _sim_atomic_store_ptr(link_ptr, node_ptr);
+
+        const size_t count = lfhashmap_ptr->_count + 1;
+        _sim_atomic_store_size(&lfhashmap_ptr->_count, count);
+
+        // chains only get longer if the table can't grow, so a failed rebuild isn't an error
+        if (count > table_ptr->bucket_count && table_ptr->bucket_count <= (SIZE_MAX >> 1))
+            _sim_lfhashmap_rebuild(lfhashmap_ptr, writer_ptr, table_ptr->bucket_count << 1);
+    }
+
+    _sim_lfhashmap_unlock(lfhashmap_ptr, writer_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_remove(2): Removes a key-value pair from a lock-free hashmap via a key.
+void sim_lfhashmap_remove(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    const void *const          remove_key_ptr
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!remove_key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const Sim_HashType hash = _sim_lfhashmap_get_hash(lfhashmap_ptr, remove_key_ptr);
+
+    _Sim_LFHashWriter *const writer_ptr = _sim_lfhashmap_lock(lfhashmap_ptr);
+    _Sim_LFHashTable *const table_ptr = lfhashmap_ptr->_table_ptr;
+
+    _Sim_LFHashNode **const link_ptr =
+        _sim_lfhashmap_find_link(lfhashmap_ptr, table_ptr, remove_key_ptr, hash);
+    _Sim_LFHashNode *const node_ptr = *link_ptr;
+
+    if (!node_ptr) {
+        _sim_lfhashmap_unlock(lfhashmap_ptr, writer_ptr);
+        RETURN(SIM_RC_FAILURE,);
+    }
+
+    // unlink the node; readers standing on it can still follow its link
+    _sim_atomic_store_ptr(link_ptr, node_ptr->next_ptr);
+    _sim_lfhashmap_retire(writer_ptr, &node_ptr->retired);
+
+    const size_t count = lfhashmap_ptr->_count - 1;
+    _sim_atomic_store_size(&lfhashmap_ptr->_count, count);
+
+    // shrink when less than 1/8 of the buckets would be used; a failed rebuild isn't an error
+    if (
+        count < (table_ptr->bucket_count >> 3) &&
+        table_ptr->bucket_count > lfhashmap_ptr->_base_size
+    )
+        _sim_lfhashmap_rebuild(lfhashmap_ptr, writer_ptr, table_ptr->bucket_count >> 1);
+
+    _sim_lfhashmap_unlock(lfhashmap_ptr, writer_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_lfhashmap_foreach(3): Applies a given function to each key-value pair in a lock-free
+//                           hashmap.
+bool sim_lfhashmap_foreach(
+    Sim_LockFreeHashMap *const lfhashmap_ptr,
+    Sim_MapForEachProc         foreach_proc,
+    Sim_Variant                userdata
+) {
+    // check for nullptrs
+    if (!lfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!foreach_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    size_t unwind_nesting;
+    if (!_sim_lfhashmap_read_begin(&unwind_nesting))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    _Sim_LFHashTable *const table_ptr = _sim_atomic_load_ptr(&lfhashmap_ptr->_table_ptr);
+    size_t item_num = 0;
+
+    for (size_t i = 0; i < table_ptr->bucket_count; i++)
+        for (
+            _Sim_LFHashNode* node_ptr = _sim_atomic_load_ptr(&table_ptr->buckets[i]);
+            node_ptr;
+            node_ptr = _sim_atomic_load_ptr(&node_ptr->next_ptr)
+        )
+            if (!(*foreach_proc)(
+                node_ptr + 1,
+                _sim_lfhashmap_get_value(lfhashmap_ptr, node_ptr),
+                item_num++,
+                userdata
+            )) {
+                _sim_lfhashmap_read_end(unwind_nesting);
+                RETURN(SIM_RC_SUCCESS, false);
+            }
+
+    _sim_lfhashmap_read_end(unwind_nesting);
+
+    RETURN(SIM_RC_SUCCESS, true);
+}
+
+#endif /* SIMSOFT_LFHASHMAP_C_ */
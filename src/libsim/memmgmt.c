@@ -29,6 +29,8 @@ void* sim_memmgmt_map_file_ptr(
     size_t           offset,
     Sim_MemoryAccess mem_access_flags
 ) {
+    if (!file_ptr)
+        THROW(SIM_RC_ERR_BADFILE);
     if (length == 0)
         THROW(SIM_RC_ERR_INVALARG);
 
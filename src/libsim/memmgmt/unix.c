@@ -13,6 +13,7 @@
 #define SIMSOFT_UNIX_MEMMGMT_C_
 
 #include "../_memmgmt.h"
+#include <errno.h>
 #include <sys/mman.h>
 
 static int _sim_unix_memmgmt_mem_access_flags_to_proti(Sim_MemoryAccess mem_access_flags) {
@@ -22,9 +23,9 @@ static int _sim_unix_memmgmt_mem_access_flags_to_proti(Sim_MemoryAccess mem_acce
     else {
         if (mem_access_flags & SIM_MEMACCESS_READABLE)
             protection |= PROT_READ;
-        else if (mem_access_flags & SIM_MEMACCESS_WRITABLE)
+        if (mem_access_flags & SIM_MEMACCESS_WRITABLE)
             protection |= PROT_WRITE;
-        else if (mem_access_flags & SIM_MEMACCESS_EXECUTABLE)
+        if (mem_access_flags & SIM_MEMACCESS_EXECUTABLE)
             protection |= PROT_EXEC;
     }
 
@@ -45,7 +46,7 @@ void* _sim_sys_memmgmt_map_file_ptr(
         (starting_address == (void*)-1) ? NULL : starting_address,
         length,
         protection,
-        MAP_PRIVATE | (starting_address != (void*)-1) ? MAP_FIXED : 0,
+        MAP_PRIVATE | ((starting_address != (void*)-1) ? MAP_FIXED : 0),
         file_descriptor,
         (off_t)offset
     );
@@ -61,7 +62,7 @@ void* _sim_sys_memmgmt_map_file_ptr(
         case ENXIO:
         case EOVERFLOW:
         case EPERM:
-            THROW(SIM_RC_ERR_INVALARG;
+            THROW(SIM_RC_ERR_INVALARG);
 
         case ENOTSUP:
             THROW(SIM_RC_ERR_UNSUPRTD);
@@ -0,0 +1,562 @@
+/**
+ * @file perfhashmap.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Source file/implementation for simsoft/perfhashmap.h
+ * @version 0.1
+ * @date 2020-02-11
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+
+#ifndef SIMSOFT_PERFHASHMAP_C_
+#define SIMSOFT_PERFHASHMAP_C_
+
+#include <string.h>
+
+#include "simsoft/perfhashmap.h"
+#include "./_hash.h"
+
+// == PERFECT HASHMAP =============================================================================
+//  Compress, hash, & displace: keys are split into buckets of a few keys each, & buckets are
+//  placed largest first. Each bucket searches for a displacement (d0, d1) that sends every one of
+//  its keys to a free slot (f1 + d0 * f2 + d1) mod n. Buckets holding a single key are placed
+//  last, straight into whichever slots are left, so no slot ends up empty.
+
+#define _SIM_PERFHASH_BUCKET_LOAD 4  // average amount of keys per displacement bucket
+#define _SIM_PERFHASH_D0_BITS     4  // low bits of each displacement holding its multiplier (d0)
+#define _SIM_PERFHASH_MAX_SEEDS   16 // seeds tried before giving up on a key set
+
+// most keys a perfect hashmap can hold; keeps each displacement within 32 bits
+#define _SIM_PERFHASH_MAX_COUNT ((size_t)(UINT32_MAX >> _SIM_PERFHASH_D0_BITS))
+
+// Where a key lands in a perfect hashmap's bucket & displacement scheme
+typedef struct _Sim_PerfHashKey {
+    size_t bucket; // displacement bucket
+    size_t f1;     // slot the key lands in when undisplaced
+    size_t f2;     // how far each step of d0 moves the key
+} _Sim_PerfHashKey;
+
+// Maps a 32-bit hash onto [0, range) without dividing.
+static inline size_t _sim_perfhash_reduce(
+    const uint32 hash,
+    const size_t range
+) {
+    return (size_t)(((uint64)hash * range) >> 32);
+}
+
+// Calculates the hash of a key.
+static inline Sim_HashType _sim_perfhash_get_hash(
+    Sim_HashProc      hash_proc,
+    const size_t      key_size,
+    const void *const key_ptr
+) {
+    return hash_proc ?
+        (*hash_proc)(key_ptr, 0) :
+        sim_fasthash(key_ptr, key_size, FASTHASH_SEED1)
+    ;
+}
+
+// Splits a key's hash into its bucket & the two halves of its slot.
+static inline _Sim_PerfHashKey _sim_perfhash_split(
+    const Sim_HashType hash,
+    const uint64       seed,
+    const size_t       bucket_count,
+    const size_t       slot_count
+) {
+    // user hashes may be weak; mix them with the seed before they're split
+    const uint64 h0 = _sim_hash_mix(hash ^ seed);
+    const uint64 h1 = _sim_hash_mix(h0 ^ 0x9e3779b97f4a7c15ULL);
+
+    return (_Sim_PerfHashKey){
+        .bucket = _sim_perfhash_reduce((uint32)h0, bucket_count),
+        .f1 = _sim_perfhash_reduce((uint32)(h0 >> 32), slot_count),
+        .f2 = _sim_perfhash_reduce((uint32)h1, slot_count)
+    };
+}
+
+// Calculates the slot a key is sent to by its bucket's displacement.
+static inline size_t _sim_perfhash_get_slot(
+    const _Sim_PerfHashKey *const key_ptr,
+    const uint32                  displacement,
+    const size_t                  slot_count
+) {
+    const size_t d0 = displacement & ((1U << _SIM_PERFHASH_D0_BITS) - 1);
+    const size_t d1 = displacement >> _SIM_PERFHASH_D0_BITS;
+
+    // f1, f2, & d1 are all below slot_count & d0 is tiny, so this can't overflow
+    return (key_ptr->f1 + (d0 * key_ptr->f2) + d1) % slot_count;
+}
+
+// Searches for a displacement sending every key in a bucket to a free slot.
+//  Marks the slots as taken & fills in each key's slot on success.
+static bool _sim_perfhash_place_bucket(
+    const _Sim_PerfHashKey *const keys_ptr,
+    const size_t *const           bucket_keys_ptr,
+    const size_t                  bucket_size,
+    const size_t                  slot_count,
+    uint8 *const                  taken_ptr,
+    size_t *const                 slots_ptr,
+    uint32 *const                 out_displacement_ptr
+) {
+    // cycle through d0 fastest; keys sharing f1 can only be separated by it
+    const uint64 displacement_count = (uint64)slot_count << _SIM_PERFHASH_D0_BITS;
+
+    for (uint64 displacement = 0; displacement < displacement_count; displacement++) {
+        size_t placed = 0;
+
+        for (; placed < bucket_size; placed++) {
+            const size_t key_index = bucket_keys_ptr[placed];
+            const size_t slot = _sim_perfhash_get_slot(
+                keys_ptr + key_index,
+                (uint32)displacement,
+                slot_count
+            );
+            if (taken_ptr[slot])
+                break;
+
+            // keys in the same bucket mustn't land on each other either
+            size_t other = 0;
+            while (other < placed && slots_ptr[bucket_keys_ptr[other]] != slot)
+                other++;
+            if (other < placed)
+                break;
+
+            slots_ptr[key_index] = slot;
+        }
+
+        if (placed == bucket_size) {
+            for (size_t i = 0; i < bucket_size; i++)
+                taken_ptr[slots_ptr[bucket_keys_ptr[i]]] = 1;
+
+            *out_displacement_ptr = (uint32)displacement;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Builds a minimal perfect hash function over a set of keys, finding each key's slot & each
+//  bucket's displacement.
+static Sim_ReturnCode _sim_perfhash_build(
+    const Sim_IAllocator *const allocator_ptr,
+    Sim_HashProc                hash_proc,
+    const size_t                key_size,
+    const uint8 *const          keys_ptr,
+    const size_t                key_count,
+    const size_t                bucket_count,
+    uint32 *const               out_displacements_ptr,
+    size_t *const               out_slots_ptr,
+    uint64 *const               out_seed_ptr
+) {
+    // check for overflow; scratch space takes less than 128 bytes per key
+    if (key_count > SIZE_MAX / 128)
+        return SIM_RC_ERR_OUTOFMEM;
+
+    // scratch space; every array of words comes before the taken-slot flags
+    const size_t scratch_size =
+        (sizeof(Sim_HashType) * key_count) +     // hash of each key
+        (sizeof(_Sim_PerfHashKey) * key_count) + // bucket & slot halves of each key
+        (sizeof(size_t) * key_count) +           // keys grouped by bucket
+        (sizeof(size_t) * (bucket_count + 1)) +  // where each bucket's keys start
+        (sizeof(size_t) * bucket_count) +        // buckets, largest first
+        (sizeof(size_t) * (key_count + 1)) +     // amount of buckets of each size
+        key_count                                // which slots are taken
+    ;
+    uint8 *const scratch_ptr = allocator_ptr->malloc(scratch_size);
+    if (!scratch_ptr)
+        return SIM_RC_ERR_OUTOFMEM;
+
+    Sim_HashType *const hashes_ptr = (Sim_HashType*)scratch_ptr;
+    _Sim_PerfHashKey *const split_keys_ptr = (_Sim_PerfHashKey*)(hashes_ptr + key_count);
+    size_t *const bucket_keys_ptr = (size_t*)(split_keys_ptr + key_count);
+    size_t *const bucket_starts_ptr = bucket_keys_ptr + key_count;
+    size_t *const bucket_order_ptr = bucket_starts_ptr + bucket_count + 1;
+    size_t *const size_counts_ptr = bucket_order_ptr + bucket_count;
+    uint8 *const taken_ptr = (uint8*)(size_counts_ptr + key_count + 1);
+
+    for (size_t i = 0; i < key_count; i++)
+        hashes_ptr[i] = _sim_perfhash_get_hash(hash_proc, key_size, keys_ptr + (key_size * i));
+
+    Sim_ReturnCode rc = SIM_RC_ERR_INVALARG;
+
+    for (uint64 attempt = 0; attempt < _SIM_PERFHASH_MAX_SEEDS; attempt++) {
+        const uint64 seed = attempt * 0x9e3779b97f4a7c15ULL;
+
+        // group keys by bucket (counting sort)
+        memset(bucket_starts_ptr, 0, sizeof(size_t) * (bucket_count + 1));
+        for (size_t i = 0; i < key_count; i++) {
+            split_keys_ptr[i] = _sim_perfhash_split(hashes_ptr[i], seed, bucket_count, key_count);
+            bucket_starts_ptr[split_keys_ptr[i].bucket + 1]++;
+        }
+        for (size_t b = 0; b < bucket_count; b++)
+            bucket_starts_ptr[b + 1] += bucket_starts_ptr[b];
+        for (size_t i = 0; i < key_count; i++)
+            bucket_keys_ptr[bucket_starts_ptr[split_keys_ptr[i].bucket]++] = i;
+        for (size_t b = bucket_count; b > 0; b--)
+            bucket_starts_ptr[b] = bucket_starts_ptr[b - 1];
+        bucket_starts_ptr[0] = 0;
+
+        // order buckets from largest to smallest (counting sort)
+        memset(size_counts_ptr, 0, sizeof(size_t) * (key_count + 1));
+        for (size_t b = 0; b < bucket_count; b++)
+            size_counts_ptr[bucket_starts_ptr[b + 1] - bucket_starts_ptr[b]]++;
+        for (size_t size = key_count, start = 0; size != (size_t)-1; size--) {
+            const size_t amount = size_counts_ptr[size];
+            size_counts_ptr[size] = start;
+            start += amount;
+        }
+        for (size_t b = 0; b < bucket_count; b++) {
+            const size_t bucket_size = bucket_starts_ptr[b + 1] - bucket_starts_ptr[b];
+            bucket_order_ptr[size_counts_ptr[bucket_size]++] = b;
+        }
+
+        memset(taken_ptr, 0, key_count);
+        memset(out_displacements_ptr, 0, sizeof(uint32) * bucket_count);
+
+        size_t order = 0, free_slot = 0;
+        bool placed = true;
+
+        // buckets of several keys search for a displacement that fits
+        for (; order < bucket_count; order++) {
+            const size_t bucket = bucket_order_ptr[order];
+            const size_t* bucket_keys = bucket_keys_ptr + bucket_starts_ptr[bucket];
+            const size_t bucket_size = bucket_starts_ptr[bucket + 1] - bucket_starts_ptr[bucket];
+
+            if (bucket_size < 2)
+                break;
+
+            if (!_sim_perfhash_place_bucket(
+                split_keys_ptr,
+                bucket_keys,
+                bucket_size,
+                key_count,
+                taken_ptr,
+                out_slots_ptr,
+                out_displacements_ptr + bucket
+            )) {
+                // keys with the same hash can never be separated, no matter the seed
+                for (size_t i = 0; i < bucket_size; i++)
+                    for (size_t j = i + 1; j < bucket_size; j++)
+                        if (hashes_ptr[bucket_keys[i]] == hashes_ptr[bucket_keys[j]]) {
+                            allocator_ptr->free(scratch_ptr);
+                            return SIM_RC_ERR_INVALARG;
+                        }
+
+                placed = false;
+                break;
+            }
+        }
+        if (!placed)
+            continue;
+
+        // buckets of a single key take whichever slots are left
+        for (; order < bucket_count; order++) {
+            const size_t bucket = bucket_order_ptr[order];
+            if (bucket_starts_ptr[bucket + 1] == bucket_starts_ptr[bucket])
+                break;
+
+            const size_t key_index = bucket_keys_ptr[bucket_starts_ptr[bucket]];
+            while (taken_ptr[free_slot])
+                free_slot++;
+
+            taken_ptr[free_slot] = 1;
+            out_slots_ptr[key_index] = free_slot;
+            out_displacements_ptr[bucket] = (uint32)(
+                ((free_slot + key_count - split_keys_ptr[key_index].f1) % key_count) <<
+                    _SIM_PERFHASH_D0_BITS
+            );
+        }
+
+        *out_seed_ptr = seed;
+        rc = SIM_RC_SUCCESS;
+        break;
+    }
+
+    allocator_ptr->free(scratch_ptr);
+    return rc;
+}
+
+// Calculates the offset of a perfect hashmap's displacements, which follow its pairs.
+static inline size_t _sim_perfhash_get_displacements_offset(
+    const size_t slot_size,
+    const size_t count
+) {
+    return ((slot_size * count) + sizeof(uint32) - 1) & ~(sizeof(uint32) - 1);
+}
+
+// Retrieves the displacements of a perfect hashmap.
+static inline const uint32* _sim_perfhashmap_get_displacements(
+    const Sim_PerfectHashMap *const perfhashmap_ptr
+) {
+    const size_t offset = _sim_perfhash_get_displacements_offset(
+        perfhashmap_ptr->_slot_size,
+        perfhashmap_ptr->count
+    );
+
+    return (const uint32*)((uint8*)perfhashmap_ptr->data_ptr + offset);
+}
+
+// Finds the slot holding a key in a perfect hashmap.
+//  Returns (size_t)-1 if the key isn't contained in it.
+static inline size_t _sim_perfhashmap_find(
+    const Sim_PerfectHashMap *const perfhashmap_ptr,
+    const void *const               key_ptr
+) {
+    const size_t count = perfhashmap_ptr->count;
+    if (!count)
+        return (size_t)-1;
+
+    const _Sim_PerfHashKey key = _sim_perfhash_split(
+        _sim_perfhash_get_hash(
+            perfhashmap_ptr->_key_properties.hash_proc,
+            perfhashmap_ptr->_key_properties.size,
+            key_ptr
+        ),
+        perfhashmap_ptr->_seed,
+        perfhashmap_ptr->_bucket_count,
+        count
+    );
+
+    // one displacement, one slot, & one comparison
+    const uint32 *const displacements_ptr = _sim_perfhashmap_get_displacements(perfhashmap_ptr);
+    const size_t slot = _sim_perfhash_get_slot(&key, displacements_ptr[key.bucket], count);
+
+    return (*perfhashmap_ptr->_key_properties.predicate_proc)(
+        key_ptr,
+        (uint8*)perfhashmap_ptr->data_ptr + (perfhashmap_ptr->_slot_size * slot)
+    ) ?
+        slot :
+        (size_t)-1
+    ;
+}
+
+// -- Perfect hashmap public API ------------------------------------------------------------------
+
+// sim_perfhashmap_construct(9): Builds a perfect hashmap holding the key-value pairs of parallel
+//                               arrays.
+void sim_perfhashmap_construct(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    const size_t              key_size,
+    Sim_HashProc              key_hash_proc,
+    Sim_PredicateProc         key_predicate_proc,
+    const size_t              value_size,
+    const Sim_IAllocator*     allocator_ptr,
+    const void *const         keys_ptr,
+    const void *const         values_ptr,
+    const size_t              item_count
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_predicate_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (item_count && !keys_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (item_count && value_size && !values_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (item_count > _SIM_PERFHASH_MAX_COUNT)
+        THROW(SIM_RC_ERR_INVALARG);
+
+    allocator_ptr = allocator_ptr ? allocator_ptr : sim_allocator_get_default();
+
+    const size_t slot_size = _sim_hash_get_slot_size(key_size + value_size, SIM_HASH_FLAT_STORAGE);
+    const size_t bucket_count = (item_count / _SIM_PERFHASH_BUCKET_LOAD) + 1;
+
+    // pairs, then displacements (aligned)
+    if (item_count > (SIZE_MAX / 2) / (slot_size + sizeof(uint32)))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    const size_t displacements_offset =
+        _sim_perfhash_get_displacements_offset(slot_size, item_count);
+
+    uint8 *const data_ptr = allocator_ptr->malloc(
+        displacements_offset + (sizeof(uint32) * bucket_count)
+    );
+    if (!data_ptr)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    size_t *const slots_ptr = allocator_ptr->malloc(sizeof(size_t) * (item_count + 1));
+    if (!slots_ptr) {
+        allocator_ptr->free(data_ptr);
+        THROW(SIM_RC_ERR_OUTOFMEM);
+    }
+
+    uint64 seed = 0;
+    const Sim_ReturnCode rc = _sim_perfhash_build(
+        allocator_ptr,
+        key_hash_proc,
+        key_size,
+        keys_ptr,
+        item_count,
+        bucket_count,
+        (uint32*)(data_ptr + displacements_offset),
+        slots_ptr,
+        &seed
+    );
+    if (rc) {
+        allocator_ptr->free(slots_ptr);
+        allocator_ptr->free(data_ptr);
+        THROW(rc);
+    }
+
+    // move each pair into its slot
+    for (size_t i = 0; i < item_count; i++) {
+        uint8 *const slot_ptr = data_ptr + (slot_size * slots_ptr[i]);
+
+        memcpy(slot_ptr, (const uint8*)keys_ptr + (key_size * i), key_size);
+        if (value_size)
+            memcpy(slot_ptr + key_size, (const uint8*)values_ptr + (value_size * i), value_size);
+    }
+    allocator_ptr->free(slots_ptr);
+
+    Sim_PerfectHashMap perfhashmap = {
+        ._key_properties = {
+            .size = key_size,
+            .hash_proc = key_hash_proc,
+            .predicate_proc = key_predicate_proc
+        },
+        ._allocator_ptr = allocator_ptr,
+        .count = item_count,
+        .data_ptr = data_ptr,
+        ._slot_size = slot_size,
+        ._bucket_count = bucket_count,
+        ._seed = seed,
+        ._value_size = value_size
+    };
+    memcpy(perfhashmap_ptr, &perfhashmap, sizeof(Sim_PerfectHashMap));
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_perfhashmap_destroy(1): Destroys a perfect hashmap.
+void sim_perfhashmap_destroy(
+    Sim_PerfectHashMap *const perfhashmap_ptr
+) {
+    // check for nullptr
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    perfhashmap_ptr->_allocator_ptr->free(perfhashmap_ptr->data_ptr);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_perfhashmap_get_index(2): Finds the index of the slot holding a key in a perfect hashmap.
+size_t sim_perfhashmap_get_index(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    const void *const         key_ptr
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t index = _sim_perfhashmap_find(perfhashmap_ptr, key_ptr);
+
+    if (index != (size_t)-1)
+        RETURN(SIM_RC_SUCCESS, index);
+    RETURN(SIM_RC_NOT_FOUND, (size_t)-1);
+}
+
+// sim_perfhashmap_contains_key(2): Checks if a key is contained in a perfect hashmap.
+bool sim_perfhashmap_contains_key(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    const void *const         key_ptr
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (_sim_perfhashmap_find(perfhashmap_ptr, key_ptr) != (size_t)-1)
+        RETURN(SIM_RC_SUCCESS, true);
+    RETURN(SIM_RC_NOT_FOUND, false);
+}
+
+// sim_perfhashmap_get_ptr(2): Get pointer to value in a perfect hashmap via a particular key.
+void* sim_perfhashmap_get_ptr(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    const void *const         key_ptr
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t index = _sim_perfhashmap_find(perfhashmap_ptr, key_ptr);
+
+    if (index != (size_t)-1)
+        RETURN(
+            SIM_RC_SUCCESS,
+            (uint8*)perfhashmap_ptr->data_ptr +
+                (perfhashmap_ptr->_slot_size * index) +
+                perfhashmap_ptr->_key_properties.size
+        );
+    RETURN(SIM_RC_NOT_FOUND, NULL);
+}
+
+// sim_perfhashmap_get(3): Get a value from a perfect hashmap via a particular key.
+void sim_perfhashmap_get(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    const void*               key_ptr,
+    void*                     out_value_ptr
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!key_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!out_value_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t index = _sim_perfhashmap_find(perfhashmap_ptr, key_ptr);
+    if (index == (size_t)-1)
+        RETURN(SIM_RC_NOT_FOUND,);
+
+    memcpy(
+        out_value_ptr,
+        (uint8*)perfhashmap_ptr->data_ptr +
+            (perfhashmap_ptr->_slot_size * index) +
+            perfhashmap_ptr->_key_properties.size,
+        perfhashmap_ptr->_value_size
+    );
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_perfhashmap_foreach(3): Applies a given function to each key-value pair in a perfect
+//                             hashmap.
+bool sim_perfhashmap_foreach(
+    Sim_PerfectHashMap *const perfhashmap_ptr,
+    Sim_MapForEachProc        foreach_proc,
+    Sim_Variant               userdata
+) {
+    // check for nullptrs
+    if (!perfhashmap_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!foreach_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    // every slot holds a pair
+    for (size_t i = 0; i < perfhashmap_ptr->count; i++) {
+        uint8 *const slot_ptr = (uint8*)perfhashmap_ptr->data_ptr +
+            (perfhashmap_ptr->_slot_size * i);
+
+        if (!(*foreach_proc)(
+            slot_ptr,
+            slot_ptr + perfhashmap_ptr->_key_properties.size,
+            i,
+            userdata
+        ))
+            RETURN(SIM_RC_SUCCESS, false);
+    }
+
+    RETURN(SIM_RC_SUCCESS, true);
+}
+
+#endif /* SIMSOFT_PERFHASHMAP_C_ */
@@ -13,6 +13,7 @@
 #define SIMSOFT_STRING_C_
 
 #include <stdarg.h>
+#include <string.h>
 
 #include "simsoft/string.h"
 #include "simsoft/util.h"
@@ -64,12 +65,6 @@ static Sim_HashType _sim_string_default_hash(
     const Sim_String *const string_ptr,
     const size_t attempt
 ) {
-    
-#   define SIPHASH_KEY1 0x90d6346e7b77f546ULL
-#   define SIPHASH_KEY2 0x1e0a6097372b5de5ULL
-#   define SIPHASH_KEY3 0x62d76395429756a9ULL
-#   define SIPHASH_KEY4 0xe26534637479058cULL
-
     Sim_HashType hash = sim_siphash(
         (const uint8*)string_ptr->c_string,
         string_ptr->length,
@@ -87,11 +82,30 @@ static Sim_HashType _sim_string_default_hash(
     }
 
     return hash;
+}
 
-#   undef SIPHASH_KEY1
-#   undef SIPHASH_KEY2
-#   undef SIPHASH_KEY3
-#   undef SIPHASH_KEY4
+// fast string hashing function for trusted strings
+static Sim_HashType _sim_string_fast_hash(
+    const Sim_String *const string_ptr,
+    const size_t attempt
+) {
+    Sim_HashType hash = sim_fasthash(
+        (const uint8*)string_ptr->c_string,
+        string_ptr->length,
+        FASTHASH_SEED1
+    );
+
+    if (attempt > 0) {
+        const Sim_HashType hash2 = sim_fasthash(
+            (const uint8*)string_ptr->c_string,
+            string_ptr->length,
+            FASTHASH_SEED2
+        );
+
+        hash += (hash2 * attempt) + attempt;
+    }
+
+    return hash;
 }
 
 static Sim_HashProc _sim_string_hash_proc = (Sim_HashProc)_sim_string_default_hash;
@@ -491,6 +505,11 @@ Sim_HashProc sim_string_get_default_hash_proc(void) {
     return _sim_string_hash_proc;
 }
 
+// sim_string_get_fast_hash_proc(0): Retrieves a sim_fasthash based string hash function.
+Sim_HashProc sim_string_get_fast_hash_proc(void) {
+    return (Sim_HashProc)_sim_string_fast_hash;
+}
+
 // sim_string_set_default_hash_proc(1): Sets the string hash funciton.
 void sim_string_set_default_hash_proc(Sim_HashProc hash_proc) {
     _sim_string_hash_proc = hash_proc ? hash_proc : (Sim_HashProc)_sim_string_default_hash;
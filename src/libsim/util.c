@@ -12,6 +12,8 @@
 #ifndef SIMSOFT_UTIL_C_
 #define SIMSOFT_UTIL_C_
 
+#include <string.h>
+
 #include "./_internal.h"
 #include "simsoft/util.h"
 
@@ -132,4 +134,348 @@ Sim_HashType sim_siphash(
 #   undef U8TO64_LE
 }
 
+// == FASTHASH ====================================================================================
+
+// wyhash mixing constants
+#define _SIM_FASTHASH_P0 0x2d358dccaa6c78a5ULL
+#define _SIM_FASTHASH_P1 0x8bb84b93962eacc9ULL
+#define _SIM_FASTHASH_P2 0x4b33a62ed433d4a3ULL
+#define _SIM_FASTHASH_P3 0x4d5a2da51de1aa47ULL
+
+// xxHash primes used by the long input accumulator
+#define _SIM_FASTHASH_PRIME32_1 0x9e3779b1U
+#define _SIM_FASTHASH_PRIME64_1 0x9e3779b185ebca87ULL
+
+// Inputs longer than this are hashed by the striped accumulator
+#define _SIM_FASTHASH_LONG_SIZE 512
+
+// Striped accumulator layout: 8 lanes over 64-byte stripes; scrambled every 16 stripes
+#define _SIM_FASTHASH_LANES       8
+#define _SIM_FASTHASH_STRIPE_SIZE 64
+#define _SIM_FASTHASH_STRIPES     16
+#define _SIM_FASTHASH_SECRET_SIZE (_SIM_FASTHASH_STRIPES + _SIM_FASTHASH_LANES)
+
+static const uint64 _sim_fasthash_secret[_SIM_FASTHASH_SECRET_SIZE] = {
+    0x65f6d4f027a796adULL, 0x51a049ee335c3a65ULL, 0xa5cc02b75c0019c5ULL,
+    0x6534d2b7fc9eb37aULL, 0x78f2bd1c7da322f8ULL, 0x8cc3dce849789e93ULL,
+    0xed4bcd7caf7655ceULL, 0xa0f235eb5ea874f3ULL, 0x5fee977ed0c85e3bULL,
+    0xee6c80f271aa3b00ULL, 0x96403f3da7cd368aULL, 0x897e8dc6e18cf2c1ULL,
+    0x26509139c2db5283ULL, 0xc1c9d4d8e24364a8ULL, 0xd8035a7af1b910c8ULL,
+    0x46b869cd011dbe8bULL, 0x41b211756916d83cULL, 0x8705fa0f70c73a61ULL,
+    0x5995f59f32073443ULL, 0xf8e200b593b86a1eULL, 0x3cef536ea69f440dULL,
+    0x139de283ece425b6ULL, 0x05523df265b44e1aULL, 0x30240675b050859dULL
+};
+
+// Reads an unaligned 64-bit integer.
+static inline uint64 _sim_fasthash_read64(const uint8 *const data_ptr) {
+    uint64 value;
+    memcpy(&value, data_ptr, sizeof(value));
+    return value;
+}
+
+// Reads an unaligned 32-bit integer.
+static inline uint64 _sim_fasthash_read32(const uint8 *const data_ptr) {
+    uint32 value;
+    memcpy(&value, data_ptr, sizeof(value));
+    return value;
+}
+
+// Multiplies two 64-bit integers, storing the low & high halves of the 128-bit product in them.
+static inline void _sim_fasthash_multiply(uint64 *const a_ptr, uint64 *const b_ptr) {
+#   if defined(__SIZEOF_INT128__)
+        const __uint128_t product = (__uint128_t)*a_ptr * *b_ptr;
+        *a_ptr = (uint64)product;
+        *b_ptr = (uint64)(product >> 64);
+#   elif defined(_MSC_VER) && defined(_M_X64)
+        *a_ptr = _umul128(*a_ptr, *b_ptr, b_ptr);
+#   else
+        const uint64 a_lo = (uint32)*a_ptr, a_hi = *a_ptr >> 32;
+        const uint64 b_lo = (uint32)*b_ptr, b_hi = *b_ptr >> 32;
+        const uint64 lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+        const uint64 lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+        const uint64 cross = (lo_lo >> 32) + (uint32)hi_lo + lo_hi;
+        *a_ptr = (cross << 32) | (uint32)lo_lo;
+        *b_ptr = hi_hi + (hi_lo >> 32) + (cross >> 32);
+#   endif
+}
+
+// Multiplies two 64-bit integers, folding the 128-bit product into 64 bits.
+static inline uint64 _sim_fasthash_mix(uint64 a, uint64 b) {
+    _sim_fasthash_multiply(&a, &b);
+    return a ^ b;
+}
+
+// Accumulator lane vectors; results are identical whichever instruction set is used
+#if defined(ARCH_X86) && defined(__AVX2__)
+#   define _SIM_FASTHASH_AVX2
+    typedef __m256i _Sim_FastHashLanes;
+#elif defined(ARCH_X86) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define _SIM_FASTHASH_SSE2
+    typedef __m128i _Sim_FastHashLanes;
+#elif defined(ARCH_ARM_NEON)
+#   define _SIM_FASTHASH_NEON
+    typedef uint64x2_t _Sim_FastHashLanes;
+#else
+    typedef uint64 _Sim_FastHashLanes;
+#endif
+
+#define _SIM_FASTHASH_VECTOR_LANES (sizeof(_Sim_FastHashLanes) / sizeof(uint64))
+#define _SIM_FASTHASH_VECTORS      (_SIM_FASTHASH_LANES / _SIM_FASTHASH_VECTOR_LANES)
+
+// Fully unroll loops over the lane vectors so they stay in registers
+#if defined(__clang__)
+#   define _SIM_FASTHASH_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && (__GNUC__ >= 8)
+#   define _SIM_FASTHASH_UNROLL _Pragma("GCC unroll 8")
+#else
+#   define _SIM_FASTHASH_UNROLL
+#endif
+
+// Accumulates a stripe of input into the striped accumulator's lanes.
+static inline void _sim_fasthash_accumulate(
+    _Sim_FastHashLanes *const acc,
+    const uint8 *const        data_ptr,
+    const uint64 *const       secret_ptr
+) {
+    _SIM_FASTHASH_UNROLL
+    for (size_t i = 0; i < _SIM_FASTHASH_VECTORS; i++) {
+        const uint8 *const lane_data_ptr = data_ptr + (i * sizeof(_Sim_FastHashLanes));
+        const uint64 *const lane_secret_ptr = secret_ptr + (i * _SIM_FASTHASH_VECTOR_LANES);
+
+        // each lane adds the product of its keyed input's halves & its neighbor's input
+#       if defined(_SIM_FASTHASH_AVX2)
+            const __m256i data = _mm256_loadu_si256((const __m256i*)lane_data_ptr);
+            const __m256i data_key = _mm256_xor_si256(
+                data,
+                _mm256_loadu_si256((const __m256i*)lane_secret_ptr)
+            );
+            const __m256i product = _mm256_mul_epu32(
+                data_key,
+                _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1))
+            );
+            const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+            acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(product, swapped));
+#       elif defined(_SIM_FASTHASH_SSE2)
+            const __m128i data = _mm_loadu_si128((const __m128i*)lane_data_ptr);
+            const __m128i data_key = _mm_xor_si128(
+                data,
+                _mm_loadu_si128((const __m128i*)lane_secret_ptr)
+            );
+            const __m128i product = _mm_mul_epu32(
+                data_key,
+                _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1))
+            );
+            const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+            acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swapped));
+#       elif defined(_SIM_FASTHASH_NEON)
+            const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(lane_data_ptr));
+            const uint64x2_t data_key = veorq_u64(data, vld1q_u64(lane_secret_ptr));
+            const uint64x2_t product = vmull_u32(vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+            const uint64x2_t swapped = vextq_u64(data, data, 1);
+
+            acc[i] = vaddq_u64(acc[i], vaddq_u64(product, swapped));
+#       else
+            const uint64 data_key = _sim_fasthash_read64(lane_data_ptr) ^ *lane_secret_ptr;
+
+            acc[i ^ 1] += _sim_fasthash_read64(lane_data_ptr);
+            acc[i] += (uint64)(uint32)data_key * (data_key >> 32);
+#       endif
+    }
+}
+
+// Scrambles the striped accumulator's lanes after every block of stripes.
+static inline void _sim_fasthash_scramble(
+    _Sim_FastHashLanes *const acc,
+    const uint64 *const       secret_ptr
+) {
+    _SIM_FASTHASH_UNROLL
+    for (size_t i = 0; i < _SIM_FASTHASH_VECTORS; i++) {
+        const uint64 *const lane_secret_ptr = secret_ptr + (i * _SIM_FASTHASH_VECTOR_LANES);
+
+        // lane ^= lane >> 47; lane ^= secret; lane *= prime (64-bit by 32-bit multiply)
+#       if defined(_SIM_FASTHASH_AVX2)
+            const __m256i prime = _mm256_set1_epi32((int)_SIM_FASTHASH_PRIME32_1);
+            __m256i lanes = _mm256_xor_si256(acc[i], _mm256_srli_epi64(acc[i], 47));
+            lanes = _mm256_xor_si256(lanes, _mm256_loadu_si256((const __m256i*)lane_secret_ptr));
+
+            const __m256i product_lo = _mm256_mul_epu32(lanes, prime);
+            const __m256i product_hi = _mm256_mul_epu32(_mm256_srli_epi64(lanes, 32), prime);
+            acc[i] = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+#       elif defined(_SIM_FASTHASH_SSE2)
+            const __m128i prime = _mm_set1_epi32((int)_SIM_FASTHASH_PRIME32_1);
+            __m128i lanes = _mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47));
+            lanes = _mm_xor_si128(lanes, _mm_loadu_si128((const __m128i*)lane_secret_ptr));
+
+            const __m128i product_lo = _mm_mul_epu32(lanes, prime);
+            const __m128i product_hi = _mm_mul_epu32(_mm_srli_epi64(lanes, 32), prime);
+            acc[i] = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+#       elif defined(_SIM_FASTHASH_NEON)
+            const uint32x2_t prime = vdup_n_u32(_SIM_FASTHASH_PRIME32_1);
+            uint64x2_t lanes = veorq_u64(acc[i], vshrq_n_u64(acc[i], 47));
+            lanes = veorq_u64(lanes, vld1q_u64(lane_secret_ptr));
+
+            const uint64x2_t product_lo = vmull_u32(vmovn_u64(lanes), prime);
+            const uint64x2_t product_hi = vmull_u32(vshrn_n_u64(lanes, 32), prime);
+            acc[i] = vaddq_u64(product_lo, vshlq_n_u64(product_hi, 32));
+#       else
+            uint64 lane = acc[i] ^ (acc[i] >> 47);
+            lane ^= *lane_secret_ptr;
+            acc[i] = lane * _SIM_FASTHASH_PRIME32_1;
+#       endif
+    }
+}
+
+// Hashes inputs longer than _SIM_FASTHASH_LONG_SIZE with an XXH3-style striped accumulator.
+static Sim_HashType _sim_fasthash_long(
+    const uint8* data_ptr,
+    const size_t data_size,
+    const uint64 seed
+) {
+    uint64 lanes[_SIM_FASTHASH_LANES] = {
+        0xc2b2ae3dULL,           0x9e3779b185ebca87ULL,
+        0xc2b2ae3d27d4eb4fULL,   0x165667b19e3779f9ULL,
+        0x85ebca77c2b2ae63ULL,   0x85ebca77ULL,
+        0x27d4eb2f165667c5ULL,   0x9e3779b1ULL
+    };
+
+    // keep lanes in vector registers while accumulating
+    _Sim_FastHashLanes acc[_SIM_FASTHASH_VECTORS];
+    memcpy(acc, lanes, sizeof(acc));
+
+    // derive a seeded secret
+    uint64 secret[_SIM_FASTHASH_SECRET_SIZE];
+    for (size_t i = 0; i < _SIM_FASTHASH_SECRET_SIZE; i++)
+        secret[i] = _sim_fasthash_secret[i] + ((i & 1) ? -seed : seed);
+
+    const size_t block_size = _SIM_FASTHASH_STRIPE_SIZE * _SIM_FASTHASH_STRIPES;
+    const uint8 *const end_ptr = data_ptr + data_size;
+
+    // full blocks
+    for (; (size_t)(end_ptr - data_ptr) > block_size; data_ptr += block_size) {
+        for (size_t stripe = 0; stripe < _SIM_FASTHASH_STRIPES; stripe++)
+            _sim_fasthash_accumulate(
+                acc,
+                data_ptr + stripe * _SIM_FASTHASH_STRIPE_SIZE,
+                secret + stripe
+            );
+        _sim_fasthash_scramble(acc, secret + _SIM_FASTHASH_STRIPES);
+    }
+
+    // remaining full stripes
+    for (size_t stripe = 0; (size_t)(end_ptr - data_ptr) > _SIM_FASTHASH_STRIPE_SIZE; stripe++) {
+        _sim_fasthash_accumulate(acc, data_ptr, secret + stripe);
+        data_ptr += _SIM_FASTHASH_STRIPE_SIZE;
+    }
+
+    // last (possibly overlapping) stripe
+    _sim_fasthash_accumulate(
+        acc,
+        end_ptr - _SIM_FASTHASH_STRIPE_SIZE,
+        secret + _SIM_FASTHASH_STRIPES - 1
+    );
+
+    memcpy(lanes, acc, sizeof(lanes));
+
+    // merge lanes
+    uint64 hash = data_size * _SIM_FASTHASH_PRIME64_1;
+    for (size_t i = 0; i < _SIM_FASTHASH_LANES; i += 2)
+        hash += _sim_fasthash_mix(
+            lanes[i] ^ secret[_SIM_FASTHASH_STRIPES + i],
+            lanes[i + 1] ^ secret[_SIM_FASTHASH_STRIPES + i + 1]
+        );
+
+    hash ^= hash >> 37;
+    hash *= 0x165667919e3779f9ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+Sim_HashType sim_fasthash(
+    const uint8* data_ptr,
+    const size_t data_size,
+    uint64       seed
+) {
+    if (!data_ptr)
+        return 0;
+    
+    if (data_size > _SIM_FASTHASH_LONG_SIZE)
+        return _sim_fasthash_long(data_ptr, data_size, seed);
+
+    // wyhash for short inputs
+    seed ^= _sim_fasthash_mix(seed ^ _SIM_FASTHASH_P0, _SIM_FASTHASH_P1);
+
+    uint64 a, b;
+    if (data_size <= 16) {
+        if (data_size >= 4) {
+            const size_t offset = (data_size >> 3) << 2;
+            a = (_sim_fasthash_read32(data_ptr) << 32) |
+                _sim_fasthash_read32(data_ptr + offset);
+            b = (_sim_fasthash_read32(data_ptr + data_size - 4) << 32) |
+                _sim_fasthash_read32(data_ptr + data_size - 4 - offset);
+        } else if (data_size > 0) {
+            a = ((uint64)data_ptr[0] << 16) |
+                ((uint64)data_ptr[data_size >> 1] << 8) |
+                data_ptr[data_size - 1];
+            b = 0;
+        } else
+            a = b = 0;
+    } else {
+        size_t remaining = data_size;
+
+        // 3 independent lanes over 48 bytes at a time
+        if (remaining > 48) {
+            uint64 seed1 = seed, seed2 = seed;
+            do {
+                seed = _sim_fasthash_mix(
+                    _sim_fasthash_read64(data_ptr) ^ _SIM_FASTHASH_P1,
+                    _sim_fasthash_read64(data_ptr + 8) ^ seed
+                );
+                seed1 = _sim_fasthash_mix(
+                    _sim_fasthash_read64(data_ptr + 16) ^ _SIM_FASTHASH_P2,
+                    _sim_fasthash_read64(data_ptr + 24) ^ seed1
+                );
+                seed2 = _sim_fasthash_mix(
+                    _sim_fasthash_read64(data_ptr + 32) ^ _SIM_FASTHASH_P3,
+                    _sim_fasthash_read64(data_ptr + 40) ^ seed2
+                );
+                data_ptr += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16) {
+            seed = _sim_fasthash_mix(
+                _sim_fasthash_read64(data_ptr) ^ _SIM_FASTHASH_P1,
+                _sim_fasthash_read64(data_ptr + 8) ^ seed
+            );
+            data_ptr += 16;
+            remaining -= 16;
+        }
+
+        // last 16 bytes (possibly overlapping)
+        a = _sim_fasthash_read64(data_ptr + remaining - 16);
+        b = _sim_fasthash_read64(data_ptr + remaining - 8);
+    }
+
+    a ^= _SIM_FASTHASH_P1;
+    b ^= seed;
+    _sim_fasthash_multiply(&a, &b);
+
+    return _sim_fasthash_mix(a ^ _SIM_FASTHASH_P0 ^ data_size, b ^ _SIM_FASTHASH_P1);
+}
+
+#undef _SIM_FASTHASH_P0
+#undef _SIM_FASTHASH_P1
+#undef _SIM_FASTHASH_P2
+#undef _SIM_FASTHASH_P3
+#undef _SIM_FASTHASH_PRIME32_1
+#undef _SIM_FASTHASH_PRIME64_1
+#undef _SIM_FASTHASH_VECTOR_LANES
+#undef _SIM_FASTHASH_VECTORS
+#undef _SIM_FASTHASH_UNROLL
+
 #endif /* SIMSOFT_UTIL_C_ */
@@ -12,19 +12,341 @@
 #ifndef SIMSOFT_VECTOR_C_
 #define SIMSOFT_VECTOR_C_
 
+#include <string.h>
+
 #include "simsoft/vector.h"
 #include "./_internal.h"
 
+static const Sim_VectorPolicy _sim_vector_default_policy = {
+    .growth_percent = SIM_VECTOR_DEFAULT_GROWTH_PERCENT,
+    .shrink_percent = SIM_VECTOR_DEFAULT_SHRINK_PERCENT
+};
+
+// Reallocates a vector's internal array to hold a given amount of items. Returns false if out of
+//  memory.
+static bool _sim_vector_reallocate(
+    Sim_Vector *const vector_ptr,
+    const size_t      size
+) {
+    const size_t item_size = vector_ptr->_item_size;
+
+    // check for overflow
+    if (size > SIZE_MAX / item_size)
+        return false;
+
+    // realloc new internal array or malloc new one if NULL
+    void* data_ptr = vector_ptr->data_ptr ?
+        vector_ptr->_allocator_ptr->realloc(vector_ptr->data_ptr, size * item_size) :
+        vector_ptr->_allocator_ptr->malloc(size * item_size)
+    ;
+    if (!data_ptr)
+        return false;
+
+    vector_ptr->data_ptr = data_ptr;
+    vector_ptr->_allocated = size;
+    return true;
+}
+
+// Grows a vector's internal array by its growth factor if it can't hold a given amount of items.
+//  Returns false if out of memory.
+static bool _sim_vector_grow(
+    Sim_Vector *const vector_ptr,
+    const size_t      size
+) {
+    if (size <= vector_ptr->_allocated)
+        return true;
+
+    const size_t allocated = vector_ptr->_allocated;
+    const size_t growth_percent = vector_ptr->_policy.growth_percent;
+
+    // small arrays may not grow by a whole item; huge ones would overflow
+    size_t new_size = allocated <= SIZE_MAX / growth_percent ?
+        allocated * growth_percent / 100 :
+        size
+    ;
+    if (new_size < size)
+        new_size = size;
+
+    return _sim_vector_reallocate(vector_ptr, new_size);
+}
+
+// Shrinks a vector's internal array by its growth factor until its load is above its shrink
+//  threshold, but never below its initial size.
+static void _sim_vector_shrink(Sim_Vector *const vector_ptr) {
+    const Sim_VectorPolicy policy = vector_ptr->_policy;
+    const size_t count = vector_ptr->count;
+    const size_t initial_size = vector_ptr->_initial_size;
+    const size_t allocated = vector_ptr->_allocated;
+
+    if (!policy.shrink_percent)
+        return;
+
+    // removing a range may call for shrinking more than once; do it in one reallocation
+    size_t new_size = allocated;
+    while (new_size > initial_size && count * 100 <= new_size * policy.shrink_percent)
+        new_size = new_size * 100 / policy.growth_percent;
+
+    if (new_size < initial_size)
+        new_size = initial_size;
+    if (new_size >= allocated)
+        return;
+
+    // keep the old array if it couldn't be shrunk
+    _sim_vector_reallocate(vector_ptr, new_size);
+}
+
+// Amount of bytes compared at once by the SIMD find fast path
+#define _SIM_VECTOR_FIND_BLOCK_SIZE 16
+
+#if defined(ARCH_X86) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define _SIM_VECTOR_FIND_SSE2
+#   define _SIM_VECTOR_FIND_MASK_SHIFT 0 // 1 bit per byte
+    typedef __m128i _Sim_VectorFindBlock;
+#elif defined(ARCH_ARM_NEON)
+#   define _SIM_VECTOR_FIND_NEON
+#   define _SIM_VECTOR_FIND_MASK_SHIFT 2 // 4 bits per byte
+    typedef uint8x16_t _Sim_VectorFindBlock;
+#endif
+
+// Finds the index of the first 1, 2, 4, or 8-byte item from a given index onwards that's bytewise
+//  equal to a given item, comparing them as integers. Other sizes are compared with memcmp.
+static size_t _sim_vector_find_scalar(
+    const uint8 *const data_ptr,
+    const void *const  item_ptr,
+    const size_t       item_size,
+    const size_t       starting_index,
+    const size_t       count
+) {
+    // loads are memcpy'd since items needn't be aligned
+#   define _SIM_VECTOR_FIND_SCALAR(TYPE) do {                                                 \
+        TYPE needle;                                                                          \
+        memcpy(&needle, item_ptr, sizeof(TYPE));                                              \
+        for (size_t i = starting_index; i < count; i++) {                                     \
+            TYPE value;                                                                       \
+            memcpy(&value, data_ptr + (i * sizeof(TYPE)), sizeof(TYPE));                      \
+            if (value == needle)                                                              \
+                return i;                                                                     \
+        }                                                                                     \
+        return (size_t)-1;                                                                    \
+    } while (0)
+
+    switch (item_size) {
+        case 1: {
+            const uint8 *const found_ptr = memchr(
+                data_ptr + starting_index,
+                *(const uint8*)item_ptr,
+                count - starting_index
+            );
+            return found_ptr ? (size_t)(found_ptr - data_ptr) : (size_t)-1;
+        }
+        case 2:
+            _SIM_VECTOR_FIND_SCALAR(uint16);
+        case 4:
+            _SIM_VECTOR_FIND_SCALAR(uint32);
+        case 8:
+            _SIM_VECTOR_FIND_SCALAR(uint64);
+        default:
+            for (size_t i = starting_index; i < count; i++)
+                if (!memcmp(data_ptr + (i * item_size), item_ptr, item_size))
+                    return i;
+            return (size_t)-1;
+    }
+
+#   undef _SIM_VECTOR_FIND_SCALAR
+}
+
+#if defined(_SIM_VECTOR_FIND_SSE2) || defined(_SIM_VECTOR_FIND_NEON)
+    // Fills a block with copies of a 1, 2, 4, or 8-byte item.
+    static inline _Sim_VectorFindBlock _sim_vector_find_splat(
+        const void *const item_ptr,
+        const size_t      item_size
+    ) {
+        uint64 item = 0;
+        memcpy(&item, item_ptr, item_size);
+
+#       if defined(_SIM_VECTOR_FIND_SSE2)
+            switch (item_size) {
+                case 1:  return _mm_set1_epi8((char)item);
+                case 2:  return _mm_set1_epi16((short)item);
+                case 4:  return _mm_set1_epi32((int)item);
+                default: return _mm_set_epi32(
+                    (int)(item >> 32), (int)item, (int)(item >> 32), (int)item
+                );
+            }
+#       else
+            switch (item_size) {
+                case 1:  return vdupq_n_u8((uint8)item);
+                case 2:  return vreinterpretq_u8_u16(vdupq_n_u16((uint16)item));
+                case 4:  return vreinterpretq_u8_u32(vdupq_n_u32((uint32)item));
+                default: return vreinterpretq_u8_u64(vdupq_n_u64(item));
+            }
+#       endif
+    }
+
+    // Matches every 1, 2, 4, or 8-byte item in a block against a block of copies of an item.
+    //  Returns a mask with the bits of the bytes of matching items set.
+    static inline uint64 _sim_vector_find_match(
+        const uint8 *const         block_ptr,
+        const _Sim_VectorFindBlock needle,
+        const size_t               item_size
+    ) {
+#       if defined(_SIM_VECTOR_FIND_SSE2)
+            const __m128i block = _mm_loadu_si128((const __m128i*)block_ptr);
+            __m128i matches;
+            switch (item_size) {
+                case 1:  matches = _mm_cmpeq_epi8(block, needle); break;
+                case 2:  matches = _mm_cmpeq_epi16(block, needle); break;
+                case 4:  matches = _mm_cmpeq_epi32(block, needle); break;
+                default:
+                    // SSE2 lacks 64-bit compares; both halves of an item must match
+                    matches = _mm_cmpeq_epi32(block, needle);
+                    matches = _mm_and_si128(
+                        matches,
+                        _mm_shuffle_epi32(matches, _MM_SHUFFLE(2, 3, 0, 1))
+                    );
+            }
+            return (uint32)_mm_movemask_epi8(matches);
+#       else
+            const uint8x16_t block = vld1q_u8(block_ptr);
+            uint8x16_t matches;
+            switch (item_size) {
+                case 1:
+                    matches = vceqq_u8(block, needle);
+                    break;
+                case 2:
+                    matches = vreinterpretq_u8_u16(vceqq_u16(
+                        vreinterpretq_u16_u8(block),
+                        vreinterpretq_u16_u8(needle)
+                    ));
+                    break;
+                default: {
+                    // 64-bit compares are AArch64-only; both halves of an item must match
+                    uint32x4_t words = vceqq_u32(
+                        vreinterpretq_u32_u8(block),
+                        vreinterpretq_u32_u8(needle)
+                    );
+                    if (item_size == 8)
+                        words = vandq_u32(words, vrev64q_u32(words));
+                    matches = vreinterpretq_u8_u32(words);
+                }
+            }
+
+            // NEON lacks movemask; narrow each matched byte down to a nibble instead
+            const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+            return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+#       endif
+    }
+
+    // Retrieves the index within a block of the lowest byte in a non-zero match mask.
+    static inline size_t _sim_vector_find_mask_first(const uint64 mask) {
+#       if defined(_MSC_VER)
+            unsigned long index; // MSVC builds use at most 1 bit for each of the 16 bytes
+            _BitScanForward(&index, (unsigned long)mask);
+            return index >> _SIM_VECTOR_FIND_MASK_SHIFT;
+#       else
+            return (size_t)__builtin_ctzll(mask) >> _SIM_VECTOR_FIND_MASK_SHIFT;
+#       endif
+    }
+#endif
+
+// Finds the index of the first item from a given index onwards that's bytewise equal to a given
+//  item. 1, 2, 4, & 8-byte items are compared a block at a time where SIMD is available.
+static size_t _sim_vector_find_bytewise(
+    const uint8 *const data_ptr,
+    const void *const  item_ptr,
+    const size_t       item_size,
+    const size_t       starting_index,
+    const size_t       count
+) {
+#   if defined(_SIM_VECTOR_FIND_SSE2) || defined(_SIM_VECTOR_FIND_NEON)
+        if (item_size == 1 || item_size == 2 || item_size == 4 || item_size == 8) {
+            const _Sim_VectorFindBlock needle = _sim_vector_find_splat(item_ptr, item_size);
+            const uint8* block_ptr = data_ptr + (starting_index * item_size);
+            const uint8 *const end_ptr = data_ptr + (count * item_size);
+
+            // 4 blocks at a time; only locate the match once one is found
+            for (; end_ptr - block_ptr >= 4 * _SIM_VECTOR_FIND_BLOCK_SIZE;
+                block_ptr += 4 * _SIM_VECTOR_FIND_BLOCK_SIZE
+            ) {
+                const uint64 masks[4] = {
+                    _sim_vector_find_match(block_ptr, needle, item_size),
+                    _sim_vector_find_match(block_ptr + 16, needle, item_size),
+                    _sim_vector_find_match(block_ptr + 32, needle, item_size),
+                    _sim_vector_find_match(block_ptr + 48, needle, item_size)
+                };
+                if (!(masks[0] | masks[1] | masks[2] | masks[3]))
+                    continue;
+
+                for (size_t i = 0;; i++)
+                    if (masks[i])
+                        return (size_t)(
+                            block_ptr - data_ptr +
+                            (i * _SIM_VECTOR_FIND_BLOCK_SIZE) +
+                            _sim_vector_find_mask_first(masks[i])
+                        ) / item_size;
+            }
+
+            for (; end_ptr - block_ptr >= _SIM_VECTOR_FIND_BLOCK_SIZE;
+                block_ptr += _SIM_VECTOR_FIND_BLOCK_SIZE
+            ) {
+                const uint64 mask = _sim_vector_find_match(block_ptr, needle, item_size);
+                if (mask)
+                    return (size_t)(
+                        block_ptr - data_ptr + _sim_vector_find_mask_first(mask)
+                    ) / item_size;
+            }
+
+            // items left over past the last whole block
+            return _sim_vector_find_scalar(
+                data_ptr,
+                item_ptr,
+                item_size,
+                (size_t)(block_ptr - data_ptr) / item_size,
+                count
+            );
+        }
+#   endif
+
+    return _sim_vector_find_scalar(data_ptr, item_ptr, item_size, starting_index, count);
+}
+
 // sim_vector_construct(4): Constructs a new vector.
 void sim_vector_construct(
     Sim_Vector *const     vector_ptr,
     const size_t          item_size,
     const Sim_IAllocator* allocator_ptr,
     size_t                initial_size
+) {
+    sim_vector_construct_with_policy(vector_ptr, item_size, allocator_ptr, initial_size, NULL);
+}
+
+// sim_vector_construct_with_policy(5): Constructs a new vector that grows & shrinks with a given
+//                                      policy.
+void sim_vector_construct_with_policy(
+    Sim_Vector *const             vector_ptr,
+    const size_t                  item_size,
+    const Sim_IAllocator*         allocator_ptr,
+    size_t                        initial_size,
+    const Sim_VectorPolicy *const policy_ptr
 ) {
     if (!vector_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
 
+    // use default policy on NULL
+    const Sim_VectorPolicy policy = policy_ptr ?
+        *policy_ptr :
+        _sim_vector_default_policy
+    ;
+
+    // a shrunk array must have room to spare, or the next push would grow it right back
+    if (
+        !item_size ||
+        policy.growth_percent <= 100 ||
+        (uint32)policy.shrink_percent * policy.growth_percent >= 10000
+    )
+        THROW(SIM_RC_ERR_INVALARG);
+
     if (!initial_size)
         initial_size = SIM_DEFAULT_VECTOR_SIZE;
         
@@ -32,27 +354,25 @@ void sim_vector_construct(
     if (!allocator_ptr)
         allocator_ptr = sim_allocator_get_default();
 
+    // check for overflow
+    if (initial_size > SIZE_MAX / item_size)
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
     // allocate internal array
     void* data_ptr = allocator_ptr->malloc(item_size * initial_size);
     if (!data_ptr)
         THROW(SIM_RC_ERR_OUTOFMEM);
 
-    // assign unchanging properties
-    memcpy(
-        (uint8*)vector_ptr + offsetof(Sim_Vector, _item_size),
-        &item_size,
-        sizeof item_size
-    );
-    memcpy(
-        (uint8*)vector_ptr + offsetof(Sim_Vector, _allocator_ptr),
-        &allocator_ptr,
-        sizeof allocator_ptr
-    );
-
-    // assign properties
-    vector_ptr->_allocated = initial_size;
-    vector_ptr->count = 0;
-    vector_ptr->data_ptr = data_ptr;
+    Sim_Vector vector = {
+        ._item_size     = item_size,
+        ._allocator_ptr = allocator_ptr,
+        ._allocated     = initial_size,
+        ._initial_size  = initial_size,
+        ._policy        = policy,
+        .count          = 0,
+        .data_ptr       = data_ptr
+    };
+    memcpy(vector_ptr, &vector, sizeof(Sim_Vector));
 
     RETURN(SIM_RC_SUCCESS,);
 }
@@ -83,10 +403,7 @@ void sim_vector_clear(Sim_Vector *const vector_ptr) {
     if (!vector_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
 
-    // free array & set count to 0
-    vector_ptr->_allocator_ptr->free(vector_ptr->data_ptr);
-    vector_ptr->data_ptr = NULL;
-    vector_ptr->_allocated = 0;
+    // keep array so refilling the vector doesn't reallocate it
     vector_ptr->count = 0;
 
     RETURN(SIM_RC_SUCCESS,);
@@ -101,35 +418,38 @@ void sim_vector_resize(
     if (!vector_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
 
-    // skip if allocated & size are identical
-    if (size == vector_ptr->_allocated)
-        RETURN(SIM_RC_SUCCESS,);
-
     // error if size < count
     if (size < vector_ptr->count)
         THROW(SIM_RC_ERR_INVALARG);
 
-    // calculate how many bytes to allocate for internal array
-    size_t bytes_to_alloc =
-        (size > SIM_DEFAULT_VECTOR_SIZE ?
-            size :
-            SIM_DEFAULT_VECTOR_SIZE
-        ) * vector_ptr->_item_size
+    // allocate at least the default size
+    const size_t new_size = size > SIM_DEFAULT_VECTOR_SIZE ?
+        size :
+        SIM_DEFAULT_VECTOR_SIZE
     ;
-    
-    // realloc new internal array or malloc new one if NULL
-    void* data_ptr;
-    if (vector_ptr->data_ptr)
-        data_ptr = vector_ptr->_allocator_ptr->realloc(vector_ptr->data_ptr, bytes_to_alloc);
-    else
-        data_ptr = vector_ptr->_allocator_ptr->malloc(bytes_to_alloc);
 
-    if (!data_ptr)
+    // skip if allocated & size are identical
+    if (new_size == vector_ptr->_allocated)
+        RETURN(SIM_RC_SUCCESS,);
+
+    if (!_sim_vector_reallocate(vector_ptr, new_size))
+        THROW(SIM_RC_ERR_OUTOFMEM);
+
+    RETURN(SIM_RC_SUCCESS,);
+}
+
+// sim_vector_reserve(2): Grows a vector to hold at least a given amount of items without
+//                        reallocating.
+void sim_vector_reserve(
+    Sim_Vector *const vector_ptr,
+    const size_t      size
+) {
+    // check for nullptr
+    if (!vector_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    if (size > vector_ptr->_allocated && !_sim_vector_reallocate(vector_ptr, size))
         THROW(SIM_RC_ERR_OUTOFMEM);
-    
-    // reassign data_ptr and _allocated
-    vector_ptr->data_ptr = data_ptr;
-    vector_ptr->_allocated = size;
 
     RETURN(SIM_RC_SUCCESS,);
 }
@@ -176,17 +496,30 @@ size_t sim_vector_find(
         THROW(SIM_RC_ERR_NULLPTR);
     if (!item_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
-    if (!predicate_proc)
-        THROW(SIM_RC_ERR_NULLPTR);
 
     // check for out-of-bounds starting index
-    if (starting_index >= vector_ptr->count)
+    if (starting_index > vector_ptr->count)
         THROW(SIM_RC_ERR_OUTOFBND);
     
-    uint8*  data_ptr = (uint8*)vector_ptr->data_ptr;
     size_t count = vector_ptr->count;
     const size_t item_size = vector_ptr->_item_size;
 
+    // compare bytes directly rather than calling a predicate per item
+    if (!predicate_proc) {
+        const size_t index = _sim_vector_find_bytewise(
+            vector_ptr->data_ptr,
+            item_ptr,
+            item_size,
+            starting_index,
+            count
+        );
+        if (index == (size_t)-1)
+            RETURN(SIM_RC_NOT_FOUND, (size_t)-1);
+        RETURN(SIM_RC_SUCCESS, index);
+    }
+
+    uint8*  data_ptr = (uint8*)vector_ptr->data_ptr + (item_size * starting_index);
+
     // iterate over indexes
     for (size_t i = starting_index; i < count; i++) {
         // check if item & comparison_data compare as equal
@@ -227,61 +560,62 @@ void sim_vector_insert(
     Sim_Vector *const vector_ptr,
     const void*       new_item_ptr,
     const size_t      index
+) {
+    sim_vector_insert_n(vector_ptr, new_item_ptr, 1, index);
+}
+
+// sim_vector_append_n(3): Push an array of new items to the back of a vector.
+void sim_vector_append_n(
+    Sim_Vector *const vector_ptr,
+    const void*       items_ptr,
+    const size_t      item_count
+) {
+    sim_vector_insert_n(vector_ptr, items_ptr, item_count, vector_ptr ? vector_ptr->count : 0);
+}
+
+// sim_vector_insert_n(4): Insert an array of new items into a vector at a given index.
+void sim_vector_insert_n(
+    Sim_Vector *const vector_ptr,
+    const void*       items_ptr,
+    const size_t      item_count,
+    const size_t      index
 ) {
     // check for nullptrs
     if (!vector_ptr)
         THROW(SIM_RC_ERR_NULLPTR);
-    if (!new_item_ptr)
+    if (!items_ptr && item_count)
         THROW(SIM_RC_ERR_NULLPTR);
 
     // check for out-of-bounds index
     if (index > vector_ptr->count)
         THROW(SIM_RC_ERR_OUTOFBND);
 
-    // reallocate data_ptr if cleared
-    if (!vector_ptr->data_ptr) {
-        sim_vector_resize(vector_ptr, SIM_DEFAULT_VECTOR_SIZE);
+    const size_t count = vector_ptr->count;
 
-        THROW(sim_get_return_code());
-    }
+    // resize vector once to fit every item
+    if (item_count > SIZE_MAX - count || !_sim_vector_grow(vector_ptr, count + item_count))
+        THROW(SIM_RC_ERR_OUTOFMEM);
 
     const size_t item_size = vector_ptr->_item_size;
     uint8*  data_ptr = vector_ptr->data_ptr;
-    
-    // resize vector if full
-    if (vector_ptr->count == vector_ptr->_allocated) {
-        // check for overflow
-        if (item_size * vector_ptr->_allocated * 2 < item_size * vector_ptr->_allocated)
-            THROW(SIM_RC_ERR_OUTOFMEM);
-
-        data_ptr = vector_ptr->_allocator_ptr->realloc(
-            data_ptr,
-            item_size * vector_ptr->_allocated * 2
-        );
-
-        // check if resize failed
-        if (!data_ptr)
-            THROW(SIM_RC_ERR_OUTOFMEM);
 
-        vector_ptr->_allocated *= 2;
-        vector_ptr->data_ptr = data_ptr;
-    }
-
-    // pointer to insert new item into
+    // pointer to insert new items into
     uint8* insert_ptr = data_ptr + (item_size * index);
 
     // move items ahead of index forward
-    memmove(
-        insert_ptr + item_size,
-        insert_ptr,
-        item_size * (vector_ptr->count - index)
-    );
+    if (index < count)
+        memmove(
+            insert_ptr + (item_size * item_count),
+            insert_ptr,
+            item_size * (count - index)
+        );
 
-    // insert new item
-    memcpy(insert_ptr, new_item_ptr, item_size);
+    // insert new items
+    if (item_count)
+        memcpy(insert_ptr, items_ptr, item_size * item_count);
 
-    // increment data count
-    vector_ptr->count++;
+    // increase data count
+    vector_ptr->count += item_count;
     RETURN(SIM_RC_SUCCESS,);
 }
 
@@ -298,51 +632,47 @@ void sim_vector_remove(
     Sim_Vector *const vector_ptr,
     void*             data_out_ptr,
     const size_t      index
+) {
+    sim_vector_remove_range(vector_ptr, data_out_ptr, index, 1);
+}
+
+// sim_vector_remove_range(4): Removes a range of consecutive items from the vector.
+void sim_vector_remove_range(
+    Sim_Vector *const vector_ptr,
+    void*             items_out_ptr,
+    const size_t      start_index,
+    const size_t      item_count
 ) {
     // check for nullptr
     if (!vector_ptr)    
         THROW(SIM_RC_ERR_NULLPTR);
 
-    // check for out-of-bounds index
-    if (index >= vector_ptr->count)
+    const size_t count = vector_ptr->count;
+
+    // check for out-of-bounds range
+    if (start_index > count || item_count > count - start_index)
         THROW(SIM_RC_ERR_OUTOFBND);
     
     size_t item_size  = vector_ptr->_item_size;
-    uint8*  remove_ptr = (uint8*)vector_ptr->data_ptr + (item_size * index);
-
-    // fill data_out_ptr with removed item if provided
-    if (data_out_ptr)
-        memcpy(data_out_ptr, remove_ptr, item_size);
-
-    // move items ahead of index backward
-    memmove(
-        remove_ptr,
-        remove_ptr + item_size,
-        item_size * (vector_ptr->count - index)
-    );
+    uint8*  remove_ptr = (uint8*)vector_ptr->data_ptr + (item_size * start_index);
+
+    // fill items_out_ptr with removed items if provided
+    if (items_out_ptr && item_count)
+        memcpy(items_out_ptr, remove_ptr, item_size * item_count);
+
+    // move items ahead of range backward
+    if (start_index + item_count < count)
+        memmove(
+            remove_ptr,
+            remove_ptr + (item_size * item_count),
+            item_size * (count - start_index - item_count)
+        );
 
-    // decrement count
-    vector_ptr->count--;
+    // decrease count
+    vector_ptr->count -= item_count;
 
     // resize down if able to
-    if (
-        vector_ptr->count <= vector_ptr->_allocated / 4 &&
-        vector_ptr->_allocated > SIM_DEFAULT_VECTOR_SIZE
-    ) {
-        size_t new_size = (vector_ptr->_allocated / 2) > SIM_DEFAULT_VECTOR_SIZE ?
-            (vector_ptr->_allocated / 2) :
-            SIM_DEFAULT_VECTOR_SIZE
-        ;
-
-        void* data_ptr = vector_ptr->_allocator_ptr->realloc(
-            vector_ptr->data_ptr,
-            new_size * item_size
-        );
-        vector_ptr->_allocated = new_size;
-
-        // use new array if successfully reallocated; else use old array
-        if (data_ptr) vector_ptr->data_ptr = data_ptr;
-    }
+    _sim_vector_shrink(vector_ptr);
 
     RETURN(SIM_RC_SUCCESS,);
 }
@@ -436,4 +766,224 @@ void sim_vector_select(
     _sim_vector_filter(vector_ptr, select_proc, userdata, out_vector_ptr, false);
 }
 
+// Amount of bytes swapped at once when swapping items of any size without allocating
+#define _SIM_VECTOR_SWAP_BLOCK_SIZE 64
+
+// Size of the stack buffer stable partitions set failing items aside in
+#define _SIM_VECTOR_PARTITION_BUFFER_SIZE 512
+
+// Swaps two non-overlapping ranges of bytes through a small stack buffer.
+static void _sim_vector_swap(
+    uint8*       a_ptr,
+    uint8*       b_ptr,
+    const size_t size
+) {
+    uint8 buffer[_SIM_VECTOR_SWAP_BLOCK_SIZE];
+
+    for (size_t offset = 0; offset < size; offset += _SIM_VECTOR_SWAP_BLOCK_SIZE) {
+        const size_t block_size = size - offset < _SIM_VECTOR_SWAP_BLOCK_SIZE ?
+            size - offset :
+            _SIM_VECTOR_SWAP_BLOCK_SIZE
+        ;
+
+        memcpy(buffer, a_ptr + offset, block_size);
+        memcpy(a_ptr + offset, b_ptr + offset, block_size);
+        memcpy(b_ptr + offset, buffer, block_size);
+    }
+}
+
+// Rotates the bytes in [first_ptr, last_ptr) so that middle_ptr becomes the first byte, by
+//  repeatedly swapping the shorter side into its final place as one block.
+static void _sim_vector_rotate(
+    uint8* first_ptr,
+    uint8* middle_ptr,
+    uint8* last_ptr
+) {
+    while (first_ptr != middle_ptr && middle_ptr != last_ptr) {
+        const size_t left_size = (size_t)(middle_ptr - first_ptr);
+        const size_t right_size = (size_t)(last_ptr - middle_ptr);
+
+        if (left_size <= right_size) {
+            // the front of the right side is in place; the left side moved into it
+            _sim_vector_swap(first_ptr, middle_ptr, left_size);
+            first_ptr = middle_ptr;
+            middle_ptr += left_size;
+        } else {
+            // the back of the left side is in place; the right side moved into it
+            _sim_vector_swap(middle_ptr - right_size, middle_ptr, right_size);
+            last_ptr = middle_ptr;
+            middle_ptr -= right_size;
+        }
+    }
+}
+
+// Moves the items passing a filter function in front of those failing it, keeping both groups in
+//  order. Each item is tested once; returns the amount of items passing.
+static size_t _sim_vector_partition_stable(
+    uint8*         data_ptr,
+    const size_t   count,
+    const size_t   item_size,
+    Sim_FilterProc filter_proc,
+    Sim_Variant    userdata
+) {
+    if (count == 1)
+        return (*filter_proc)(data_ptr, userdata) ? 1 : 0;
+
+    // ranges small enough to fit on the stack set failing items aside rather than rotating
+    if (count * item_size <= _SIM_VECTOR_PARTITION_BUFFER_SIZE) {
+        uint8 buffer[_SIM_VECTOR_PARTITION_BUFFER_SIZE];
+        size_t passed = 0;
+        size_t failed = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            const uint8* item_ptr = data_ptr + (item_size * i);
+
+            if ((*filter_proc)(item_ptr, userdata)) {
+                if (passed != i)
+                    memcpy(data_ptr + (item_size * passed), item_ptr, item_size);
+                passed++;
+            } else {
+                memcpy(buffer + (item_size * failed), item_ptr, item_size);
+                failed++;
+            }
+        }
+
+        memcpy(data_ptr + (item_size * passed), buffer, item_size * failed);
+        return passed;
+    }
+
+    // partition each half, then rotate the left half's failures behind the right half's passes
+    const size_t half = count / 2;
+    uint8* half_ptr = data_ptr + (item_size * half);
+
+    const size_t left = _sim_vector_partition_stable(
+        data_ptr, half, item_size, filter_proc, userdata
+    );
+    const size_t right = _sim_vector_partition_stable(
+        half_ptr, count - half, item_size, filter_proc, userdata
+    );
+
+    _sim_vector_rotate(
+        data_ptr + (item_size * left),
+        half_ptr,
+        half_ptr + (item_size * right)
+    );
+
+    return left + right;
+}
+
+// sim_vector_retain(4): Removes every item failing a given function from the vector in place.
+size_t sim_vector_retain(
+    Sim_Vector *const vector_ptr,
+    Sim_FilterProc    filter_proc,
+    Sim_Variant       userdata,
+    const bool        stable
+) {
+    // check for nullptrs
+    if (!vector_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!filter_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t count = vector_ptr->count;
+    const size_t item_size = vector_ptr->_item_size;
+    uint8* data_ptr = vector_ptr->data_ptr;
+    size_t kept = 0;
+
+    if (stable) {
+        // move each run of kept items back over the removed items before it in one block
+        size_t run_start = 0;
+
+        for (size_t i = 0; i <= count; i++) {
+            if (i < count && (*filter_proc)(data_ptr + (item_size * i), userdata))
+                continue;
+
+            const size_t run_count = i - run_start;
+            if (run_count && kept != run_start)
+                memmove(
+                    data_ptr + (item_size * kept),
+                    data_ptr + (item_size * run_start),
+                    item_size * run_count
+                );
+
+            kept += run_count;
+            run_start = i + 1;
+        }
+    } else {
+        // fill each removed item's slot with a kept item from the back of the vector
+        size_t end = count;
+
+        while (kept < end) {
+            if ((*filter_proc)(data_ptr + (item_size * kept), userdata)) {
+                kept++;
+                continue;
+            }
+
+            do end--;
+            while (end > kept && !(*filter_proc)(data_ptr + (item_size * end), userdata));
+
+            if (end > kept) {
+                memcpy(data_ptr + (item_size * kept), data_ptr + (item_size * end), item_size);
+                kept++;
+            }
+        }
+    }
+
+    vector_ptr->count = kept;
+
+    RETURN(SIM_RC_SUCCESS, count - kept);
+}
+
+// sim_vector_partition(4): Moves items passing a given function in front of those failing it.
+size_t sim_vector_partition(
+    Sim_Vector *const vector_ptr,
+    Sim_FilterProc    filter_proc,
+    Sim_Variant       userdata,
+    const bool        stable
+) {
+    // check for nullptrs
+    if (!vector_ptr)
+        THROW(SIM_RC_ERR_NULLPTR);
+    if (!filter_proc)
+        THROW(SIM_RC_ERR_NULLPTR);
+
+    const size_t count = vector_ptr->count;
+    const size_t item_size = vector_ptr->_item_size;
+    uint8* data_ptr = vector_ptr->data_ptr;
+
+    if (!count)
+        RETURN(SIM_RC_SUCCESS, 0);
+
+    if (stable)
+        RETURN(
+            SIM_RC_SUCCESS,
+            _sim_vector_partition_stable(data_ptr, count, item_size, filter_proc, userdata)
+        );
+
+    // swap failing items from the front with passing items from the back
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (true) {
+        while (lo < hi && (*filter_proc)(data_ptr + (item_size * lo), userdata))
+            lo++;
+        while (lo + 1 < hi && !(*filter_proc)(data_ptr + (item_size * (hi - 1)), userdata))
+            hi--;
+
+        // the item at lo failed; everything from hi onwards failed too
+        if (lo + 1 >= hi)
+            break;
+
+        _sim_vector_swap(
+            data_ptr + (item_size * lo),
+            data_ptr + (item_size * (hi - 1)),
+            item_size
+        );
+        lo++;
+        hi--;
+    }
+
+    RETURN(SIM_RC_SUCCESS, lo);
+}
+
 #endif /* SIMSOFT_VECTOR_C_ */
@@ -15,6 +15,14 @@
 
 #include "./tests/vector_tests.h"
 #include "./tests/hashset_tests.h"
+#include "./tests/hashmap_tests.h"
+#include "./tests/conhashmap_tests.h"
+#include "./tests/lfhashmap_tests.h"
+#include "./tests/perfhashmap_tests.h"
+#include "./tests/inthashmap_tests.h"
+#include "./tests/cache_tests.h"
+#include "./tests/hashtable_tests.h"
+#include "./tests/cppvector_tests.h"
 
 #ifdef _WIN32
 #   ifndef WIN32_LEAN_AND_MEAN
@@ -300,26 +308,145 @@ static SimTestStruct tests[] = {
     {
         .name = "vector",
         .description = "Unit tests for Sim_Vector.",
-        .num_tests = 7,
+        .num_tests = 11,
         .test_procs = (SimT_TestProcStruct []){
             { vector_test_construct, "constructor" },
             { vector_test_push,      "push" },
             { vector_test_get,       "get & get_ptr" },
-            { vector_test_contains,  "contains & index_of" },
+            { vector_test_contains,  "contains & find" },
             { vector_test_remove,    "remove & pop" },
             { vector_test_clear,     "clear" },
+            { vector_test_policy,    "growth policy, reserve, & clear keeping capacity" },
+            { vector_test_bulk,      "append_n, insert_n, & remove_range" },
+            { vector_test_find_bytewise, "bytewise find & contains" },
+            { vector_test_retain,    "in-place retain & partition" },
             { vector_test_destroy,   "destructor" }
         }
     },
     {
         .name = "hashset",
         .description = "Unit tests for Sim_HashSet.",
-        .num_tests = 4,
+        .num_tests = 6,
         .test_procs = (SimT_TestProcStruct []){
-            { hashset_test_construct, "constructor" },
-            { hashset_test_insert,    "insert & contains" },
-            { hashset_test_remove,    "remove & contains" },
-            { hashset_test_destroy,   "destructor" }
+            { hashset_test_construct,      "constructor" },
+            { hashset_test_insert,         "insert & contains" },
+            { hashset_test_remove,         "remove & contains" },
+            { hashset_test_set_operations, "union, intersect, difference, & is_subset" },
+            { hashset_test_wrap_around,    "in place set operations on wrapped clusters" },
+            { hashset_test_destroy,        "destructor" }
+        }
+    },
+    {
+        .name = "hashmap",
+        .description = "Unit tests for Sim_HashMap.",
+        .num_tests = 14,
+        .test_procs = (SimT_TestProcStruct []){
+            { hashmap_test_construct,          "constructor" },
+            { hashmap_test_insert,             "insert" },
+            { hashmap_test_get,                "get & get_ptr" },
+            { hashmap_test_remove,             "remove & clear" },
+            { hashmap_test_cached_hashes,      "cached hashes" },
+            { hashmap_test_incremental_resize, "incremental resize" },
+            { hashmap_test_tombstones,         "tombstones" },
+            { hashmap_test_batched,            "insert_many & get_many" },
+            { hashmap_test_construct_from,     "construct_from" },
+            { hashmap_test_robin_hood,         "Robin Hood hashing" },
+            { hashmap_test_stats,              "stats" },
+            { hashmap_test_mapped,             "serialize & construct_mapped" },
+            { hashmap_test_parallel,           "set_thread_count & parallel insert_many" },
+            { hashmap_test_destroy,            "destructor" }
+        }
+    },
+    {
+        .name = "conhashmap",
+        .description = "Unit tests for Sim_ConcurrentHashMap.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { conhashmap_test_construct, "constructor" },
+            { conhashmap_test_insert,    "insert & get" },
+            { conhashmap_test_remove,    "remove & clear" },
+            { conhashmap_test_threads,   "concurrent insert, get, & remove" },
+            { conhashmap_test_destroy,   "destructor" }
+        }
+    },
+    {
+        .name = "lfhashmap",
+        .description = "Unit tests for Sim_LockFreeHashMap.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { lfhashmap_test_construct, "constructor" },
+            { lfhashmap_test_insert,    "insert, get, & get_ptr" },
+            { lfhashmap_test_remove,    "remove & clear" },
+            { lfhashmap_test_threads,   "lookups concurrent with a writer" },
+            { lfhashmap_test_destroy,   "destructor" }
+        }
+    },
+    {
+        .name = "perfhashmap",
+        .description = "Unit tests for Sim_PerfectHashMap.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { perfhashmap_test_construct, "constructor" },
+            { perfhashmap_test_get,       "get_index, get, & get_ptr" },
+            { perfhashmap_test_keywords,  "keyword set without values" },
+            { perfhashmap_test_foreach,   "foreach" },
+            { perfhashmap_test_destroy,   "destructor" }
+        }
+    },
+    {
+        .name = "inthashmap",
+        .description = "Unit tests for Sim_IntHashMap.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { inthashmap_test_construct, "constructor" },
+            { inthashmap_test_insert,    "insert, get, & get_ptr" },
+            { inthashmap_test_remove,    "remove, shrinking, & clear" },
+            { inthashmap_test_foreach,   "foreach" },
+            { inthashmap_test_destroy,   "destructor" }
+        }
+    },
+    {
+        .name = "cache",
+        .description = "Unit tests for Sim_Cache.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { cache_test_construct, "constructor" },
+            { cache_test_lru,       "LRU eviction, remove, & stats" },
+            { cache_test_clock,     "CLOCK eviction & clear" },
+            { cache_test_charge,    "capacity in bytes & no allocation once full" },
+            { cache_test_destroy,   "destructor" }
+        }
+    },
+    {
+        .name = "hashtable",
+        .description = "Unit tests for the C++ HashMap & HashSet templates.",
+        .num_tests = 3,
+        .test_procs = (SimT_TestProcStruct []){
+            { hashtable_test_hashmap,   "HashMap insert, get, remove, & foreach" },
+            { hashtable_test_hashset,   "HashSet with non-trivial items, copies, & moves" },
+            { hashtable_test_allocator, "allocators & out of memory" }
+        }
+    },
+    {
+        .name = "cppvector",
+        .description = "Unit tests for the C++ Vector template.",
+        .num_tests = 3,
+        .test_procs = (SimT_TestProcStruct []){
+            { cppvector_test_trivial,    "trivially copyable items, iterators, copies, & moves" },
+            { cppvector_test_nontrivial, "non-trivial items are moved on growth" },
+            { cppvector_test_allocator,  "allocators & out of memory" }
+        }
+    },
+    {
+        .name = "hashmap-bench",
+        .description = "Lookup latency benchmarks for Sim_HashMap table modes & Sim_IntHashMap.",
+        .num_tests = 5,
+        .test_procs = (SimT_TestProcStruct []){
+            { hashmap_bench_prime,        "prime sized, double hashing" },
+            { hashmap_bench_power_of_two, "power of 2 sized, linear probing" },
+            { hashmap_bench_robin_hood,   "power of 2 sized, Robin Hood hashing" },
+            { hashmap_bench_get_many,     "batched lookups with prefetching" },
+            { inthashmap_bench_lookup,    "integer keys, Fibonacci hashing" }
         }
     }
 };
@@ -407,7 +534,7 @@ void perform_test(int test_id, bool exit_on_failure) {
         printf(
             ERR_STR(" Test %d of suite returned error: \"%s\""),
             total - remaining,
-            sim_debug_get_return_code_string(test_result)
+            sim_get_return_code_string(test_result)
         );
 
         if (exit_on_failure)
@@ -23,6 +23,17 @@
 
 #define ERR_STR(str) "\33[1;91mError: \33[0;31m" str "\33[0m\n"
 
+// Runs a statement, catching any exception it throws. Sets rc to the thrown error code, or to
+//  SIM_RC_SUCCESS if nothing was thrown.
+#define SIMT_CATCH(rc, ...) do {           \
+    switch (setjmp(*sim_cexcept_push())) { \
+    case 0:                                \
+        __VA_ARGS__;                       \
+        break;                             \
+    }                                      \
+    (rc) = sim_cexcept_pop();              \
+} while (0)
+
 extern void*  simt_malloc(size_t size);
 extern void*  simt_falloc(size_t size, uint8 fill);
 extern void*  simt_realloc(void* ptr, size_t size);
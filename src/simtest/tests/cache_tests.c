@@ -0,0 +1,378 @@
+/**
+ * @file cache_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Bounded cache unit tests.
+ * @version 0.1
+ * @date 2020-02-20
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CACHE_TESTS_C_
+#define SIMTEST_CACHE_TESTS_C_
+
+#include "../test.h"
+#include "simsoft/cache.h"
+#include "./cache_tests.h"
+
+#define CACHE_TEST_CAPACITY 4
+
+static bool _cache_int_eq(const int *const a, const int *const b) {
+    return *a == *b;
+}
+
+// Keys of evicted entries, in the order they were evicted
+typedef struct _CacheEvictions {
+    size_t count;
+    int keys[64];
+} _CacheEvictions;
+
+static void _cache_record_eviction(
+    const void *const key_ptr,
+    void *const       value_ptr,
+    Sim_Variant       userdata
+) {
+    (void)value_ptr;
+
+    _CacheEvictions *const evictions_ptr = userdata.pointer;
+
+    if (evictions_ptr->count < sizeof(evictions_ptr->keys) / sizeof(int))
+        evictions_ptr->keys[evictions_ptr->count] = *(const int*)key_ptr;
+    evictions_ptr->count++;
+}
+
+// Counts calls into the test allocator; caches shouldn't allocate once they're full.
+static size_t _cache_alloc_calls;
+
+static void* _cache_malloc(size_t size) {
+    _cache_alloc_calls++;
+    return simt_malloc(size);
+}
+
+static void* _cache_falloc(size_t size, uint8 fill) {
+    _cache_alloc_calls++;
+    return simt_falloc(size, fill);
+}
+
+static void* _cache_realloc(void* ptr, size_t size) {
+    _cache_alloc_calls++;
+    return simt_realloc(ptr, size);
+}
+
+static const Sim_IAllocator _cache_allocator = {
+    _cache_malloc,
+    _cache_falloc,
+    _cache_realloc,
+    simt_free
+};
+
+static Sim_Cache cache;
+static _CacheEvictions _cache_evictions;
+static size_t _cache_alloc_size;
+
+Sim_ReturnCode cache_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    _cache_alloc_size = simt_alloc_size();
+
+    sim_cache_construct(
+        &cache,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_cache_int_eq,
+        sizeof(int),
+        NULL,
+        SIM_CACHE_LRU,
+        CACHE_TEST_CAPACITY,
+        NULL,
+        _cache_record_eviction,
+        (Sim_Variant){ .pointer = &_cache_evictions }
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    if (cache.count || cache.charge || cache.capacity != CACHE_TEST_CAPACITY) {
+        *out_err_str = "construct: cache wasn't empty";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode cache_test_lru(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int key = 1; key <= CACHE_TEST_CAPACITY; key++) {
+        const int value = key * 10;
+
+        sim_cache_put(&cache, &key, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on put";
+            return rc;
+        }
+    }
+
+    // using 1 makes 2 the least recently used
+    int key = 1, value = 0;
+    sim_cache_get(&cache, &key, &value);
+    if (sim_get_return_code() || value != 10) {
+        *out_err_str = "get: failed to retrieve value";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 5;
+    value = 50;
+    sim_cache_put(&cache, &key, &value);
+    if (
+        cache.count != CACHE_TEST_CAPACITY ||
+        _cache_evictions.count != 1 || _cache_evictions.keys[0] != 2
+    ) {
+        *out_err_str = "put: didn't evict the least recently used entry";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 2;
+    if (sim_cache_get_ptr(&cache, &key) || sim_get_return_code() != SIM_RC_NOT_FOUND) {
+        *out_err_str = "get_ptr: evicted key didn't return NOT_FOUND";
+        return SIM_RC_FAILURE;
+    }
+    if (sim_cache_contains_key(&cache, &key) || sim_get_return_code() != SIM_RC_NOT_FOUND) {
+        *out_err_str = "contains_key: evicted key didn't return NOT_FOUND";
+        return SIM_RC_FAILURE;
+    }
+
+    // contains_key doesn't count as a use, so 3 stays the least recently used
+    key = 3;
+    if (!sim_cache_contains_key(&cache, &key)) {
+        *out_err_str = "contains_key: failed to find key";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 6;
+    value = 60;
+    sim_cache_put(&cache, &key, &value);
+    if (_cache_evictions.count != 2 || _cache_evictions.keys[1] != 3) {
+        *out_err_str = "put: contains_key changed which entry was evicted";
+        return SIM_RC_FAILURE;
+    }
+
+    // removed entries make room without evicting anything
+    key = 4;
+    sim_cache_remove(&cache, &key);
+    if ((rc = sim_get_return_code()) || cache.count != CACHE_TEST_CAPACITY - 1) {
+        *out_err_str = "remove: failed to remove entry";
+        return rc ? rc : SIM_RC_FAILURE;
+    }
+
+    key = 7;
+    value = 70;
+    sim_cache_put(&cache, &key, &value);
+    if (_cache_evictions.count != 2) {
+        *out_err_str = "put: evicted an entry while a removed one was free";
+        return SIM_RC_FAILURE;
+    }
+
+    Sim_CacheStats stats;
+    sim_cache_get_stats(&cache, &stats);
+    if (
+        stats.count != CACHE_TEST_CAPACITY || stats.hits != 1 || stats.misses != 1 ||
+        stats.insertions != 7 || stats.evictions != 2 || stats.hit_rate != 0.5
+    ) {
+        *out_err_str = "get_stats: incorrect counters";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_cache_reset_stats(&cache);
+    sim_cache_get_stats(&cache, &stats);
+    if (stats.hits || stats.misses || stats.evictions || stats.hit_rate != 0.0) {
+        *out_err_str = "reset_stats: counters weren't reset";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode cache_test_clock(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Cache clock_cache;
+    _CacheEvictions evictions = { 0 };
+
+    sim_cache_construct(
+        &clock_cache,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_cache_int_eq,
+        sizeof(int),
+        NULL,
+        SIM_CACHE_CLOCK,
+        CACHE_TEST_CAPACITY,
+        NULL,
+        _cache_record_eviction,
+        (Sim_Variant){ .pointer = &evictions }
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int key = 1; key <= CACHE_TEST_CAPACITY; key++)
+        sim_cache_put(&clock_cache, &key, &key);
+
+    // every entry starts out referenced, so the first sweep clears them all & evicts the oldest
+    int key = 5;
+    sim_cache_put(&clock_cache, &key, &key);
+    if (evictions.count != 1 || evictions.keys[0] != 1) {
+        sim_cache_destroy(&clock_cache);
+        *out_err_str = "put: clock hand didn't evict the oldest entry";
+        return SIM_RC_FAILURE;
+    }
+
+    // 2 gets a second chance; 3 hasn't been used since the sweep
+    key = 2;
+    if (!sim_cache_get_ptr(&clock_cache, &key)) {
+        sim_cache_destroy(&clock_cache);
+        *out_err_str = "get_ptr: failed to retrieve value";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 6;
+    sim_cache_put(&clock_cache, &key, &key);
+    if (evictions.count != 2 || evictions.keys[1] != 3) {
+        sim_cache_destroy(&clock_cache);
+        *out_err_str = "put: clock hand evicted a referenced entry";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 2;
+    if (!sim_cache_contains_key(&clock_cache, &key) || clock_cache.count != CACHE_TEST_CAPACITY) {
+        sim_cache_destroy(&clock_cache);
+        *out_err_str = "put: referenced entry wasn't kept";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_cache_clear(&clock_cache);
+    if (clock_cache.count || sim_cache_contains_key(&clock_cache, &key)) {
+        sim_cache_destroy(&clock_cache);
+        *out_err_str = "clear: cache wasn't emptied";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_cache_destroy(&clock_cache);
+
+    return SIM_RC_SUCCESS;
+}
+
+static size_t _cache_charge_value(const void *const key_ptr, const void *const value_ptr) {
+    (void)key_ptr;
+    return *(const size_t*)value_ptr;
+}
+
+Sim_ReturnCode cache_test_charge(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Cache byte_cache;
+    _CacheEvictions evictions = { 0 };
+
+    // values are how many bytes their entry pretends to hold
+    sim_cache_construct(
+        &byte_cache,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_cache_int_eq,
+        sizeof(size_t),
+        &_cache_allocator,
+        SIM_CACHE_LRU,
+        1000,
+        _cache_charge_value,
+        _cache_record_eviction,
+        (Sim_Variant){ .pointer = &evictions }
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    int key = 0;
+    size_t value = 400;
+    for (key = 1; key <= 2; key++)
+        sim_cache_put(&byte_cache, &key, &value);
+
+    // 800 + 300 bytes doesn't fit, so the oldest entry goes
+    value = 300;
+    sim_cache_put(&byte_cache, &key, &value);
+    if (byte_cache.charge != 700 || evictions.count != 1 || evictions.keys[0] != 1) {
+        sim_cache_destroy(&byte_cache);
+        *out_err_str = "put: incorrect eviction by charge";
+        return SIM_RC_FAILURE;
+    }
+
+    // entries heavier than the whole cache are turned away
+    key = 4;
+    value = 1001;
+    sim_cache_put(&byte_cache, &key, &value);
+    if (sim_get_return_code() != SIM_RC_FAILURE || sim_cache_contains_key(&byte_cache, &key)) {
+        sim_cache_destroy(&byte_cache);
+        *out_err_str = "put: entry larger than capacity wasn't turned away";
+        return SIM_RC_FAILURE;
+    }
+
+    // growing an entry's value may evict others, but never the entry itself
+    key = 3;
+    value = 900;
+    sim_cache_put(&byte_cache, &key, &value);
+    if (
+        byte_cache.count != 1 || byte_cache.charge != 900 ||
+        !sim_cache_contains_key(&byte_cache, &key)
+    ) {
+        sim_cache_destroy(&byte_cache);
+        *out_err_str = "put: overwriting with a heavier value evicted the wrong entries";
+        return SIM_RC_FAILURE;
+    }
+
+    // warm up with small entries, then churn through many more keys without allocating
+    sim_cache_clear(&byte_cache);
+    value = 1;
+    for (key = 0; key < 1000; key++)
+        sim_cache_put(&byte_cache, &key, &value);
+
+    const size_t alloc_calls = _cache_alloc_calls;
+    for (key = 1000; key < 20000; key++) {
+        sim_cache_put(&byte_cache, &key, &value);
+
+        const int hit_key = key - 250;
+        if (!sim_cache_get_ptr(&byte_cache, &hit_key)) {
+            sim_cache_destroy(&byte_cache);
+            *out_err_str = "get_ptr: recently put key was evicted";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    if (_cache_alloc_calls != alloc_calls || byte_cache.count != 1000) {
+        sim_cache_destroy(&byte_cache);
+        *out_err_str = "put: full cache allocated memory";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_cache_destroy(&byte_cache);
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode cache_test_destroy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_cache_destroy(&cache);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on destroy";
+        return rc;
+    }
+
+    if (simt_alloc_size() > _cache_alloc_size) {
+        *out_err_str = "destroy: failed to free cache";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_CACHE_TESTS_C_ */
@@ -0,0 +1,22 @@
+/**
+ * @file cache_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Bounded cache unit tests.
+ * @version 0.1
+ * @date 2020-02-20
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CACHE_TESTS_H_
+#define SIMTEST_CACHE_TESTS_H_
+
+#include "simsoft/common.h"
+
+extern Sim_ReturnCode cache_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode cache_test_lru(const char* *const out_err_str);
+extern Sim_ReturnCode cache_test_clock(const char* *const out_err_str);
+extern Sim_ReturnCode cache_test_charge(const char* *const out_err_str);
+extern Sim_ReturnCode cache_test_destroy(const char* *const out_err_str);
+
+#endif /* SIMTEST_CACHE_TESTS_H_ */
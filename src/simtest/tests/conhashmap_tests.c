@@ -0,0 +1,230 @@
+/**
+ * @file conhashmap_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Concurrent hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-05
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CONHASHMAP_TESTS_C_
+#define SIMTEST_CONHASHMAP_TESTS_C_
+
+#include "../test.h"
+#include "simsoft/conhashmap.h"
+#include "./conhashmap_tests.h"
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+#define CONHASHMAP_TEST_THREADS 8
+#define CONHASHMAP_TEST_KEYS    4096
+
+static bool _conhashmap_int_eq(const int *const a, const int *const b) {
+    return *a == *b;
+}
+
+// the test allocator isn't thread-safe; worker threads allocate through the library's default
+static const Sim_IAllocator _conhashmap_allocator = {
+    sim_allocator_default_malloc,
+    sim_allocator_default_falloc,
+    sim_allocator_default_realloc,
+    sim_allocator_default_free
+};
+
+static Sim_ConcurrentHashMap conhashmap;
+
+Sim_ReturnCode conhashmap_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_conhashmap_construct(
+        &conhashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_conhashmap_int_eq,
+        sizeof(int),
+        &_conhashmap_allocator,
+        0,
+        5,
+        SIM_HASH_DEFAULT
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    if (conhashmap._shard_count != 8) {
+        *out_err_str = "construct: shard count wasn't rounded up to a power of 2";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode conhashmap_test_insert(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 256; i++) {
+        const int value = i * 2;
+
+        sim_conhashmap_insert(&conhashmap, &i, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    if (sim_conhashmap_get_count(&conhashmap) != 256) {
+        *out_err_str = "insert: incorrect count after inserting keys";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        int value;
+
+        sim_conhashmap_get(&conhashmap, &i, &value);
+        if ((rc = sim_get_return_code()) || value != i * 2) {
+            *out_err_str = "get: failed to retrieve value for key in concurrent hashmap";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode conhashmap_test_remove(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 256; i += 2) {
+        sim_conhashmap_remove(&conhashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on remove";
+            return rc;
+        }
+    }
+
+    for (int i = 0; i < 256; i++) {
+        if (sim_conhashmap_contains_key(&conhashmap, &i) != (bool)(i % 2)) {
+            *out_err_str = "contains_key: removed keys still contained in concurrent hashmap";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_conhashmap_clear(&conhashmap);
+    if (sim_conhashmap_get_count(&conhashmap) != 0) {
+        *out_err_str = "clear: concurrent hashmap not empty after clearing";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+// Inserts, reads back, & removes a range of keys unique to each worker thread.
+static int _conhashmap_worker(const int thread_num) {
+    int errors = 0;
+    const int first_key = thread_num * CONHASHMAP_TEST_KEYS;
+
+    for (int key = first_key; key < first_key + CONHASHMAP_TEST_KEYS; key++) {
+        sim_conhashmap_insert(&conhashmap, &key, &thread_num);
+        errors += sim_get_return_code() != SIM_RC_SUCCESS;
+    }
+
+    for (int key = first_key; key < first_key + CONHASHMAP_TEST_KEYS; key++) {
+        int value = -1;
+
+        sim_conhashmap_get(&conhashmap, &key, &value);
+        errors += value != thread_num;
+    }
+
+    for (int key = first_key; key < first_key + CONHASHMAP_TEST_KEYS; key += 2) {
+        sim_conhashmap_remove(&conhashmap, &key);
+        errors += sim_get_return_code() != SIM_RC_SUCCESS;
+    }
+
+    return errors;
+}
+
+#ifdef _WIN32
+    static DWORD WINAPI _conhashmap_thread_proc(LPVOID arg) {
+        return (DWORD)_conhashmap_worker((int)(intptr_t)arg);
+    }
+#else
+    static void* _conhashmap_thread_proc(void* arg) {
+        return (void*)(intptr_t)_conhashmap_worker((int)(intptr_t)arg);
+    }
+#endif
+
+Sim_ReturnCode conhashmap_test_threads(const char* *const out_err_str) {
+    intptr_t errors = 0;
+
+#   ifdef _WIN32
+        HANDLE threads[CONHASHMAP_TEST_THREADS];
+
+        for (int i = 0; i < CONHASHMAP_TEST_THREADS; i++)
+            threads[i] = CreateThread(
+                NULL,
+                0,
+                _conhashmap_thread_proc,
+                (LPVOID)(intptr_t)i,
+                0,
+                NULL
+            );
+
+        for (int i = 0; i < CONHASHMAP_TEST_THREADS; i++) {
+            DWORD thread_errors = 0;
+
+            WaitForSingleObject(threads[i], INFINITE);
+            GetExitCodeThread(threads[i], &thread_errors);
+            CloseHandle(threads[i]);
+            errors += thread_errors;
+        }
+#   else
+        pthread_t threads[CONHASHMAP_TEST_THREADS];
+
+        for (int i = 0; i < CONHASHMAP_TEST_THREADS; i++)
+            pthread_create(&threads[i], NULL, _conhashmap_thread_proc, (void*)(intptr_t)i);
+
+        for (int i = 0; i < CONHASHMAP_TEST_THREADS; i++) {
+            void* thread_errors = NULL;
+
+            pthread_join(threads[i], &thread_errors);
+            errors += (intptr_t)thread_errors;
+        }
+#   endif
+
+    if (errors) {
+        *out_err_str = "threads: concurrent insert, get, or remove failed";
+        return SIM_RC_FAILURE;
+    }
+
+    if (
+        sim_conhashmap_get_count(&conhashmap) !=
+            CONHASHMAP_TEST_THREADS * CONHASHMAP_TEST_KEYS / 2
+    ) {
+        *out_err_str = "threads: incorrect count after concurrent inserts & removes";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode conhashmap_test_destroy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_conhashmap_destroy(&conhashmap);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on destroy";
+        return rc;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_CONHASHMAP_TESTS_C_ */
@@ -0,0 +1,22 @@
+/**
+ * @file conhashmap_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Concurrent hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-05
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CONHASHMAP_TESTS_H_
+#define SIMTEST_CONHASHMAP_TESTS_H_
+
+#include "simsoft/common.h"
+
+extern Sim_ReturnCode conhashmap_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode conhashmap_test_insert(const char* *const out_err_str);
+extern Sim_ReturnCode conhashmap_test_remove(const char* *const out_err_str);
+extern Sim_ReturnCode conhashmap_test_threads(const char* *const out_err_str);
+extern Sim_ReturnCode conhashmap_test_destroy(const char* *const out_err_str);
+
+#endif /* SIMTEST_CONHASHMAP_TESTS_H_ */
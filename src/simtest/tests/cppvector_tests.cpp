@@ -0,0 +1,269 @@
+/**
+ * @file cppvector_tests.cpp
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief C++ Vector unit tests.
+ * @version 0.1
+ * @date 2020-02-14
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CPPVECTOR_TESTS_CPP_
+#define SIMTEST_CPPVECTOR_TESTS_CPP_
+
+#include <algorithm>
+#include <string>
+
+#include "simsoft/hashmap.h" // included by test.h; its templates need C++ linkage
+#include "simsoft/vector.h"
+
+using namespace SimSoft;
+using namespace SimSoft::C_API;
+
+// the test suite is C; its declarations & the test procedures need C linkage
+extern "C" {
+#   include "../test.h"
+}
+
+// Counts live instances & copies so growth can be checked to move rather than copy.
+struct _Tracked {
+    static size_t live, copies;
+
+    std::string str;
+
+    _Tracked(const std::string& str) : str(str) { live++; }
+    _Tracked(const _Tracked& other) : str(other.str) { live++; copies++; }
+    _Tracked(_Tracked&& other) noexcept : str(std::move(other.str)) { live++; }
+    ~_Tracked() { live--; }
+
+    _Tracked& operator=(const _Tracked& other) {
+        str = other.str;
+        copies++;
+        return *this;
+    }
+    _Tracked& operator=(_Tracked&& other) noexcept {
+        str = std::move(other.str);
+        return *this;
+    }
+
+    bool operator==(const _Tracked& other) const {
+        return str == other.str;
+    }
+};
+size_t _Tracked::live = 0;
+size_t _Tracked::copies = 0;
+
+// Allocates with the test suite's allocator so leaks can be counted.
+class _TestAllocator final : public Allocator {
+public:
+    void* malloc(size_t size) override {
+        return simt_malloc(size);
+    }
+    void* falloc(size_t size, uint8 fill) override {
+        return simt_falloc(size, fill);
+    }
+    void* realloc(void* ptr, size_t size) override {
+        return simt_realloc(ptr, size);
+    }
+    void free(void* ptr) override {
+        simt_free(ptr);
+    }
+};
+
+extern "C" Sim_ReturnCode cppvector_test_trivial(const char* *const out_err_str) {
+    Vector<uint64> vector(4);
+
+    for (uint64 i = 0; i < 5000; i++)
+        vector.push(i * 3);
+    if (vector.get_count() != 5000 || vector.get_capacity() != 8192) {
+        *out_err_str = "push: vector didn't double as it grew";
+        return SIM_RC_FAILURE;
+    }
+
+    for (size_t i = 0; i < 5000; i++) {
+        if (vector[i] != i * 3 || vector.get(i) != i * 3) {
+            *out_err_str = "operator[]: pushed item has wrong value";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    bool threw = false;
+    try {
+        vector.get(5000);
+    } catch (OutOfBoundsException&) {
+        threw = true;
+    }
+    if (!threw) {
+        *out_err_str = "get: failed to throw on out of bounds index";
+        return SIM_RC_FAILURE;
+    }
+
+    vector.insert(1, 0);
+    vector.insert(2, 2500);
+    if (vector[0] != 1 || vector[1] != 0 || vector[2500] != 2 || vector[2501] != 2499 * 3) {
+        *out_err_str = "insert: later items weren't shifted back";
+        return SIM_RC_FAILURE;
+    }
+    if (vector.remove(2500) != 2 || vector.remove(0) != 1 || vector.pop() != 4999 * 3) {
+        *out_err_str = "remove: removed wrong item";
+        return SIM_RC_FAILURE;
+    }
+
+    if (vector.find(3 * 10) != 10 || vector.find(3 * 10, 11) != (size_t)-1) {
+        *out_err_str = "find: failed to find pushed item";
+        return SIM_RC_FAILURE;
+    }
+    if (vector.contains(1) || !vector.contains(3 * 4998)) {
+        *out_err_str = "contains: wrong result";
+        return SIM_RC_FAILURE;
+    }
+
+    // iterators work with standard algorithms in both directions
+    uint64 sum = 0;
+    for (const uint64& item : vector)
+        sum += item;
+    if (sum != 3 * (4999 * 4998 / 2) || vector.end() - vector.begin() != 4999) {
+        *out_err_str = "begin: failed to iterate over every item";
+        return SIM_RC_FAILURE;
+    }
+
+    std::sort(vector.rbegin(), vector.rend());
+    if (vector[0] != 3 * 4998 || vector[4998] != 0) {
+        *out_err_str = "rbegin: failed to sort in reverse";
+        return SIM_RC_FAILURE;
+    }
+    Vector<uint64>::const_iterator iter = vector.begin();
+    if (iter != vector.cbegin() || *(iter + 1) != 3 * 4997) {
+        *out_err_str = "cbegin: const iterator doesn't match iterator";
+        return SIM_RC_FAILURE;
+    }
+
+    // copies & moves keep every item
+    Vector<uint64> copy = vector;
+    Vector<uint64> moved = std::move(copy);
+    if (!copy.is_empty() || moved.get_count() != 4999 || moved[4998] != 0) {
+        *out_err_str = "move: moved vector has wrong items";
+        return SIM_RC_FAILURE;
+    }
+
+    vector.clear();
+    if (!vector.is_empty() || vector.get_capacity() != 8192) {
+        *out_err_str = "clear: failed to keep internal array";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+extern "C" Sim_ReturnCode cppvector_test_nontrivial(const char* *const out_err_str) {
+    _Tracked::live = _Tracked::copies = 0;
+
+    {
+        Vector<_Tracked> vector(1);
+
+        for (int i = 0; i < 1000; i++)
+            vector.emplace(std::to_string(i));
+        if (_Tracked::copies != 0 || _Tracked::live != 1000) {
+            *out_err_str = "emplace: items were copied instead of moved on growth";
+            return SIM_RC_FAILURE;
+        }
+
+        // pushing one of the vector's own items while it grows
+        vector.resize(1000);
+        vector.push(vector[0]);
+        if (vector[1000].str != "0" || vector[0].str != "0") {
+            *out_err_str = "push: pushed item was moved before it was copied";
+            return SIM_RC_FAILURE;
+        }
+
+        vector.insert(_Tracked("front"), 0);
+        if (vector[0].str != "front" || vector[1].str != "0" || vector[1001].str != "0") {
+            *out_err_str = "insert: later items weren't shifted back";
+            return SIM_RC_FAILURE;
+        }
+
+        if (vector.remove(1).str != "0" || vector.pop().str != "0" || vector.get_count() != 1000) {
+            *out_err_str = "remove: removed wrong item";
+            return SIM_RC_FAILURE;
+        }
+        if (vector.find(_Tracked("999")) != 999 || vector.contains(_Tracked("1000"))) {
+            *out_err_str = "find: wrong result";
+            return SIM_RC_FAILURE;
+        }
+
+        Vector<_Tracked> copy = vector;
+        if (copy.get_count() != 1000 || copy[500].str != vector[500].str) {
+            *out_err_str = "copy: copied vector has wrong items";
+            return SIM_RC_FAILURE;
+        }
+
+        size_t count = 0;
+        copy.foreach([&count](_Tracked& item, size_t index) {
+            count += index == 0 ? item.str == "front" : 1;
+            return true;
+        });
+        copy.clear();
+        if (count != 1000 || _Tracked::live != 1000) {
+            *out_err_str = "clear: failed to destroy every item";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    if (_Tracked::live != 0) {
+        *out_err_str = "destructor: failed to destroy every item";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+extern "C" Sim_ReturnCode cppvector_test_allocator(const char* *const out_err_str) {
+    _TestAllocator allocator;
+    const size_t alloc_size = simt_alloc_size();
+
+    {
+        Vector<std::string, Predicate_Equal<std::string>, _TestAllocator> vector(
+            Vector<std::string>::DEFAULT_SIZE,
+            &allocator
+        );
+
+        for (int i = 0; i < 200; i++)
+            vector.push(std::to_string(i));
+        if (simt_alloc_size() != alloc_size + 1) {
+            *out_err_str = "push: internal array wasn't allocated by the vector's allocator";
+            return SIM_RC_FAILURE;
+        }
+
+        // out of memory is thrown as an exception & leaves the items untouched
+        vector.resize(200);
+        bool threw = false;
+
+        simt_alloc_set_lock(true);
+        try {
+            vector.push("200");
+        } catch (OutOfMemoryException&) {
+            threw = true;
+        }
+        simt_alloc_set_lock(false);
+
+        if (!threw || vector.get_count() != 200 || vector[199] != "199") {
+            *out_err_str = "push: failed to throw when out of memory";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    {
+        Vector<uint32, Predicate_Equal<uint32>, _TestAllocator> vector(8, &allocator);
+        for (uint32 i = 0; i < 1000; i++)
+            vector.push(i);
+    }
+
+    if (simt_alloc_size() != alloc_size) {
+        *out_err_str = "destructor: failed to free internal array";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_CPPVECTOR_TESTS_CPP_ */
@@ -0,0 +1,21 @@
+/**
+ * @file cppvector_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief C++ Vector unit tests.
+ * @version 0.1
+ * @date 2020-02-14
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_CPPVECTOR_TESTS_H_
+#define SIMTEST_CPPVECTOR_TESTS_H_
+
+#include "simsoft/common.h"
+
+// defined with C linkage in cppvector_tests.cpp
+extern Sim_ReturnCode cppvector_test_trivial(const char* *const out_err_str);
+extern Sim_ReturnCode cppvector_test_nontrivial(const char* *const out_err_str);
+extern Sim_ReturnCode cppvector_test_allocator(const char* *const out_err_str);
+
+#endif /* SIMTEST_CPPVECTOR_TESTS_H_ */
@@ -0,0 +1,1236 @@
+/**
+ * @file hashmap_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-05
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_HASHMAP_TESTS_C_
+#define SIMTEST_HASHMAP_TESTS_C_
+
+#include "../test.h"
+#include "simsoft/hashmap.h"
+#include "simsoft/vector.h"
+#include "./hashmap_tests.h"
+
+static bool _int_eq(const int *const a, const int *const b) {
+    return *a == *b;
+}
+
+static Sim_HashMap hashmap;
+
+Sim_ReturnCode hashmap_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_hashmap_construct_with_flags(
+        &hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(double),
+        NULL,
+        75,
+        SIM_HASH_FLAT_STORAGE
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_insert(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 512; i++) {
+        double value = i * 0.5;
+
+        sim_hashmap_insert(&hashmap, &i, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+        if (hashmap.count != (size_t)(i + 1)) {
+            *out_err_str = "insert: failed to increment count property";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // overwrite existing values
+    for (int i = 0; i < 512; i += 2) {
+        double value = -i;
+
+        sim_hashmap_insert(&hashmap, &i, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+    if (hashmap.count != 512) {
+        *out_err_str = "insert: incremented count for duplicate key";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_get(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 512; i++) {
+        double value;
+
+        sim_hashmap_get(&hashmap, &i, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "get: failed to retrieve value for key in hashmap";
+            return SIM_RC_FAILURE;
+        }
+        if (value != ((i % 2) ? i * 0.5 : -i)) {
+            *out_err_str = "get: retrieved wrong value for key";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    int key = 1024;
+    if (sim_hashmap_get_ptr(&hashmap, &key)) {
+        *out_err_str = "get_ptr: returned non-NULL for key not in hashmap";
+        return SIM_RC_FAILURE;
+    }
+    if (sim_get_return_code() != SIM_RC_NOT_FOUND) {
+        *out_err_str = "get_ptr: failed to return NOT_FOUND for key not in hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_remove(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 512; i += 2) {
+        sim_hashmap_remove(&hashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on remove";
+            return rc;
+        }
+    }
+    if (hashmap.count != 256) {
+        *out_err_str = "remove: failed to decrement count property";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 512; i++) {
+        bool contained = sim_hashmap_contains_key(&hashmap, &i);
+        if (contained != (bool)(i % 2)) {
+            *out_err_str = (i % 2) ?
+                "contains_key: returned FALSE for key in hashmap" :
+                "contains_key: returned TRUE for key removed from hashmap"
+            ;
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_clear(&hashmap);
+    if (hashmap.count != 0) {
+        *out_err_str = "clear: failed to reset count property";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+static size_t _counted_hash_calls;
+
+static Sim_HashType _counted_int_hash(const int *const key, const size_t attempt) {
+    _counted_hash_calls++;
+    return (Sim_HashType)*key + attempt;
+}
+
+// Enough keys to fill a table of the initial size to just under the load at which it grows
+#define _CHURN_KEY_COUNT 140
+#define _CHURN_TOGGLE_COUNT 5000
+#define _CHURN_SEED_COUNT 64
+
+// Inserts or removes random keys in a hashmap of a given initial size, checking every key after.
+static Sim_ReturnCode _hashmap_test_churn(
+    const Sim_HashFlags flags,
+    uint32              seed,
+    const char* *const  out_err_str
+) {
+    Sim_ReturnCode rc;
+    Sim_HashMap churned_hashmap;
+    bool contained[_CHURN_KEY_COUNT] = { false };
+
+    sim_hashmap_construct_with_flags(
+        &churned_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        120,
+        flags
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < _CHURN_TOGGLE_COUNT; i++) {
+        seed = seed * 1664525 + 1013904223;
+        const int key = (int)((seed >> 8) % _CHURN_KEY_COUNT);
+
+        if (contained[key])
+            sim_hashmap_remove(&churned_hashmap, &key);
+        else
+            sim_hashmap_insert(&churned_hashmap, &key, &key);
+        contained[key] = !contained[key];
+
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "unexpected error out on insert or remove";
+            return rc;
+        }
+    }
+
+    for (int i = 0; i < _CHURN_KEY_COUNT; i++) {
+        int* value_ptr = sim_hashmap_get_ptr(&churned_hashmap, &i);
+        if (contained[i] ? (!value_ptr || *value_ptr != i) : value_ptr != NULL) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "get_ptr: incorrect value retrieved for key after churning";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&churned_hashmap);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_cached_hashes(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap cached_hashmap;
+
+    sim_hashmap_construct_with_flags(
+        &cached_hashmap,
+        sizeof(int),
+        (Sim_HashProc)_counted_int_hash,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0,
+        SIM_HASH_CACHE_HASHES
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    // inserting enough items to resize several times should hash each key only once
+    _counted_hash_calls = 0;
+    for (int i = 0; i < 512; i++) {
+        sim_hashmap_insert(&cached_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&cached_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+    if (_counted_hash_calls != 512) {
+        sim_hashmap_destroy(&cached_hashmap);
+        *out_err_str = "insert: hash function called more than once per key";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 512; i++) {
+        int* value_ptr = sim_hashmap_get_ptr(&cached_hashmap, &i);
+        if (!value_ptr || *value_ptr != i) {
+            sim_hashmap_destroy(&cached_hashmap);
+            *out_err_str = "get_ptr: failed to retrieve value for key in hashmap";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&cached_hashmap);
+
+    // probe sequences derived from cached hashes must reach a free slot however the table is
+    //  sized; toggling random keys fills it with tombstones that are dropped in place
+    for (uint32 seed = 1; seed <= _CHURN_SEED_COUNT; seed++) {
+        if ((rc = _hashmap_test_churn(SIM_HASH_CACHE_HASHES, seed, out_err_str)))
+            return rc;
+        rc = _hashmap_test_churn(
+            SIM_HASH_CACHE_HASHES | SIM_HASH_INCREMENTAL_RESIZE,
+            seed,
+            out_err_str
+        );
+        if (rc)
+            return rc;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_incremental_resize(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap incremental_hashmap;
+    const size_t alloc_size = simt_alloc_size();
+
+    sim_hashmap_construct_with_flags(
+        &incremental_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0,
+        SIM_HASH_INCREMENTAL_RESIZE | SIM_HASH_FLAT_STORAGE
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    // every key must stay reachable while items are migrated between bucket arrays
+    bool migrating = false;
+    for (int i = 0; i < 1024; i++) {
+        sim_hashmap_insert(&incremental_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&incremental_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+        migrating |= incremental_hashmap._old_data_ptr != NULL;
+
+        for (int j = 0; j <= i; j += 7) {
+            int* value_ptr = sim_hashmap_get_ptr(&incremental_hashmap, &j);
+            if (!value_ptr || *value_ptr != j) {
+                sim_hashmap_destroy(&incremental_hashmap);
+                *out_err_str = "get_ptr: failed to retrieve value for key during resize";
+                return SIM_RC_FAILURE;
+            }
+        }
+    }
+    if (!migrating) {
+        sim_hashmap_destroy(&incremental_hashmap);
+        *out_err_str = "insert: hashmap never resized incrementally";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 1024; i += 2) {
+        sim_hashmap_remove(&incremental_hashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&incremental_hashmap);
+            *out_err_str = "remove: failed to remove key during resize";
+            return rc;
+        }
+    }
+    if (incremental_hashmap.count != 512) {
+        sim_hashmap_destroy(&incremental_hashmap);
+        *out_err_str = "remove: incorrect count after removing keys";
+        return SIM_RC_FAILURE;
+    }
+
+    // shrinking must stop at the default size
+    for (int i = 1; i < 1024; i += 2) {
+        sim_hashmap_remove(&incremental_hashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&incremental_hashmap);
+            *out_err_str = "remove: failed to remove key during resize";
+            return rc;
+        }
+    }
+    if (incremental_hashmap._allocated < SIM_HASH_DEFAULT_SIZE) {
+        sim_hashmap_destroy(&incremental_hashmap);
+        *out_err_str = "remove: hashmap shrank below the default size";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_hashmap_destroy(&incremental_hashmap);
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free old buckets";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_tombstones(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap churned_hashmap;
+
+    sim_hashmap_construct(
+        &churned_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        sim_hashmap_insert(&churned_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    // removing & inserting at a constant count should never need new buckets
+    const size_t allocated = churned_hashmap._allocated;
+    for (int i = 256; i < 16384; i++) {
+        const int removed_key = i - 256;
+
+        sim_hashmap_remove(&churned_hashmap, &removed_key);
+        sim_hashmap_insert(&churned_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+
+        if (churned_hashmap._allocated != allocated) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "insert: hashmap reallocated while its count stayed constant";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    for (int i = 16384 - 256; i < 16384; i++) {
+        int* value_ptr = sim_hashmap_get_ptr(&churned_hashmap, &i);
+        if (!value_ptr || *value_ptr != i) {
+            sim_hashmap_destroy(&churned_hashmap);
+            *out_err_str = "get_ptr: failed to retrieve value after rehashing in place";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&churned_hashmap);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_batched(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap batched_hashmap;
+
+    sim_hashmap_construct_with_flags(
+        &batched_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0,
+        SIM_HASH_GROUP_PROBING
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    // batches span several prefetch windows & force resizes partway through
+    int keys[100], values[100];
+    for (int i = 0; i < 100; i++) {
+        keys[i] = i * 3;
+        values[i] = -i;
+    }
+
+    sim_hashmap_insert_many(&batched_hashmap, keys, values, 100);
+    if ((rc = sim_get_return_code())) {
+        sim_hashmap_destroy(&batched_hashmap);
+        *out_err_str = "unexpected error out on insert_many";
+        return rc;
+    }
+    if (batched_hashmap.count != 100) {
+        sim_hashmap_destroy(&batched_hashmap);
+        *out_err_str = "insert_many: incorrect count after inserting keys";
+        return SIM_RC_FAILURE;
+    }
+
+    // every other lookup misses
+    int lookup_keys[100];
+    void* value_ptrs[100];
+    for (int i = 0; i < 100; i++)
+        lookup_keys[i] = (i % 2) ?
+            i * 3 + 1 :
+            i * 3
+        ;
+
+    size_t found = sim_hashmap_get_many(&batched_hashmap, lookup_keys, 100, value_ptrs);
+    if (sim_get_return_code() != SIM_RC_NOT_FOUND || found != 50) {
+        sim_hashmap_destroy(&batched_hashmap);
+        *out_err_str = "get_many: incorrect amount of keys found";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 100; i++) {
+        const int *const value_ptr = value_ptrs[i];
+
+        if ((i % 2) ? value_ptr != NULL : (!value_ptr || *value_ptr != -i)) {
+            sim_hashmap_destroy(&batched_hashmap);
+            *out_err_str = "get_many: incorrect value pointer retrieved for key";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&batched_hashmap);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_construct_from(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap bulk_hashmap;
+    const size_t alloc_size = simt_alloc_size();
+
+    // the last key repeats the first; its value should win
+    int keys[1001], values[1001];
+    for (int i = 0; i < 1000; i++) {
+        keys[i] = i * 5;
+        values[i] = i;
+    }
+    keys[1000] = 0;
+    values[1000] = -1;
+
+    sim_hashmap_construct_from(
+        &bulk_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        SIM_HASH_DEFAULT,
+        keys,
+        values,
+        1001
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct_from";
+        return rc;
+    }
+    if (bulk_hashmap.count != 1000 || bulk_hashmap._resize_count != 0) {
+        sim_hashmap_destroy(&bulk_hashmap);
+        *out_err_str = "construct_from: incorrect count or resized while inserting";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        const int key = i * 5;
+        int* value_ptr = sim_hashmap_get_ptr(&bulk_hashmap, &key);
+
+        if (!value_ptr || *value_ptr != (i ? i : -1)) {
+            sim_hashmap_destroy(&bulk_hashmap);
+            *out_err_str = "get_ptr: failed to retrieve value for bulk inserted key";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // nodes from the bulk block must survive removals & resizes alongside individual ones
+    for (int i = 0; i < 1000; i += 2) {
+        const int key = i * 5;
+        sim_hashmap_remove(&bulk_hashmap, &key);
+    }
+    for (int i = 5000; i < 5600; i++) {
+        sim_hashmap_insert(&bulk_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&bulk_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+    for (int i = 1; i < 1000; i += 2) {
+        const int key = i * 5;
+        int* value_ptr = sim_hashmap_get_ptr(&bulk_hashmap, &key);
+
+        if (!value_ptr || *value_ptr != i) {
+            sim_hashmap_destroy(&bulk_hashmap);
+            *out_err_str = "get_ptr: failed to retrieve bulk inserted value after resizing";
+            return SIM_RC_FAILURE;
+        }
+    }
+    if (bulk_hashmap._resize_count == 0) {
+        sim_hashmap_destroy(&bulk_hashmap);
+        *out_err_str = "insert: hashmap never resized after bulk construction";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_hashmap_destroy(&bulk_hashmap);
+
+    // pairs vectors hold each key followed by its value
+    Sim_Vector pairs_vector;
+    sim_vector_construct(&pairs_vector, sizeof(int) * 2, NULL, 0);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on vector construct";
+        return rc;
+    }
+    for (int i = 0; i < 100; i++) {
+        const int pair[2] = { i, i * i };
+        sim_vector_push(&pairs_vector, pair);
+    }
+
+    sim_hashmap_construct_from_vector(
+        &bulk_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        SIM_HASH_FLAT_STORAGE,
+        &pairs_vector
+    );
+    sim_vector_destroy(&pairs_vector);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct_from_vector";
+        return rc;
+    }
+
+    for (int i = 0; i < 100; i++) {
+        int* value_ptr = sim_hashmap_get_ptr(&bulk_hashmap, &i);
+
+        if (!value_ptr || *value_ptr != i * i) {
+            sim_hashmap_destroy(&bulk_hashmap);
+            *out_err_str = "get_ptr: failed to retrieve value for key from pairs vector";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&bulk_hashmap);
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free bulk constructed hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+static Sim_HashType _int_parity(const int *const key, const size_t attempt) {
+    (void)attempt;
+    return (Sim_HashType)(*key & 1);
+}
+
+// Inserts, looks up, & removes keys in a Robin Hood hashmap, checking every remaining key after.
+static Sim_ReturnCode _hashmap_test_robin_hood_keys(
+    Sim_HashProc        hash_proc,
+    const Sim_HashFlags flags,
+    const int           key_count,
+    const char* *const  out_err_str
+) {
+    Sim_ReturnCode rc;
+    Sim_HashMap robin_hood_hashmap;
+
+    sim_hashmap_construct_with_flags(
+        &robin_hood_hashmap,
+        sizeof(int),
+        hash_proc,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0,
+        flags | SIM_HASH_ROBIN_HOOD
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < key_count; i++) {
+        sim_hashmap_insert(&robin_hood_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&robin_hood_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    // removals shift items back instead of leaving tombstones
+    for (int i = 0; i < key_count; i += 3) {
+        sim_hashmap_remove(&robin_hood_hashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&robin_hood_hashmap);
+            *out_err_str = "remove: failed to remove key";
+            return rc;
+        }
+    }
+    if (robin_hood_hashmap._tombstones != 0) {
+        sim_hashmap_destroy(&robin_hood_hashmap);
+        *out_err_str = "remove: left tombstones behind";
+        return SIM_RC_FAILURE;
+    }
+
+    // misses stop early, but must never stop before a key that's present
+    for (int i = 0; i < key_count * 2; i++) {
+        int* value_ptr = sim_hashmap_get_ptr(&robin_hood_hashmap, &i);
+        const bool expected = i < key_count && i % 3;
+
+        if (expected ? (!value_ptr || *value_ptr != i) : value_ptr != NULL) {
+            sim_hashmap_destroy(&robin_hood_hashmap);
+            *out_err_str = expected ?
+                "get_ptr: failed to retrieve value for key" :
+                "get_ptr: retrieved value for key that isn't in hashmap"
+            ;
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    sim_hashmap_destroy(&robin_hood_hashmap);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_robin_hood(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    rc = _hashmap_test_robin_hood_keys(NULL, SIM_HASH_DEFAULT, 768, out_err_str);
+    if (rc)
+        return rc;
+
+    rc = _hashmap_test_robin_hood_keys(
+        NULL,
+        SIM_HASH_INCREMENTAL_RESIZE | SIM_HASH_CACHE_HASHES | SIM_HASH_FLAT_STORAGE,
+        4096,
+        out_err_str
+    );
+    if (rc)
+        return rc;
+
+    // 2 home slots make for clusters longer than a displacement byte can hold
+    return _hashmap_test_robin_hood_keys(
+        (Sim_HashProc)_int_parity,
+        SIM_HASH_DEFAULT,
+        768,
+        out_err_str
+    );
+}
+
+static Sim_HashType _int_collide(const int *const key, const size_t attempt) {
+    (void)key;
+    return attempt;
+}
+
+Sim_ReturnCode hashmap_test_stats(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap stats_hashmap;
+    Sim_HashStats stats;
+
+    // every key hashes the same, so each insert has to probe past all of the ones before it
+    sim_hashmap_construct(
+        &stats_hashmap,
+        sizeof(int),
+        (Sim_HashProc)_int_collide,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        64
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        sim_hashmap_insert(&stats_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&stats_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+    int key = 7;
+    sim_hashmap_remove(&stats_hashmap, &key);
+    sim_hashmap_get_ptr(&stats_hashmap, &key);
+
+    sim_hashmap_get_stats(&stats_hashmap, &stats);
+    if ((rc = sim_get_return_code())) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "unexpected error out on get_stats";
+        return rc;
+    }
+    if (stats.count != 7 || stats.allocated != stats_hashmap._allocated) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: incorrect count or amount allocated";
+        return SIM_RC_FAILURE;
+    }
+    if (stats.load_factor <= 0.0 || stats.load_factor >= 1.0 || stats.allocated_bytes == 0) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: incorrect load factor or memory use";
+        return SIM_RC_FAILURE;
+    }
+
+    size_t histogram_total = 0;
+    for (size_t i = 0; i < SIM_HASH_STATS_HISTOGRAM_SIZE; i++)
+        histogram_total += stats.probe_histogram[i];
+    if (histogram_total != 7 || stats.probe_histogram[0] != 1) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: probe histogram doesn't account for every item";
+        return SIM_RC_FAILURE;
+    }
+    if (stats.max_displacement != 6 || stats.average_displacement != 3.0) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: incorrect displacement for colliding keys";
+        return SIM_RC_FAILURE;
+    }
+
+#   if SIM_HASH_OP_COUNTERS
+        if (
+            stats.op_counters.inserts != 8 ||
+            stats.op_counters.removes != 1 ||
+            stats.op_counters.lookups != 1 ||
+            stats.op_counters.lookup_probes < 8
+        ) {
+            sim_hashmap_destroy(&stats_hashmap);
+            *out_err_str = "get_stats: incorrect operation counters";
+            return SIM_RC_FAILURE;
+        }
+#   endif
+
+    sim_hashmap_destroy(&stats_hashmap);
+
+    // nodes of a bulk construction are allocated as one block, which stays until it's all freed
+    int keys[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    sim_hashmap_construct_from(
+        &stats_hashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        SIM_HASH_DEFAULT,
+        keys,
+        keys,
+        8
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct_from";
+        return rc;
+    }
+
+    Sim_HashStats bulk_stats;
+    sim_hashmap_get_stats(&stats_hashmap, &bulk_stats);
+    key = 8;
+    sim_hashmap_insert(&stats_hashmap, &key, &key);
+    sim_hashmap_get_stats(&stats_hashmap, &stats);
+    if (stats.allocated_bytes != bulk_stats.allocated_bytes + sizeof(int) * 2) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: incorrect memory use after inserting past a node block";
+        return SIM_RC_FAILURE;
+    }
+
+    key = 0;
+    sim_hashmap_remove(&stats_hashmap, &key);
+    sim_hashmap_get_stats(&stats_hashmap, &bulk_stats);
+    if (bulk_stats.allocated_bytes != stats.allocated_bytes) {
+        sim_hashmap_destroy(&stats_hashmap);
+        *out_err_str = "get_stats: incorrect memory use after removing from a node block";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_hashmap_destroy(&stats_hashmap);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_mapped(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap source_hashmap, mapped_hashmap;
+    const size_t alloc_size = simt_alloc_size();
+
+    // every probing scheme keeps its own bucket layout; each one has to survive the round trip
+    const Sim_HashFlags flags[] = {
+        SIM_HASH_FLAT_STORAGE,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_POWER_OF_TWO | SIM_HASH_CACHE_HASHES,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_GROUP_PROBING,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_ROBIN_HOOD
+    };
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        sim_hashmap_construct_with_flags(
+            &source_hashmap,
+            sizeof(int),
+            NULL,
+            (Sim_PredicateProc)_int_eq,
+            sizeof(int),
+            NULL,
+            0,
+            flags[f]
+        );
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on construct";
+            return rc;
+        }
+
+        // removed keys leave tombstones behind in all but Robin Hood hashmaps
+        for (int i = 0; i < 1000; i++) {
+            const int value = i * 3;
+            sim_hashmap_insert(&source_hashmap, &i, &value);
+        }
+        for (int i = 0; i < 1000; i += 4)
+            sim_hashmap_remove(&source_hashmap, &i);
+
+        FILE* file_ptr = tmpfile();
+        if (!file_ptr) {
+            sim_hashmap_destroy(&source_hashmap);
+            *out_err_str = "tmpfile: couldn't create a temporary file";
+            return SIM_RC_FAILURE;
+        }
+
+        sim_hashmap_serialize(&source_hashmap, file_ptr);
+        sim_hashmap_destroy(&source_hashmap);
+        if ((rc = sim_get_return_code())) {
+            fclose(file_ptr);
+            *out_err_str = "unexpected error out on serialize";
+            return rc;
+        }
+
+        sim_hashmap_construct_mapped(&mapped_hashmap, file_ptr, NULL, (Sim_PredicateProc)_int_eq);
+        fclose(file_ptr);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on construct_mapped";
+            return rc;
+        }
+        if (mapped_hashmap.count != 750) {
+            sim_hashmap_destroy(&mapped_hashmap);
+            *out_err_str = "construct_mapped: incorrect count";
+            return SIM_RC_FAILURE;
+        }
+
+        for (int i = 0; i < 1200; i++) {
+            const int* value_ptr = sim_hashmap_get_ptr(&mapped_hashmap, &i);
+
+            if ((i < 1000 && i % 4) ? (!value_ptr || *value_ptr != i * 3) : !!value_ptr) {
+                sim_hashmap_destroy(&mapped_hashmap);
+                *out_err_str = "get_ptr: mapped hashmap doesn't hold what was serialized";
+                return SIM_RC_FAILURE;
+            }
+        }
+
+        sim_hashmap_destroy(&mapped_hashmap);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on destroying a mapped hashmap";
+            return rc;
+        }
+    }
+
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free serialized hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#define _PARALLEL_KEY_COUNT 40000
+
+static int _parallel_keys[_PARALLEL_KEY_COUNT * 3 / 2];
+static int _parallel_values[_PARALLEL_KEY_COUNT * 3 / 2];
+
+Sim_ReturnCode hashmap_test_parallel(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashMap parallel_hashmap;
+    const size_t alloc_size = simt_alloc_size();
+    const int item_count = _PARALLEL_KEY_COUNT * 3 / 2;
+
+    // every probing scheme claims slots in its own order; node storage would allocate every item
+    //  through the test allocator, which neither tracks this many pointers nor is thread-safe
+    const Sim_HashFlags flags[] = {
+        SIM_HASH_FLAT_STORAGE,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_CACHE_HASHES,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_POWER_OF_TWO | SIM_HASH_CACHE_HASHES,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_GROUP_PROBING
+    };
+
+    // the first half of the keys appear twice; later values must win
+    for (int i = 0; i < item_count; i++) {
+        _parallel_keys[i] = i % _PARALLEL_KEY_COUNT;
+        _parallel_values[i] = i;
+    }
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        sim_hashmap_construct_with_flags(
+            &parallel_hashmap,
+            sizeof(int),
+            NULL,
+            (Sim_PredicateProc)_int_eq,
+            sizeof(int),
+            NULL,
+            0,
+            flags[f]
+        );
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on construct";
+            return rc;
+        }
+
+        sim_hashmap_set_thread_count(&parallel_hashmap, 4);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&parallel_hashmap);
+            *out_err_str = "unexpected error out on set_thread_count";
+            return rc;
+        }
+
+        sim_hashmap_insert_many(&parallel_hashmap, _parallel_keys, _parallel_values, item_count);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&parallel_hashmap);
+            *out_err_str = "unexpected error out on insert_many";
+            return rc;
+        }
+        if (parallel_hashmap.count != _PARALLEL_KEY_COUNT) {
+            sim_hashmap_destroy(&parallel_hashmap);
+            *out_err_str = "insert_many: incorrect count after inserting duplicate keys";
+            return SIM_RC_FAILURE;
+        }
+
+        // overwrite the values of keys that are already in the hashmap
+        sim_hashmap_insert_many(
+            &parallel_hashmap,
+            _parallel_keys + _PARALLEL_KEY_COUNT / 2,
+            _parallel_values,
+            _PARALLEL_KEY_COUNT / 2
+        );
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&parallel_hashmap);
+            *out_err_str = "unexpected error out on insert_many";
+            return rc;
+        }
+
+        // inserting one at a time grows the hashmap with parallel rehashes
+        for (int i = _PARALLEL_KEY_COUNT; i < _PARALLEL_KEY_COUNT * 2; i++) {
+            sim_hashmap_insert(&parallel_hashmap, &i, &i);
+            if ((rc = sim_get_return_code())) {
+                sim_hashmap_destroy(&parallel_hashmap);
+                *out_err_str = "unexpected error out on insert";
+                return rc;
+            }
+        }
+        if (parallel_hashmap.count != _PARALLEL_KEY_COUNT * 2) {
+            sim_hashmap_destroy(&parallel_hashmap);
+            *out_err_str = "insert: incorrect count after parallel rehashes";
+            return SIM_RC_FAILURE;
+        }
+
+        for (int i = 0; i < _PARALLEL_KEY_COUNT * 2; i++) {
+            const int* value_ptr = sim_hashmap_get_ptr(&parallel_hashmap, &i);
+            const int expected =
+                (i < _PARALLEL_KEY_COUNT / 2) ? i + _PARALLEL_KEY_COUNT :
+                (i < _PARALLEL_KEY_COUNT) ? i - _PARALLEL_KEY_COUNT / 2 :
+                i
+            ;
+
+            if (!value_ptr || *value_ptr != expected) {
+                sim_hashmap_destroy(&parallel_hashmap);
+                *out_err_str = "get_ptr: failed to retrieve value for key";
+                return SIM_RC_FAILURE;
+            }
+        }
+
+        sim_hashmap_destroy(&parallel_hashmap);
+    }
+
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free parallel hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_test_destroy(const char* *const out_err_str) {
+    sim_hashmap_destroy(&hashmap);
+
+    if (simt_alloc_size() > 0) {
+        *out_err_str = "destroy: failed to free dynamically allocated memory";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+// == BENCHMARKS ==================================================================================
+
+#define HASHMAP_BENCH_KEYS   (1 << 16)
+#define HASHMAP_BENCH_ROUNDS 16
+
+#define HASHMAP_BENCH_BATCH_KEYS (1 << 21)
+#define HASHMAP_BENCH_BATCH      64
+
+static Sim_HashType _int_hash(const int *const key, const size_t attempt) {
+    return (Sim_HashType)*key * 0x9e3779b97f4a7c15ULL + attempt;
+}
+
+// Times hits & misses on a hashmap constructed with the given flags.
+static Sim_ReturnCode _hashmap_bench_lookup(
+    const Sim_HashFlags flags,
+    char *const         out_result_str,
+    const size_t        result_str_size
+) {
+    Sim_ReturnCode rc;
+    Sim_HashMap bench_hashmap;
+
+    sim_hashmap_construct_with_flags(
+        &bench_hashmap,
+        sizeof(int),
+        (Sim_HashProc)_int_hash,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        0,
+        flags | SIM_HASH_FLAT_STORAGE
+    );
+    if ((rc = sim_get_return_code()))
+        return rc;
+
+    // even keys are inserted; odd keys are used for misses
+    for (int i = 0; i < HASHMAP_BENCH_KEYS; i++) {
+        int key = i * 2;
+
+        sim_hashmap_insert(&bench_hashmap, &key, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&bench_hashmap);
+            return rc;
+        }
+    }
+
+    size_t found = 0;
+    clock_t start = clock();
+    for (int round = 0; round < HASHMAP_BENCH_ROUNDS; round++)
+        for (int i = 0; i < HASHMAP_BENCH_KEYS; i++) {
+            int key = i * 2;
+            found += sim_hashmap_get_ptr(&bench_hashmap, &key) != NULL;
+        }
+    clock_t hit_ticks = clock() - start;
+
+    start = clock();
+    for (int round = 0; round < HASHMAP_BENCH_ROUNDS; round++)
+        for (int i = 0; i < HASHMAP_BENCH_KEYS; i++) {
+            int key = i * 2 + 1;
+            found += sim_hashmap_get_ptr(&bench_hashmap, &key) != NULL;
+        }
+    clock_t miss_ticks = clock() - start;
+
+    sim_hashmap_destroy(&bench_hashmap);
+
+    if (found != (size_t)HASHMAP_BENCH_KEYS * HASHMAP_BENCH_ROUNDS)
+        return SIM_RC_FAILURE;
+
+    const double lookups = (double)HASHMAP_BENCH_KEYS * HASHMAP_BENCH_ROUNDS;
+    snprintf(
+        out_result_str,
+        result_str_size,
+        "%.1f ns/hit, %.1f ns/miss",
+        (double)hit_ticks * 1e9 / CLOCKS_PER_SEC / lookups,
+        (double)miss_ticks * 1e9 / CLOCKS_PER_SEC / lookups
+    );
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode hashmap_bench_prime(const char* *const out_err_str) {
+    static char result_str[64];
+
+    Sim_ReturnCode rc = _hashmap_bench_lookup(SIM_HASH_DEFAULT, result_str, sizeof(result_str));
+    *out_err_str = rc ?
+        "unexpected error out on prime sized lookups" :
+        result_str
+    ;
+    return rc;
+}
+
+Sim_ReturnCode hashmap_bench_power_of_two(const char* *const out_err_str) {
+    static char result_str[64];
+
+    Sim_ReturnCode rc =
+        _hashmap_bench_lookup(SIM_HASH_POWER_OF_TWO, result_str, sizeof(result_str));
+    *out_err_str = rc ?
+        "unexpected error out on power of 2 sized lookups" :
+        result_str
+    ;
+    return rc;
+}
+
+Sim_ReturnCode hashmap_bench_robin_hood(const char* *const out_err_str) {
+    static char result_str[64];
+
+    Sim_ReturnCode rc = _hashmap_bench_lookup(SIM_HASH_ROBIN_HOOD, result_str, sizeof(result_str));
+    *out_err_str = rc ?
+        "unexpected error out on Robin Hood lookups" :
+        result_str
+    ;
+    return rc;
+}
+
+// Times single & batched hits on a hashmap too large to fit in cache.
+Sim_ReturnCode hashmap_bench_get_many(const char* *const out_err_str) {
+    static char result_str[64];
+    Sim_ReturnCode rc;
+    Sim_HashMap bench_hashmap;
+
+    // flat storage; nodes for every key would exceed the test allocator's live allocation limit
+    sim_hashmap_construct_with_flags(
+        &bench_hashmap,
+        sizeof(int),
+        (Sim_HashProc)_int_hash,
+        (Sim_PredicateProc)_int_eq,
+        sizeof(int),
+        NULL,
+        HASHMAP_BENCH_BATCH_KEYS,
+        SIM_HASH_FLAT_STORAGE
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < HASHMAP_BENCH_BATCH_KEYS; i++) {
+        sim_hashmap_insert(&bench_hashmap, &i, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_hashmap_destroy(&bench_hashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    // look keys up in a scattered order so that consecutive lookups don't share cache lines
+    int keys[HASHMAP_BENCH_BATCH];
+    void* value_ptrs[HASHMAP_BENCH_BATCH];
+    size_t found = 0;
+
+    clock_t start = clock();
+    for (int batch = 0; batch < HASHMAP_BENCH_BATCH_KEYS; batch += HASHMAP_BENCH_BATCH)
+        for (int i = 0; i < HASHMAP_BENCH_BATCH; i++) {
+            const int key = (int)(((unsigned)(batch + i) * 2654435761u) % HASHMAP_BENCH_BATCH_KEYS);
+            found += sim_hashmap_get_ptr(&bench_hashmap, &key) != NULL;
+        }
+    clock_t single_ticks = clock() - start;
+
+    start = clock();
+    for (int batch = 0; batch < HASHMAP_BENCH_BATCH_KEYS; batch += HASHMAP_BENCH_BATCH) {
+        for (int i = 0; i < HASHMAP_BENCH_BATCH; i++)
+            keys[i] = (int)(((unsigned)(batch + i) * 2654435761u) % HASHMAP_BENCH_BATCH_KEYS);
+        found += sim_hashmap_get_many(&bench_hashmap, keys, HASHMAP_BENCH_BATCH, value_ptrs);
+    }
+    clock_t batched_ticks = clock() - start;
+
+    sim_hashmap_destroy(&bench_hashmap);
+
+    if (found != (size_t)HASHMAP_BENCH_BATCH_KEYS * 2) {
+        *out_err_str = "unexpected amount of keys found";
+        return SIM_RC_FAILURE;
+    }
+
+    snprintf(
+        result_str,
+        sizeof(result_str),
+        "%.1f ns/get_ptr, %.1f ns/key batched",
+        (double)single_ticks * 1e9 / CLOCKS_PER_SEC / HASHMAP_BENCH_BATCH_KEYS,
+        (double)batched_ticks * 1e9 / CLOCKS_PER_SEC / HASHMAP_BENCH_BATCH_KEYS
+    );
+    *out_err_str = result_str;
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_HASHMAP_TESTS_C_ */
@@ -13,4 +13,24 @@
 
 #include "simsoft/common.h"
 
+extern Sim_ReturnCode hashmap_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_insert(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_get(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_remove(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_cached_hashes(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_incremental_resize(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_tombstones(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_batched(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_construct_from(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_robin_hood(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_stats(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_mapped(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_parallel(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_test_destroy(const char* *const out_err_str);
+
+extern Sim_ReturnCode hashmap_bench_prime(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_bench_power_of_two(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_bench_robin_hood(const char* *const out_err_str);
+extern Sim_ReturnCode hashmap_bench_get_many(const char* *const out_err_str);
+
 #endif /* SIMTEST_HASHMAP_TESTS_H_ */
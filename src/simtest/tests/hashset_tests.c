@@ -25,30 +25,30 @@ Sim_ReturnCode hashset_test_construct(const char* *const out_err_str) {
     Sim_ReturnCode rc;
     srand(time(NULL));
 
-    sim_hashset_construct(
+    SIMT_CATCH(rc, sim_hashset_construct(
         NULL,
         sizeof(void*),
         NULL,
         (Sim_PredicateProc)_int_eq,
         NULL,
         75
-    );
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    ));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "construct: failed to check for NULLPTR hashset";
-        return SIM_RC_ERR_NULLPTR;
+        return SIM_RC_FAILURE;
     }
 
-    sim_hashset_construct(
+    SIMT_CATCH(rc, sim_hashset_construct(
         &hashset,
         sizeof(void*),
         NULL,
         NULL,
         NULL,
         75
-    );
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    ));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "construct: failed to check for NULLPTR predicate function";
-        return SIM_RC_ERR_NULLPTR;
+        return SIM_RC_FAILURE;
     }
 
     sim_hashset_construct(
@@ -59,7 +59,7 @@ Sim_ReturnCode hashset_test_construct(const char* *const out_err_str) {
         NULL,
         75
     );
-    if ((rc = sim_return_code())) {
+    if ((rc = sim_get_return_code())) {
         *out_err_str = "unexpected error out on construct";
         return rc;
     }
@@ -71,42 +71,31 @@ Sim_ReturnCode hashset_test_insert(const char* *const out_err_str) {
     Sim_ReturnCode rc;
     int i = 0;
 
-    sim_hashset_insert(NULL, &i);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_hashset_insert(NULL, &i));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "insert: failed to check for NULLPTR hashset";
         return SIM_RC_FAILURE;
     }
-    sim_hashset_insert(&hashset, NULL);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_hashset_insert(&hashset, NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "insert: failed to check for NULLPTR item";
         return SIM_RC_FAILURE;
     }
 
-    {
-        bool r = sim_hashset_contains(NULL, &i);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "contains: failed to check for NULLPTR hashset";
-            return SIM_RC_FAILURE;
-        }
-        if (r) {
-            *out_err_str = "contains: failed to return FALSE on error";
-            return SIM_RC_FAILURE;
-        }
-        
-        r = sim_hashset_contains(&hashset, NULL);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "contains: failed to check for NULLPTR item";
-            return SIM_RC_FAILURE;
-        }
-        if (r) {
-            *out_err_str = "contains: failed to return FALSE on error";
-            return SIM_RC_FAILURE;
-        }
+    SIMT_CATCH(rc, sim_hashset_contains(NULL, &i));
+    if (rc != SIM_RC_ERR_NULLPTR) {
+        *out_err_str = "contains: failed to check for NULLPTR hashset";
+        return SIM_RC_FAILURE;
+    }
+    SIMT_CATCH(rc, sim_hashset_contains(&hashset, NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
+        *out_err_str = "contains: failed to check for NULLPTR item";
+        return SIM_RC_FAILURE;
     }
 
     for (; i < 128; i++) {
         sim_hashset_insert(&hashset, &i);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_hashset_destroy(&hashset);
             *out_err_str = "unexpected error out on insert";
             return rc;
@@ -117,7 +106,7 @@ Sim_ReturnCode hashset_test_insert(const char* *const out_err_str) {
         }
 
         sim_hashset_insert(&hashset, &i);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             *out_err_str = "unexpected error out on insert";
             return rc;
         }
@@ -127,9 +116,9 @@ Sim_ReturnCode hashset_test_insert(const char* *const out_err_str) {
         }
 
         if (!sim_hashset_contains(&hashset, &i)) {
-            switch ((rc = sim_return_code())) {
-            case SIM_RC_ERR_NOTFOUND:
-                *out_err_str = "contains: raised ERR_NOTFOUND for item in hashset";
+            switch ((rc = sim_get_return_code())) {
+            case SIM_RC_NOT_FOUND:
+                *out_err_str = "contains: returned NOT_FOUND for item in hashset";
                 return SIM_RC_FAILURE;
             case SIM_RC_SUCCESS:
                 *out_err_str = "contains: returned FALSE for item in hashset";
@@ -147,8 +136,8 @@ Sim_ReturnCode hashset_test_insert(const char* *const out_err_str) {
         *out_err_str = "contains: returned TRUE for item not in hashset";
         return SIM_RC_FAILURE;
     }
-    if (sim_return_code() != SIM_RC_ERR_NOTFOUND) {
-        *out_err_str = "contains: failed to raise ERR_NOTFOUND for item not in hashset";
+    if (sim_get_return_code() != SIM_RC_NOT_FOUND) {
+        *out_err_str = "contains: failed to return NOT_FOUND for item not in hashset";
         return SIM_RC_FAILURE;
     }
 
@@ -159,23 +148,23 @@ Sim_ReturnCode hashset_test_remove(const char* *const out_err_str) {
     Sim_ReturnCode rc;
     int i = 0;
 
-    sim_hashset_remove(NULL, &i);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_hashset_remove(NULL, &i));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "remove: failed to check for NULLPTR hashset";
         return SIM_RC_FAILURE;
     }
-    sim_hashset_remove(&hashset, NULL);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_hashset_remove(&hashset, NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "remove: failed to check for NULLPTR item";
         return SIM_RC_FAILURE;
     }
 
     i = 32;
     sim_hashset_remove(&hashset, &i);
-    if ((rc = sim_return_code())) {
+    if ((rc = sim_get_return_code())) {
         switch (rc) {
-        case SIM_RC_ERR_NOTFOUND:
-            *out_err_str = "remove: raised ERR_NOTFOUND for item in hashset";
+        case SIM_RC_FAILURE:
+            *out_err_str = "remove: returned FAILURE for item in hashset";
             return SIM_RC_FAILURE;
         default:
             *out_err_str = "unexpected error out on remove";
@@ -188,15 +177,257 @@ Sim_ReturnCode hashset_test_remove(const char* *const out_err_str) {
         *out_err_str = "contains: returned TRUE for item removed from hashset";
         return SIM_RC_FAILURE;
     }
-    if (sim_return_code() != SIM_RC_ERR_NOTFOUND) {
-        *out_err_str = "contains: failed to raise ERR_NOTFOUND for item removed from hashset";
+    if (sim_get_return_code() != SIM_RC_NOT_FOUND) {
+        *out_err_str = "contains: failed to return NOT_FOUND for item removed from hashset";
         return SIM_RC_FAILURE;
     }
 
     i = 255;
     sim_hashset_remove(&hashset, &i);
-    if (sim_return_code() != SIM_RC_ERR_NOTFOUND) {
-        *out_err_str = "remove: failed to raise ERR_NOTFOUND for item not in hashset";
+    if (sim_get_return_code() != SIM_RC_FAILURE) {
+        *out_err_str = "remove: failed to return FAILURE for item not in hashset";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+// Set operations are checked against every integer below this; kept small enough that node storage
+//  stays under the test allocator's limit on live allocations
+#define _HASHSET_RANGE 300
+
+// Checks that a set operation succeeded & left a hashset holding exactly the integers below
+//  _HASHSET_RANGE that a given predicate accepts. Returns NULL if so; an error string otherwise.
+static const char* _hashset_check(
+    Sim_HashSet *const set_ptr,
+    bool (*accepts)(const int),
+    const char* err_str
+) {
+    size_t expected_count = 0;
+
+    if (sim_get_return_code())
+        return "unexpected error out on set operation";
+
+    for (int i = 0; i < _HASHSET_RANGE; i++) {
+        if (sim_hashset_contains(set_ptr, &i) != accepts(i))
+            return err_str;
+        expected_count += accepts(i);
+    }
+    return (set_ptr->count == expected_count) ? NULL : err_str;
+}
+
+static bool _in_a(const int i) { return i < _HASHSET_RANGE / 3; }
+static bool _in_b(const int i) { return i % 3 == 0; }
+static bool _in_union(const int i) { return _in_a(i) || _in_b(i); }
+static bool _in_intersection(const int i) { return _in_a(i) && _in_b(i); }
+static bool _in_difference(const int i) { return _in_a(i) && !_in_b(i); }
+static bool _in_nothing(const int i) { (void)i; return false; }
+
+Sim_ReturnCode hashset_test_set_operations(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashSet set_a, set_b, set_out;
+    const size_t alloc_size = simt_alloc_size();
+
+    // removing items in place shifts linearly probed clusters back rather than leaving tombstones
+    const Sim_HashFlags flags[] = {
+        SIM_HASH_DEFAULT,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_POWER_OF_TWO,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_GROUP_PROBING | SIM_HASH_CACHE_HASHES,
+        SIM_HASH_ROBIN_HOOD,
+        SIM_HASH_INCREMENTAL_RESIZE | SIM_HASH_CACHE_HASHES
+    };
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        Sim_HashSet *const sets[] = { &set_a, &set_b, &set_out };
+        for (size_t i = 0; i < 3; i++) {
+            // operands with different flags can still share cached hashes or not
+            sim_hashset_construct_with_flags(
+                sets[i],
+                sizeof(int),
+                NULL,
+                (Sim_PredicateProc)_int_eq,
+                NULL,
+                0,
+                flags[(f + i) % (sizeof(flags) / sizeof(flags[0]))]
+            );
+            if ((rc = sim_get_return_code())) {
+                while (i-- > 0)
+                    sim_hashset_destroy(sets[i]);
+                *out_err_str = "unexpected error out on construct";
+                return rc;
+            }
+        }
+
+        for (int i = 0; i < _HASHSET_RANGE; i++) {
+            if (_in_a(i))
+                sim_hashset_insert(&set_a, &i);
+            if (_in_b(i))
+                sim_hashset_insert(&set_b, &i);
+        }
+
+        const char* err_str;
+
+        sim_hashset_union(&set_a, &set_b, &set_out);
+        err_str = _hashset_check(
+            &set_out,
+            _in_union,
+            "union: output hashset doesn't hold the items of both"
+        );
+
+        sim_hashset_intersect(&set_a, &set_b, &set_out);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_intersection,
+            "intersect: output hashset doesn't hold the items in common"
+        );
+
+        sim_hashset_difference(&set_a, &set_b, &set_out);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_difference,
+            "difference: output hashset doesn't hold the items only one has"
+        );
+
+        if (!err_str && (
+            sim_hashset_is_subset(&set_a, &set_b) ||
+            !sim_hashset_is_subset(&set_out, &set_a) ||
+            sim_hashset_is_subset(&set_out, &set_b)
+        ))
+            err_str = "is_subset: incorrect result";
+
+        // in place: out = A, then out ∩= B, then out ∪= B, then out -= B
+        sim_hashset_clear(&set_out);
+        sim_hashset_union(&set_out, &set_a, NULL);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_a,
+            "union: failed to add items in place"
+        );
+
+        sim_hashset_intersect(&set_out, &set_b, NULL);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_intersection,
+            "intersect: failed to remove items in place"
+        );
+
+        sim_hashset_union(&set_b, &set_out, &set_out);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_b,
+            "union: failed to add items to an output hashset that's also an operand"
+        );
+
+        sim_hashset_difference(&set_out, &set_b, NULL);
+        err_str = err_str ? err_str : _hashset_check(
+            &set_out,
+            _in_nothing,
+            "difference: failed to remove items in place"
+        );
+
+        sim_hashset_destroy(&set_a);
+        sim_hashset_destroy(&set_b);
+        sim_hashset_destroy(&set_out);
+        if (err_str) {
+            *out_err_str = err_str;
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free hashsets";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+static Sim_HashType _pile_up_hash;
+
+// Hashes every key to the same value, piling them up into one cluster wherever that value lands.
+static Sim_HashType _int_pile_up(const int *const key, const size_t attempt) {
+    (void)key;
+    (void)attempt;
+    return _pile_up_hash;
+}
+
+// Every key is in a single cluster; with enough different starting points some of them wrap
+//  around the end of the buckets
+#define _PILE_UP_KEY_COUNT 40
+#define _PILE_UP_HASH_COUNT 16
+
+static bool _in_pile_up_even(const int i) { return i < _PILE_UP_KEY_COUNT && i % 2 == 0; }
+static bool _in_pile_up_half(const int i) { return _in_pile_up_even(i) && i % 4 != 0; }
+
+Sim_ReturnCode hashset_test_wrap_around(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_HashSet set_out, set_even, set_quarter;
+    const size_t alloc_size = simt_alloc_size();
+
+    // removing items in place shifts clusters back; Robin Hood hashing stops at items already home
+    const Sim_HashFlags flags[] = {
+        SIM_HASH_ROBIN_HOOD,
+        SIM_HASH_ROBIN_HOOD | SIM_HASH_FLAT_STORAGE | SIM_HASH_CACHE_HASHES,
+        SIM_HASH_FLAT_STORAGE | SIM_HASH_POWER_OF_TWO
+    };
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        for (_pile_up_hash = 0; _pile_up_hash < _PILE_UP_HASH_COUNT; _pile_up_hash++) {
+            Sim_HashSet *const sets[] = { &set_out, &set_even, &set_quarter };
+            for (size_t i = 0; i < 3; i++) {
+                sim_hashset_construct_with_flags(
+                    sets[i],
+                    sizeof(int),
+                    (Sim_HashProc)_int_pile_up,
+                    (Sim_PredicateProc)_int_eq,
+                    NULL,
+                    0,
+                    flags[f]
+                );
+                if ((rc = sim_get_return_code())) {
+                    while (i-- > 0)
+                        sim_hashset_destroy(sets[i]);
+                    *out_err_str = "unexpected error out on construct";
+                    return rc;
+                }
+            }
+
+            for (int i = 0; i < _PILE_UP_KEY_COUNT; i++) {
+                sim_hashset_insert(&set_out, &i);
+                if (i % 2 == 0)
+                    sim_hashset_insert(&set_even, &i);
+                if (i % 4 == 0)
+                    sim_hashset_insert(&set_quarter, &i);
+            }
+
+            const char* err_str;
+
+            sim_hashset_intersect(&set_out, &set_even, NULL);
+            err_str = _hashset_check(
+                &set_out,
+                _in_pile_up_even,
+                "intersect: lost items in place from a wrapped around cluster"
+            );
+
+            sim_hashset_difference(&set_out, &set_quarter, NULL);
+            err_str = err_str ? err_str : _hashset_check(
+                &set_out,
+                _in_pile_up_half,
+                "difference: lost items in place from a wrapped around cluster"
+            );
+
+            sim_hashset_destroy(&set_out);
+            sim_hashset_destroy(&set_even);
+            sim_hashset_destroy(&set_quarter);
+            if (err_str) {
+                *out_err_str = err_str;
+                return SIM_RC_FAILURE;
+            }
+        }
+    }
+
+    if (simt_alloc_size() > alloc_size) {
+        *out_err_str = "destroy: failed to free hashsets";
         return SIM_RC_FAILURE;
     }
 
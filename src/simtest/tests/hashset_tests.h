@@ -16,6 +16,8 @@
 extern Sim_ReturnCode hashset_test_construct(const char* *const out_err_str);
 extern Sim_ReturnCode hashset_test_insert(const char* *const out_err_str);
 extern Sim_ReturnCode hashset_test_remove(const char* *const out_err_str);
+extern Sim_ReturnCode hashset_test_set_operations(const char* *const out_err_str);
+extern Sim_ReturnCode hashset_test_wrap_around(const char* *const out_err_str);
 extern Sim_ReturnCode hashset_test_destroy(const char* *const out_err_str);
 
 #endif /* SIMTEST_HASHSET_TESTS_H_ */
@@ -0,0 +1,220 @@
+/**
+ * @file hashtable_tests.cpp
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief C++ HashMap & HashSet unit tests.
+ * @version 0.1
+ * @date 2020-02-14
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_HASHTABLE_TESTS_CPP_
+#define SIMTEST_HASHTABLE_TESTS_CPP_
+
+#include <string>
+
+#include "simsoft/hashmap.h"
+#include "simsoft/hashset.h"
+
+using namespace SimSoft;
+using namespace SimSoft::C_API;
+
+// the test suite is C; its declarations & the test procedures need C linkage
+extern "C" {
+#   include "../test.h"
+}
+
+// Hashes strings, which Hash can't since they aren't trivially copyable.
+struct _StringHash {
+    Sim_HashType operator()(const std::string& str) const {
+        return sim_fasthash((const uint8*)str.data(), str.size(), 0);
+    }
+};
+
+// Allocates with the test suite's allocator so leaks can be counted.
+class _TestAllocator final : public Allocator {
+public:
+    void* malloc(size_t size) override {
+        return simt_malloc(size);
+    }
+    void* falloc(size_t size, uint8 fill) override {
+        return simt_falloc(size, fill);
+    }
+    void* realloc(void* ptr, size_t size) override {
+        return simt_realloc(ptr, size);
+    }
+    void free(void* ptr) override {
+        simt_free(ptr);
+    }
+};
+
+extern "C" Sim_ReturnCode hashtable_test_hashmap(const char* *const out_err_str) {
+    HashMap<uint64, uint64> hashmap;
+
+    for (uint64 i = 0; i < 5000; i++) {
+        if (!hashmap.insert(i * 7, i)) {
+            *out_err_str = "insert: new key reported as pre-existing";
+            return SIM_RC_FAILURE;
+        }
+    }
+    if (hashmap.insert(7, 100) || hashmap.get(7) != 100 || hashmap.get_count() != 5000) {
+        *out_err_str = "insert: failed to overwrite pre-existing key's value";
+        return SIM_RC_FAILURE;
+    }
+    hashmap[7] = 1;
+
+    for (uint64 i = 0; i < 5000; i++) {
+        const uint64 *const value_ptr = hashmap.get_ptr(i * 7);
+        if (!value_ptr || *value_ptr != i) {
+            *out_err_str = "get_ptr: inserted key has wrong value";
+            return SIM_RC_FAILURE;
+        }
+        if (hashmap.contains_key(i * 7 + 1)) {
+            *out_err_str = "contains_key: found key that was never inserted";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    bool threw = false;
+    try {
+        hashmap.get(1);
+    } catch (OutOfBoundsException&) {
+        threw = true;
+    }
+    if (!threw) {
+        *out_err_str = "get: failed to throw on missing key";
+        return SIM_RC_FAILURE;
+    }
+
+    // operator[] inserts value-initialized values
+    if (hashmap[3] != 0 || hashmap.get_count() != 5001 || !hashmap.remove(3)) {
+        *out_err_str = "operator[]: failed to insert missing key";
+        return SIM_RC_FAILURE;
+    }
+
+    // remove every other key; later keys in a cluster are shifted back
+    for (uint64 i = 0; i < 5000; i += 2) {
+        if (!hashmap.remove(i * 7)) {
+            *out_err_str = "remove: failed to find inserted key";
+            return SIM_RC_FAILURE;
+        }
+    }
+    if (hashmap.remove(0) || hashmap.get_count() != 2500) {
+        *out_err_str = "remove: removed key twice";
+        return SIM_RC_FAILURE;
+    }
+
+    uint64 sum = 0;
+    hashmap.foreach([&sum](const uint64& key, uint64& value) {
+        sum += value;
+        return key != (uint64)-1;
+    });
+    if (sum != 2500 * 2500) {
+        *out_err_str = "foreach: failed to visit the remaining pairs";
+        return SIM_RC_FAILURE;
+    }
+
+    hashmap.clear();
+    if (!hashmap.is_empty() || hashmap.contains_key(7)) {
+        *out_err_str = "clear: failed to remove every pair";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+extern "C" Sim_ReturnCode hashtable_test_hashset(const char* *const out_err_str) {
+    HashSet<std::string, _StringHash> hashset(8);
+
+    for (int i = 0; i < 1000; i++)
+        hashset.insert(std::to_string(i));
+    for (int i = 0; i < 1000; i += 3)
+        hashset.remove(std::to_string(i));
+
+    // copies & moves keep every item
+    HashSet<std::string, _StringHash> copy = hashset;
+    HashSet<std::string, _StringHash> moved = std::move(copy);
+    if (!copy.is_empty() || copy.contains("1")) {
+        *out_err_str = "move: moved-from hashset isn't empty";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        if (moved.contains(std::to_string(i)) != (i % 3 != 0)) {
+            *out_err_str = "contains: copied hashset has wrong items";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    size_t count = 0;
+    moved.foreach([&count](const std::string&) {
+        count++;
+        return true;
+    });
+    if (count != hashset.get_count() || count != 666) {
+        *out_err_str = "foreach: failed to visit every item";
+        return SIM_RC_FAILURE;
+    }
+
+    // both zeroes compare equal, so they must hash alike
+    HashSet<double> doubles;
+    doubles.insert(0.0);
+    if (doubles.insert(-0.0) || !doubles.contains(-0.0)) {
+        *out_err_str = "insert: -0.0 & 0.0 hashed differently";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+extern "C" Sim_ReturnCode hashtable_test_allocator(const char* *const out_err_str) {
+    _TestAllocator allocator;
+    const size_t alloc_size = simt_alloc_size();
+
+    {
+        HashMap<uint32, std::string, Hash<uint32>, Predicate_Equal<uint32>, _TestAllocator>
+            hashmap(HashMap<uint32, std::string>::DEFAULT_SIZE, &allocator);
+
+        for (uint32 i = 0; i < 200; i++)
+            hashmap.insert(i, std::to_string(i));
+        hashmap.resize(1024);
+
+        if (simt_alloc_size() != alloc_size + 1) {
+            *out_err_str = "resize: slots weren't allocated by the hashmap's allocator";
+            return SIM_RC_FAILURE;
+        }
+
+        // shrinks back down as it empties
+        for (uint32 i = 0; i < 200; i++)
+            hashmap.remove(i);
+    }
+
+    if (simt_alloc_size() != alloc_size) {
+        *out_err_str = "destructor: failed to free slots";
+        return SIM_RC_FAILURE;
+    }
+
+    // out of memory is thrown as an exception
+    HashSet<int, Hash<int>, Predicate_Equal<int>, _TestAllocator> hashset(
+        HashSet<int>::DEFAULT_SIZE,
+        &allocator
+    );
+    bool threw = false;
+
+    simt_alloc_set_lock(true);
+    try {
+        hashset.insert(1);
+    } catch (OutOfMemoryException&) {
+        threw = true;
+    }
+    simt_alloc_set_lock(false);
+
+    if (!threw || !hashset.is_empty()) {
+        *out_err_str = "insert: failed to throw when out of memory";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_HASHTABLE_TESTS_CPP_ */
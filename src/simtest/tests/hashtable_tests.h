@@ -0,0 +1,21 @@
+/**
+ * @file hashtable_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief C++ HashMap & HashSet unit tests.
+ * @version 0.1
+ * @date 2020-02-14
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_HASHTABLE_TESTS_H_
+#define SIMTEST_HASHTABLE_TESTS_H_
+
+#include "simsoft/common.h"
+
+// defined with C linkage in hashtable_tests.cpp
+extern Sim_ReturnCode hashtable_test_hashmap(const char* *const out_err_str);
+extern Sim_ReturnCode hashtable_test_hashset(const char* *const out_err_str);
+extern Sim_ReturnCode hashtable_test_allocator(const char* *const out_err_str);
+
+#endif /* SIMTEST_HASHTABLE_TESTS_H_ */
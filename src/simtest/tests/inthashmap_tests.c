@@ -0,0 +1,308 @@
+/**
+ * @file inthashmap_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Integer-keyed hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-18
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_INTHASHMAP_TESTS_C_
+#define SIMTEST_INTHASHMAP_TESTS_C_
+
+#include "../test.h"
+#include "simsoft/inthashmap.h"
+#include "./inthashmap_tests.h"
+
+#define INTHASHMAP_TEST_KEYS 50000
+
+// sparse keys with a large stride, like IDs handed out by a counter in another process
+#define INTHASHMAP_TEST_KEY(i) ((uint64)(i) * 0x10001ULL + 1)
+
+static Sim_IntHashMap inthashmap;
+static size_t _inthashmap_alloc_size;
+
+Sim_ReturnCode inthashmap_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    _inthashmap_alloc_size = simt_alloc_size();
+
+    sim_inthashmap_construct(&inthashmap, sizeof(uint64), NULL, 0, 0);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    if (inthashmap.count != 0) {
+        *out_err_str = "construct: hashmap wasn't empty";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode inthashmap_test_insert(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (uint64 i = 0; i < INTHASHMAP_TEST_KEYS; i++) {
+        sim_inthashmap_insert(&inthashmap, INTHASHMAP_TEST_KEY(i), &i);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    if (inthashmap.count != INTHASHMAP_TEST_KEYS) {
+        *out_err_str = "insert: incorrect count";
+        return SIM_RC_FAILURE;
+    }
+
+    for (uint64 i = 0; i < INTHASHMAP_TEST_KEYS; i++) {
+        uint64 value = (uint64)-1;
+
+        sim_inthashmap_get(&inthashmap, INTHASHMAP_TEST_KEY(i), &value);
+        if ((rc = sim_get_return_code()) || value != i) {
+            *out_err_str = "get: failed to retrieve value";
+            return rc ? rc : SIM_RC_FAILURE;
+        }
+
+        if (
+            sim_inthashmap_contains_key(&inthashmap, INTHASHMAP_TEST_KEY(i) + 1) ||
+            sim_get_return_code() != SIM_RC_NOT_FOUND
+        ) {
+            *out_err_str = "contains_key: found a key that wasn't inserted";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // inserting a key that's already contained overwrites its value
+    const uint64 key = INTHASHMAP_TEST_KEY(12), value = 1212;
+    sim_inthashmap_insert(&inthashmap, key, &value);
+
+    uint64 *const value_ptr = sim_inthashmap_get_ptr(&inthashmap, key);
+    if (!value_ptr || *value_ptr != value || inthashmap.count != INTHASHMAP_TEST_KEYS) {
+        *out_err_str = "insert: pre-existing pair wasn't overwritten";
+        return SIM_RC_FAILURE;
+    }
+    *value_ptr = 12;
+
+    if (
+        sim_inthashmap_get_ptr(&inthashmap, INTHASHMAP_TEST_KEY(INTHASHMAP_TEST_KEYS)) ||
+        sim_get_return_code() != SIM_RC_NOT_FOUND
+    ) {
+        *out_err_str = "get_ptr: missing key didn't return NOT_FOUND";
+        return SIM_RC_FAILURE;
+    }
+
+    // any key can be reserved as the empty key, freeing up 0 for use
+    Sim_IntHashMap pointer_inthashmap;
+    sim_inthashmap_construct(&pointer_inthashmap, sizeof(void*), NULL, 0, 0x5555);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct with a non-zero empty key";
+        return rc;
+    }
+
+    void* pointer = &pointer_inthashmap;
+    sim_inthashmap_insert(&pointer_inthashmap, 0, &pointer);
+    sim_inthashmap_insert(&pointer_inthashmap, (uint64)(size_t)pointer, &pointer);
+
+    void* *const pointer_ptr = sim_inthashmap_get_ptr(&pointer_inthashmap, 0);
+    if (
+        !pointer_ptr || *pointer_ptr != pointer ||
+        !sim_inthashmap_contains_key(&pointer_inthashmap, (uint64)(size_t)pointer) ||
+        sim_inthashmap_contains_key(&pointer_inthashmap, 1)
+    ) {
+        sim_inthashmap_destroy(&pointer_inthashmap);
+        *out_err_str = "get_ptr: incorrect result with a non-zero empty key";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_inthashmap_destroy(&pointer_inthashmap);
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode inthashmap_test_remove(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    // remove every odd key, leaving gaps in the middle of probe runs
+    for (uint64 i = 1; i < INTHASHMAP_TEST_KEYS; i += 2) {
+        sim_inthashmap_remove(&inthashmap, INTHASHMAP_TEST_KEY(i));
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on remove";
+            return rc;
+        }
+    }
+
+    sim_inthashmap_remove(&inthashmap, INTHASHMAP_TEST_KEY(1));
+    if (sim_get_return_code() != SIM_RC_FAILURE) {
+        *out_err_str = "remove: removing a missing key didn't return FAILURE";
+        return SIM_RC_FAILURE;
+    }
+
+    if (inthashmap.count != INTHASHMAP_TEST_KEYS / 2) {
+        *out_err_str = "remove: incorrect count";
+        return SIM_RC_FAILURE;
+    }
+
+    // keys shifted back into the gaps must still be found
+    for (uint64 i = 0; i < INTHASHMAP_TEST_KEYS; i++) {
+        const uint64 *const value_ptr =
+            sim_inthashmap_get_ptr(&inthashmap, INTHASHMAP_TEST_KEY(i));
+
+        if ((i & 1) ? !!value_ptr : (!value_ptr || *value_ptr != i)) {
+            *out_err_str = "remove: incorrect keys left after removal";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // shrinking & clearing keep the hashmap usable
+    Sim_IntHashMap small_inthashmap;
+    sim_inthashmap_construct(&small_inthashmap, sizeof(uint32), NULL, 0, UINT64_MAX);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (uint32 i = 0; i < 4096; i++)
+        sim_inthashmap_insert(&small_inthashmap, i, &i);
+    for (uint32 i = 0; i < 4000; i++)
+        sim_inthashmap_remove(&small_inthashmap, i);
+
+    uint32 value = 0;
+    sim_inthashmap_get(&small_inthashmap, 4000, &value);
+    if (sim_get_return_code() || value != 4000 || small_inthashmap._allocated >= 4096) {
+        sim_inthashmap_destroy(&small_inthashmap);
+        *out_err_str = "remove: hashmap didn't shrink or lost a key while shrinking";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_inthashmap_clear(&small_inthashmap);
+    if (small_inthashmap.count || sim_inthashmap_contains_key(&small_inthashmap, 4000)) {
+        sim_inthashmap_destroy(&small_inthashmap);
+        *out_err_str = "clear: hashmap wasn't emptied";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_inthashmap_destroy(&small_inthashmap);
+
+    return SIM_RC_SUCCESS;
+}
+
+static bool _inthashmap_foreach_sum(
+    const void *const key_ptr,
+    void *const       value_ptr,
+    const size_t      index,
+    Sim_Variant       userdata
+) {
+    (void)index;
+
+    uint64 *const sum_ptr = userdata.pointer;
+
+    if (*(const uint64*)key_ptr != INTHASHMAP_TEST_KEY(*(uint64*)value_ptr))
+        return false;
+
+    *sum_ptr += *(uint64*)value_ptr;
+    return true;
+}
+
+Sim_ReturnCode inthashmap_test_foreach(const char* *const out_err_str) {
+    uint64 sum = 0;
+
+    if (!sim_inthashmap_foreach(
+        &inthashmap,
+        _inthashmap_foreach_sum,
+        (Sim_Variant){ .pointer = &sum }
+    )) {
+        *out_err_str = "foreach: key passed doesn't match its value";
+        return SIM_RC_FAILURE;
+    }
+
+    // sum of every even index below INTHASHMAP_TEST_KEYS
+    const uint64 half = INTHASHMAP_TEST_KEYS / 2;
+    if (sum != half * (half - 1)) {
+        *out_err_str = "foreach: didn't visit every pair";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode inthashmap_test_destroy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_inthashmap_destroy(&inthashmap);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on destroy";
+        return rc;
+    }
+
+    if (simt_alloc_size() > _inthashmap_alloc_size) {
+        *out_err_str = "destroy: failed to free integer-keyed hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+// == BENCHMARKS ==================================================================================
+
+#define INTHASHMAP_BENCH_KEYS   (1 << 16)
+#define INTHASHMAP_BENCH_ROUNDS 16
+
+// Times hits & misses on an integer-keyed hashmap; same keys as the Sim_HashMap benchmarks.
+Sim_ReturnCode inthashmap_bench_lookup(const char* *const out_err_str) {
+    static char result_str[64];
+    Sim_ReturnCode rc;
+    Sim_IntHashMap bench_inthashmap;
+
+    sim_inthashmap_construct(&bench_inthashmap, sizeof(int), NULL, 0, UINT64_MAX);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    // even keys are inserted; odd keys are used for misses
+    for (int i = 0; i < INTHASHMAP_BENCH_KEYS; i++) {
+        sim_inthashmap_insert(&bench_inthashmap, (uint64)i * 2, &i);
+        if ((rc = sim_get_return_code())) {
+            sim_inthashmap_destroy(&bench_inthashmap);
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    size_t found = 0;
+    clock_t start = clock();
+    for (int round = 0; round < INTHASHMAP_BENCH_ROUNDS; round++)
+        for (int i = 0; i < INTHASHMAP_BENCH_KEYS; i++)
+            found += sim_inthashmap_get_ptr(&bench_inthashmap, (uint64)i * 2) != NULL;
+    clock_t hit_ticks = clock() - start;
+
+    start = clock();
+    for (int round = 0; round < INTHASHMAP_BENCH_ROUNDS; round++)
+        for (int i = 0; i < INTHASHMAP_BENCH_KEYS; i++)
+            found += sim_inthashmap_get_ptr(&bench_inthashmap, (uint64)i * 2 + 1) != NULL;
+    clock_t miss_ticks = clock() - start;
+
+    sim_inthashmap_destroy(&bench_inthashmap);
+
+    if (found != (size_t)INTHASHMAP_BENCH_KEYS * INTHASHMAP_BENCH_ROUNDS) {
+        *out_err_str = "get_ptr: incorrect amount of keys found";
+        return SIM_RC_FAILURE;
+    }
+
+    const double lookups = (double)INTHASHMAP_BENCH_KEYS * INTHASHMAP_BENCH_ROUNDS;
+    snprintf(
+        result_str,
+        sizeof(result_str),
+        "%.1f ns/hit, %.1f ns/miss",
+        (double)hit_ticks * 1e9 / CLOCKS_PER_SEC / lookups,
+        (double)miss_ticks * 1e9 / CLOCKS_PER_SEC / lookups
+    );
+    *out_err_str = result_str;
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_INTHASHMAP_TESTS_C_ */
@@ -0,0 +1,24 @@
+/**
+ * @file inthashmap_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Integer-keyed hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-18
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_INTHASHMAP_TESTS_H_
+#define SIMTEST_INTHASHMAP_TESTS_H_
+
+#include "simsoft/common.h"
+
+extern Sim_ReturnCode inthashmap_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode inthashmap_test_insert(const char* *const out_err_str);
+extern Sim_ReturnCode inthashmap_test_remove(const char* *const out_err_str);
+extern Sim_ReturnCode inthashmap_test_foreach(const char* *const out_err_str);
+extern Sim_ReturnCode inthashmap_test_destroy(const char* *const out_err_str);
+
+extern Sim_ReturnCode inthashmap_bench_lookup(const char* *const out_err_str);
+
+#endif /* SIMTEST_INTHASHMAP_TESTS_H_ */
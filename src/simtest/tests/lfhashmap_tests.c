@@ -0,0 +1,305 @@
+/**
+ * @file lfhashmap_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Lock-free hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-09
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_LFHASHMAP_TESTS_C_
+#define SIMTEST_LFHASHMAP_TESTS_C_
+
+#include "../test.h"
+#include "simsoft/lfhashmap.h"
+#include "./lfhashmap_tests.h"
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+#define LFHASHMAP_TEST_READERS 7
+#define LFHASHMAP_TEST_KEYS    1024
+#define LFHASHMAP_TEST_ROUNDS  64
+
+static bool _lfhashmap_int_eq(const int *const a, const int *const b) {
+    return *a == *b;
+}
+
+// the test allocator isn't thread-safe; worker threads allocate through the library's default
+static const Sim_IAllocator _lfhashmap_allocator = {
+    sim_allocator_default_malloc,
+    sim_allocator_default_falloc,
+    sim_allocator_default_realloc,
+    sim_allocator_default_free
+};
+
+static Sim_LockFreeHashMap lfhashmap;
+
+Sim_ReturnCode lfhashmap_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_lfhashmap_construct(
+        &lfhashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_lfhashmap_int_eq,
+        sizeof(int),
+        &_lfhashmap_allocator,
+        0,
+        SIM_HASH_DEFAULT
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    if (sim_lfhashmap_get_count(&lfhashmap) != 0) {
+        *out_err_str = "construct: lock-free hashmap not empty after construction";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode lfhashmap_test_insert(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 256; i++) {
+        const int value = i * 2;
+
+        sim_lfhashmap_insert(&lfhashmap, &i, &value);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on insert";
+            return rc;
+        }
+    }
+
+    if (sim_lfhashmap_get_count(&lfhashmap) != 256) {
+        *out_err_str = "insert: incorrect count after inserting keys";
+        return SIM_RC_FAILURE;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        int value;
+
+        sim_lfhashmap_get(&lfhashmap, &i, &value);
+        if ((rc = sim_get_return_code()) || value != i * 2) {
+            *out_err_str = "get: failed to retrieve value for key in lock-free hashmap";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // pointers are only handed out inside of read-side sections
+    const int key = 7;
+    sim_lfhashmap_get_ptr(&lfhashmap, &key);
+    if (sim_get_return_code() != SIM_RC_FAILURE) {
+        *out_err_str = "get_ptr: returned a pointer outside of a read-side section";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_lfhashmap_read_begin(&lfhashmap);
+    const int *const value_ptr = sim_lfhashmap_get_ptr(&lfhashmap, &key);
+
+    // overwriting replaces the node; the old value stays readable until the section ends
+    const int new_value = -1;
+    sim_lfhashmap_insert(&lfhashmap, &key, &new_value);
+
+    const bool kept_old_value = value_ptr && *value_ptr == key * 2;
+    const int *const new_value_ptr = sim_lfhashmap_get_ptr(&lfhashmap, &key);
+    const bool found_new_value = new_value_ptr && *new_value_ptr == new_value;
+    sim_lfhashmap_read_end(&lfhashmap);
+
+    if (!kept_old_value || !found_new_value) {
+        *out_err_str = "get_ptr: incorrect values around an overwrite in a read-side section";
+        return SIM_RC_FAILURE;
+    }
+
+    // a caught exception doesn't end a section it wasn't thrown from inside of
+    sim_lfhashmap_read_begin(&lfhashmap);
+    SIMT_CATCH(rc, sim_lfhashmap_get(&lfhashmap, &key, NULL));
+    const bool kept_section = sim_lfhashmap_get_ptr(&lfhashmap, &key) != NULL;
+    sim_lfhashmap_read_end(&lfhashmap);
+
+    if (rc != SIM_RC_ERR_NULLPTR || !kept_section) {
+        *out_err_str = "read_begin: read-side section ended by an unrelated exception";
+        return SIM_RC_FAILURE;
+    }
+
+    if (sim_lfhashmap_get_count(&lfhashmap) != 256) {
+        *out_err_str = "insert: overwriting a key changed the count";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode lfhashmap_test_remove(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    for (int i = 0; i < 256; i += 2) {
+        sim_lfhashmap_remove(&lfhashmap, &i);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on remove";
+            return rc;
+        }
+    }
+
+    for (int i = 0; i < 256; i++) {
+        if (sim_lfhashmap_contains_key(&lfhashmap, &i) != (bool)(i % 2)) {
+            *out_err_str = "contains_key: removed keys still contained in lock-free hashmap";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    const int key = 0;
+    sim_lfhashmap_remove(&lfhashmap, &key);
+    if (sim_get_return_code() != SIM_RC_FAILURE) {
+        *out_err_str = "remove: removing a missing key didn't fail";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_lfhashmap_clear(&lfhashmap);
+    if (sim_lfhashmap_get_count(&lfhashmap) != 0 || sim_lfhashmap_contains_key(&lfhashmap, &key)) {
+        *out_err_str = "clear: lock-free hashmap not empty after clearing";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+static volatile int _lfhashmap_writer_done;
+
+// Repeatedly overwrites every key's value & removes & reinserts the odd keys.
+static int _lfhashmap_writer(void) {
+    int errors = 0;
+
+    for (int round = 0; round < LFHASHMAP_TEST_ROUNDS; round++) {
+        for (int key = 0; key < LFHASHMAP_TEST_KEYS; key++) {
+            const int value = key * (2 + round % 2);
+
+            sim_lfhashmap_insert(&lfhashmap, &key, &value);
+            errors += sim_get_return_code() != SIM_RC_SUCCESS;
+        }
+
+        for (int key = 1; key < LFHASHMAP_TEST_KEYS; key += 2) {
+            sim_lfhashmap_remove(&lfhashmap, &key);
+            errors += sim_get_return_code() != SIM_RC_SUCCESS;
+        }
+    }
+
+    _lfhashmap_writer_done = 1;
+    return errors;
+}
+
+// Looks up every key until the writer is done; even keys must always be found.
+static int _lfhashmap_reader(void) {
+    int errors = 0;
+
+    do {
+        for (int key = 0; key < LFHASHMAP_TEST_KEYS; key++) {
+            int value = -1;
+
+            sim_lfhashmap_get(&lfhashmap, &key, &value);
+            if (sim_get_return_code() == SIM_RC_SUCCESS)
+                errors += value != key * 2 && value != key * 3;
+            else
+                errors += key % 2 == 0;
+        }
+    } while (!_lfhashmap_writer_done);
+
+    return errors;
+}
+
+// Thread 0 writes while every other thread reads.
+static int _lfhashmap_worker(const int thread_num) {
+    return thread_num ? _lfhashmap_reader() : _lfhashmap_writer();
+}
+
+#ifdef _WIN32
+    static DWORD WINAPI _lfhashmap_thread_proc(LPVOID arg) {
+        return (DWORD)_lfhashmap_worker((int)(intptr_t)arg);
+    }
+#else
+    static void* _lfhashmap_thread_proc(void* arg) {
+        return (void*)(intptr_t)_lfhashmap_worker((int)(intptr_t)arg);
+    }
+#endif
+
+Sim_ReturnCode lfhashmap_test_threads(const char* *const out_err_str) {
+    intptr_t errors = 0;
+
+    for (int key = 0; key < LFHASHMAP_TEST_KEYS; key++) {
+        const int value = key * 2;
+
+        sim_lfhashmap_insert(&lfhashmap, &key, &value);
+    }
+    _lfhashmap_writer_done = 0;
+
+#   ifdef _WIN32
+        HANDLE threads[LFHASHMAP_TEST_READERS + 1];
+
+        for (int i = 0; i <= LFHASHMAP_TEST_READERS; i++)
+            threads[i] = CreateThread(
+                NULL,
+                0,
+                _lfhashmap_thread_proc,
+                (LPVOID)(intptr_t)i,
+                0,
+                NULL
+            );
+
+        for (int i = 0; i <= LFHASHMAP_TEST_READERS; i++) {
+            DWORD thread_errors = 0;
+
+            WaitForSingleObject(threads[i], INFINITE);
+            GetExitCodeThread(threads[i], &thread_errors);
+            CloseHandle(threads[i]);
+            errors += thread_errors;
+        }
+#   else
+        pthread_t threads[LFHASHMAP_TEST_READERS + 1];
+
+        for (int i = 0; i <= LFHASHMAP_TEST_READERS; i++)
+            pthread_create(&threads[i], NULL, _lfhashmap_thread_proc, (void*)(intptr_t)i);
+
+        for (int i = 0; i <= LFHASHMAP_TEST_READERS; i++) {
+            void* thread_errors = NULL;
+
+            pthread_join(threads[i], &thread_errors);
+            errors += (intptr_t)thread_errors;
+        }
+#   endif
+
+    if (errors) {
+        *out_err_str = "threads: lookups concurrent with a writer returned missing or torn values";
+        return SIM_RC_FAILURE;
+    }
+
+    if (sim_lfhashmap_get_count(&lfhashmap) != LFHASHMAP_TEST_KEYS / 2) {
+        *out_err_str = "threads: incorrect count after concurrent overwrites & removes";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode lfhashmap_test_destroy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_lfhashmap_destroy(&lfhashmap);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on destroy";
+        return rc;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_LFHASHMAP_TESTS_C_ */
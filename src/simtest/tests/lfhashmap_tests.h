@@ -0,0 +1,22 @@
+/**
+ * @file lfhashmap_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Lock-free hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-09
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_LFHASHMAP_TESTS_H_
+#define SIMTEST_LFHASHMAP_TESTS_H_
+
+#include "simsoft/common.h"
+
+extern Sim_ReturnCode lfhashmap_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode lfhashmap_test_insert(const char* *const out_err_str);
+extern Sim_ReturnCode lfhashmap_test_remove(const char* *const out_err_str);
+extern Sim_ReturnCode lfhashmap_test_threads(const char* *const out_err_str);
+extern Sim_ReturnCode lfhashmap_test_destroy(const char* *const out_err_str);
+
+#endif /* SIMTEST_LFHASHMAP_TESTS_H_ */
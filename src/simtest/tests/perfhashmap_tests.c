@@ -0,0 +1,274 @@
+/**
+ * @file perfhashmap_tests.c
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Perfect hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-11
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_PERFHASHMAP_TESTS_C_
+#define SIMTEST_PERFHASHMAP_TESTS_C_
+
+#include <string.h>
+
+#include "../test.h"
+#include "simsoft/perfhashmap.h"
+#include "./perfhashmap_tests.h"
+
+#define PERFHASHMAP_TEST_KEYS 50000
+
+static bool _perfhashmap_int_eq(const int *const a, const int *const b) {
+    return *a == *b;
+}
+
+static Sim_PerfectHashMap perfhashmap;
+static size_t _perfhashmap_alloc_size;
+
+Sim_ReturnCode perfhashmap_test_construct(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    _perfhashmap_alloc_size = simt_alloc_size();
+
+    // empty & single key sets are still valid perfect hashmaps
+    const int key = 42, value = 7;
+    for (size_t count = 0; count < 2; count++) {
+        Sim_PerfectHashMap small_perfhashmap;
+
+        sim_perfhashmap_construct(
+            &small_perfhashmap,
+            sizeof(int),
+            NULL,
+            (Sim_PredicateProc)_perfhashmap_int_eq,
+            sizeof(int),
+            NULL,
+            count ? &key : NULL,
+            count ? &value : NULL,
+            count
+        );
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on construct";
+            return rc;
+        }
+
+        const int* value_ptr = sim_perfhashmap_get_ptr(&small_perfhashmap, &key);
+        if (count ? (!value_ptr || *value_ptr != value) : !!value_ptr) {
+            sim_perfhashmap_destroy(&small_perfhashmap);
+            *out_err_str = "get_ptr: incorrect result on an empty or single key perfect hashmap";
+            return SIM_RC_FAILURE;
+        }
+
+        sim_perfhashmap_destroy(&small_perfhashmap);
+    }
+
+    static int keys[PERFHASHMAP_TEST_KEYS], values[PERFHASHMAP_TEST_KEYS];
+    for (int i = 0; i < PERFHASHMAP_TEST_KEYS; i++) {
+        keys[i] = i * 7 + 3;
+        values[i] = i;
+    }
+
+    sim_perfhashmap_construct(
+        &perfhashmap,
+        sizeof(int),
+        NULL,
+        (Sim_PredicateProc)_perfhashmap_int_eq,
+        sizeof(int),
+        NULL,
+        keys,
+        values,
+        PERFHASHMAP_TEST_KEYS
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    if (perfhashmap.count != PERFHASHMAP_TEST_KEYS) {
+        *out_err_str = "construct: incorrect count";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode perfhashmap_test_get(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    // every key must have its own index, so no slot is left empty
+    static bool index_used[PERFHASHMAP_TEST_KEYS];
+    memset(index_used, 0, sizeof(index_used));
+
+    for (int i = 0; i < PERFHASHMAP_TEST_KEYS; i++) {
+        const int key = i * 7 + 3;
+
+        const size_t index = sim_perfhashmap_get_index(&perfhashmap, &key);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "get_index: failed to find a key the perfect hashmap was built from";
+            return rc;
+        }
+        if (index >= PERFHASHMAP_TEST_KEYS || index_used[index]) {
+            *out_err_str = "get_index: index out of range or shared between keys";
+            return SIM_RC_FAILURE;
+        }
+        index_used[index] = true;
+
+        int value = -1;
+        sim_perfhashmap_get(&perfhashmap, &key, &value);
+        if ((rc = sim_get_return_code()) || value != i) {
+            *out_err_str = "get: failed to retrieve value";
+            return rc ? rc : SIM_RC_FAILURE;
+        }
+    }
+
+    // keys that weren't in the set still land on a slot, but must not match it
+    for (int i = 0; i < PERFHASHMAP_TEST_KEYS; i++) {
+        const int key = i * 7 + 4;
+
+        if (
+            sim_perfhashmap_contains_key(&perfhashmap, &key) ||
+            sim_get_return_code() != SIM_RC_NOT_FOUND
+        ) {
+            *out_err_str = "contains_key: found a key the perfect hashmap wasn't built from";
+            return SIM_RC_FAILURE;
+        }
+
+        if (
+            sim_perfhashmap_get_ptr(&perfhashmap, &key) ||
+            sim_get_return_code() != SIM_RC_NOT_FOUND
+        ) {
+            *out_err_str = "get_ptr: missing key didn't return NOT_FOUND";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // values stay writable
+    const int key = 3;
+    int* value_ptr = sim_perfhashmap_get_ptr(&perfhashmap, &key);
+    if (!value_ptr) {
+        *out_err_str = "get_ptr: failed to retrieve value";
+        return SIM_RC_FAILURE;
+    }
+    *value_ptr = -5;
+
+    int value = 0;
+    sim_perfhashmap_get(&perfhashmap, &key, &value);
+    if (value != -5) {
+        *out_err_str = "get: value written through get_ptr wasn't kept";
+        return SIM_RC_FAILURE;
+    }
+    *value_ptr = 0;
+
+    return SIM_RC_SUCCESS;
+}
+
+typedef char _PerfHashMapKeyword[16];
+
+static bool _perfhashmap_keyword_eq(
+    const _PerfHashMapKeyword *const a,
+    const _PerfHashMapKeyword *const b
+) {
+    return !strncmp(*a, *b, sizeof(_PerfHashMapKeyword));
+}
+
+Sim_ReturnCode perfhashmap_test_keywords(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_PerfectHashMap keyword_perfhashmap;
+
+    // fixed keyword sets only need membership, so no values are kept
+    static const _PerfHashMapKeyword keywords[] = {
+        "help", "version", "verbose", "quiet", "output", "input", "config", "define",
+        "include", "library", "optimize", "debug", "warnings", "jobs", "dry-run", "force"
+    };
+    const size_t keyword_count = sizeof(keywords) / sizeof(keywords[0]);
+
+    sim_perfhashmap_construct(
+        &keyword_perfhashmap,
+        sizeof(_PerfHashMapKeyword),
+        NULL,
+        (Sim_PredicateProc)_perfhashmap_keyword_eq,
+        0,
+        NULL,
+        keywords,
+        NULL,
+        keyword_count
+    );
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (size_t i = 0; i < keyword_count; i++)
+        if (!sim_perfhashmap_contains_key(&keyword_perfhashmap, &keywords[i])) {
+            sim_perfhashmap_destroy(&keyword_perfhashmap);
+            *out_err_str = "contains_key: failed to find keyword";
+            return SIM_RC_FAILURE;
+        }
+
+    static const _PerfHashMapKeyword missing_keyword = "verbosity";
+    if (sim_perfhashmap_contains_key(&keyword_perfhashmap, &missing_keyword)) {
+        sim_perfhashmap_destroy(&keyword_perfhashmap);
+        *out_err_str = "contains_key: found a keyword that isn't in the set";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_perfhashmap_destroy(&keyword_perfhashmap);
+
+    return SIM_RC_SUCCESS;
+}
+
+static bool _perfhashmap_foreach_count(
+    const void *const key_ptr,
+    void *const       value_ptr,
+    const size_t      index,
+    Sim_Variant       userdata
+) {
+    (void)value_ptr;
+
+    size_t *const visited_ptr = userdata.pointer;
+
+    // pairs are visited in index order
+    if (sim_perfhashmap_get_index(&perfhashmap, key_ptr) != index)
+        return false;
+
+    (*visited_ptr)++;
+    return true;
+}
+
+Sim_ReturnCode perfhashmap_test_foreach(const char* *const out_err_str) {
+    size_t visited = 0;
+
+    if (!sim_perfhashmap_foreach(
+        &perfhashmap,
+        _perfhashmap_foreach_count,
+        (Sim_Variant){ .pointer = &visited }
+    )) {
+        *out_err_str = "foreach: index passed doesn't match get_index";
+        return SIM_RC_FAILURE;
+    }
+
+    if (visited != PERFHASHMAP_TEST_KEYS) {
+        *out_err_str = "foreach: didn't visit every pair";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode perfhashmap_test_destroy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
+    sim_perfhashmap_destroy(&perfhashmap);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on destroy";
+        return rc;
+    }
+
+    if (simt_alloc_size() > _perfhashmap_alloc_size) {
+        *out_err_str = "destroy: failed to free perfect hashmap";
+        return SIM_RC_FAILURE;
+    }
+
+    return SIM_RC_SUCCESS;
+}
+
+#endif /* SIMTEST_PERFHASHMAP_TESTS_C_ */
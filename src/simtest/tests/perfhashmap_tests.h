@@ -0,0 +1,22 @@
+/**
+ * @file perfhashmap_tests.h
+ * @author Simon Struthers (snstruthers@gmail.com)
+ * @brief Perfect hashmap unit tests.
+ * @version 0.1
+ * @date 2020-02-11
+ * 
+ * @copyright Copyright (c) 2020 LGPLv3
+ * 
+ */
+#ifndef SIMTEST_PERFHASHMAP_TESTS_H_
+#define SIMTEST_PERFHASHMAP_TESTS_H_
+
+#include "simsoft/common.h"
+
+extern Sim_ReturnCode perfhashmap_test_construct(const char* *const out_err_str);
+extern Sim_ReturnCode perfhashmap_test_get(const char* *const out_err_str);
+extern Sim_ReturnCode perfhashmap_test_keywords(const char* *const out_err_str);
+extern Sim_ReturnCode perfhashmap_test_foreach(const char* *const out_err_str);
+extern Sim_ReturnCode perfhashmap_test_destroy(const char* *const out_err_str);
+
+#endif /* SIMTEST_PERFHASHMAP_TESTS_H_ */
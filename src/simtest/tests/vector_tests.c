@@ -11,6 +11,8 @@
 #ifndef SIMTEST_VECTOR_TESTS_C_
 #define SIMTEST_VECTOR_TESTS_C_
 
+#include <string.h>
+
 #include "./vector_tests.h"
 #include "../test.h"
 #include "simsoft/vector.h"
@@ -21,21 +23,35 @@ static bool _int_eq(const int *const a, const int *const b) {
 
 static Sim_Vector vec;
 
+// counts reallocations so growth policies can be checked
+static size_t _vector_realloc_calls;
+
+static void* _vector_realloc(void* ptr, size_t size) {
+    _vector_realloc_calls++;
+    return simt_realloc(ptr, size);
+}
+
+static const Sim_IAllocator _vector_allocator = {
+    simt_malloc,
+    simt_falloc,
+    _vector_realloc,
+    simt_free
+};
+
 Sim_ReturnCode vector_test_construct(const char* *const out_err_str) {
     Sim_ReturnCode rc;
 
     srand(time(NULL));
 
-    sim_vector_construct(
+    SIMT_CATCH(rc, sim_vector_construct(
         NULL,
         sizeof(void*),
         NULL,
         256
-    );
-    printf("%s\n", sim_debug_get_return_code_string(sim_return_code()));
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    ));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "construct: failed to check for NULLPTR vector";
-        return SIM_RC_ERR_NULLPTR;
+        return SIM_RC_FAILURE;
     }
 
     sim_vector_construct(
@@ -44,7 +60,7 @@ Sim_ReturnCode vector_test_construct(const char* *const out_err_str) {
         NULL,
         256
     );
-    if ((rc = sim_return_code())) {
+    if ((rc = sim_get_return_code())) {
         *out_err_str = "unexpected error out on construct";
         return rc;
     }
@@ -60,21 +76,21 @@ Sim_ReturnCode vector_test_construct(const char* *const out_err_str) {
 Sim_ReturnCode vector_test_push(const char* *const out_err_str) {
     Sim_ReturnCode rc;
 
-    sim_vector_push(NULL, &rc);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_vector_push(NULL, &rc));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "push: failed to check for NULLPTR vector";
         return SIM_RC_FAILURE;
     }
 
-    sim_vector_push(&vec, NULL);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_vector_push(&vec, NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "push: failed to check for NULLPTR out_data_ptr";
         return SIM_RC_FAILURE;
     }
 
     for (int i = 0; i < 256; i++) {
         sim_vector_push(&vec, &i);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on push";
             return rc;
@@ -92,28 +108,22 @@ Sim_ReturnCode vector_test_get(const char* *const out_err_str) {
     Sim_ReturnCode rc;
 
     {
-        sim_vector_get(NULL, 0, NULL);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+        SIMT_CATCH(rc, sim_vector_get(NULL, 0, NULL));
+        if (rc != SIM_RC_ERR_NULLPTR) {
             *out_err_str = "get: failed to check for NULLPTR vector";
             return SIM_RC_FAILURE;
         }
 
-        {
-            int* i =sim_vector_get_ptr(NULL, 0);
-            if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-                *out_err_str = "get_ptr: failed to check for NULLPTR vector";
-                return SIM_RC_FAILURE;
-            }
-            if (i) {
-                *out_err_str = "get_ptr: failed to return NULLPTR on error";
-                return SIM_RC_FAILURE;
-            }
+        SIMT_CATCH(rc, sim_vector_get_ptr(NULL, 0));
+        if (rc != SIM_RC_ERR_NULLPTR) {
+            *out_err_str = "get_ptr: failed to check for NULLPTR vector";
+            return SIM_RC_FAILURE;
         }
 
         int j;
         for (size_t i = 0; i < 256; i++) {
             sim_vector_get(&vec, i, &j);
-            if ((rc = sim_return_code())) {
+            if ((rc = sim_get_return_code())) {
                 sim_vector_destroy(&vec);
                 *out_err_str = "unexpected error out on get";
                 return rc;
@@ -125,8 +135,8 @@ Sim_ReturnCode vector_test_get(const char* *const out_err_str) {
             }
         }
 
-        sim_vector_get(&vec, 256, &j);
-        if (sim_return_code() != SIM_RC_ERR_OUTOFBND) {
+        SIMT_CATCH(rc, sim_vector_get(&vec, 256, &j));
+        if (rc != SIM_RC_ERR_OUTOFBND) {
             *out_err_str = "get: failed to throw ERR_OUTOFBND for out-of-bounds index";
             sim_vector_destroy(&vec);
             return SIM_RC_ERR_OUTOFBND;
@@ -136,7 +146,7 @@ Sim_ReturnCode vector_test_get(const char* *const out_err_str) {
     {
         int old_val, new_val, retrieved_val;
         int* k = sim_vector_get_ptr(&vec, 32);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on get_ptr";
             return rc;
@@ -157,7 +167,7 @@ Sim_ReturnCode vector_test_get(const char* *const out_err_str) {
         *k = new_val;
         
         sim_vector_get(&vec, 32, &retrieved_val);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on get";
             return rc;
@@ -173,104 +183,102 @@ Sim_ReturnCode vector_test_get(const char* *const out_err_str) {
 }
 
 Sim_ReturnCode vector_test_contains(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+
     {
         int item;
-        if (sim_vector_contains(NULL, &item, (Sim_PredicateProc)_int_eq)) {
-            *out_err_str = "contains: returned TRUE for NULLPTR vector";
-            return SIM_RC_FAILURE;
-        }
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+        SIMT_CATCH(rc, sim_vector_contains(NULL, &item, (Sim_PredicateProc)_int_eq));
+        if (rc != SIM_RC_ERR_NULLPTR) {
             *out_err_str = "contains: failed to check for NULLPTR vector";
             return SIM_RC_FAILURE;
         }
 
-        if (sim_vector_contains(&vec, NULL, (Sim_PredicateProc)_int_eq)) {
-            *out_err_str = "contains: returned true for NULLPTR item";
-            return SIM_RC_FAILURE;
-        }
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+        SIMT_CATCH(rc, sim_vector_contains(&vec, NULL, (Sim_PredicateProc)_int_eq));
+        if (rc != SIM_RC_ERR_NULLPTR) {
             *out_err_str = "contains: failed to check for NULLPTR item";
             return SIM_RC_FAILURE;
         }
 
-        if (sim_vector_contains(&vec, &item, NULL)) {
-            *out_err_str = "contains: returned true for NULLPTR predicate function";
-            return SIM_RC_FAILURE;
-        }
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "contains: failed to check for NULLPTR predicate function";
+        SIMT_CATCH(rc, sim_vector_find(NULL, &item, (Sim_PredicateProc)_int_eq, 0));
+        if (rc != SIM_RC_ERR_NULLPTR) {
+            *out_err_str = "find: failed to check for NULLPTR vector";
             return SIM_RC_FAILURE;
         }
 
-        size_t ind = sim_vector_index_of(NULL, &item, (Sim_PredicateProc)_int_eq, 0);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "index_of: failed to check for NULLPTR vector";
+        SIMT_CATCH(rc, sim_vector_find(&vec, NULL, (Sim_PredicateProc)_int_eq, 0));
+        if (rc != SIM_RC_ERR_NULLPTR) {
+            *out_err_str = "find: failed to check for NULLPTR item";
             return SIM_RC_FAILURE;
         }
-        if (ind != (size_t)-1) {
-            *out_err_str = "index_of: failed to return -1 on error";
-        }
 
-        ind = sim_vector_index_of(&vec, NULL, (Sim_PredicateProc)_int_eq, 0);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "index_of: failed to check for NULLPTR item";
+        // searches may start at the end of the vector, but not past it
+        item = 0;
+        size_t ind = sim_vector_find(&vec, &item, (Sim_PredicateProc)_int_eq, vec.count);
+        if (sim_get_return_code() != SIM_RC_NOT_FOUND || ind != (size_t)-1) {
+            *out_err_str = "find: failed to return NOT_FOUND when starting at the end";
             return SIM_RC_FAILURE;
         }
-        if (ind != (size_t)-1) {
-            *out_err_str = "index_of: failed to return -1 on error";
-        }
-        
-        ind = sim_vector_index_of(&vec, &item, NULL, 0);
-        if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
-            *out_err_str = "index_of: failed to check for NULLPTR predicate function";
+
+        SIMT_CATCH(rc, sim_vector_find(&vec, &item, (Sim_PredicateProc)_int_eq, vec.count + 1));
+        if (rc != SIM_RC_ERR_OUTOFBND) {
+            *out_err_str = "find: failed to check for out-of-bounds starting index";
             return SIM_RC_FAILURE;
         }
-        if (ind != (size_t)-1) {
-            *out_err_str = "index_of: failed to return -1 on error";
-        }
     }
 
     {
+        // a NULL predicate function compares items bytewise
         int i = 16;
-        if (!sim_vector_contains(&vec, &i, (Sim_PredicateProc)_int_eq)) {
+        if (
+            !sim_vector_contains(&vec, &i, (Sim_PredicateProc)_int_eq) ||
+            !sim_vector_contains(&vec, &i, NULL)
+        ) {
             *out_err_str = "contains: returned false for item in the vector";
             return SIM_RC_FAILURE;
         }
+        if (
+            sim_vector_find(&vec, &i, NULL, 0) !=
+            sim_vector_find(&vec, &i, (Sim_PredicateProc)_int_eq, 0)
+        ) {
+            *out_err_str = "find: bytewise search returned a different index";
+            return SIM_RC_FAILURE;
+        }
+
         i = -30;
-        if (sim_vector_contains(&vec, &i, (Sim_PredicateProc)_int_eq)) {
+        if (
+            sim_vector_contains(&vec, &i, (Sim_PredicateProc)_int_eq) ||
+            sim_vector_contains(&vec, &i, NULL)
+        ) {
             *out_err_str = "contains: returned true for item not in the vector";
             return SIM_RC_FAILURE;
         }
     }
 
-    Sim_ReturnCode rc;
-
     {
         int i = rand() % vec.count, j;
 
-        size_t ind = sim_vector_index_of(&vec, &i, (Sim_PredicateProc)_int_eq, 0);
-        if ((rc = sim_return_code())) {
-            *out_err_str = "unexpected error out on index_of";
+        size_t ind = sim_vector_find(&vec, &i, (Sim_PredicateProc)_int_eq, 0);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on find";
             sim_vector_destroy(&vec);
             return rc;
         }
         sim_vector_get(&vec, ind, &j);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on get";
             return rc;
         }
         if (i != j) {
-            *out_err_str = "index_of: wrong index returned";
+            *out_err_str = "find: wrong index returned";
             return SIM_RC_FAILURE;
         }
 
         j = -1;
-        ind = sim_vector_index_of(&vec, &j, (Sim_PredicateProc)_int_eq, 0);
-        if (sim_return_code() != SIM_RC_ERR_NOTFOUND) {
-            sim_vector_destroy(&vec);
-            *out_err_str = "index_of: failed to throw ERR_NOTFOUND for item not in vector";
-            return SIM_RC_ERR_NOTFOUND;
+        ind = sim_vector_find(&vec, &j, (Sim_PredicateProc)_int_eq, 0);
+        if (sim_get_return_code() != SIM_RC_NOT_FOUND || ind != (size_t)-1) {
+            *out_err_str = "find: failed to return NOT_FOUND for item not in vector";
+            return SIM_RC_FAILURE;
         }
     }
 
@@ -280,13 +288,13 @@ Sim_ReturnCode vector_test_contains(const char* *const out_err_str) {
 Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
     Sim_ReturnCode rc;
 
-    sim_vector_remove(NULL, NULL, 0);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_vector_remove(NULL, NULL, 0));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "remove: failed to check for NULLPTR vector";
         return SIM_RC_FAILURE;
     }
-    sim_vector_pop(NULL, NULL);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_vector_pop(NULL, NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "pop: failed to check for NULLPTR vector";
         return SIM_RC_FAILURE;
     }
@@ -297,7 +305,7 @@ Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
     while (!sim_vector_is_empty(&vec)) {
         size_t ind = (size_t)(rand() % vec.count);
         sim_vector_remove(&vec, &(arr[i++]), ind);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on remove";
             return rc;
@@ -311,7 +319,7 @@ Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
 
     for (i = 0; i < 256; i++) {
         sim_vector_push(&vec, &arr[i]);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on push";
             return rc;
@@ -320,7 +328,7 @@ Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
 
     for (i = 0; i < 256; i++) {
         sim_vector_pop(&vec, &arr[i]);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "unexpected error out on pop";
             return rc;
@@ -334,7 +342,7 @@ Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
     
     for (i = 0; i < 256; i++) {
         sim_vector_push(&vec, &arr[i]);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             *out_err_str = "unexpected error out on push";
             return rc;
         }
@@ -346,14 +354,14 @@ Sim_ReturnCode vector_test_remove(const char* *const out_err_str) {
 Sim_ReturnCode vector_test_clear(const char* *const out_err_str) {
     Sim_ReturnCode rc;
 
-    sim_vector_clear(NULL);
-    if (sim_return_code() != SIM_RC_ERR_NULLPTR) {
+    SIMT_CATCH(rc, sim_vector_clear(NULL));
+    if (rc != SIM_RC_ERR_NULLPTR) {
         *out_err_str = "clear: failed to check for NULLPTR vector";
         return SIM_RC_FAILURE;
     }
 
     sim_vector_clear(&vec);
-    if ((rc = sim_return_code())) {
+    if ((rc = sim_get_return_code())) {
         sim_vector_destroy(&vec);
         *out_err_str = "unexpected error out on clear";
         return rc;
@@ -364,8 +372,8 @@ Sim_ReturnCode vector_test_clear(const char* *const out_err_str) {
         return SIM_RC_FAILURE;
     }
 
-    sim_vector_pop(&vec, NULL);
-    if (sim_return_code() != SIM_RC_ERR_OUTOFBND) {
+    SIMT_CATCH(rc, sim_vector_pop(&vec, NULL));
+    if (rc != SIM_RC_ERR_OUTOFBND) {
         *out_err_str = "pop: failed to raise ERR_OUTOFBND given cleared vector";
         return SIM_RC_FAILURE;
     }
@@ -373,7 +381,7 @@ Sim_ReturnCode vector_test_clear(const char* *const out_err_str) {
     {
         int i = 5;
         sim_vector_push(&vec, &i);
-        if ((rc = sim_return_code())) {
+        if ((rc = sim_get_return_code())) {
             sim_vector_destroy(&vec);
             *out_err_str = "error out on push given cleared vector";
             return rc;
@@ -384,6 +392,424 @@ Sim_ReturnCode vector_test_clear(const char* *const out_err_str) {
     return SIM_RC_SUCCESS;
 }
 
+Sim_ReturnCode vector_test_policy(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Vector policy_vec;
+
+    // default policy doubles when full & halves at 25% load
+    sim_vector_construct(&policy_vec, sizeof(int), &_vector_allocator, 4);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int i = 0; i < 64; i++)
+        sim_vector_push(&policy_vec, &i);
+    if (policy_vec._allocated != 64) {
+        *out_err_str = "push: failed to double internal array when full";
+        return SIM_RC_FAILURE;
+    }
+
+    while (policy_vec.count > 16)
+        sim_vector_pop(&policy_vec, NULL);
+    if (policy_vec._allocated != 32) {
+        *out_err_str = "pop: failed to halve internal array at 25% load";
+        return SIM_RC_FAILURE;
+    }
+
+    // pushing & popping around the boundary doesn't reallocate
+    _vector_realloc_calls = 0;
+    for (int i = 0; i < 100; i++) {
+        sim_vector_push(&policy_vec, &i);
+        sim_vector_pop(&policy_vec, NULL);
+        sim_vector_pop(&policy_vec, NULL);
+        sim_vector_push(&policy_vec, &i);
+    }
+    if (_vector_realloc_calls) {
+        *out_err_str = "push: reallocated while oscillating around a boundary";
+        return SIM_RC_FAILURE;
+    }
+
+    // clear keeps the internal array, so refilling doesn't reallocate
+    void *const data_ptr = policy_vec.data_ptr;
+    for (int round = 0; round < 10; round++) {
+        sim_vector_clear(&policy_vec);
+        for (int i = 0; i < 32; i++)
+            sim_vector_push(&policy_vec, &i);
+    }
+    if (_vector_realloc_calls || policy_vec.data_ptr != data_ptr) {
+        *out_err_str = "clear: failed to keep internal array";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_vector_reserve(&policy_vec, 1000);
+    sim_vector_reserve(&policy_vec, 10);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on reserve";
+        return rc;
+    }
+    if (policy_vec._allocated != 1000 || _vector_realloc_calls != 1) {
+        *out_err_str = "reserve: failed to grow internal array exactly once";
+        return SIM_RC_FAILURE;
+    }
+    for (int i = 32; i < 1000; i++)
+        sim_vector_push(&policy_vec, &i);
+    if (_vector_realloc_calls != 1) {
+        *out_err_str = "push: reallocated reserved internal array";
+        return SIM_RC_FAILURE;
+    }
+    sim_vector_destroy(&policy_vec);
+
+    // 1.5x growth without shrinking
+    const Sim_VectorPolicy policy = { .growth_percent = 150, .shrink_percent = 0 };
+    sim_vector_construct_with_policy(&policy_vec, sizeof(int), &_vector_allocator, 10, &policy);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct_with_policy";
+        return rc;
+    }
+
+    for (int i = 0; i < 11; i++)
+        sim_vector_push(&policy_vec, &i);
+    if (policy_vec._allocated != 15) {
+        *out_err_str = "push: failed to grow internal array by growth factor";
+        return SIM_RC_FAILURE;
+    }
+
+    while (!sim_vector_is_empty(&policy_vec))
+        sim_vector_remove(&policy_vec, NULL, 0);
+    if (policy_vec._allocated != 15) {
+        *out_err_str = "remove: shrank internal array with shrinking disabled";
+        return SIM_RC_FAILURE;
+    }
+    sim_vector_destroy(&policy_vec);
+
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode vector_test_bulk(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Vector bulk_vec;
+    static int batch[4096], removed[100];
+
+    sim_vector_construct(&bulk_vec, sizeof(int), &_vector_allocator, 0);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    // each batch grows the vector at most once
+    _vector_realloc_calls = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4096; j++)
+            batch[j] = i * 4096 + j;
+
+        sim_vector_append_n(&bulk_vec, batch, 4096);
+        if ((rc = sim_get_return_code())) {
+            sim_vector_destroy(&bulk_vec);
+            *out_err_str = "unexpected error out on append_n";
+            return rc;
+        }
+    }
+    sim_vector_append_n(&bulk_vec, NULL, 0);
+
+    const int* items = bulk_vec.data_ptr;
+    if (bulk_vec.count != 16384 || _vector_realloc_calls > 4) {
+        *out_err_str = "append_n: failed to append each batch with a single reallocation";
+        return SIM_RC_FAILURE;
+    }
+    for (int i = 0; i < 16384; i++) {
+        if (items[i] != i) {
+            *out_err_str = "append_n: appended items out of order";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    for (int i = 0; i < 100; i++)
+        batch[i] = -i;
+    sim_vector_insert_n(&bulk_vec, batch, 100, 10);
+    if ((rc = sim_get_return_code())) {
+        sim_vector_destroy(&bulk_vec);
+        *out_err_str = "unexpected error out on insert_n";
+        return rc;
+    }
+
+    items = bulk_vec.data_ptr;
+    if (
+        bulk_vec.count != 16484 ||
+        items[9] != 9 || items[10] != 0 || items[109] != -99 || items[110] != 10 ||
+        items[16483] != 16383
+    ) {
+        *out_err_str = "insert_n: later items weren't shifted back";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_vector_remove_range(&bulk_vec, removed, 10, 100);
+    if ((rc = sim_get_return_code())) {
+        sim_vector_destroy(&bulk_vec);
+        *out_err_str = "unexpected error out on remove_range";
+        return rc;
+    }
+    if (removed[0] != 0 || removed[99] != -99) {
+        *out_err_str = "remove_range: failed to fill items_out_ptr with removed items";
+        return SIM_RC_FAILURE;
+    }
+
+    items = bulk_vec.data_ptr;
+    for (int i = 0; i < 16384; i++) {
+        if (items[i] != i) {
+            *out_err_str = "remove_range: later items weren't shifted forward";
+            return SIM_RC_FAILURE;
+        }
+    }
+
+    // removing most items shrinks the vector several times over in one reallocation
+    _vector_realloc_calls = 0;
+    sim_vector_remove_range(&bulk_vec, NULL, 0, 16000);
+    if (
+        bulk_vec.count != 384 || ((int*)bulk_vec.data_ptr)[0] != 16000 ||
+        bulk_vec._allocated != 1024 || _vector_realloc_calls != 1
+    ) {
+        *out_err_str = "remove_range: failed to shrink internal array once";
+        return SIM_RC_FAILURE;
+    }
+
+    sim_vector_destroy(&bulk_vec);
+    return SIM_RC_SUCCESS;
+}
+
+Sim_ReturnCode vector_test_find_bytewise(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Vector find_vec;
+
+    // SIMD widths, plus one compared with memcmp
+    static const size_t item_sizes[] = { 1, 2, 4, 8, 3 };
+    uint8 item[8], needle[8];
+
+    for (size_t s = 0; s < sizeof(item_sizes) / sizeof(*item_sizes); s++) {
+        const size_t item_size = item_sizes[s];
+
+        sim_vector_construct(&find_vec, item_size, NULL, 0);
+        if ((rc = sim_get_return_code())) {
+            *out_err_str = "unexpected error out on construct";
+            return rc;
+        }
+
+        // nothing to find in an empty vector
+        memset(needle, 0xAB, sizeof(needle));
+        if (sim_vector_contains(&find_vec, needle, NULL)) {
+            sim_vector_destroy(&find_vec);
+            *out_err_str = "contains: found item in empty vector";
+            return SIM_RC_FAILURE;
+        }
+
+        // items differ from the needle in their last byte only, so every byte is compared
+        memset(item, 0xAB, sizeof(item));
+        item[item_size - 1] = 0;
+        for (size_t i = 0; i < 300; i++)
+            sim_vector_push(&find_vec, item);
+
+        // needles in & past whole blocks, from every starting index around them
+        static const size_t positions[] = { 0, 1, 15, 16, 63, 64, 100, 255, 299 };
+        for (size_t p = 0; p < sizeof(positions) / sizeof(*positions); p++) {
+            uint8 *const item_ptr = sim_vector_get_ptr(&find_vec, positions[p]);
+            memcpy(item_ptr, needle, item_size);
+
+            for (size_t start = positions[p] > 3 ? positions[p] - 3 : 0; start < 300; start++) {
+                const size_t expected = start <= positions[p] ? positions[p] : (size_t)-1;
+                if (sim_vector_find(&find_vec, needle, NULL, start) != expected) {
+                    sim_vector_destroy(&find_vec);
+                    *out_err_str = "find: wrong index returned comparing bytewise";
+                    return SIM_RC_FAILURE;
+                }
+                if (start > positions[p] + 3)
+                    break;
+            }
+
+            memcpy(item_ptr, item, item_size);
+        }
+
+        if (sim_vector_contains(&find_vec, needle, NULL)) {
+            sim_vector_destroy(&find_vec);
+            *out_err_str = "contains: found item that was never pushed";
+            return SIM_RC_FAILURE;
+        }
+        sim_vector_destroy(&find_vec);
+    }
+
+    // predicates are still called from the starting index onwards
+    sim_vector_construct(&find_vec, sizeof(int), NULL, 0);
+    for (int i = 0; i < 10; i++) {
+        const int j = i % 5;
+        sim_vector_push(&find_vec, &j);
+    }
+    const int target = 2;
+    if (sim_vector_find(&find_vec, &target, (Sim_PredicateProc)_int_eq, 3) != 7) {
+        sim_vector_destroy(&find_vec);
+        *out_err_str = "find: predicate search ignored starting index";
+        return SIM_RC_FAILURE;
+    }
+    sim_vector_destroy(&find_vec);
+
+    return SIM_RC_SUCCESS;
+}
+
+static size_t _filter_calls;
+
+// Keeps items divisible by the userdata integer.
+static bool _int_divisible(const int *const item, Sim_Variant userdata) {
+    _filter_calls++;
+    return *item % userdata.signed_int == 0;
+}
+
+// Larger than the swap buffer, so partitions swap items in several blocks.
+typedef struct _BigItem {
+    int key;
+    uint8 padding[100];
+} _BigItem;
+
+static bool _big_item_even(const _BigItem *const item, Sim_Variant userdata) {
+    (void)userdata;
+    return item->key % 2 == 0;
+}
+
+Sim_ReturnCode vector_test_retain(const char* *const out_err_str) {
+    Sim_ReturnCode rc;
+    Sim_Vector retain_vec;
+    const Sim_Variant three = { .signed_int = 3 };
+
+    sim_vector_construct(&retain_vec, sizeof(int), &_vector_allocator, 1000);
+    if ((rc = sim_get_return_code())) {
+        *out_err_str = "unexpected error out on construct";
+        return rc;
+    }
+
+    for (int stable = 0; stable < 2; stable++) {
+        retain_vec.count = 0;
+        for (int i = 0; i < 1000; i++)
+            sim_vector_push(&retain_vec, &i);
+
+        // filtering in place never reallocates
+        _vector_realloc_calls = 0;
+        _filter_calls = 0;
+        size_t removed = sim_vector_retain(
+            &retain_vec,
+            (Sim_FilterProc)_int_divisible,
+            three,
+            stable
+        );
+        if ((rc = sim_get_return_code())) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "unexpected error out on retain";
+            return rc;
+        }
+        if (removed != 666 || retain_vec.count != 334 || _filter_calls != 1000) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "retain: removed wrong amount of items";
+            return SIM_RC_FAILURE;
+        }
+        if (_vector_realloc_calls != 0 || retain_vec._allocated != 1000) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "retain: reallocated internal array";
+            return SIM_RC_FAILURE;
+        }
+
+        const int* items = retain_vec.data_ptr;
+        int sum = 0;
+        for (size_t i = 0; i < retain_vec.count; i++) {
+            if (items[i] % 3 || (stable && items[i] != (int)i * 3)) {
+                sim_vector_destroy(&retain_vec);
+                *out_err_str = stable ?
+                    "retain: stable retain reordered kept items" :
+                    "retain: kept item failing filter"
+                ;
+                return SIM_RC_FAILURE;
+            }
+            sum += items[i];
+        }
+        if (sum != 3 * (333 * 334 / 2)) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "retain: lost kept items";
+            return SIM_RC_FAILURE;
+        }
+
+        // partitions keep every item, passing ones first
+        retain_vec.count = 0;
+        for (int i = 0; i < 1000; i++)
+            sim_vector_push(&retain_vec, &i);
+
+        _filter_calls = 0;
+        size_t split = sim_vector_partition(
+            &retain_vec,
+            (Sim_FilterProc)_int_divisible,
+            three,
+            stable
+        );
+        if ((rc = sim_get_return_code())) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "unexpected error out on partition";
+            return rc;
+        }
+        if (split != 334 || retain_vec.count != 1000 || _filter_calls != 1000) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "partition: returned wrong index of first failing item";
+            return SIM_RC_FAILURE;
+        }
+
+        items = retain_vec.data_ptr;
+        sum = 0;
+        for (size_t i = 0; i < 1000; i++) {
+            const bool passed = items[i] % 3 == 0;
+            if (passed != (i < split)) {
+                sim_vector_destroy(&retain_vec);
+                *out_err_str = "partition: failing item in front of passing item";
+                return SIM_RC_FAILURE;
+            }
+            if (stable && i > 0 && i != split && items[i] < items[i - 1]) {
+                sim_vector_destroy(&retain_vec);
+                *out_err_str = "partition: stable partition reordered items";
+                return SIM_RC_FAILURE;
+            }
+            sum += items[i];
+        }
+        if (sum != 999 * 1000 / 2) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "partition: lost items";
+            return SIM_RC_FAILURE;
+        }
+    }
+    sim_vector_destroy(&retain_vec);
+
+    // items larger than the swap buffer
+    sim_vector_construct(&retain_vec, sizeof(_BigItem), NULL, 0);
+    for (int i = 0; i < 101; i++) {
+        _BigItem item = { .key = i };
+        memset(item.padding, i, sizeof(item.padding));
+        sim_vector_push(&retain_vec, &item);
+    }
+
+    const size_t split = sim_vector_partition(
+        &retain_vec,
+        (Sim_FilterProc)_big_item_even,
+        (Sim_Variant){ .pointer = NULL },
+        true
+    );
+    const _BigItem* big_items = retain_vec.data_ptr;
+    for (size_t i = 0; i < 101; i++) {
+        const int key = i < split ? (int)i * 2 : (int)(i - split) * 2 + 1;
+        if (
+            big_items[i].key != key ||
+            big_items[i].padding[0] != key || big_items[i].padding[99] != key
+        ) {
+            sim_vector_destroy(&retain_vec);
+            *out_err_str = "partition: large items were torn or reordered";
+            return SIM_RC_FAILURE;
+        }
+    }
+    sim_vector_destroy(&retain_vec);
+
+    return SIM_RC_SUCCESS;
+}
+
 Sim_ReturnCode vector_test_destroy(const char* *const out_err_str) {
     sim_vector_destroy(&vec);
 
@@ -21,6 +21,10 @@ extern Sim_ReturnCode vector_test_get(const char* *const out_err_str);
 extern Sim_ReturnCode vector_test_contains(const char* *const out_err_str);
 extern Sim_ReturnCode vector_test_remove(const char* *const out_err_str);
 extern Sim_ReturnCode vector_test_clear(const char* *const out_err_str);
+extern Sim_ReturnCode vector_test_policy(const char* *const out_err_str);
+extern Sim_ReturnCode vector_test_bulk(const char* *const out_err_str);
+extern Sim_ReturnCode vector_test_find_bytewise(const char* *const out_err_str);
+extern Sim_ReturnCode vector_test_retain(const char* *const out_err_str);
 extern Sim_ReturnCode vector_test_destroy(const char* *const out_err_str);
 
 #endif /* SIMTEST_VECTOR_TEST_H_ */